@@ -40,14 +40,223 @@ brainll::NeuronModel convertBrainLLToAdvancedNeuronModel(BrainLL::NeuronModel mo
         case BrainLL::NeuronModel::LSTM: return brainll::NeuronModel::LSTM;
         case BrainLL::NeuronModel::TRANSFORMER: return brainll::NeuronModel::TRANSFORMER;
         case BrainLL::NeuronModel::GRU: return brainll::NeuronModel::GRU;
-        case BrainLL::NeuronModel::CNN: return brainll::NeuronModel::LIF; // Map to LIF as fallback
+        case BrainLL::NeuronModel::CNN: return brainll::NeuronModel::LIF; // No CNN in brainll; the group still runs CNNNeuron
+        case BrainLL::NeuronModel::HIGH_RESOLUTION_LIF: return brainll::NeuronModel::HIGH_RESOLUTION_LIF;
+        case BrainLL::NeuronModel::FAST_SPIKING: return brainll::NeuronModel::FAST_SPIKING;
+        case BrainLL::NeuronModel::REGULAR_SPIKING: return brainll::NeuronModel::REGULAR_SPIKING;
+        case BrainLL::NeuronModel::MEMORY_CELL: return brainll::NeuronModel::MEMORY_CELL;
+        case BrainLL::NeuronModel::EXECUTIVE_CONTROLLER: return brainll::NeuronModel::EXECUTIVE_CONTROLLER;
         case BrainLL::NeuronModel::HODGKIN_HUXLEY: return brainll::NeuronModel::HODGKIN_HUXLEY;
         case BrainLL::NeuronModel::ADAPTIVE: return brainll::NeuronModel::ADAPTIVE;
         case BrainLL::NeuronModel::ATTENTION_UNIT: return brainll::NeuronModel::ATTENTION_UNIT;
+        case BrainLL::NeuronModel::CUSTOM: return brainll::NeuronModel::CUSTOM;
         default: return brainll::NeuronModel::LIF; // Default fallback
     }
 }
 
+namespace brainll {
+
+// Neurons of one model. The virtual calls happen once per group and step, not per neuron.
+class NeuronModelGroup {
+public:
+    explicit NeuronModelGroup(BrainLL::NeuronModel model) : m_model(model) {}
+    virtual ~NeuronModelGroup() = default;
+
+    BrainLL::NeuronModel getModel() const { return m_model; }
+    size_t size() const { return m_ids.size(); }
+
+    // Returns the index of the new neuron within the group
+    virtual size_t add(size_t neuron_id, const BrainLL::AdvancedNeuronParams& params) = 0;
+    // Steps every member; ids of the neurons that fired are appended to 'fired'
+    virtual void update(std::vector<std::shared_ptr<AdvancedNeuron>>& neurons, double time, double dt,
+                        std::vector<size_t>& fired) = 0;
+    virtual bool updateOne(size_t index, AdvancedNeuron& neuron, double time, double dt) = 0;
+    virtual void reset() = 0;
+
+protected:
+    BrainLL::NeuronModel m_model;
+    std::vector<size_t> m_ids;  // Network neuron id of each member
+};
+
+namespace {
+
+// Hands the facade's pending inputs to the implementation and mirrors its state back.
+// The qualified calls bind statically, so the loop body has no virtual dispatch.
+template <typename Impl>
+inline bool stepImplementation(Impl& impl, AdvancedNeuron& neuron, double time, double dt) {
+    if (!neuron.inputs.empty()) {
+        double total_input = 0.0;
+        for (double input : neuron.inputs) {
+            total_input += input;
+        }
+        neuron.inputs.clear();
+        impl.Impl::addInput(total_input);
+    }
+
+    impl.Impl::update(dt);
+
+    const bool fired = impl.Impl::hasFired();
+    neuron.setCurrentTime(time);
+    neuron.setPotential(impl.Impl::getPotential());
+    neuron.setFired(fired);
+    if (fired) {
+        neuron.recordSpike(time);
+    }
+    return fired;
+}
+
+template <typename Impl>
+class ModelGroup final : public NeuronModelGroup {
+public:
+    using NeuronModelGroup::NeuronModelGroup;
+
+    size_t add(size_t neuron_id, const BrainLL::AdvancedNeuronParams& params) override {
+        m_ids.push_back(neuron_id);
+        m_impl.emplace_back(params);
+        return m_impl.size() - 1;
+    }
+
+    void update(std::vector<std::shared_ptr<AdvancedNeuron>>& neurons, double time, double dt,
+                std::vector<size_t>& fired) override {
+        for (size_t i = 0; i < m_impl.size(); ++i) {
+            if (stepImplementation(m_impl[i], *neurons[m_ids[i]], time, dt)) {
+                fired.push_back(m_ids[i]);
+            }
+        }
+    }
+
+    bool updateOne(size_t index, AdvancedNeuron& neuron, double time, double dt) override {
+        return stepImplementation(m_impl[index], neuron, time, dt);
+    }
+
+    void reset() override {
+        for (Impl& impl : m_impl) {
+            impl.Impl::reset();
+        }
+    }
+
+private:
+    std::vector<Impl> m_impl;  // Stored by value, in the same order as m_ids
+};
+
+// CUSTOM has no BIO/neurons implementation: the facade runs its own custom update function
+class CustomModelGroup final : public NeuronModelGroup {
+public:
+    using NeuronModelGroup::NeuronModelGroup;
+
+    size_t add(size_t neuron_id, const BrainLL::AdvancedNeuronParams&) override {
+        m_ids.push_back(neuron_id);
+        return m_ids.size() - 1;
+    }
+
+    void update(std::vector<std::shared_ptr<AdvancedNeuron>>& neurons, double time, double dt,
+                std::vector<size_t>& fired) override {
+        for (size_t i = 0; i < m_ids.size(); ++i) {
+            if (updateOne(i, *neurons[m_ids[i]], time, dt)) {
+                fired.push_back(m_ids[i]);
+            }
+        }
+    }
+
+    bool updateOne(size_t, AdvancedNeuron& neuron, double time, double dt) override {
+        neuron.setCurrentTime(time - dt);
+        neuron.update(dt);
+        return neuron.hasFired();
+    }
+
+    void reset() override {}
+};
+
+// Model -> implementation table; models without a class of their own run the class whose
+// dynamics they parameterize (Izhikevich regimes, adaptive LIF, LSTM and GRU cells)
+std::unique_ptr<NeuronModelGroup> createModelGroup(BrainLL::NeuronModel model) {
+    using BrainLL::NeuronModel;
+    switch (model) {
+        case NeuronModel::LIF:
+            return std::make_unique<ModelGroup<BrainLL::LIFNeuron>>(model);
+        case NeuronModel::ADAPTIVE_LIF:
+        case NeuronModel::HIGH_RESOLUTION_LIF:
+            return std::make_unique<ModelGroup<BrainLL::AdaptiveLIFNeuron>>(model);
+        case NeuronModel::IZHIKEVICH:
+        case NeuronModel::FAST_SPIKING:
+        case NeuronModel::REGULAR_SPIKING:
+            return std::make_unique<ModelGroup<BrainLL::IzhikevichNeuron>>(model);
+        case NeuronModel::LSTM:
+        case NeuronModel::MEMORY_CELL:
+            return std::make_unique<ModelGroup<BrainLL::LSTMNeuron>>(model);
+        case NeuronModel::GRU:
+        case NeuronModel::EXECUTIVE_CONTROLLER:
+            return std::make_unique<ModelGroup<BrainLL::GRUNeuron>>(model);
+        case NeuronModel::TRANSFORMER:
+            return std::make_unique<ModelGroup<BrainLL::TransformerNeuron>>(model);
+        case NeuronModel::CNN:
+            return std::make_unique<ModelGroup<BrainLL::CNNNeuron>>(model);
+        case NeuronModel::HODGKIN_HUXLEY:
+            return std::make_unique<ModelGroup<BrainLL::HodgkinHuxleyNeuron>>(model);
+        case NeuronModel::ATTENTION_UNIT:
+            return std::make_unique<ModelGroup<BrainLL::AttentionNeuron>>(model);
+        case NeuronModel::ADAPTIVE:
+            return std::make_unique<ModelGroup<BrainLL::AdaptiveNeuron>>(model);
+        case NeuronModel::CUSTOM:
+            return std::make_unique<CustomModelGroup>(model);
+    }
+    throw std::runtime_error("Unknown neuron model");
+}
+
+// Accepts NeuronFactory names ("FAST_SPIKING") and the legacy CamelCase names ("FastSpiking")
+BrainLL::NeuronModel parseNeuronType(const std::string& type) {
+    try {
+        return BrainLL::NeuronFactory::stringToModel(type);
+    } catch (const std::exception&) {
+        static const std::map<std::string, BrainLL::NeuronModel> legacy_names = {
+            {"AdaptiveLIF", BrainLL::NeuronModel::ADAPTIVE_LIF},
+            {"Izhikevich", BrainLL::NeuronModel::IZHIKEVICH},
+            {"Transformer", BrainLL::NeuronModel::TRANSFORMER},
+            {"HighResolutionLIF", BrainLL::NeuronModel::HIGH_RESOLUTION_LIF},
+            {"FastSpiking", BrainLL::NeuronModel::FAST_SPIKING},
+            {"RegularSpiking", BrainLL::NeuronModel::REGULAR_SPIKING},
+            {"MemoryCell", BrainLL::NeuronModel::MEMORY_CELL},
+            {"AttentionUnit", BrainLL::NeuronModel::ATTENTION_UNIT},
+            {"ExecutiveController", BrainLL::NeuronModel::EXECUTIVE_CONTROLLER},
+            {"HodgkinHuxley", BrainLL::NeuronModel::HODGKIN_HUXLEY},
+            {"Adaptive", BrainLL::NeuronModel::ADAPTIVE}
+        };
+        auto it = legacy_names.find(type);
+        return it != legacy_names.end() ? it->second : BrainLL::NeuronModel::LIF; // Default
+    }
+}
+
+// Mirrors the implementation's parameters on the AdvancedNeuron facade
+void applyImplementationParams(AdvancedNeuron& neuron, const BrainLL::AdvancedNeuronParams& source) {
+    AdvancedNeuronParams params = neuron.getParameters();
+    params.threshold = source.threshold;
+    params.resting_potential = source.resting_potential;
+    params.reset_potential = source.reset_potential;
+    params.membrane_resistance = source.membrane_resistance;
+    params.membrane_capacitance = source.membrane_capacitance;
+    params.refractory_period = source.refractory_period;
+    params.adaptation_strength = source.adaptation_strength;
+    params.adaptation_time_constant = source.adaptation_time_constant;
+    params.a = source.a;
+    params.b = source.b;
+    params.c = source.c;
+    params.d = source.d;
+    params.hidden_size = source.hidden_size;
+    params.forget_bias = source.forget_bias;
+    params.noise_variance = source.noise_variance;
+    neuron.setParameters(params);
+}
+
+// Delay in whole steps of dt; a spike never arrives in the step it was emitted
+size_t delayInSteps(double delay, double dt) {
+    const double steps = std::round(delay / dt);
+    return steps < 1.0 ? 1 : static_cast<size_t>(steps);
+}
+
+} // namespace
+
+} // namespace brainll
+
 AdvancedNeuralNetwork::AdvancedNeuralNetwork() {
     // Initialize default configuration
     m_global_config.simulation_timestep = 0.001;
@@ -59,6 +268,9 @@ AdvancedNeuralNetwork::AdvancedNeuralNetwork() {
     m_global_config.gpu_acceleration = false;
     m_current_time = 0.0;
     m_timestep = 0.001;
+    m_delivery_head = 0;
+    m_delivery_dt = 0.0;
+    m_adjacency_dirty = true;
     m_is_running = false;
     m_is_paused = false;
     m_learning_enabled = true;
@@ -74,7 +286,16 @@ AdvancedNeuralNetwork::~AdvancedNeuralNetwork() {
 
 void AdvancedNeuralNetwork::clear() {
     m_neurons.clear();
+    m_model_groups.clear();
+    m_neuron_slots.clear();
     m_connections.clear();
+    m_out_offsets.clear();
+    m_out_synapses.clear();
+    m_out_delay_steps.clear();
+    m_delivery_ring.clear();
+    m_delivery_head = 0;
+    m_delivery_dt = 0.0;
+    m_adjacency_dirty = true;
     m_populations.clear();
     m_input_interfaces.clear();
     m_output_interfaces.clear();
@@ -91,103 +312,62 @@ void AdvancedNeuralNetwork::setGlobalConfig(const GlobalConfig& global_config) {
 }
 
 size_t AdvancedNeuralNetwork::addNeuron(const std::string& type, const std::map<std::string, double>& params) {
-    try {
-        // Use NeuronFactory to create modular neurons
-        BrainLL::NeuronModel model = BrainLL::NeuronFactory::stringToModel(type);
-        BrainLL::AdvancedNeuronParams neuron_params = BrainLL::NeuronFactory::getDefaultParams(model);
-        
-        // Apply custom parameters
-        for (const auto& param : params) {
-            // Map common parameters
-            if (param.first == "threshold") neuron_params.threshold = param.second;
-            else if (param.first == "resting_potential") neuron_params.resting_potential = param.second;
-            else if (param.first == "reset_potential") neuron_params.reset_potential = param.second;
-            else if (param.first == "membrane_resistance") neuron_params.membrane_resistance = param.second;
-            else if (param.first == "membrane_capacitance") neuron_params.membrane_capacitance = param.second;
-            else if (param.first == "refractory_period") neuron_params.refractory_period = param.second;
-            else if (param.first == "a") neuron_params.a = param.second;
-            else if (param.first == "b") neuron_params.b = param.second;
-            else if (param.first == "c") neuron_params.c = param.second;
-            else if (param.first == "d") neuron_params.d = param.second;
-            else if (param.first == "hidden_size") neuron_params.hidden_size = static_cast<int>(param.second);
-            else if (param.first == "num_heads") neuron_params.num_heads = static_cast<int>(param.second);
-            else if (param.first == "d_model") neuron_params.d_model = static_cast<int>(param.second);
-            else if (param.first == "adaptation_rate") neuron_params.adaptation_rate = param.second;
-            else if (param.first == "plasticity_window") neuron_params.plasticity_window = param.second;
-            else if (param.first == "leak_rate") neuron_params.leak_rate = param.second;
-            else if (param.first == "noise_variance") neuron_params.noise_variance = param.second;
-        }
-        
-        // Create modular neuron
-        auto modular_neuron = BrainLL::NeuronFactory::createNeuron(neuron_params);
-        
-        // Create AdvancedNeuron wrapper using AdvancedNeuronAdapter
-        size_t neuron_id = m_neurons.size();
-        brainll::NeuronModel advanced_model = convertBrainLLToAdvancedNeuronModel(model);
-        auto advanced_neuron = std::make_shared<AdvancedNeuron>(neuron_id, advanced_model);
-        
-        // Store the modular neuron for later use (we'll need to modify AdvancedNeuron to hold this)
-        // For now, we'll use the existing AdvancedNeuron but with proper model type
-        
-        m_neurons.push_back(advanced_neuron);
-        return neuron_id;
-        
-    } catch (const std::exception& e) {
-        // Fallback to original hardcoded implementation if modular neuron not found
-        NeuronModel model;
-        if (type == "LIF") {
-            model = NeuronModel::LIF;
-        } else if (type == "AdaptiveLIF") {
-            model = NeuronModel::ADAPTIVE_LIF;
-        } else if (type == "Izhikevich") {
-            model = NeuronModel::IZHIKEVICH;
-        } else if (type == "LSTM") {
-            model = NeuronModel::LSTM;
-        } else if (type == "Transformer") {
-            model = NeuronModel::TRANSFORMER;
-        } else if (type == "GRU") {
-            model = NeuronModel::GRU;
-        } else if (type == "HighResolutionLIF") {
-            model = NeuronModel::HIGH_RESOLUTION_LIF;
-        } else if (type == "FastSpiking") {
-            model = NeuronModel::FAST_SPIKING;
-        } else if (type == "RegularSpiking") {
-            model = NeuronModel::REGULAR_SPIKING;
-        } else if (type == "MemoryCell") {
-            model = NeuronModel::MEMORY_CELL;
-        } else if (type == "AttentionUnit") {
-            model = NeuronModel::ATTENTION_UNIT;
-        } else if (type == "ExecutiveController") {
-            model = NeuronModel::EXECUTIVE_CONTROLLER;
-        } else if (type == "HodgkinHuxley") {
-            model = NeuronModel::HODGKIN_HUXLEY;
-        } else if (type == "Adaptive") {
-            model = NeuronModel::ADAPTIVE;
-        } else {
-            model = NeuronModel::LIF; // Default
-        }
-        
-        size_t neuron_id = m_neurons.size();
-        auto neuron = std::make_shared<AdvancedNeuron>(neuron_id, model);
-        
-        // Set custom parameters
-        for (const auto& param : params) {
-            neuron->setParameter(param.first, param.second);
+    BrainLL::NeuronModel model = parseNeuronType(type);
+    BrainLL::AdvancedNeuronParams neuron_params = BrainLL::NeuronFactory::getDefaultParams(model);
+    
+    // Apply custom parameters
+    for (const auto& param : params) {
+        // Map common parameters
+        if (param.first == "threshold") neuron_params.threshold = param.second;
+        else if (param.first == "resting_potential") neuron_params.resting_potential = param.second;
+        else if (param.first == "reset_potential") neuron_params.reset_potential = param.second;
+        else if (param.first == "membrane_resistance") neuron_params.membrane_resistance = param.second;
+        else if (param.first == "membrane_capacitance") neuron_params.membrane_capacitance = param.second;
+        else if (param.first == "refractory_period") neuron_params.refractory_period = param.second;
+        else if (param.first == "a") neuron_params.a = param.second;
+        else if (param.first == "b") neuron_params.b = param.second;
+        else if (param.first == "c") neuron_params.c = param.second;
+        else if (param.first == "d") neuron_params.d = param.second;
+        else if (param.first == "hidden_size") neuron_params.hidden_size = static_cast<int>(param.second);
+        else if (param.first == "num_heads") neuron_params.num_heads = static_cast<int>(param.second);
+        else if (param.first == "d_model") neuron_params.d_model = static_cast<int>(param.second);
+        else if (param.first == "adaptation_rate") neuron_params.adaptation_rate = param.second;
+        else if (param.first == "plasticity_window") neuron_params.plasticity_window = param.second;
+        else if (param.first == "leak_rate") neuron_params.leak_rate = param.second;
+        else if (param.first == "noise_variance") neuron_params.noise_variance = param.second;
+    }
+    
+    size_t neuron_id = m_neurons.size();
+    auto neuron = std::make_shared<AdvancedNeuron>(neuron_id, convertBrainLLToAdvancedNeuronModel(model));
+    applyImplementationParams(*neuron, neuron_params);
+    m_neurons.push_back(neuron);
+    
+    // The implementation lives in the group of its model; the AdvancedNeuron is the facade
+    size_t group = getModelGroup(model);
+    m_neuron_slots.emplace_back(group, m_model_groups[group]->add(neuron_id, neuron_params));
+    m_adjacency_dirty = true;
+    return neuron_id;
+}
+
+size_t AdvancedNeuralNetwork::getModelGroup(BrainLL::NeuronModel model) {
+    for (size_t i = 0; i < m_model_groups.size(); ++i) {
+        if (m_model_groups[i]->getModel() == model) {
+            return i;
         }
-        
-        m_neurons.push_back(neuron);
-        return neuron_id;
     }
+    m_model_groups.push_back(createModelGroup(model));
+    return m_model_groups.size() - 1;
 }
 
-size_t AdvancedNeuralNetwork::addConnection(size_t source_id, size_t target_id, double weight, const std::string& plasticity_type) {
+size_t AdvancedNeuralNetwork::addConnection(size_t source_id, size_t target_id, double weight, const std::string& plasticity_type,
+                                            double delay) {
     if (source_id >= m_neurons.size() || target_id >= m_neurons.size()) {
         throw std::runtime_error("Invalid neuron IDs for connection");
     }
     
     size_t connection_id = m_connections.size();
     auto connection = std::make_shared<AdvancedConnection>(connection_id, source_id, target_id, weight);
-    connection->delay = 1.0; // Default delay
+    connection->setDelay(delay > 0.0 ? delay : m_timestep);
     
     // Set plasticity rule
     PlasticityRule rule;
@@ -209,6 +389,7 @@ size_t AdvancedNeuralNetwork::addConnection(size_t source_id, size_t target_id,
     connection->setPlasticityRule(rule);
     
     m_connections.push_back(connection);
+    m_adjacency_dirty = true;
     
     // Add connection to source neuron's output connections
     m_neurons[source_id]->addOutputConnection(connection);
@@ -276,11 +457,19 @@ void AdvancedNeuralNetwork::stimulateNeuron(size_t neuron_id, double current) {
 }
 
 void AdvancedNeuralNetwork::update(double dt) {
-    // Update all neurons
-    for (auto& neuron : m_neurons) {
-        updateNeuron(neuron, dt);
+    if (dt <= 0.0) {
+        dt = m_timestep;
+    }
+    if (m_adjacency_dirty || dt != m_delivery_dt) {
+        rebuildSpikeAdjacency(dt);
     }
     
+    // Spikes whose delay ends in this step become input before neurons integrate
+    deliverPendingSpikes();
+    
+    // Update all neurons, one model group at a time
+    updateNeurons(dt);
+    
     // Process connections and apply plasticity
     if (m_global_config.learning_enabled) {
         updateConnections(dt);
@@ -294,149 +483,27 @@ void AdvancedNeuralNetwork::update(double dt) {
     m_current_time += dt;
 }
 
-void AdvancedNeuralNetwork::updateNeuron(std::shared_ptr<AdvancedNeuron> neuron, double dt) {
-    // Calculate total input current from inputs vector
-    double total_input = 0.0;
-    for (double input : neuron->inputs) {
-        total_input += input;
+void AdvancedNeuralNetwork::updateNeurons(double dt) {
+    const double time = m_current_time + dt;
+    m_fired_neurons.clear();
+    for (auto& group : m_model_groups) {
+        group->update(m_neurons, time, dt, m_fired_neurons);
     }
-    
-    switch (neuron->getModel()) {
-        case NeuronModel::LIF:
-            updateLIFNeuron(neuron, dt, total_input);
-            break;
-        case NeuronModel::ADAPTIVE_LIF:
-            updateAdaptiveLIFNeuron(neuron, dt, total_input);
-            break;
-        case NeuronModel::IZHIKEVICH:
-            updateIzhikevichNeuron(neuron, dt, total_input);
-            break;
-        case NeuronModel::LSTM:
-            updateLSTMNeuron(neuron, dt, total_input);
-            break;
-        case NeuronModel::TRANSFORMER:
-            updateTransformerNeuron(neuron, dt, total_input);
-            break;
-        case NeuronModel::GRU:
-            updateGRUNeuron(neuron, dt, total_input);
-            break;
-        case NeuronModel::HIGH_RESOLUTION_LIF:
-            updateAdaptiveLIFNeuron(neuron, dt, total_input); // Use adaptive LIF logic
-            break;
-        case NeuronModel::FAST_SPIKING:
-        case NeuronModel::REGULAR_SPIKING:
-            updateIzhikevichNeuron(neuron, dt, total_input); // Use Izhikevich logic
-            break;
-        case NeuronModel::MEMORY_CELL:
-            updateLSTMNeuron(neuron, dt, total_input); // Use LSTM logic
-            break;
-        case NeuronModel::ATTENTION_UNIT:
-            updateTransformerNeuron(neuron, dt, total_input); // Use Transformer logic
-            break;
-        case NeuronModel::EXECUTIVE_CONTROLLER:
-            updateGRUNeuron(neuron, dt, total_input); // Use GRU logic
-            break;
-        case NeuronModel::HODGKIN_HUXLEY:
-            updateIzhikevichNeuron(neuron, dt, total_input); // Use Izhikevich logic for now
-            break;
-        case NeuronModel::ADAPTIVE:
-            updateAdaptiveLIFNeuron(neuron, dt, total_input); // Use adaptive LIF logic
-            break;
-        case NeuronModel::CUSTOM:
-            updateLIFNeuron(neuron, dt, total_input); // Fallback to LIF for custom
-            break;
+    for (size_t neuron_id : m_fired_neurons) {
+        propagateSpike(neuron_id);
     }
-    
-    // Clear inputs after processing
-    neuron->inputs.clear();
 }
 
-void AdvancedNeuralNetwork::updateLIFNeuron(std::shared_ptr<AdvancedNeuron> neuron, double dt, double input_current) {
-    const auto& params = neuron->getParameters();
-    double threshold = params.threshold;
-    double leak_rate = 1.0 / params.membrane_resistance; // Use membrane resistance as leak rate
-    
-    // LIF dynamics: dV/dt = -leak_rate * V + I_input
-    double current_potential = neuron->getPotential();
-    double dV_dt = -leak_rate * current_potential + input_current;
-    neuron->setPotential(current_potential + dV_dt * dt);
-    
-    // Check for spike
-    if (neuron->getPotential() >= threshold) {
-        neuron->setPotential(params.reset_potential); // Reset to reset potential
-        neuron->setLastSpikeTime(m_current_time);
-        
-        // Propagate spike to connected neurons
-        propagateSpike(neuron->getId());
-    }
-}
-
-void AdvancedNeuralNetwork::updateAdaptiveLIFNeuron(std::shared_ptr<AdvancedNeuron> neuron, double dt, double input_current) {
-    const auto& params = neuron->getParameters();
-    double adaptation_rate = params.adaptation_strength;
-    
-    // Update adaptation current
-    double current_adaptation = neuron->getAdaptationCurrent();
-    if (m_current_time - neuron->getLastSpikeTime() < params.refractory_period) {
-        current_adaptation += adaptation_rate * dt;
-    } else {
-        current_adaptation *= 0.99; // Use decay factor
+void AdvancedNeuralNetwork::updateNeuron(size_t neuron_id, double dt) {
+    if (neuron_id >= m_neuron_slots.size()) {
+        throw std::runtime_error("Invalid neuron ID for update");
     }
-    neuron->setAdaptationCurrent(current_adaptation);
-    
-    // Apply adaptation to input
-    double adapted_input = input_current - current_adaptation;
-    
-    // Similar to LIF but with adaptation current
-    updateLIFNeuron(neuron, dt, adapted_input);
-}
-
-void AdvancedNeuralNetwork::updateIzhikevichNeuron(std::shared_ptr<AdvancedNeuron> neuron, double dt, double input_current) {
-    const auto& params = neuron->getParameters();
-    double a = params.a;
-    double b = params.b;
-    double c = params.c;
-    double d = params.d;
-    
-    double v = neuron->getPotential();
-    double u = neuron->getIzhikevichU();
-    
-    // Izhikevich model equations
-    double dv_dt = 0.04 * v * v + 5 * v + 140 - u + input_current;
-    double du_dt = a * (b * v - u);
-    
-    neuron->setPotential(v + dv_dt * dt);
-    u += du_dt * dt;
-    neuron->setIzhikevichU(u);
-    
-    // Check for spike
-    if (neuron->getPotential() >= 30.0) { // Izhikevich spike threshold
-        neuron->setPotential(c);
-        neuron->setIzhikevichU(u + d);
-        neuron->setLastSpikeTime(m_current_time);
-        
-        propagateSpike(neuron->getId());
+    const auto& slot = m_neuron_slots[neuron_id];
+    if (m_model_groups[slot.first]->updateOne(slot.second, *m_neurons[neuron_id], m_current_time + dt, dt)) {
+        propagateSpike(neuron_id);
     }
 }
 
-void AdvancedNeuralNetwork::updateLSTMNeuron(std::shared_ptr<AdvancedNeuron> neuron, double dt, double input_current) {
-    // Simplified LSTM implementation
-    // In a full implementation, this would involve gates and cell states
-    updateLIFNeuron(neuron, dt, input_current); // Fallback to LIF for now
-}
-
-void AdvancedNeuralNetwork::updateTransformerNeuron(std::shared_ptr<AdvancedNeuron> neuron, double dt, double input_current) {
-    // Simplified Transformer implementation
-    // In a full implementation, this would involve attention mechanisms
-    updateLIFNeuron(neuron, dt, input_current); // Fallback to LIF for now
-}
-
-void AdvancedNeuralNetwork::updateGRUNeuron(std::shared_ptr<AdvancedNeuron> neuron, double dt, double input_current) {
-    // Simplified GRU implementation
-    // In a full implementation, this would involve update and reset gates
-    updateLIFNeuron(neuron, dt, input_current); // Fallback to LIF for now
-}
-
 void AdvancedNeuralNetwork::updateConnections(double dt) {
     for (auto& connection : m_connections) {
         if (connection->getParameters().plasticity_rule != PlasticityRule::NONE) {
@@ -557,14 +624,18 @@ void AdvancedNeuralNetwork::updateAntiHebbian(std::shared_ptr<AdvancedConnection
 }
 
 void AdvancedNeuralNetwork::propagateSpike(const std::string& neuron_id) {
-    // Find the neuron by ID and propagate spike to its output connections
-    for (auto& neuron : m_neurons) {
-        if (neuron->getId() == neuron_id) {
-            // In a full implementation, this would send spikes to connected neurons
-            // For now, we'll just record the spike
-            break;
+    // addNeuron() names neurons after their index; fall back to a scan for other ids
+    size_t index = m_neurons.size();
+    if (!neuron_id.empty() && neuron_id.find_first_not_of("0123456789") == std::string::npos) {
+        index = static_cast<size_t>(std::stoull(neuron_id));
+    }
+    if (index >= m_neurons.size() || m_neurons[index]->getId() != neuron_id) {
+        index = 0;
+        while (index < m_neurons.size() && m_neurons[index]->getId() != neuron_id) {
+            ++index;
         }
     }
+    propagateSpike(index);
 }
 
 void AdvancedNeuralNetwork::updateMonitoring(double dt) {
@@ -577,11 +648,68 @@ void AdvancedNeuralNetwork::updateMonitoring(double dt) {
 
 void AdvancedNeuralNetwork::propagateSpike(size_t neuron_id) {
     if (neuron_id >= m_neurons.size()) return;
+    if (m_adjacency_dirty) {
+        rebuildSpikeAdjacency(m_delivery_dt > 0.0 ? m_delivery_dt : m_timestep);
+    }
     
-    auto& neuron = m_neurons[neuron_id];
+    // Schedule every outgoing synapse; a delay of d steps lands d - 1 slots past the head,
+    // which is the slot delivered at the start of the next step
+    const size_t ring_size = m_delivery_ring.size();
+    for (size_t i = m_out_offsets[neuron_id]; i < m_out_offsets[neuron_id + 1]; ++i) {
+        const size_t slot = (m_delivery_head + m_out_delay_steps[i] - 1) % ring_size;
+        m_delivery_ring[slot].push_back(m_out_synapses[i]);
+    }
+}
+
+void AdvancedNeuralNetwork::deliverPendingSpikes() {
+    if (m_delivery_ring.empty()) return;
+    
+    // Weights are read on arrival, so plasticity applied while a spike is in flight counts
+    auto& slot = m_delivery_ring[m_delivery_head];
+    for (size_t connection_index : slot) {
+        const auto& connection = m_connections[connection_index];
+        m_neurons[connection->getTargetId()]->inputs.push_back(connection->getWeight());
+    }
+    slot.clear();
+    m_delivery_head = (m_delivery_head + 1) % m_delivery_ring.size();
+}
+
+void AdvancedNeuralNetwork::rebuildSpikeAdjacency(double dt) {
+    // Counting sort of the connections by source neuron
+    const size_t neuron_count = m_neurons.size();
+    m_out_offsets.assign(neuron_count + 1, 0);
+    for (const auto& connection : m_connections) {
+        ++m_out_offsets[connection->getSourceId() + 1];
+    }
+    for (size_t i = 0; i < neuron_count; ++i) {
+        m_out_offsets[i + 1] += m_out_offsets[i];
+    }
     
-    // Implementation would need to be updated based on actual connection structure
-    // This is a simplified version
+    m_out_synapses.resize(m_connections.size());
+    m_out_delay_steps.resize(m_connections.size());
+    std::vector<size_t> fill(m_out_offsets.begin(), m_out_offsets.end() - 1);
+    size_t max_delay_steps = 1;
+    for (size_t c = 0; c < m_connections.size(); ++c) {
+        const size_t entry = fill[m_connections[c]->getSourceId()]++;
+        m_out_synapses[entry] = c;
+        m_out_delay_steps[entry] = delayInSteps(m_connections[c]->getDelay(), dt);
+        max_delay_steps = std::max(max_delay_steps, m_out_delay_steps[entry]);
+    }
+    
+    // Carry spikes already in flight over to the new ring, re-discretized if dt changed
+    std::vector<std::vector<size_t>> ring(max_delay_steps);
+    const size_t old_size = m_delivery_ring.size();
+    for (size_t j = 0; j < old_size; ++j) {
+        auto& pending = m_delivery_ring[(m_delivery_head + j) % old_size];
+        if (pending.empty()) continue;
+        size_t steps = (m_delivery_dt > 0.0) ? delayInSteps((j + 1) * m_delivery_dt, dt) : j + 1;
+        steps = std::min(steps, max_delay_steps);
+        ring[steps - 1].insert(ring[steps - 1].end(), pending.begin(), pending.end());
+    }
+    m_delivery_ring.swap(ring);
+    m_delivery_head = 0;
+    m_delivery_dt = dt;
+    m_adjacency_dirty = false;
 }
 
 size_t AdvancedNeuralNetwork::getNeuronCount() const {
@@ -614,6 +742,13 @@ void AdvancedNeuralNetwork::reset() {
         // Reset neuron state using proper methods
         neuron->reset();
     }
+    for (auto& group : m_model_groups) {
+        group->reset();
+    }
+    for (auto& slot : m_delivery_ring) {
+        slot.clear();
+    }
+    m_delivery_head = 0;
 }
 
 void AdvancedNeuralNetwork::saveWeights(const std::string& filename) {
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ * Licensed under AGPL v3 License - 17/7/2025
+ */
+
+// Las comprobaciones usan assert: que sigan activas también en builds Release
+#undef NDEBUG
+
+#include "../../include/AdvancedNeuralNetwork.hpp"
+#include "../../include/DebugConfig.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace brainll {
+namespace Tests {
+
+constexpr double kDt = 0.1;  // ms
+
+// Una fuente que dispara en el paso 0 y un destino que solo puede disparar por la sinapsis;
+// devuelve el primer paso en que dispara el destino (o -1)
+int arrivalStep(double delay, bool explicit_delay) {
+    AdvancedNeuralNetwork network;
+    const size_t source = network.addNeuron("LIF");
+    const size_t target = network.addNeuron("LIF");
+    if (explicit_delay) {
+        network.addConnection(source, target, 1e4, "NONE", delay);
+    } else {
+        network.addConnection(source, target, 1e4);
+    }
+    auto source_neuron = network.getNeuron(std::to_string(source));
+    auto target_neuron = network.getNeuron(std::to_string(target));
+
+    network.stimulateNeuron(source, 1e4);
+    for (int step = 0; step < 100; ++step) {
+        network.update(kDt);
+        if (step == 0) {
+            assert(source_neuron->hasFired());
+        }
+        if (target_neuron->hasFired()) {
+            return step;
+        }
+    }
+    return -1;
+}
+
+void testDelayArrival() {
+    std::cout << "Testing synaptic delay arrival step..." << std::endl;
+
+    // Disparo en el paso 0: llega round(delay / dt) pasos después, nunca en el mismo paso
+    assert(arrivalStep(0.5, true) == 5);
+    assert(arrivalStep(0.3, true) == 3);
+    assert(arrivalStep(1.0, true) == 10);
+    assert(arrivalStep(0.02, true) == 1);
+    assert(arrivalStep(0.0, false) == 1);
+
+    std::cout << "✓ Delay arrival tests passed" << std::endl;
+}
+
+void testDelayReachesConnection() {
+    std::cout << "Testing AdvancedConnection delay accessors..." << std::endl;
+
+    AdvancedConnection connection(0, 0, 1, 1.0);
+    assert(connection.getDelay() == 1.0);
+    connection.setDelay(2.5);
+    assert(connection.getDelay() == 2.5);
+    assert(connection.delay == 2.5);
+    connection.setState({{"delay", 4.0}});
+    assert(connection.getDelay() == 4.0);
+
+    std::cout << "✓ Delay accessor tests passed" << std::endl;
+}
+
+void runAllTests() {
+    std::cout << "=== Running AdvancedNeuralNetwork Tests ===" << std::endl;
+    DebugConfig::getInstance().setDebugLevel(DebugLevel::WARNING);
+
+    testDelayReachesConnection();
+    testDelayArrival();
+
+    std::cout << "\nAll AdvancedNeuralNetwork tests passed" << std::endl;
+}
+
+} // namespace Tests
+} // namespace brainll
+
+int main() {
+    brainll::Tests::runAllTests();
+    return 0;
+}
@@ -28,7 +28,7 @@ namespace brainll {
 // AdvancedNeuron implementation
 AdvancedNeuron::AdvancedNeuron(size_t neuron_id, NeuronModel neuron_model)
     : numeric_id_(neuron_id), id_(std::to_string(neuron_id)), potential_(0.0), last_spike_time_(-1.0), 
-      adaptation_current_(0.0), has_fired_(false), recovery_variable_(0.0), threshold_(1.0) {
+      current_time_(0.0), adaptation_current_(0.0), has_fired_(false), recovery_variable_(0.0), threshold_(1.0) {
     params_.model = neuron_model;
     // Initialize default parameters based on model
     switch (params_.model) {
@@ -75,6 +75,7 @@ AdvancedNeuron::AdvancedNeuron(size_t neuron_id, NeuronModel neuron_model)
             params_.b = 0.2;
             params_.c = -65.0;
             params_.d = 2.0;
+            params_.spike_history_capacity = 4 * SpikeHistory::DEFAULT_CAPACITY; // Fires at hundreds of Hz
             recovery_variable_ = params_.b * params_.c;
             break;
         case NeuronModel::REGULAR_SPIKING:
@@ -103,11 +104,13 @@ AdvancedNeuron::AdvancedNeuron(size_t neuron_id, NeuronModel neuron_model)
         default:
             break;
     }
+    spike_history_.setCapacity(params_.spike_history_capacity);
 }
 
 AdvancedNeuron::AdvancedNeuron(const std::string& id, const AdvancedNeuronParams& params)
     : id_(id), numeric_id_(0), params_(params), potential_(0.0), last_spike_time_(-1.0),
-      adaptation_current_(0.0), has_fired_(false), recovery_variable_(0.0), threshold_(params.threshold) {
+      current_time_(0.0), adaptation_current_(0.0), has_fired_(false), recovery_variable_(0.0), threshold_(params.threshold),
+      spike_history_(params.spike_history_capacity) {
     // Initialize model-specific variables
     if (params_.model == NeuronModel::IZHIKEVICH) {
         recovery_variable_ = params_.b * params_.c;
@@ -180,9 +183,11 @@ void AdvancedNeuron::removeOutputConnection(size_t connection_id) {
 void AdvancedNeuron::reset() {
     potential_ = 0.0;
     last_spike_time_ = -1.0;
+    current_time_ = 0.0;
     adaptation_current_ = 0.0;
     has_fired_ = false;
     inputs.clear();
+    spike_history_.clear();
     
     // Reset model-specific state
     switch (params_.model) {
@@ -210,6 +215,8 @@ void AdvancedNeuron::reset() {
 }
 
 void AdvancedNeuron::update(double dt) {
+    current_time_ += dt;
+    
     // Calculate total input current
     double total_input = 0.0;
     for (double input : inputs) {
@@ -293,8 +300,7 @@ void AdvancedNeuron::updateLIF(double dt) {
     if (potential_ >= params_.threshold) {
         has_fired_ = true;
         potential_ = params_.reset_potential;
-        last_spike_time_ = 0.0; // Would need current time
-        recordSpike(0.0);
+        recordSpike(current_time_);
     } else {
         has_fired_ = false;
     }
@@ -318,9 +324,8 @@ void AdvancedNeuron::updateAdaptiveLIF(double dt) {
     if (potential_ >= params_.threshold) {
         has_fired_ = true;
         potential_ = params_.reset_potential;
-        last_spike_time_ = 0.0;
         adaptation_current_ += params_.adaptation_strength;
-        recordSpike(0.0);
+        recordSpike(current_time_);
     } else {
         has_fired_ = false;
     }
@@ -344,8 +349,7 @@ void AdvancedNeuron::updateIzhikevich(double dt) {
         has_fired_ = true;
         potential_ = params_.c;
         recovery_variable_ += params_.d;
-        last_spike_time_ = 0.0;
-        recordSpike(0.0);
+        recordSpike(current_time_);
     } else {
         has_fired_ = false;
     }
@@ -472,9 +476,8 @@ void AdvancedNeuron::updateHighResolutionLIF(double dt) {
     if (potential_ >= dynamic_threshold) {
         has_fired_ = true;
         potential_ = params_.reset_potential;
-        last_spike_time_ = 0.0;
         adaptation_current_ += params_.adaptation_strength;
-        recordSpike(0.0);
+        recordSpike(current_time_);
     } else {
         has_fired_ = false;
     }
@@ -498,8 +501,7 @@ void AdvancedNeuron::updateFastSpiking(double dt) {
         has_fired_ = true;
         potential_ = params_.c;
         recovery_variable_ += params_.d;
-        last_spike_time_ = 0.0;
-        recordSpike(0.0);
+        recordSpike(current_time_);
     } else {
         has_fired_ = false;
     }
@@ -522,8 +524,7 @@ void AdvancedNeuron::updateRegularSpiking(double dt) {
         has_fired_ = true;
         potential_ = params_.c;
         recovery_variable_ += params_.d;
-        last_spike_time_ = 0.0;
-        recordSpike(0.0);
+        recordSpike(current_time_);
     } else {
         has_fired_ = false;
     }
@@ -818,12 +819,13 @@ double AdvancedNeuron::generateNoise(double dt) {
 }
 
 void AdvancedNeuron::recordSpike(double time) {
-    spike_times_.push_back(time);
-    
-    // Keep only recent spikes (last 1000ms)
-    double cutoff_time = time - 1000.0;
-    auto it = std::lower_bound(spike_times_.begin(), spike_times_.end(), cutoff_time);
-    spike_times_.erase(spike_times_.begin(), it);
+    last_spike_time_ = time;
+    spike_history_.record(time);
+}
+
+void AdvancedNeuron::setSpikeHistoryCapacity(size_t capacity) {
+    params_.spike_history_capacity = capacity;
+    spike_history_.setCapacity(capacity);
 }
 
 void AdvancedNeuron::updateHistory() {
@@ -835,27 +837,20 @@ void AdvancedNeuron::updateHistory() {
     }
 }
 
-std::vector<double> AdvancedNeuron::getSpikeHistory(double time_window) const {
-    std::vector<double> recent_spikes;
-    double current_time = 0.0; // Would need actual current time
-    double cutoff_time = current_time - time_window;
-    
-    for (double spike_time : spike_times_) {
-        if (spike_time >= cutoff_time) {
-            recent_spikes.push_back(spike_time);
-        }
-    }
-    return recent_spikes;
+SpikeTimesView AdvancedNeuron::getSpikeHistory(double time_window) const {
+    return spike_history_.view().since(current_time_ - time_window);
 }
 
 double AdvancedNeuron::getFiringRate(double time_window) const {
-    auto recent_spikes = getSpikeHistory(time_window);
-    return static_cast<double>(recent_spikes.size()) / (time_window / 1000.0); // Convert to Hz
+    return spike_history_.firingRate(current_time_, time_window); // Hz
 }
 
 void AdvancedNeuron::setParameters(const AdvancedNeuronParams& params) {
     params_ = params;
     threshold_ = params_.threshold;
+    if (params_.spike_history_capacity != spike_history_.capacity()) {
+        spike_history_.setCapacity(params_.spike_history_capacity);
+    }
     
     // Reset model-specific state if model changed
     if (params_.model == NeuronModel::IZHIKEVICH) {
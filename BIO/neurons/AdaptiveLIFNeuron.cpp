@@ -10,6 +10,7 @@ AdaptiveLIFNeuron::AdaptiveLIFNeuron(const AdvancedNeuronParams& params)
 }
 
 void AdaptiveLIFNeuron::update(double dt) {
+    advanceClock(dt);
     updateAdaptiveLIF(dt);
     
     // Apply noise if enabled
@@ -36,9 +37,8 @@ void AdaptiveLIFNeuron::updateAdaptiveLIF(double dt) {
     if (potential_ >= params_.threshold) {
         has_fired_ = true;
         potential_ = params_.reset_potential;
-        last_spike_time_ = 0.0;
         adaptation_current_ += params_.adaptation_strength;
-        recordSpike(0.0);
+        recordSpike(current_time_);
     } else {
         has_fired_ = false;
     }
@@ -21,6 +21,7 @@ AdaptiveNeuron::AdaptiveNeuron(const AdvancedNeuronParams& params)
 }
 
 void AdaptiveNeuron::update(double dt) {
+    advanceClock(dt);
     has_fired_ = false;
     time_since_last_spike_ += dt;
     
@@ -52,8 +53,8 @@ void AdaptiveNeuron::update(double dt) {
     // Check for firing
     if (potential_ > current_threshold_) {
         has_fired_ = true;
-        recordSpike(0.0);
-        last_spike_time_ = 0.0;
+        recordSpike(current_time_);
+        last_spike_time_ = current_time_;
         time_since_last_spike_ = 0.0;
         
         // Reset potential after spike
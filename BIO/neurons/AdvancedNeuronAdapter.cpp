@@ -66,7 +66,7 @@ void AdvancedNeuronAdapter::removeOutputConnection(std::shared_ptr<NeuronBase> n
     modular_neuron_->removeOutputConnection(neuron);
 }
 
-std::vector<double> AdvancedNeuronAdapter::getSpikeHistory() const {
+brainll::SpikeTimesView AdvancedNeuronAdapter::getSpikeHistory() const {
     return modular_neuron_->getSpikeHistory();
 }
 
@@ -35,7 +35,7 @@ public:
     void removeOutputConnection(std::shared_ptr<NeuronBase> neuron);
     
     // Spike history
-    std::vector<double> getSpikeHistory() const;
+    brainll::SpikeTimesView getSpikeHistory() const;
     double getFiringRate(double time_window = 1000.0) const;
     
     // Utility functions
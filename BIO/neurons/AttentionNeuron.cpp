@@ -17,6 +17,7 @@ AttentionNeuron::AttentionNeuron(const AdvancedNeuronParams& params)
 }
 
 void AttentionNeuron::update(double dt) {
+    advanceClock(dt);
     has_fired_ = false;
     
     // Collect inputs
@@ -52,7 +53,7 @@ void AttentionNeuron::update(double dt) {
     // Check for firing
     if (potential_ > attention_threshold_) {
         has_fired_ = true;
-        recordSpike(0.0);
+        recordSpike(current_time_);
     }
     
     // Add noise if enabled
@@ -1,13 +1,21 @@
 #include "CNNNeuron.hpp"
+#include "../../optimization/SIMDOptimizer.hpp"
+#include "../../optimization/TaskScheduler.hpp"
 #include <algorithm>
 #include <numeric>
 #include <random>
 #include <cmath>
-#include <thread>
-#include <future>
+#include <limits>
 
 namespace BrainLL {
 
+namespace {
+    // Filters per GEMM call; also the unit of work handed to the scheduler
+    constexpr int kFilterBlock = 8;
+    // Multiply-adds below which the convolution stays on the calling thread
+    constexpr size_t kParallelWork = 1 << 16;
+}
+
 CNNNeuron::CNNNeuron(const AdvancedNeuronParams& params)
     : NeuronBase(params)
     , input_width_(28), input_height_(28), input_channels_(1)  // Default MNIST-like dimensions
@@ -26,60 +34,29 @@ CNNNeuron::CNNNeuron(const AdvancedNeuronParams& params)
     
     // Initialize spike adaptations
     filter_spike_history_.resize(num_filters_, 0.0);
-    
-    // Initialize temporal buffer
-    temporal_buffer_.resize(num_filters_);
-    for (int f = 0; f < num_filters_; ++f) {
-        temporal_buffer_[f].resize(output_height_, std::vector<double>(output_width_, 0.0));
-    }
-    
-    // Initialize spike modulation
-    spike_modulation_.resize(num_filters_);
-    for (int f = 0; f < num_filters_; ++f) {
-        spike_modulation_[f].resize(output_height_, std::vector<double>(output_width_, 1.0));
-    }
 }
 
 void CNNNeuron::update(double dt) {
+    advanceClock(dt);
     if (input_feature_map_.empty()) {
         return;
     }
     
     // Update temporal dynamics
-    for (int f = 0; f < num_filters_; ++f) {
-        for (int y = 0; y < output_height_; ++y) {
-            for (int x = 0; x < output_width_; ++x) {
-                temporal_buffer_[f][y][x] *= temporal_decay_;
-            }
-        }
+    for (double& value : temporal_buffer_) {
+        value *= temporal_decay_;
     }
     
     // Update spike-based convolution
     updateSpikeConvolution(dt);
     
-    // Perform CNN operations
-    performConvolution();
-    performPooling();
-    applyActivation();
-    
-    // Apply spike modulation
-    applySpikeModulation();
+    // Convolution, pooling, activation and spike modulation in one pass
+    fusedForward();
     
     // Update neuron potential based on output
-    double total_activity = 0.0;
-    int total_elements = 0;
-    
-    for (const auto& filter : final_output_) {
-        for (const auto& row : filter) {
-            for (double val : row) {
-                total_activity += val;
-                total_elements++;
-            }
-        }
-    }
-    
-    if (total_elements > 0) {
-        potential_ = total_activity / total_elements;
+    if (!final_output_.empty()) {
+        double total_activity = std::accumulate(final_output_.begin(), final_output_.end(), 0.0);
+        potential_ = total_activity / final_output_.size();
     }
     
     // Apply spike threshold modification
@@ -88,7 +65,7 @@ void CNNNeuron::update(double dt) {
     // Check for spike
     if (potential_ > effective_threshold) {
         has_fired_ = true;
-        recordSpike(0.0);
+        recordSpike(current_time_);
         potential_ = params_.reset_potential;
         
         // Update filter spike history
@@ -109,38 +86,14 @@ void CNNNeuron::reset() {
     NeuronBase::reset();
     
     // Reset feature maps
-    for (auto& filter : conv_output_) {
-        for (auto& row : filter) {
-            std::fill(row.begin(), row.end(), 0.0);
-        }
-    }
-    
-    for (auto& filter : pooled_output_) {
-        for (auto& row : filter) {
-            std::fill(row.begin(), row.end(), 0.0);
-        }
-    }
-    
-    for (auto& filter : final_output_) {
-        for (auto& row : filter) {
-            std::fill(row.begin(), row.end(), 0.0);
-        }
-    }
+    std::fill(conv_output_.begin(), conv_output_.end(), 0.0);
+    std::fill(pooled_output_.begin(), pooled_output_.end(), 0.0);
+    std::fill(final_output_.begin(), final_output_.end(), 0.0);
     
     // Reset spike adaptations
     std::fill(filter_spike_history_.begin(), filter_spike_history_.end(), 0.0);
-    
-    for (auto& filter : spike_modulation_) {
-        for (auto& row : filter) {
-            std::fill(row.begin(), row.end(), 1.0);
-        }
-    }
-    
-    for (auto& filter : temporal_buffer_) {
-        for (auto& row : filter) {
-            std::fill(row.begin(), row.end(), 0.0);
-        }
-    }
+    std::fill(spike_modulation_.begin(), spike_modulation_.end(), 1.0);
+    std::fill(temporal_buffer_.begin(), temporal_buffer_.end(), 0.0);
     
     spike_threshold_modifier_ = 1.0;
 }
@@ -149,168 +102,210 @@ void CNNNeuron::addInput(double current) {
     NeuronBase::addInput(current);
     
     // Add to first pixel of first channel
-    if (!input_feature_map_.empty() && !input_feature_map_[0].empty() && !input_feature_map_[0][0].empty()) {
-        input_feature_map_[0][0][0] += current;
+    if (!input_feature_map_.empty()) {
+        input_feature_map_[0] += current;
     }
 }
 
 void CNNNeuron::setInputFeatureMap(const std::vector<std::vector<std::vector<double>>>& input) {
-    input_feature_map_ = input;
+    if (input.empty() || input[0].empty() || input[0][0].empty()) {
+        return;
+    }
     
     // Update dimensions if necessary
-    if (!input.empty() && !input[0].empty() && !input[0][0].empty()) {
-        input_channels_ = input.size();
-        input_height_ = input[0].size();
-        input_width_ = input[0][0].size();
+    const int channels = static_cast<int>(input.size());
+    const int height = static_cast<int>(input[0].size());
+    const int width = static_cast<int>(input[0][0].size());
+    if (channels != input_channels_ || height != input_height_ || width != input_width_) {
+        const bool new_channels = channels != input_channels_;
+        input_channels_ = channels;
+        input_height_ = height;
+        input_width_ = width;
         
         calculateOutputDimensions();
+        if (new_channels) {
+            initializeKernels();
+        }
         resizeFeatureMaps();
     }
+    
+    // Flatten to [channels][height][width]
+    double* dst = input_feature_map_.data();
+    for (const auto& channel : input) {
+        for (int y = 0; y < height; ++y) {
+            const size_t count = std::min<size_t>(channel[y].size(), width);
+            std::copy(channel[y].begin(), channel[y].begin() + count, dst);
+            std::fill(dst + count, dst + width, 0.0);
+            dst += width;
+        }
+    }
+}
+
+void CNNNeuron::setInputFeatureMap(const std::vector<double>& input) {
+    const size_t count = std::min(input.size(), input_feature_map_.size());
+    std::copy(input.begin(), input.begin() + count, input_feature_map_.begin());
+    std::fill(input_feature_map_.begin() + count, input_feature_map_.end(), 0.0);
 }
 
 void CNNNeuron::performConvolution() {
-    // Parallel convolution for better performance
-    std::vector<std::future<void>> futures;
+    lowerToColumns();
     
-    for (int f = 0; f < num_filters_; ++f) {
-        futures.push_back(std::async(std::launch::async, [this, f]() {
-            for (int y = 0; y < output_height_; ++y) {
-                for (int x = 0; x < output_width_; ++x) {
-                    conv_output_[f][y][x] = convolutionAt(f, y, x) + biases_[f];
-                }
-            }
-        }));
-    }
+    const int blocks = (num_filters_ + kFilterBlock - 1) / kFilterBlock;
+    const bool parallel = blocks > 1 && kernels_.size() * output_height_ * output_width_ >= kParallelWork;
     
-    // Wait for all threads to complete
-    for (auto& future : futures) {
-        future.wait();
+    auto convolveBlocks = [this](size_t begin, size_t end) {
+        for (size_t block = begin; block < end; ++block) {
+            const int first = static_cast<int>(block) * kFilterBlock;
+            convolveFilters(first, std::min(kFilterBlock, num_filters_ - first));
+        }
+    };
+    if (parallel) {
+        getTaskScheduler().parallelFor(0, blocks, 1, convolveBlocks);
+    } else {
+        convolveBlocks(0, blocks);
     }
 }
 
 void CNNNeuron::performPooling() {
-    if (pooling_type_ == "none") {
-        pooled_output_ = conv_output_;
-        return;
-    }
-    
-    int pooled_height = output_height_ / pool_size_;
-    int pooled_width = output_width_ / pool_size_;
-    
-    // Resize pooled output
-    pooled_output_.resize(num_filters_);
+    const size_t pooled_plane = static_cast<size_t>(pooled_height_) * pooled_width_;
     for (int f = 0; f < num_filters_; ++f) {
-        pooled_output_[f].resize(pooled_height, std::vector<double>(pooled_width, 0.0));
+        poolFilter(f, &pooled_output_[f * pooled_plane]);
     }
-    
-    for (int f = 0; f < num_filters_; ++f) {
-        for (int y = 0; y < pooled_height; ++y) {
-            for (int x = 0; x < pooled_width; ++x) {
-                if (pooling_type_ == "max") {
-                    pooled_output_[f][y][x] = maxPoolingAt(f, y, x);
-                } else if (pooling_type_ == "average") {
-                    pooled_output_[f][y][x] = averagePoolingAt(f, y, x);
-                }
-            }
-        }
-    }
-    
-    // Update output dimensions
-    output_height_ = pooled_height;
-    output_width_ = pooled_width;
 }
 
 void CNNNeuron::applyActivation() {
-    final_output_ = (pooling_type_ == "none") ? conv_output_ : pooled_output_;
-    
-    for (auto& filter : final_output_) {
-        for (auto& row : filter) {
-            for (double& val : row) {
-                applyActivationFunction(val);
-            }
-        }
-    }
+    final_output_ = pooled_output_;
+    applyActivationFunction(final_output_.data(), final_output_.size());
 }
 
-double CNNNeuron::convolutionAt(int filter_idx, int out_y, int out_x) {
-    double result = 0.0;
-    
-    for (int c = 0; c < input_channels_; ++c) {
-        for (int ky = 0; ky < kernel_size_; ++ky) {
-            for (int kx = 0; kx < kernel_size_; ++kx) {
-                int in_y = out_y * stride_ - padding_ + ky;
-                int in_x = out_x * stride_ - padding_ + kx;
-                
-                if (isValidPosition(in_y, in_x, c)) {
-                    result += input_feature_map_[c][in_y][in_x] * kernels_[filter_idx][c][ky][kx];
+void CNNNeuron::fusedForward() {
+    lowerToColumns();
+    
+    const size_t pooled_plane = static_cast<size_t>(pooled_height_) * pooled_width_;
+    const int blocks = (num_filters_ + kFilterBlock - 1) / kFilterBlock;
+    const bool parallel = blocks > 1 && kernels_.size() * output_height_ * output_width_ >= kParallelWork;
+    
+    auto forwardBlocks = [this, pooled_plane](size_t begin, size_t end) {
+        for (size_t block = begin; block < end; ++block) {
+            const int first = static_cast<int>(block) * kFilterBlock;
+            const int count = std::min(kFilterBlock, num_filters_ - first);
+            convolveFilters(first, count);
+            
+            // The block's conv output is still in cache: pool, activate and modulate it now
+            for (int f = first; f < first + count; ++f) {
+                double* pooled = &pooled_output_[f * pooled_plane];
+                double* output = &final_output_[f * pooled_plane];
+                const double* modulation = &spike_modulation_[f * pooled_plane];
+                poolFilter(f, pooled);
+                std::copy(pooled, pooled + pooled_plane, output);
+                applyActivationFunction(output, pooled_plane);
+                for (size_t i = 0; i < pooled_plane; ++i) {
+                    output[i] *= modulation[i];
                 }
             }
         }
+    };
+    if (parallel) {
+        getTaskScheduler().parallelFor(0, blocks, 1, forwardBlocks);
+    } else {
+        forwardBlocks(0, blocks);
     }
-    
-    return result;
 }
 
-double CNNNeuron::maxPoolingAt(int filter_idx, int out_y, int out_x) {
-    double max_val = -std::numeric_limits<double>::infinity();
-    
-    for (int py = 0; py < pool_size_; ++py) {
-        for (int px = 0; px < pool_size_; ++px) {
-            int conv_y = out_y * pool_size_ + py;
-            int conv_x = out_x * pool_size_ + px;
-            
-            if (conv_y < static_cast<int>(conv_output_[filter_idx].size()) && 
-                conv_x < static_cast<int>(conv_output_[filter_idx][0].size())) {
-                max_val = std::max(max_val, conv_output_[filter_idx][conv_y][conv_x]);
+void CNNNeuron::lowerToColumns() {
+    const int plane = output_height_ * output_width_;
+    const int patch = input_channels_ * kernel_size_ * kernel_size_;
+    columns_.resize(static_cast<size_t>(patch) * plane);
+    
+    // Row r = (c, ky, kx) of the column matrix holds that tap for every output pixel
+    for (int r = 0; r < patch; ++r) {
+        const int c = r / (kernel_size_ * kernel_size_);
+        const int ky = (r / kernel_size_) % kernel_size_;
+        const int kx = r % kernel_size_;
+        const double* channel = &input_feature_map_[static_cast<size_t>(c) * input_height_ * input_width_];
+        double* row = &columns_[static_cast<size_t>(r) * plane];
+        
+        for (int y = 0; y < output_height_; ++y) {
+            const int in_y = y * stride_ - padding_ + ky;
+            double* dst = row + y * output_width_;
+            if (in_y < 0 || in_y >= input_height_) {
+                std::fill(dst, dst + output_width_, 0.0);
+                continue;
+            }
+            const double* src = channel + in_y * input_width_;
+            for (int x = 0; x < output_width_; ++x) {
+                const int in_x = x * stride_ - padding_ + kx;
+                dst[x] = (in_x >= 0 && in_x < input_width_) ? src[in_x] : 0.0;
             }
         }
     }
-    
-    return max_val;
 }
 
-double CNNNeuron::averagePoolingAt(int filter_idx, int out_y, int out_x) {
-    double sum = 0.0;
-    int count = 0;
-    
-    for (int py = 0; py < pool_size_; ++py) {
-        for (int px = 0; px < pool_size_; ++px) {
-            int conv_y = out_y * pool_size_ + py;
-            int conv_x = out_x * pool_size_ + px;
-            
-            if (conv_y < static_cast<int>(conv_output_[filter_idx].size()) && 
-                conv_x < static_cast<int>(conv_output_[filter_idx][0].size())) {
-                sum += conv_output_[filter_idx][conv_y][conv_x];
-                count++;
-            }
+void CNNNeuron::convolveFilters(int first_filter, int count) {
+    const size_t plane = static_cast<size_t>(output_height_) * output_width_;
+    const size_t patch = static_cast<size_t>(input_channels_) * kernel_size_ * kernel_size_;
+    double* output = &conv_output_[first_filter * plane];
+    
+    // [count][patch] x [patch][plane]
+    getSIMDOptimizer().matrixMatrixMul(&kernels_[first_filter * patch], columns_.data(), output,
+                                       count, plane, patch);
+    
+    for (int f = 0; f < count; ++f) {
+        const double bias = biases_[first_filter + f];
+        double* map = output + f * plane;
+        for (size_t i = 0; i < plane; ++i) {
+            map[i] += bias;
         }
     }
-    
-    return (count > 0) ? sum / count : 0.0;
+}
+
+void CNNNeuron::poolFilter(int filter_idx, double* output) const {
+    const size_t plane = static_cast<size_t>(output_height_) * output_width_;
+    const double* map = &conv_output_[filter_idx * plane];
+    
+    if (pooling_type_ == "max") {
+        getSIMDOptimizer().maxPooling2D(map, output, output_height_, output_width_,
+                                        pool_size_, pool_size_, pool_size_, pool_size_);
+    } else if (pooling_type_ == "average") {
+        getSIMDOptimizer().avgPooling2D(map, output, output_height_, output_width_,
+                                        pool_size_, pool_size_, pool_size_, pool_size_);
+    } else {
+        std::copy(map, map + plane, output);
+    }
 }
 
 void CNNNeuron::applyActivationFunction(double& value) {
+    applyActivationFunction(&value, 1);
+}
+
+void CNNNeuron::applyActivationFunction(double* values, size_t count) const {
     if (activation_type_ == "relu") {
-        value = relu(value);
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = relu(values[i]);
+        }
     } else if (activation_type_ == "sigmoid") {
-        value = sigmoid(value);
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = sigmoid(values[i]);
+        }
     } else if (activation_type_ == "tanh") {
-        value = tanh_activation(value);
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = tanh_activation(values[i]);
+        }
     }
 }
 
 void CNNNeuron::updateSpikeConvolution(double dt) {
     // Update spike modulation based on recent activity
+    const size_t pooled_plane = static_cast<size_t>(pooled_height_) * pooled_width_;
     for (int f = 0; f < num_filters_; ++f) {
         double filter_activity = filter_spike_history_[f];
+        double* modulation = &spike_modulation_[f * pooled_plane];
         
-        for (int y = 0; y < output_height_; ++y) {
-            for (int x = 0; x < output_width_; ++x) {
-                if (filter_activity > 0.1) {
-                    spike_modulation_[f][y][x] = std::min(2.0, spike_modulation_[f][y][x] + 0.1 * dt);
-                } else {
-                    spike_modulation_[f][y][x] = std::max(0.5, spike_modulation_[f][y][x] - 0.05 * dt);
-                }
+        for (size_t i = 0; i < pooled_plane; ++i) {
+            if (filter_activity > 0.1) {
+                modulation[i] = std::min(2.0, modulation[i] + 0.1 * dt);
+            } else {
+                modulation[i] = std::max(0.5, modulation[i] - 0.05 * dt);
             }
         }
     }
@@ -325,15 +320,9 @@ void CNNNeuron::updateSpikeConvolution(double dt) {
 }
 
 void CNNNeuron::applySpikeModulation() {
-    for (int f = 0; f < num_filters_; ++f) {
-        for (int y = 0; y < output_height_; ++y) {
-            for (int x = 0; x < output_width_; ++x) {
-                if (y < static_cast<int>(final_output_[f].size()) && 
-                    x < static_cast<int>(final_output_[f][y].size())) {
-                    final_output_[f][y][x] *= spike_modulation_[f][y][x];
-                }
-            }
-        }
+    const size_t count = std::min(final_output_.size(), spike_modulation_.size());
+    for (size_t i = 0; i < count; ++i) {
+        final_output_[i] *= spike_modulation_[i];
     }
 }
 
@@ -346,17 +335,9 @@ void CNNNeuron::initializeKernels() {
     std::normal_distribution<double> dist(0.0, std_dev);
     
     // Initialize kernels
-    kernels_.resize(num_filters_);
-    for (int f = 0; f < num_filters_; ++f) {
-        kernels_[f].resize(input_channels_);
-        for (int c = 0; c < input_channels_; ++c) {
-            kernels_[f][c].resize(kernel_size_, std::vector<double>(kernel_size_));
-            for (int y = 0; y < kernel_size_; ++y) {
-                for (int x = 0; x < kernel_size_; ++x) {
-                    kernels_[f][c][y][x] = dist(gen);
-                }
-            }
-        }
+    kernels_.resize(static_cast<size_t>(num_filters_) * input_channels_ * kernel_size_ * kernel_size_);
+    for (double& weight : kernels_) {
+        weight = dist(gen);
     }
     
     // Initialize biases
@@ -366,25 +347,30 @@ void CNNNeuron::initializeKernels() {
 void CNNNeuron::calculateOutputDimensions() {
     output_height_ = (input_height_ + 2 * padding_ - kernel_size_) / stride_ + 1;
     output_width_ = (input_width_ + 2 * padding_ - kernel_size_) / stride_ + 1;
+    
+    if (pooling_type_ == "max" || pooling_type_ == "average") {
+        pooled_height_ = output_height_ / pool_size_;
+        pooled_width_ = output_width_ / pool_size_;
+    } else {
+        pooled_height_ = output_height_;
+        pooled_width_ = output_width_;
+    }
 }
 
 void CNNNeuron::resizeFeatureMaps() {
     // Resize input feature map
-    input_feature_map_.resize(input_channels_);
-    for (int c = 0; c < input_channels_; ++c) {
-        input_feature_map_[c].resize(input_height_, std::vector<double>(input_width_, 0.0));
-    }
+    input_feature_map_.resize(static_cast<size_t>(input_channels_) * input_height_ * input_width_, 0.0);
     
     // Resize output feature maps
-    conv_output_.resize(num_filters_);
-    pooled_output_.resize(num_filters_);
-    final_output_.resize(num_filters_);
-    
-    for (int f = 0; f < num_filters_; ++f) {
-        conv_output_[f].resize(output_height_, std::vector<double>(output_width_, 0.0));
-        pooled_output_[f].resize(output_height_, std::vector<double>(output_width_, 0.0));
-        final_output_[f].resize(output_height_, std::vector<double>(output_width_, 0.0));
-    }
+    const size_t conv_size = static_cast<size_t>(num_filters_) * output_height_ * output_width_;
+    const size_t pooled_size = static_cast<size_t>(num_filters_) * pooled_height_ * pooled_width_;
+    conv_output_.assign(conv_size, 0.0);
+    pooled_output_.assign(pooled_size, 0.0);
+    final_output_.assign(pooled_size, 0.0);
+    
+    // Spike modulation and temporal buffer follow the final output
+    spike_modulation_.assign(pooled_size, 1.0);
+    temporal_buffer_.assign(pooled_size, 0.0);
 }
 
 bool CNNNeuron::isValidPosition(int y, int x, int channel) const {
@@ -400,6 +386,7 @@ void CNNNeuron::setInputDimensions(int width, int height, int channels) {
     
     calculateOutputDimensions();
     initializeKernels();
+    input_feature_map_.clear();
     resizeFeatureMaps();
 }
 
@@ -431,18 +418,45 @@ void CNNNeuron::setNumFilters(int num_filters) {
 
 void CNNNeuron::setPoolingType(const std::string& pooling_type) {
     pooling_type_ = pooling_type;
+    calculateOutputDimensions();
+    resizeFeatureMaps();
 }
 
 void CNNNeuron::setPoolingSize(int pool_size) {
     pool_size_ = pool_size;
+    calculateOutputDimensions();
+    resizeFeatureMaps();
 }
 
 std::vector<std::vector<std::vector<double>>> CNNNeuron::getOutputFeatureMap() const {
-    return final_output_;
+    std::vector<std::vector<std::vector<double>>> output(num_filters_,
+        std::vector<std::vector<double>>(pooled_height_, std::vector<double>(pooled_width_)));
+    
+    const double* src = final_output_.data();
+    for (auto& filter : output) {
+        for (auto& row : filter) {
+            std::copy(src, src + pooled_width_, row.begin());
+            src += pooled_width_;
+        }
+    }
+    return output;
 }
 
 std::vector<std::vector<std::vector<std::vector<double>>>> CNNNeuron::getKernels() const {
-    return kernels_;
+    std::vector<std::vector<std::vector<std::vector<double>>>> kernels(num_filters_,
+        std::vector<std::vector<std::vector<double>>>(input_channels_,
+            std::vector<std::vector<double>>(kernel_size_, std::vector<double>(kernel_size_))));
+    
+    const double* src = kernels_.data();
+    for (auto& filter : kernels) {
+        for (auto& channel : filter) {
+            for (auto& row : channel) {
+                std::copy(src, src + kernel_size_, row.begin());
+                src += kernel_size_;
+            }
+        }
+    }
+    return kernels;
 }
 
 std::vector<double> CNNNeuron::getState() const {
@@ -453,11 +467,7 @@ std::vector<double> CNNNeuron::getState() const {
     state.push_back(spike_threshold_modifier_);
     
     // Add flattened feature maps (simplified)
-    for (const auto& filter : final_output_) {
-        for (const auto& row : filter) {
-            state.insert(state.end(), row.begin(), row.end());
-        }
-    }
+    state.insert(state.end(), final_output_.begin(), final_output_.end());
     
     return state;
 }
@@ -15,6 +15,11 @@ namespace BrainLL {
  * - Multiple feature maps
  * - Activation functions
  * - Spike-based adaptations
+ * 
+ * Tensors are contiguous row-major CHW buffers. The convolution lowers the input with
+ * im2col once per update and runs one blocked GEMM per block of filters through
+ * SIMDOptimizer; filter blocks run on the shared BrainLL::TaskScheduler, and bias, pooling,
+ * activation and spike modulation are applied in the same pass while the block is hot.
  */
 class CNNNeuron : public NeuronBase {
 public:
@@ -37,7 +42,11 @@ public:
     
     // Input/Output management
     void setInputFeatureMap(const std::vector<std::vector<std::vector<double>>>& input);
+    void setInputFeatureMap(const std::vector<double>& input);  // [channels][height][width], current dimensions
     std::vector<std::vector<std::vector<double>>> getOutputFeatureMap() const;
+    const std::vector<double>& getOutputTensor() const { return final_output_; }  // [filters][height][width]
+    int getOutputHeight() const { return pooled_height_; }
+    int getOutputWidth() const { return pooled_width_; }
     std::vector<std::vector<std::vector<std::vector<double>>>> getKernels() const;
     
     // Convolution operations
@@ -57,47 +66,49 @@ public:
 private:
     // CNN parameters
     int input_width_, input_height_, input_channels_;
-    int output_width_, output_height_, num_filters_;
+    int output_width_, output_height_, num_filters_;  // Convolution output
+    int pooled_width_, pooled_height_;                // After pooling (== output with "none")
     int kernel_size_, stride_, padding_;
     int pool_size_;
     std::string pooling_type_;  // "max", "average", "none"
     std::string activation_type_;  // "relu", "sigmoid", "tanh"
     
-    // Feature maps
-    std::vector<std::vector<std::vector<double>>> input_feature_map_;   // [channels][height][width]
-    std::vector<std::vector<std::vector<double>>> conv_output_;         // [filters][height][width]
-    std::vector<std::vector<std::vector<double>>> pooled_output_;       // [filters][height][width]
-    std::vector<std::vector<std::vector<double>>> final_output_;        // [filters][height][width]
+    // Feature maps (row-major)
+    std::vector<double> input_feature_map_;   // [channels][height][width]
+    std::vector<double> columns_;             // im2col: [channels * kernel * kernel][output_h * output_w]
+    std::vector<double> conv_output_;         // [filters][output_h][output_w]
+    std::vector<double> pooled_output_;       // [filters][pooled_h][pooled_w]
+    std::vector<double> final_output_;        // [filters][pooled_h][pooled_w]
     
     // Kernels/Filters
-    std::vector<std::vector<std::vector<std::vector<double>>>> kernels_; // [filters][channels][kernel_h][kernel_w]
-    std::vector<double> biases_;  // [filters]
+    std::vector<double> kernels_;             // [filters][channels][kernel_h][kernel_w]
+    std::vector<double> biases_;              // [filters]
     
     // Spike-based adaptations
-    std::vector<std::vector<std::vector<double>>> spike_modulation_;    // [filters][height][width]
+    std::vector<double> spike_modulation_;    // [filters][pooled_h][pooled_w]
     std::vector<double> filter_spike_history_;                          // [filters]
     double spike_threshold_modifier_;
     double spike_decay_rate_;
     
     // Temporal dynamics
-    std::vector<std::vector<std::vector<double>>> temporal_buffer_;     // [filters][height][width]
+    std::vector<double> temporal_buffer_;     // [filters][pooled_h][pooled_w]
     double temporal_decay_;
     
     // Utility functions
     void initializeKernels();
     void calculateOutputDimensions();
-    double convolutionAt(int filter_idx, int out_y, int out_x);
-    double maxPoolingAt(int filter_idx, int out_y, int out_x);
-    double averagePoolingAt(int filter_idx, int out_y, int out_x);
+    void lowerToColumns();                                   // im2col with zero padding
+    void convolveFilters(int first_filter, int count);       // GEMM + bias for a block of filters
+    void poolFilter(int filter_idx, double* output) const;   // conv_output_ -> [pooled_h][pooled_w]
     void applyActivationFunction(double& value);
+    void applyActivationFunction(double* values, size_t count) const;
     
     // Memory management
     void resizeFeatureMaps();
     void ensureKernelSize();
     
     // Performance optimizations
-    void vectorizedConvolution();
-    void parallelConvolution();
+    void fusedForward();  // Convolution + pooling + activation + spike modulation per filter block
     bool isValidPosition(int y, int x, int channel = 0) const;
     
     // Spike processing
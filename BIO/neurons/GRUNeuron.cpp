@@ -1,4 +1,5 @@
 #include "GRUNeuron.hpp"
+#include "../../optimization/SIMDOptimizer.hpp"
 #include <algorithm>
 #include <numeric>
 #include <random>
@@ -12,6 +13,8 @@ GRUNeuron::GRUNeuron(const AdvancedNeuronParams& params)
     , hidden_size_(params.hidden_size)
     , input_size_(64)  // Default input size
     , dropout_rate_(params.dropout_rate)
+    , weights_f32_valid_(false)
+    , use_float32_(false)
     , spike_threshold_modifier_(1.0)
     , spike_decay_rate_(0.95)
     , temporal_decay_(0.9)
@@ -35,6 +38,7 @@ GRUNeuron::GRUNeuron(const AdvancedNeuronParams& params)
 }
 
 void GRUNeuron::update(double dt) {
+    advanceClock(dt);
     if (current_input_.empty()) {
         return;
     }
@@ -47,10 +51,8 @@ void GRUNeuron::update(double dt) {
     // Update spike-based gating
     updateSpikeGating(dt);
     
-    // Compute GRU gates
-    computeResetGate(current_input_);
-    computeUpdateGate(current_input_);
-    computeCandidateState(current_input_);
+    // Compute GRU gates (one fused projection for reset, update and new gates)
+    computeGates(current_input_, 0, 3);
     updateHiddenState();
     
     // Apply spike modulation
@@ -66,7 +68,7 @@ void GRUNeuron::update(double dt) {
     // Check for spike
     if (potential_ > effective_threshold) {
         has_fired_ = true;
-        recordSpike(0.0);  // Time tracking would need global time
+        recordSpike(current_time_);
         potential_ = params_.reset_potential;
         
         // Update spike history for gates
@@ -84,6 +86,7 @@ void GRUNeuron::update(double dt) {
     
     // Clear current input for next timestep
     std::fill(current_input_.begin(), current_input_.end(), 0.0);
+    inputs.clear();
 }
 
 void GRUNeuron::reset() {
@@ -126,122 +129,91 @@ void GRUNeuron::setSequenceInput(const std::vector<double>& input) {
 
 void GRUNeuron::computeResetGate(const std::vector<double>& input) {
     // r_t = σ(W_ir * x_t + b_ir + W_hr * h_{t-1} + b_hr)
-    
-    std::vector<double> input_contribution(hidden_size_, 0.0);
-    std::vector<double> hidden_contribution(hidden_size_, 0.0);
-    
-    if (use_simd_) {
-        simdMatrixVectorMultiply(W_ir_, input, input_contribution);
-        simdMatrixVectorMultiply(W_hr_, hidden_state_, hidden_contribution);
-        simdVectorAdd(input_contribution, b_ir_, input_contribution);
-        simdVectorAdd(hidden_contribution, b_hr_, hidden_contribution);
-        simdVectorAdd(input_contribution, hidden_contribution, reset_gate_);
-    } else {
-        // Standard computation
-        for (int i = 0; i < hidden_size_; ++i) {
-            reset_gate_[i] = b_ir_[i] + b_hr_[i];
-            
-            for (size_t j = 0; j < input.size() && j < W_ir_[i].size(); ++j) {
-                reset_gate_[i] += W_ir_[i][j] * input[j];
-            }
-            
-            for (int j = 0; j < hidden_size_ && j < static_cast<int>(W_hr_[i].size()); ++j) {
-                reset_gate_[i] += W_hr_[i][j] * hidden_state_[j];
-            }
-        }
-    }
-    
-    // Apply sigmoid activation
-    vectorizedSigmoid(reset_gate_);
+    computeGates(input, 0, 1);
 }
 
 void GRUNeuron::computeUpdateGate(const std::vector<double>& input) {
     // z_t = σ(W_iz * x_t + b_iz + W_hz * h_{t-1} + b_hz)
-    
-    std::vector<double> input_contribution(hidden_size_, 0.0);
-    std::vector<double> hidden_contribution(hidden_size_, 0.0);
-    
-    if (use_simd_) {
-        simdMatrixVectorMultiply(W_iz_, input, input_contribution);
-        simdMatrixVectorMultiply(W_hz_, hidden_state_, hidden_contribution);
-        simdVectorAdd(input_contribution, b_iz_, input_contribution);
-        simdVectorAdd(hidden_contribution, b_hz_, hidden_contribution);
-        simdVectorAdd(input_contribution, hidden_contribution, update_gate_);
-    } else {
-        for (int i = 0; i < hidden_size_; ++i) {
-            update_gate_[i] = b_iz_[i] + b_hz_[i];
-            
-            for (size_t j = 0; j < input.size() && j < W_iz_[i].size(); ++j) {
-                update_gate_[i] += W_iz_[i][j] * input[j];
-            }
-            
-            for (int j = 0; j < hidden_size_ && j < static_cast<int>(W_hz_[i].size()); ++j) {
-                update_gate_[i] += W_hz_[i][j] * hidden_state_[j];
-            }
-        }
-    }
-    
-    vectorizedSigmoid(update_gate_);
+    computeGates(input, 1, 2);
 }
 
 void GRUNeuron::computeCandidateState(const std::vector<double>& input) {
     // n_t = tanh(W_in * x_t + b_in + r_t ⊙ (W_hn * h_{t-1} + b_hn))
-    
-    std::vector<double> input_contribution(hidden_size_, 0.0);
-    std::vector<double> hidden_contribution(hidden_size_, 0.0);
-    std::vector<double> gated_hidden(hidden_size_, 0.0);
-    
-    if (use_simd_) {
-        simdMatrixVectorMultiply(W_in_, input, input_contribution);
-        simdMatrixVectorMultiply(W_hn_, hidden_state_, hidden_contribution);
-        simdVectorAdd(input_contribution, b_in_, input_contribution);
-        simdVectorAdd(hidden_contribution, b_hn_, hidden_contribution);
-        
-        // Apply reset gate: r_t ⊙ (W_hn * h_{t-1} + b_hn)
-        simdVectorMultiply(reset_gate_, hidden_contribution, gated_hidden);
-        simdVectorAdd(input_contribution, gated_hidden, candidate_state_);
+    computeGates(input, 2, 3);
+}
+
+void GRUNeuron::computeGates(const std::vector<double>& input, int first_gate, int last_gate) {
+    if (use_float32_) {
+        if (!weights_f32_valid_) {
+            weights_f32_.assignFrom(weights_);
+            weights_f32_valid_ = true;
+        }
+        computeGates(weights_f32_, scratch_f32_, input, first_gate, last_gate);
     } else {
-        for (int i = 0; i < hidden_size_; ++i) {
-            candidate_state_[i] = b_in_[i];
-            
-            // Input contribution
-            for (size_t j = 0; j < input.size() && j < W_in_[i].size(); ++j) {
-                candidate_state_[i] += W_in_[i][j] * input[j];
-            }
-            
-            // Gated hidden contribution
-            double hidden_contrib = b_hn_[i];
-            for (int j = 0; j < hidden_size_ && j < static_cast<int>(W_hn_[i].size()); ++j) {
-                hidden_contrib += W_hn_[i][j] * hidden_state_[j];
+        computeGates(weights_, scratch_, input, first_gate, last_gate);
+    }
+}
+
+template <typename T>
+void GRUNeuron::computeGates(const PackedGateWeights<T>& weights, GateScratch<T>& scratch,
+                             const std::vector<double>& input, int first_gate, int last_gate) {
+    SIMDOptimizer& simd = getSIMDOptimizer();
+    const size_t hidden = hidden_size_;
+    const size_t cols = input_size_ + hidden;
+    
+    scratch.x.assign(input_size_, static_cast<T>(0));
+    std::copy(input.begin(), input.begin() + std::min<size_t>(input.size(), input_size_), scratch.x.begin());
+    scratch.h.assign(hidden_state_.begin(), hidden_state_.end());
+    scratch.gate_x.resize(3 * hidden);
+    scratch.gate_h.resize(3 * hidden);
+    scratch.act.resize(3 * hidden);
+    
+    // W_x x and W_h h for every row of the requested gates, one pass over the packed rows
+    const size_t row_begin = first_gate * hidden;
+    const size_t row_end = last_gate * hidden;
+    simd.gateMatrixVectorMul(&weights.weights[row_begin * cols], scratch.x.data(), scratch.h.data(),
+                             &scratch.gate_x[row_begin], &scratch.gate_h[row_begin],
+                             row_end - row_begin, input_size_, hidden);
+    for (size_t i = row_begin; i < row_end; ++i) {
+        scratch.gate_x[i] += weights.bias_x[i];
+        scratch.gate_h[i] += weights.bias_h[i];
+    }
+    
+    // Reset and update gates: σ(a) = 0.5 + 0.5 * tanh(a / 2), one vectorTanh over both
+    const size_t sigmoid_end = std::min(row_end, 2 * hidden);
+    if (row_begin < sigmoid_end) {
+        T* act = &scratch.act[row_begin];
+        const size_t count = sigmoid_end - row_begin;
+        for (size_t i = 0; i < count; ++i) {
+            act[i] = static_cast<T>(0.5) * (scratch.gate_x[row_begin + i] + scratch.gate_h[row_begin + i]);
+        }
+        simd.vectorTanh(act, act, count);
+        for (size_t i = 0; i < count; ++i) {
+            const double gate = 0.5 + 0.5 * act[i];
+            const size_t row = row_begin + i;
+            if (row < hidden) {
+                reset_gate_[row] = gate;
+            } else {
+                update_gate_[row - hidden] = gate;
             }
-            candidate_state_[i] += reset_gate_[i] * hidden_contrib;
         }
     }
     
-    vectorizedTanh(candidate_state_);
+    // Candidate: the reset gate scales only the hidden projection
+    if (row_end == 3 * hidden) {
+        T* act = &scratch.act[2 * hidden];
+        for (size_t i = 0; i < hidden; ++i) {
+            act[i] = scratch.gate_x[2 * hidden + i] + static_cast<T>(reset_gate_[i]) * scratch.gate_h[2 * hidden + i];
+        }
+        simd.vectorTanh(act, act, hidden);
+        std::copy(act, act + hidden, candidate_state_.begin());
+    }
 }
 
 void GRUNeuron::updateHiddenState() {
     // h_t = (1 - z_t) ⊙ n_t + z_t ⊙ h_{t-1}
-    
-    if (use_simd_) {
-        std::vector<double> one_minus_update(hidden_size_);
-        std::vector<double> new_contribution(hidden_size_);
-        std::vector<double> old_contribution(hidden_size_);
-        
-        // Compute (1 - z_t)
-        for (int i = 0; i < hidden_size_; ++i) {
-            one_minus_update[i] = 1.0 - update_gate_[i];
-        }
-        
-        simdVectorMultiply(one_minus_update, candidate_state_, new_contribution);
-        simdVectorMultiply(update_gate_, hidden_state_, old_contribution);
-        simdVectorAdd(new_contribution, old_contribution, hidden_state_);
-    } else {
-        for (int i = 0; i < hidden_size_; ++i) {
-            hidden_state_[i] = (1.0 - update_gate_[i]) * candidate_state_[i] + 
-                              update_gate_[i] * hidden_state_[i];
-        }
+    for (int i = 0; i < hidden_size_; ++i) {
+        hidden_state_[i] = candidate_state_[i] + update_gate_[i] * (hidden_state_[i] - candidate_state_[i]);
     }
     
     // Apply dropout if enabled
@@ -352,38 +324,21 @@ void GRUNeuron::initializeWeights() {
     double std_dev = std::sqrt(2.0 / (input_size_ + hidden_size_));
     std::normal_distribution<double> dist(0.0, std_dev);
     
-    // Initialize weight matrices
-    ensureMatrixSize(W_ir_, hidden_size_, input_size_);
-    ensureMatrixSize(W_hr_, hidden_size_, hidden_size_);
-    ensureMatrixSize(W_iz_, hidden_size_, input_size_);
-    ensureMatrixSize(W_hz_, hidden_size_, hidden_size_);
-    ensureMatrixSize(W_in_, hidden_size_, input_size_);
-    ensureMatrixSize(W_hn_, hidden_size_, hidden_size_);
-    
-    auto initMatrix = [&](std::vector<std::vector<double>>& matrix) {
-        for (auto& row : matrix) {
-            for (double& weight : row) {
-                weight = dist(gen);
-            }
-        }
-    };
-    
-    initMatrix(W_ir_);
-    initMatrix(W_hr_);
-    initMatrix(W_iz_);
-    initMatrix(W_hz_);
-    initMatrix(W_in_);
-    initMatrix(W_hn_);
+    // Initialize packed weight matrix
+    weights_.weights.resize(static_cast<size_t>(3 * hidden_size_) * (input_size_ + hidden_size_));
+    for (double& weight : weights_.weights) {
+        weight = dist(gen);
+    }
+    weights_f32_valid_ = false;
 }
 
 void GRUNeuron::initializeBiases() {
-    // Initialize biases to zero except forget gate bias (set to 1)
-    b_ir_.resize(hidden_size_, 0.0);
-    b_hr_.resize(hidden_size_, 0.0);
-    b_iz_.resize(hidden_size_, 1.0);  // Update gate bias to 1 for better gradient flow
-    b_hz_.resize(hidden_size_, 1.0);
-    b_in_.resize(hidden_size_, 0.0);
-    b_hn_.resize(hidden_size_, 0.0);
+    // Initialize biases to zero except update gate bias (set to 1)
+    weights_.bias_x.assign(3 * hidden_size_, 0.0);
+    weights_.bias_h.assign(3 * hidden_size_, 0.0);
+    std::fill(weights_.bias_x.begin() + hidden_size_, weights_.bias_x.begin() + 2 * hidden_size_, 1.0);  // Update gate bias to 1 for better gradient flow
+    std::fill(weights_.bias_h.begin() + hidden_size_, weights_.bias_h.begin() + 2 * hidden_size_, 1.0);
+    weights_f32_valid_ = false;
 }
 
 void GRUNeuron::vectorizedSigmoid(std::vector<double>& data) {
@@ -430,13 +385,6 @@ void GRUNeuron::ensureVectorSize(std::vector<double>& vec, size_t size) {
     }
 }
 
-void GRUNeuron::ensureMatrixSize(std::vector<std::vector<double>>& matrix, size_t rows, size_t cols) {
-    matrix.resize(rows);
-    for (auto& row : matrix) {
-        row.resize(cols, 0.0);
-    }
-}
-
 std::vector<double> GRUNeuron::getHiddenState() const {
     return hidden_state_;
 }
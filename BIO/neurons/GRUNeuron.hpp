@@ -1,6 +1,7 @@
 #pragma once
 
 #include "NeuronBase.hpp"
+#include "RecurrentGates.hpp"
 #include <vector>
 #include <memory>
 
@@ -15,6 +16,10 @@ namespace BrainLL {
  * - Candidate hidden state
  * - SIMD optimizations
  * - Spike-based adaptations
+ * 
+ * The six gate matrices are packed into one [3H x (I + H)] matrix (rows reset | update |
+ * new), so update() projects all gates with a single fused matrix-vector pass.
+ * setUseFloat32(true) runs the gates in single precision.
  */
 class GRUNeuron : public NeuronBase {
 public:
@@ -32,6 +37,10 @@ public:
     std::vector<double> getHiddenState() const;
     std::vector<double> getGateStates() const;
     
+    // Precision of the gate computation (weights are kept in double and converted once)
+    void setUseFloat32(bool use_float32) { use_float32_ = use_float32; }
+    bool isUsingFloat32() const { return use_float32_; }
+    
     // Gate computations
     void computeResetGate(const std::vector<double>& input);
     void computeUpdateGate(const std::vector<double>& input);
@@ -60,18 +69,14 @@ private:
     int input_size_;
     double dropout_rate_;
     
-    // Weight matrices
-    std::vector<std::vector<double>> W_ir_;  // Input to reset gate
-    std::vector<std::vector<double>> W_hr_;  // Hidden to reset gate
-    std::vector<std::vector<double>> W_iz_;  // Input to update gate
-    std::vector<std::vector<double>> W_hz_;  // Hidden to update gate
-    std::vector<std::vector<double>> W_in_;  // Input to new gate
-    std::vector<std::vector<double>> W_hn_;  // Hidden to new gate
-    
-    // Bias vectors
-    std::vector<double> b_ir_, b_hr_;  // Reset gate biases
-    std::vector<double> b_iz_, b_hz_;  // Update gate biases
-    std::vector<double> b_in_, b_hn_;  // New gate biases
+    // Packed weights: rows [reset | update | new] x hidden, columns [input | hidden];
+    // bias_x holds b_ir | b_iz | b_in and bias_h holds b_hr | b_hz | b_hn
+    PackedGateWeights<double> weights_;
+    PackedGateWeights<float> weights_f32_;
+    bool weights_f32_valid_;
+    bool use_float32_;
+    GateScratch<double> scratch_;
+    GateScratch<float> scratch_f32_;
     
     // State vectors
     std::vector<double> hidden_state_;
@@ -94,6 +99,12 @@ private:
     bool use_simd_;
     int simd_alignment_;
     
+    // Projects gates [first_gate, last_gate) for 'input' and applies their activations
+    template <typename T>
+    void computeGates(const PackedGateWeights<T>& weights, GateScratch<T>& scratch,
+                      const std::vector<double>& input, int first_gate, int last_gate);
+    void computeGates(const std::vector<double>& input, int first_gate, int last_gate);
+    
     // Utility functions
     void initializeWeights();
     void initializeBiases();
@@ -102,7 +113,6 @@ private:
     
     // Memory management
     void ensureVectorSize(std::vector<double>& vec, size_t size);
-    void ensureMatrixSize(std::vector<std::vector<double>>& matrix, size_t rows, size_t cols);
     
     // Performance optimizations
     void vectorizedSigmoid(std::vector<double>& data);
@@ -25,6 +25,7 @@ HodgkinHuxleyNeuron::HodgkinHuxleyNeuron(const AdvancedNeuronParams& params)
 }
 
 void HodgkinHuxleyNeuron::update(double dt) {
+    advanceClock(dt);
     last_V_ = V_;
     fired_this_cycle_ = false;
     
@@ -61,7 +62,7 @@ void HodgkinHuxleyNeuron::update(double dt) {
     if (V_ > 0.0 && last_V_ <= 0.0) {
         fired_this_cycle_ = true;
         has_fired_ = true;
-        recordSpike(0.0); // Time parameter not used in this context
+        recordSpike(current_time_);
     } else {
         has_fired_ = false;
     }
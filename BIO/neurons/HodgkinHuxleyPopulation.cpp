@@ -0,0 +1,280 @@
+#include "HodgkinHuxleyPopulation.hpp"
+#include "../../optimization/SIMDOptimizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace BrainLL {
+
+namespace {
+    // Same rate constants as HodgkinHuxleyNeuron
+    double alphaM(double V) {
+        if (std::abs(V + 40.0) < 1e-6) return 1.0;
+        return 0.1 * (V + 40.0) / (1.0 - std::exp(-(V + 40.0) / 10.0));
+    }
+    double betaM(double V) { return 4.0 * std::exp(-(V + 65.0) / 18.0); }
+    double alphaH(double V) { return 0.07 * std::exp(-(V + 65.0) / 20.0); }
+    double betaH(double V) { return 1.0 / (1.0 + std::exp(-(V + 35.0) / 10.0)); }
+    double alphaN(double V) {
+        if (std::abs(V + 55.0) < 1e-6) return 0.1;
+        return 0.01 * (V + 55.0) / (1.0 - std::exp(-(V + 55.0) / 10.0));
+    }
+    double betaN(double V) { return 0.125 * std::exp(-(V + 65.0) / 80.0); }
+
+    // Decay factor for dt / 2^level from the factor for dt: exp(-dt/tau)^(1/2^level)
+    inline double refineDecay(double decay, int level) {
+        for (int i = 0; i < level; ++i) {
+            decay = std::sqrt(decay);
+        }
+        return decay;
+    }
+
+    // Initial state of HodgkinHuxleyNeuron
+    constexpr double kInitialV = -65.0;
+    constexpr double kInitialM = 0.05;
+    constexpr double kInitialH = 0.6;
+    constexpr double kInitialN = 0.32;
+}
+
+HodgkinHuxleyPopulation::HodgkinHuxleyPopulation(size_t size, const AdvancedNeuronParams& params,
+                                                 const HHIntegratorConfig& config)
+    : params_(params)
+    , config_(config)
+    , time_(0.0)
+    , spike_count_(0)
+    , substep_count_(0)
+    , table_dt_(0.0)
+    , table_inv_resolution_(1.0 / config.table_resolution)
+    , V_(size, kInitialV)
+    , m_(size, kInitialM)
+    , h_(size, kInitialH)
+    , n_(size, kInitialN)
+    , input_(size, 0.0)
+    , last_spike_time_(size, 0.0)
+    , fired_(size, 0)
+    , noise_generator_(std::random_device{}())
+    , noise_distribution_(params.noise_mean, std::sqrt(params.noise_variance))
+{
+    params_.model = model;
+}
+
+void HodgkinHuxleyPopulation::setConfig(const HHIntegratorConfig& config) {
+    config_ = config;
+    table_inv_resolution_ = 1.0 / config_.table_resolution;
+    table_dt_ = 0.0; // Rebuild on the next update()
+}
+
+void HodgkinHuxleyPopulation::buildRateTable(double dt) {
+    const size_t entries = static_cast<size_t>(
+        std::ceil((config_.table_max_voltage - config_.table_min_voltage) * table_inv_resolution_)) + 1;
+    rate_table_.resize(std::max<size_t>(entries, 2));
+
+    for (size_t i = 0; i < rate_table_.size(); ++i) {
+        const double V = config_.table_min_voltage + static_cast<double>(i) * config_.table_resolution;
+        const double am = alphaM(V), bm = betaM(V);
+        const double ah = alphaH(V), bh = betaH(V);
+        const double an = alphaN(V), bn = betaN(V);
+
+        RateEntry& entry = rate_table_[i];
+        entry.m_inf = am / (am + bm);
+        entry.m_decay = std::exp(-dt * (am + bm));
+        entry.h_inf = ah / (ah + bh);
+        entry.h_decay = std::exp(-dt * (ah + bh));
+        entry.n_inf = an / (an + bn);
+        entry.n_decay = std::exp(-dt * (an + bn));
+    }
+    table_dt_ = dt;
+}
+
+void HodgkinHuxleyPopulation::update(double dt) {
+    if (dt != table_dt_) {
+        buildRateTable(dt);
+    }
+
+    const long long count = static_cast<long long>(size());
+    size_t spikes = 0;
+    size_t substeps = 0;
+
+    #pragma omp parallel for schedule(static) reduction(+:spikes, substeps) if(count >= 4096)
+    for (long long i = 0; i < count; ++i) {
+        int neuron_substeps = 0;
+        const bool spiked = integrate(static_cast<size_t>(i), dt, neuron_substeps);
+        spikes += spiked ? 1 : 0;
+        substeps += static_cast<size_t>(neuron_substeps);
+    }
+
+    time_ += dt;
+    spike_count_ = spikes;
+    substep_count_ = substeps;
+
+    const bool noisy = params_.noise_variance > 0.0;
+    const double noise_scale = std::sqrt(dt);
+    for (size_t i = 0; i < size(); ++i) {
+        if (fired_[i]) {
+            last_spike_time_[i] = time_;
+        }
+        if (noisy) {
+            V_[i] += noise_distribution_(noise_generator_) * noise_scale;
+        }
+    }
+}
+
+void HodgkinHuxleyPopulation::updateNeuron(size_t index, double dt) {
+    if (dt != table_dt_) {
+        buildRateTable(dt);
+    }
+    int substeps = 0;
+    if (integrate(index, dt, substeps)) {
+        last_spike_time_[index] = time_ + dt;
+    }
+    if (params_.noise_variance > 0.0) {
+        V_[index] += noise_distribution_(noise_generator_) * std::sqrt(dt);
+    }
+}
+
+bool HodgkinHuxleyPopulation::integrate(size_t index, double dt, int& substeps) {
+    const double C = params_.C_m;
+    const double g_Na = params_.g_Na, g_K = params_.g_K, g_L = params_.g_L;
+    const double E_Na = params_.E_Na, E_K = params_.E_K, E_L = params_.E_L;
+    const double I = input_[index];
+    input_[index] = 0.0;
+
+    const int max_level = config_.adaptive_substepping ? std::max(0, config_.max_substep_levels) : 0;
+    const double last_entry = static_cast<double>(rate_table_.size() - 1);
+
+    double V = V_[index], m = m_[index], h = h_[index], n = n_[index];
+    bool spiked = false;
+
+    // Remaining time in units of dt / 2^max_level
+    long long remaining = 1LL << max_level;
+    while (remaining > 0) {
+        // Finest level needed so that |dV/dt| * sub_dt stays within tolerance
+        int level = 0;
+        if (max_level > 0) {
+            const double m2 = m * m;
+            const double n2 = n * n;
+            const double dV_dt = (I - g_Na * m2 * m * h * (V - E_Na) - g_K * n2 * n2 * (V - E_K) - g_L * (V - E_L)) / C;
+            double estimate = std::abs(dV_dt) * dt;
+            while (level < max_level && estimate > config_.voltage_tolerance) {
+                estimate *= 0.5;
+                ++level;
+            }
+            while ((1LL << (max_level - level)) > remaining) {
+                ++level;
+            }
+        }
+        const double sub_dt = std::ldexp(dt, -level);
+        remaining -= 1LL << (max_level - level);
+        ++substeps;
+
+        // Table lookup with linear interpolation
+        const double x = std::min(std::max((V - config_.table_min_voltage) * table_inv_resolution_, 0.0), last_entry);
+        const size_t row = std::min(static_cast<size_t>(x), rate_table_.size() - 2);
+        const double frac = x - static_cast<double>(row);
+        const RateEntry& lo = rate_table_[row];
+        const RateEntry& hi = rate_table_[row + 1];
+
+        const double m_inf = lo.m_inf + frac * (hi.m_inf - lo.m_inf);
+        const double h_inf = lo.h_inf + frac * (hi.h_inf - lo.h_inf);
+        const double n_inf = lo.n_inf + frac * (hi.n_inf - lo.n_inf);
+        const double m_decay = refineDecay(lo.m_decay + frac * (hi.m_decay - lo.m_decay), level);
+        const double h_decay = refineDecay(lo.h_decay + frac * (hi.h_decay - lo.h_decay), level);
+        const double n_decay = refineDecay(lo.n_decay + frac * (hi.n_decay - lo.n_decay), level);
+
+        // Rush-Larsen gating update
+        m = m_inf + (m - m_inf) * m_decay;
+        h = h_inf + (h - h_inf) * h_decay;
+        n = n_inf + (n - n_inf) * n_decay;
+
+        // Exponential Euler for C dV/dt = I - g_tot * (V - V_inf)
+        const double n2 = n * n;
+        const double g_na = g_Na * m * m * m * h;
+        const double g_k = g_K * n2 * n2;
+        const double g_total = g_na + g_k + g_L;
+        const double V_inf = (I + g_na * E_Na + g_k * E_K + g_L * E_L) / g_total;
+        const double V_prev = V;
+        V = V_inf + (V - V_inf) * std::exp(-sub_dt * g_total / C);
+
+        if (V > 0.0 && V_prev <= 0.0) {
+            spiked = true;
+        }
+    }
+
+    V_[index] = V;
+    m_[index] = m;
+    h_[index] = h;
+    n_[index] = n;
+    fired_[index] = spiked ? 1 : 0;
+    return spiked;
+}
+
+void HodgkinHuxleyPopulation::reset() {
+    for (size_t i = 0; i < size(); ++i) {
+        resetNeuron(i);
+    }
+    time_ = 0.0;
+    spike_count_ = 0;
+    substep_count_ = 0;
+}
+
+void HodgkinHuxleyPopulation::resetNeuron(size_t index) {
+    V_[index] = kInitialV;
+    m_[index] = kInitialM;
+    h_[index] = kInitialH;
+    n_[index] = kInitialN;
+    input_[index] = 0.0;
+    last_spike_time_[index] = 0.0;
+    fired_[index] = 0;
+}
+
+void HodgkinHuxleyPopulation::addInputs(const double* currents) {
+    getSIMDOptimizer().vectorAdd(input_.data(), currents, input_.data(), input_.size());
+}
+
+std::vector<size_t> HodgkinHuxleyPopulation::getFiredIndices() const {
+    std::vector<size_t> indices;
+    indices.reserve(spike_count_);
+    for (size_t i = 0; i < fired_.size(); ++i) {
+        if (fired_[i]) {
+            indices.push_back(i);
+        }
+    }
+    return indices;
+}
+
+std::vector<double> HodgkinHuxleyPopulation::getState(size_t index) const {
+    return {V_[index], fired_[index] ? 1.0 : 0.0, last_spike_time_[index], 0.0,
+            V_[index], m_[index], h_[index], n_[index]};
+}
+
+void HodgkinHuxleyPopulation::setState(size_t index, const std::vector<double>& state) {
+    if (state.size() >= 8) {
+        fired_[index] = state[1] > 0.5 ? 1 : 0;
+        last_spike_time_[index] = state[2];
+        V_[index] = state[4];
+        m_[index] = state[5];
+        h_[index] = state[6];
+        n_[index] = state[7];
+    }
+}
+
+void HodgkinHuxleyPopulation::setNoise(double mean, double variance) {
+    params_.noise_mean = mean;
+    params_.noise_variance = variance;
+    noise_distribution_ = std::normal_distribution<double>(mean, std::sqrt(variance));
+}
+
+std::shared_ptr<NeuronBase> HodgkinHuxleyPopulation::getView(size_t index) {
+    if (index >= size()) {
+        throw std::out_of_range("HodgkinHuxleyPopulation::getView: index out of range");
+    }
+    return std::make_shared<PopulationNeuronView<HodgkinHuxleyNeuron>>(shared_from_this(), index);
+}
+
+template class PopulationNeuronView<HodgkinHuxleyNeuron>;
+
+} // namespace BrainLL
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "NeuronPopulation.hpp"
+#include "HodgkinHuxleyNeuron.hpp"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace BrainLL {
+
+class HodgkinHuxleyPopulation;
+
+template <>
+struct PopulationModelTraits<HodgkinHuxleyNeuron> {
+    static constexpr NeuronModel model = NeuronModel::HODGKIN_HUXLEY;
+    using Population = HodgkinHuxleyPopulation;
+};
+
+struct HHIntegratorConfig {
+    // Rate lookup table (gating steady states and per-step decay factors)
+    double table_min_voltage = -120.0;   // mV; voltages outside the range are clamped
+    double table_max_voltage = 80.0;
+    double table_resolution = 0.05;      // mV between table entries
+
+    // Adaptive sub-stepping: a neuron whose estimated |dV| over one sub-step exceeds
+    // voltage_tolerance halves its sub-step, up to 2^max_substep_levels sub-steps per update()
+    bool adaptive_substepping = true;
+    int max_substep_levels = 4;
+    double voltage_tolerance = 1.0;      // mV
+};
+
+/**
+ * Batched Hodgkin-Huxley engine over structure-of-arrays state.
+ *
+ * Gating variables advance with the Rush-Larsen scheme, x' = x_inf + (x - x_inf) * exp(-dt / tau_x),
+ * with x_inf and the decay factor read from a voltage lookup table instead of six exp()
+ * calls per neuron. The membrane equation is linear in V for fixed conductances and is
+ * integrated with exponential Euler, so the step stays stable at dt well above the
+ * forward-Euler limit of HodgkinHuxleyNeuron::update(). Neurons in the fast part of a
+ * spike sub-step adaptively.
+ */
+class HodgkinHuxleyPopulation : public std::enable_shared_from_this<HodgkinHuxleyPopulation> {
+public:
+    HodgkinHuxleyPopulation(size_t size, const AdvancedNeuronParams& params,
+                            const HHIntegratorConfig& config = HHIntegratorConfig());
+
+    // Simulation
+    void update(double dt);
+    void updateNeuron(size_t index, double dt);
+    void reset();
+    void resetNeuron(size_t index);
+
+    // Input accumulation (external current), consumed by the next update()
+    void addInput(size_t index, double current) { input_[index] += current; }
+    void addInputs(const double* currents);
+    double* getInputBuffer() { return input_.data(); }
+
+    // State access
+    size_t size() const { return V_.size(); }
+    double getPotential(size_t index) const { return V_[index]; }
+    bool hasFired(size_t index) const { return fired_[index] != 0; }
+    double getSodiumActivation(size_t index) const { return m_[index]; }
+    double getSodiumInactivation(size_t index) const { return h_[index]; }
+    double getPotassiumActivation(size_t index) const { return n_[index]; }
+    const double* getPotentials() const { return V_.data(); }
+    const uint8_t* getFiredFlags() const { return fired_.data(); }
+    std::vector<size_t> getFiredIndices() const;
+    size_t getSpikeCount() const { return spike_count_; }       // Spikes in the last update()
+    size_t getSubstepCount() const { return substep_count_; }   // Sub-steps taken in the last update()
+    double getTime() const { return time_; }
+
+    // Same layout as HodgkinHuxleyNeuron::getState(): base state followed by V, m, h, n
+    std::vector<double> getState(size_t index) const;
+    void setState(size_t index, const std::vector<double>& state);
+
+    const AdvancedNeuronParams& getParameters() const { return params_; }
+    const HHIntegratorConfig& getConfig() const { return config_; }
+    void setConfig(const HHIntegratorConfig& config);
+    void setNoise(double mean, double variance);
+
+    // Optional per-neuron view over this population
+    std::shared_ptr<NeuronBase> getView(size_t index);
+
+    static constexpr NeuronModel model = NeuronModel::HODGKIN_HUXLEY;
+
+private:
+    // One table row per voltage sample; decays are for a full step of table_dt_
+    struct RateEntry {
+        double m_inf, m_decay;
+        double h_inf, h_decay;
+        double n_inf, n_decay;
+    };
+
+    void buildRateTable(double dt);
+    bool integrate(size_t index, double dt, int& substeps);
+
+    AdvancedNeuronParams params_;
+    HHIntegratorConfig config_;
+    double time_;
+    size_t spike_count_;
+    size_t substep_count_;
+
+    std::vector<RateEntry> rate_table_;
+    double table_dt_;
+    double table_inv_resolution_;
+
+    // Structure-of-arrays state
+    std::vector<double> V_;
+    std::vector<double> m_;
+    std::vector<double> h_;
+    std::vector<double> n_;
+    std::vector<double> input_;
+    std::vector<double> last_spike_time_;
+    std::vector<uint8_t> fired_;
+
+    std::mt19937 noise_generator_;
+    std::normal_distribution<double> noise_distribution_;
+};
+
+extern template class PopulationNeuronView<HodgkinHuxleyNeuron>;
+
+} // namespace BrainLL
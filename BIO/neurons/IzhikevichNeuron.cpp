@@ -11,6 +11,7 @@ IzhikevichNeuron::IzhikevichNeuron(const AdvancedNeuronParams& params)
 }
 
 void IzhikevichNeuron::update(double dt) {
+    advanceClock(dt);
     updateIzhikevich(dt);
     
     // Apply noise if enabled
@@ -37,8 +38,7 @@ void IzhikevichNeuron::updateIzhikevich(double dt) {
         has_fired_ = true;
         potential_ = params_.c;
         recovery_variable_ += params_.d;
-        last_spike_time_ = 0.0;
-        recordSpike(0.0);
+        recordSpike(current_time_);
     } else {
         has_fired_ = false;
     }
@@ -10,6 +10,7 @@ LIFNeuron::LIFNeuron(const AdvancedNeuronParams& params)
 }
 
 void LIFNeuron::update(double dt) {
+    advanceClock(dt);
     // Calculate total input current
     double total_input = std::accumulate(inputs.begin(), inputs.end(), 0.0);
     
@@ -36,8 +37,7 @@ void LIFNeuron::updateLIF(double dt) {
     if (potential_ >= params_.threshold) {
         has_fired_ = true;
         potential_ = params_.reset_potential;
-        last_spike_time_ = 0.0; // Would need current time
-        recordSpike(0.0);
+        recordSpike(current_time_);
     } else {
         has_fired_ = false;
     }
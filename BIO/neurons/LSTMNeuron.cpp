@@ -1,20 +1,31 @@
 #include "LSTMNeuron.hpp"
+#include "../../optimization/SIMDOptimizer.hpp"
+#include <algorithm>
+#include <cmath>
 #include <numeric>
+#include <random>
 
 namespace BrainLL {
 
 LSTMNeuron::LSTMNeuron(const AdvancedNeuronParams& params) 
-    : NeuronBase(params) {
+    : NeuronBase(params)
+    , has_sequence_input_(false)
+    , input_size_(1)  // Summed input current only, until setSequenceInput()
+    , weights_f32_valid_(false)
+    , use_float32_(false) {
     // Ensure this is an LSTM neuron
     params_.model = NeuronModel::LSTM;
     
     // Initialize LSTM states
     hidden_state_.resize(params_.hidden_size, 0.0);
     cell_state_.resize(params_.hidden_size, 0.0);
+    current_input_.resize(input_size_, 0.0);
+    initializeWeights();
 }
 
 void LSTMNeuron::update(double dt) {
-    if (inputs.empty()) return;
+    advanceClock(dt);
+    if (inputs.empty() && !has_sequence_input_) return;
     
     updateLSTM(dt);
     
@@ -25,6 +36,8 @@ void LSTMNeuron::update(double dt) {
     
     // Clear inputs for next timestep
     inputs.clear();
+    std::fill(current_input_.begin(), current_input_.end(), 0.0);
+    has_sequence_input_ = false;
 }
 
 void LSTMNeuron::updateLSTM(double dt) {
@@ -35,29 +48,104 @@ void LSTMNeuron::updateLSTM(double dt) {
         hidden_state_.resize(params_.hidden_size, 0.0);
         cell_state_.resize(params_.hidden_size, 0.0);
     }
+    current_input_[0] += input_sum;
     
-    // Simplified LSTM for single value
-    double forget_gate = sigmoid(input_sum + params_.forget_bias);
-    double input_gate = sigmoid(input_sum);
-    double candidate = tanh_activation(input_sum);
-    double output_gate = sigmoid(input_sum);
-    
-    // Update first element of states
-    cell_state_[0] = forget_gate * cell_state_[0] + input_gate * candidate;
-    hidden_state_[0] = output_gate * tanh_activation(cell_state_[0]);
+    if (use_float32_) {
+        if (!weights_f32_valid_) {
+            weights_f32_.assignFrom(weights_);
+            weights_f32_valid_ = true;
+        }
+        step(weights_f32_, scratch_f32_);
+    } else {
+        step(weights_, scratch_);
+    }
     
     potential_ = hidden_state_[0];
     has_fired_ = potential_ > 0.5;
     
     if (has_fired_) {
-        recordSpike(0.0);
+        recordSpike(current_time_);
+    }
+}
+
+template <typename T>
+void LSTMNeuron::step(const PackedGateWeights<T>& weights, GateScratch<T>& scratch) {
+    SIMDOptimizer& simd = getSIMDOptimizer();
+    const size_t hidden = hidden_state_.size();
+    const size_t rows = 4 * hidden;
+    
+    scratch.x.assign(current_input_.begin(), current_input_.end());
+    scratch.h.assign(hidden_state_.begin(), hidden_state_.end());
+    scratch.gate_x.resize(rows);
+    scratch.gate_h.resize(rows);
+    scratch.act.resize(rows + hidden);
+    
+    // All four gates in one pass over the packed rows
+    simd.gateMatrixVectorMul(weights.weights.data(), scratch.x.data(), scratch.h.data(),
+                             scratch.gate_x.data(), scratch.gate_h.data(), rows, input_size_, hidden);
+    
+    // σ(a) = 0.5 + 0.5 * tanh(a / 2): pre-scale the sigmoid gates and run one vectorTanh over all rows
+    T* act = scratch.act.data();
+    for (size_t i = 0; i < rows; ++i) {
+        const T a = scratch.gate_x[i] + weights.bias_x[i] + scratch.gate_h[i] + weights.bias_h[i];
+        const bool cell_gate = i >= 2 * hidden && i < 3 * hidden;
+        act[i] = cell_gate ? a : static_cast<T>(0.5) * a;
+    }
+    simd.vectorTanh(act, act, rows);
+    
+    // c_t = f ⊙ c_{t-1} + i ⊙ g, h_t = o ⊙ tanh(c_t)
+    T* cell_tanh = act + rows;
+    for (size_t i = 0; i < hidden; ++i) {
+        const double input_gate = 0.5 + 0.5 * act[i];
+        const double forget_gate = 0.5 + 0.5 * act[hidden + i];
+        cell_state_[i] = forget_gate * cell_state_[i] + input_gate * act[2 * hidden + i];
+        cell_tanh[i] = static_cast<T>(cell_state_[i]);
+    }
+    simd.vectorTanh(cell_tanh, cell_tanh, hidden);
+    for (size_t i = 0; i < hidden; ++i) {
+        hidden_state_[i] = (0.5 + 0.5 * act[3 * hidden + i]) * cell_tanh[i];
+    }
+}
+
+void LSTMNeuron::initializeWeights() {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    
+    const size_t hidden = params_.hidden_size;
+    const size_t rows = 4 * hidden;
+    
+    // Xavier/Glorot initialization
+    std::normal_distribution<double> dist(0.0, std::sqrt(2.0 / (input_size_ + hidden)));
+    weights_.weights.resize(rows * (input_size_ + hidden));
+    for (double& weight : weights_.weights) {
+        weight = dist(gen);
+    }
+    
+    // Forget gate bias keeps the cell open early on
+    weights_.bias_x.assign(rows, 0.0);
+    weights_.bias_h.assign(rows, 0.0);
+    std::fill(weights_.bias_x.begin() + hidden, weights_.bias_x.begin() + 2 * hidden, params_.forget_bias);
+    weights_f32_valid_ = false;
+}
+
+void LSTMNeuron::setSequenceInput(const std::vector<double>& input) {
+    if (input.empty()) return;
+    
+    // Update input size if necessary
+    if (static_cast<int>(input.size()) != input_size_) {
+        input_size_ = static_cast<int>(input.size());
+        initializeWeights();  // Reinitialize with new input size
     }
+    current_input_ = input;
+    has_sequence_input_ = true;
 }
 
 void LSTMNeuron::reset() {
     NeuronBase::reset();
     std::fill(hidden_state_.begin(), hidden_state_.end(), 0.0);
     std::fill(cell_state_.begin(), cell_state_.end(), 0.0);
+    std::fill(current_input_.begin(), current_input_.end(), 0.0);
+    has_sequence_input_ = false;
 }
 
 std::vector<double> LSTMNeuron::getState() const {
@@ -1,9 +1,18 @@
 #pragma once
 
 #include "NeuronBase.hpp"
+#include "RecurrentGates.hpp"
 
 namespace BrainLL {
 
+/**
+ * LSTM cell with packed gate weights.
+ *
+ * The input at each step is the sequence input (setSequenceInput) with the summed input
+ * currents added to its first element. The four gates share one [4H x (I + H)] matrix
+ * (rows input | forget | cell | output), projected with a single fused matrix-vector
+ * pass per step. The neuron potential is the first hidden unit.
+ */
 class LSTMNeuron : public NeuronBase {
 public:
     explicit LSTMNeuron(const AdvancedNeuronParams& params);
@@ -19,13 +28,32 @@ public:
     std::vector<double> getHiddenState() const;
     void setCellState(const std::vector<double>& cell_state);
     std::vector<double> getCellState() const;
+    void setSequenceInput(const std::vector<double>& input);  // x_t for the next update(); resizes the input
+    
+    // Precision of the gate computation (weights are kept in double and converted once)
+    void setUseFloat32(bool use_float32) { use_float32_ = use_float32; }
+    bool isUsingFloat32() const { return use_float32_; }
 
 private:
     void updateLSTM(double dt);
+    template <typename T>
+    void step(const PackedGateWeights<T>& weights, GateScratch<T>& scratch);
+    void initializeWeights();
     
     // LSTM-specific state
     std::vector<double> hidden_state_;
     std::vector<double> cell_state_;
+    std::vector<double> current_input_;   // [input_size]
+    bool has_sequence_input_;
+    int input_size_;
+    
+    // Packed weights: rows [input | forget | cell | output] x hidden, columns [input | hidden]
+    PackedGateWeights<double> weights_;
+    PackedGateWeights<float> weights_f32_;
+    bool weights_f32_valid_;
+    bool use_float32_;
+    GateScratch<double> scratch_;
+    GateScratch<float> scratch_f32_;
 };
 
 } // namespace BrainLL
\ No newline at end of file
@@ -9,6 +9,8 @@ NeuronBase::NeuronBase(const AdvancedNeuronParams& params)
     , potential_(params.resting_potential)
     , has_fired_(false)
     , last_spike_time_(0.0)
+    , current_time_(0.0)
+    , spike_history_(params.spike_history_capacity)
     , adaptation_enabled_(true)
     , adaptation_current_(0.0)
     , noise_generator_(std::random_device{}())
@@ -20,6 +22,7 @@ void NeuronBase::reset() {
     potential_ = params_.resting_potential;
     has_fired_ = false;
     last_spike_time_ = 0.0;
+    current_time_ = 0.0;
     adaptation_current_ = 0.0;
     inputs.clear();
     spike_history_.clear();
@@ -73,28 +76,26 @@ void NeuronBase::removeOutputConnection(std::shared_ptr<NeuronBase> neuron) {
         output_connections_.end());
 }
 
+void NeuronBase::setParameters(const AdvancedNeuronParams& params) {
+    params_ = params;
+    if (params.spike_history_capacity != spike_history_.capacity()) {
+        spike_history_.setCapacity(params.spike_history_capacity);
+    }
+}
+
 void NeuronBase::recordSpike(double time) {
-    spike_history_.push_back(time);
-    // Keep only recent spikes (last 1000ms)
-    const double max_history = 1000.0;
-    spike_history_.erase(
-        std::remove_if(spike_history_.begin(), spike_history_.end(),
-            [time, max_history](double spike_time) { 
-                return (time - spike_time) > max_history; 
-            }),
-        spike_history_.end());
+    last_spike_time_ = time;
+    spike_history_.record(time);
+}
+
+void NeuronBase::setSpikeHistoryCapacity(size_t capacity) {
+    params_.spike_history_capacity = capacity;
+    spike_history_.setCapacity(capacity);
 }
 
 double NeuronBase::getFiringRate(double time_window) const {
-    if (spike_history_.empty()) return 0.0;
-    
-    double current_time = spike_history_.back();
-    int recent_spikes = std::count_if(spike_history_.begin(), spike_history_.end(),
-        [current_time, time_window](double spike_time) {
-            return (current_time - spike_time) <= time_window;
-        });
-    
-    return (recent_spikes * 1000.0) / time_window; // spikes per second
+    // Rate over the window ending at the neuron's clock, in spikes per second
+    return spike_history_.firingRate(current_time_, time_window);
 }
 
 void NeuronBase::setNoise(double mean, double variance) {
@@ -132,8 +133,7 @@ bool NeuronBase::isRefractory() const {
 }
 
 double NeuronBase::getTimeSinceLastSpike() const {
-    // This would need current simulation time - simplified for now
-    return last_spike_time_;
+    return current_time_ - last_spike_time_;
 }
 
 } // namespace BrainLL
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <functional>
 #include <random>
 #include <cmath>
+#include "../../include/SpikeHistory.hpp"
 
 namespace BrainLL {
 
@@ -105,6 +106,9 @@ struct AdvancedNeuronParams {
     double adaptation_rate = 0.1;
     double plasticity_window = 100.0;
     double leak_rate = 0.01;
+    
+    // Spike history ring buffer (spikes kept per neuron)
+    size_t spike_history_capacity = 1024;
 };
 
 class NeuronBase {
@@ -131,13 +135,17 @@ public:
     void removeOutputConnection(std::shared_ptr<NeuronBase> neuron);
     
     // Parameter management
-    void setParameters(const AdvancedNeuronParams& params) { params_ = params; }
+    void setParameters(const AdvancedNeuronParams& params);
     const AdvancedNeuronParams& getParameters() const { return params_; }
     
-    // Spike history
+    // Spike history (bounded; the view is invalidated by the next recorded spike)
     void recordSpike(double time);
-    std::vector<double> getSpikeHistory() const { return spike_history_; }
+    brainll::SpikeTimesView getSpikeHistory() const { return spike_history_.view(); }
     double getFiringRate(double time_window = 1000.0) const;
+    double getLastSpikeTime() const { return last_spike_time_; }
+    void setSpikeHistoryCapacity(size_t capacity);
+    size_t getSpikeHistoryCapacity() const { return spike_history_.capacity(); }
+    double getTime() const { return current_time_; }
     
     // Utility functions
     void enableAdaptation(bool enable) { adaptation_enabled_ = enable; }
@@ -154,10 +162,11 @@ protected:
     double potential_;
     bool has_fired_;
     double last_spike_time_;
+    double current_time_;   // Local clock (ms), advanced by update()
     std::vector<double> inputs;
     
     // Spike history
-    std::vector<double> spike_history_;
+    brainll::SpikeHistory spike_history_;
     
     // Adaptation
     bool adaptation_enabled_;
@@ -172,6 +181,7 @@ protected:
     std::vector<std::pair<std::shared_ptr<NeuronBase>, double>> output_connections_;
     
     // Utility functions
+    void advanceClock(double dt) { current_time_ += dt; }
     double sigmoid(double x) const { return 1.0 / (1.0 + std::exp(-x)); }
     double tanh_activation(double x) const { return std::tanh(x); }
     double relu(double x) const { return std::max(0.0, x); }
@@ -51,6 +51,10 @@ std::shared_ptr<NeuronBase> NeuronFactory::createNeuron(const AdvancedNeuronPara
 }
 
 std::shared_ptr<NeuronBase> NeuronFactory::createNeuron(NeuronModel model, const AdvancedNeuronParams& base_params) {
+    return createNeuron(applyModelDefaults(model, base_params));
+}
+
+AdvancedNeuronParams NeuronFactory::applyModelDefaults(NeuronModel model, const AdvancedNeuronParams& base_params) {
     AdvancedNeuronParams params = base_params;
     params.model = model;
     
@@ -64,7 +68,7 @@ std::shared_ptr<NeuronBase> NeuronFactory::createNeuron(NeuronModel model, const
     if (params.c == -65.0 && defaults.c != -65.0) params.c = defaults.c;
     if (params.d == 8.0 && defaults.d != 8.0) params.d = defaults.d;
     
-    return createNeuron(params);
+    return params;
 }
 
 NeuronModel NeuronFactory::stringToModel(const std::string& model_str) {
@@ -11,6 +11,8 @@
 #include "HodgkinHuxleyNeuron.hpp"
 #include "AttentionNeuron.hpp"
 #include "AdaptiveNeuron.hpp"
+#include "NeuronPopulation.hpp"
+#include "HodgkinHuxleyPopulation.hpp"
 #include <memory>
 
 namespace BrainLL {
@@ -20,6 +22,15 @@ public:
     static std::shared_ptr<NeuronBase> createNeuron(const AdvancedNeuronParams& params);
     static std::shared_ptr<NeuronBase> createNeuron(NeuronModel model, const AdvancedNeuronParams& base_params = {});
     
+    // Population with contiguous state and a batched kernel
+    // (LIFNeuron, AdaptiveLIFNeuron, IzhikevichNeuron, HodgkinHuxleyNeuron)
+    template <typename Model>
+    static std::shared_ptr<typename PopulationModelTraits<Model>::Population>
+    createPopulation(size_t size, const AdvancedNeuronParams& base_params = {}) {
+        return std::make_shared<typename PopulationModelTraits<Model>::Population>(
+            size, applyModelDefaults(PopulationModelTraits<Model>::model, base_params));
+    }
+    
     // Utility functions
     static NeuronModel stringToModel(const std::string& model_str);
     static std::string modelToString(NeuronModel model);
@@ -29,6 +40,8 @@ public:
     
 private:
     NeuronFactory() = default; // Static class
+    
+    static AdvancedNeuronParams applyModelDefaults(NeuronModel model, const AdvancedNeuronParams& base_params);
 };
 
 } // namespace BrainLL
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "NeuronPopulation.hpp"
+#include "../../optimization/SIMDOptimizer.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace BrainLL {
+
+template <typename Model>
+NeuronPopulation<Model>::NeuronPopulation(size_t size, const AdvancedNeuronParams& params)
+    : params_(params)
+    , time_(0.0)
+    , spike_count_(0)
+    , potential_(size, params.resting_potential)
+    , input_(size, 0.0)
+    , last_spike_time_(size, 0.0)
+    , fired_(size, 0)
+    , noise_generator_(std::random_device{}())
+    , noise_distribution_(params.noise_mean, std::sqrt(params.noise_variance))
+{
+    params_.model = model;
+    if constexpr (model == NeuronModel::ADAPTIVE_LIF) {
+        adaptation_.assign(size, 0.0);
+    }
+    if constexpr (model == NeuronModel::IZHIKEVICH) {
+        recovery_.assign(size, params.b * params.resting_potential);
+    }
+}
+
+template <typename Model>
+void NeuronPopulation<Model>::update(double dt) {
+    spike_count_ = step(0, size(), dt);
+    time_ += dt;
+
+    for (size_t i = 0; i < size(); ++i) {
+        if (fired_[i]) {
+            last_spike_time_[i] = time_;
+        }
+    }
+}
+
+template <typename Model>
+void NeuronPopulation<Model>::updateNeuron(size_t index, double dt) {
+    step(index, index + 1, dt);
+    if (fired_[index]) {
+        last_spike_time_[index] = time_ + dt;
+    }
+}
+
+template <typename Model>
+size_t NeuronPopulation<Model>::step(size_t begin, size_t end, double dt) {
+    if (begin >= end) {
+        return 0;
+    }
+    SIMDOptimizer& simd = getSIMDOptimizer();
+    const size_t count = end - begin;
+    size_t spikes = 0;
+
+    if constexpr (model == NeuronModel::IZHIKEVICH) {
+        SIMDOptimizer::IzhikevichKernelParams kernel;
+        kernel.a = params_.a;
+        kernel.b = params_.b;
+        kernel.c = params_.c;
+        kernel.d = params_.d;
+        kernel.dt = dt;
+        kernel.peak = 30.0;
+        spikes = simd.izhikevichPopulationStep(&potential_[begin], &recovery_[begin], &input_[begin],
+                                               &fired_[begin], count, kernel);
+    } else {
+        // C dV/dt = -(V - E_L) / R + I - w, folded into V' = V * decay + rest_drive + (I - w) * gain
+        const double rc = params_.membrane_resistance * params_.membrane_capacitance;
+        SIMDOptimizer::LIFKernelParams kernel;
+        kernel.decay = 1.0 - dt / rc;
+        kernel.input_gain = dt / params_.membrane_capacitance;
+        kernel.rest_drive = dt * params_.resting_potential / rc;
+        kernel.threshold = params_.threshold;
+        kernel.reset = params_.reset_potential;
+        kernel.adaptation_decay = std::exp(-dt / params_.adaptation_time_constant);
+        kernel.adaptation_jump = params_.adaptation_strength;
+        double* adaptation = (model == NeuronModel::ADAPTIVE_LIF) ? &adaptation_[begin] : nullptr;
+        spikes = simd.lifPopulationStep(&potential_[begin], &input_[begin], adaptation,
+                                        &fired_[begin], count, kernel);
+    }
+
+    if (params_.noise_variance > 0.0) {
+        applyNoise(begin, end, dt);
+    }
+    return spikes;
+}
+
+template <typename Model>
+void NeuronPopulation<Model>::applyNoise(size_t begin, size_t end, double dt) {
+    const double scale = std::sqrt(dt);
+    for (size_t i = begin; i < end; ++i) {
+        potential_[i] += noise_distribution_(noise_generator_) * scale;
+    }
+}
+
+template <typename Model>
+void NeuronPopulation<Model>::reset() {
+    for (size_t i = 0; i < size(); ++i) {
+        resetNeuron(i);
+    }
+    time_ = 0.0;
+    spike_count_ = 0;
+}
+
+template <typename Model>
+void NeuronPopulation<Model>::resetNeuron(size_t index) {
+    potential_[index] = params_.resting_potential;
+    input_[index] = 0.0;
+    last_spike_time_[index] = 0.0;
+    fired_[index] = 0;
+    if constexpr (model == NeuronModel::ADAPTIVE_LIF) {
+        adaptation_[index] = 0.0;
+    }
+    if constexpr (model == NeuronModel::IZHIKEVICH) {
+        recovery_[index] = params_.b * params_.resting_potential;
+    }
+}
+
+template <typename Model>
+void NeuronPopulation<Model>::addInputs(const double* currents) {
+    getSIMDOptimizer().vectorAdd(input_.data(), currents, input_.data(), input_.size());
+}
+
+template <typename Model>
+double NeuronPopulation<Model>::getAdaptationCurrent(size_t index) const {
+    return adaptation_.empty() ? 0.0 : adaptation_[index];
+}
+
+template <typename Model>
+double NeuronPopulation<Model>::getRecoveryVariable(size_t index) const {
+    return recovery_.empty() ? 0.0 : recovery_[index];
+}
+
+template <typename Model>
+std::vector<size_t> NeuronPopulation<Model>::getFiredIndices() const {
+    std::vector<size_t> indices;
+    indices.reserve(spike_count_);
+    for (size_t i = 0; i < fired_.size(); ++i) {
+        if (fired_[i]) {
+            indices.push_back(i);
+        }
+    }
+    return indices;
+}
+
+template <typename Model>
+std::vector<double> NeuronPopulation<Model>::getState(size_t index) const {
+    std::vector<double> state;
+    state.push_back(potential_[index]);
+    state.push_back(fired_[index] ? 1.0 : 0.0);
+    state.push_back(last_spike_time_[index]);
+    state.push_back(getAdaptationCurrent(index));
+    if constexpr (model == NeuronModel::IZHIKEVICH) {
+        state.push_back(recovery_[index]);
+    }
+    return state;
+}
+
+template <typename Model>
+void NeuronPopulation<Model>::setState(size_t index, const std::vector<double>& state) {
+    if (state.size() >= 4) {
+        potential_[index] = state[0];
+        fired_[index] = state[1] > 0.5 ? 1 : 0;
+        last_spike_time_[index] = state[2];
+        if constexpr (model == NeuronModel::ADAPTIVE_LIF) {
+            adaptation_[index] = state[3];
+        }
+    }
+    if constexpr (model == NeuronModel::IZHIKEVICH) {
+        if (state.size() >= 5) {
+            recovery_[index] = state[4];
+        }
+    }
+}
+
+template <typename Model>
+void NeuronPopulation<Model>::setNoise(double mean, double variance) {
+    params_.noise_mean = mean;
+    params_.noise_variance = variance;
+    noise_distribution_ = std::normal_distribution<double>(mean, std::sqrt(variance));
+}
+
+template <typename Model>
+std::shared_ptr<NeuronBase> NeuronPopulation<Model>::getView(size_t index) {
+    if (index >= size()) {
+        throw std::out_of_range("NeuronPopulation::getView: index out of range");
+    }
+    return std::make_shared<PopulationNeuronView<Model>>(this->shared_from_this(), index);
+}
+
+template class NeuronPopulation<LIFNeuron>;
+template class NeuronPopulation<AdaptiveLIFNeuron>;
+template class NeuronPopulation<IzhikevichNeuron>;
+template class PopulationNeuronView<LIFNeuron>;
+template class PopulationNeuronView<AdaptiveLIFNeuron>;
+template class PopulationNeuronView<IzhikevichNeuron>;
+
+} // namespace BrainLL
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "NeuronBase.hpp"
+#include "LIFNeuron.hpp"
+#include "AdaptiveLIFNeuron.hpp"
+#include "IzhikevichNeuron.hpp"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace BrainLL {
+
+template <typename Model>
+class NeuronPopulation;
+
+// Maps a per-neuron model class to the population type that integrates it in batch.
+// Models without a population kernel have no specialization.
+template <typename Model>
+struct PopulationModelTraits;
+
+template <>
+struct PopulationModelTraits<LIFNeuron> {
+    static constexpr NeuronModel model = NeuronModel::LIF;
+    using Population = NeuronPopulation<LIFNeuron>;
+};
+
+template <>
+struct PopulationModelTraits<AdaptiveLIFNeuron> {
+    static constexpr NeuronModel model = NeuronModel::ADAPTIVE_LIF;
+    using Population = NeuronPopulation<AdaptiveLIFNeuron>;
+};
+
+template <>
+struct PopulationModelTraits<IzhikevichNeuron> {
+    static constexpr NeuronModel model = NeuronModel::IZHIKEVICH;
+    using Population = NeuronPopulation<IzhikevichNeuron>;
+};
+
+/**
+ * A population of identical neurons of one model, stored as structure-of-arrays.
+ *
+ * update() advances every neuron with a single vectorized kernel (AVX2/FMA through
+ * SIMDOptimizer, scalar fallback) instead of one virtual call and one input vector
+ * per neuron. Inputs accumulate in a contiguous buffer that the kernel consumes.
+ * The dynamics match LIFNeuron / AdaptiveLIFNeuron / IzhikevichNeuron::update().
+ *
+ * getView(i) returns an optional NeuronBase object backed by this storage, for code
+ * that still expects per-neuron objects. Views keep the population alive.
+ */
+template <typename Model>
+class NeuronPopulation : public std::enable_shared_from_this<NeuronPopulation<Model>> {
+public:
+    NeuronPopulation(size_t size, const AdvancedNeuronParams& params);
+
+    // Simulation
+    void update(double dt);                    // One step for the whole population
+    void updateNeuron(size_t index, double dt); // One step for a single neuron (used by views)
+    void reset();
+    void resetNeuron(size_t index);
+
+    // Input accumulation, consumed by the next update()
+    void addInput(size_t index, double current) { input_[index] += current; }
+    void addInputs(const double* currents);    // currents[i] for every neuron
+    double* getInputBuffer() { return input_.data(); }
+
+    // State access
+    size_t size() const { return potential_.size(); }
+    double getPotential(size_t index) const { return potential_[index]; }
+    bool hasFired(size_t index) const { return fired_[index] != 0; }
+    double getAdaptationCurrent(size_t index) const;
+    double getRecoveryVariable(size_t index) const;
+    const double* getPotentials() const { return potential_.data(); }
+    const uint8_t* getFiredFlags() const { return fired_.data(); }
+    std::vector<size_t> getFiredIndices() const;
+    size_t getSpikeCount() const { return spike_count_; } // Spikes in the last update()
+    double getTime() const { return time_; }
+
+    // Same layout as the per-neuron getState()/setState()
+    std::vector<double> getState(size_t index) const;
+    void setState(size_t index, const std::vector<double>& state);
+
+    const AdvancedNeuronParams& getParameters() const { return params_; }
+    void setNoise(double mean, double variance);
+
+    // Optional per-neuron view over this population
+    std::shared_ptr<NeuronBase> getView(size_t index);
+
+    static constexpr NeuronModel model = PopulationModelTraits<Model>::model;
+
+private:
+    size_t step(size_t begin, size_t end, double dt);
+    void applyNoise(size_t begin, size_t end, double dt);
+
+    AdvancedNeuronParams params_;
+    double time_;
+    size_t spike_count_;
+
+    // Structure-of-arrays state
+    std::vector<double> potential_;
+    std::vector<double> input_;
+    std::vector<double> adaptation_;      // ADAPTIVE_LIF only
+    std::vector<double> recovery_;        // IZHIKEVICH only
+    std::vector<double> last_spike_time_;
+    std::vector<uint8_t> fired_;
+
+    std::mt19937 noise_generator_;
+    std::normal_distribution<double> noise_distribution_;
+};
+
+// NeuronBase facade over one neuron of a population (NeuronPopulation or HodgkinHuxleyPopulation)
+template <typename Model>
+class PopulationNeuronView : public NeuronBase {
+public:
+    using Population = typename PopulationModelTraits<Model>::Population;
+
+    PopulationNeuronView(std::shared_ptr<Population> population, size_t index)
+        : NeuronBase(population->getParameters())
+        , population_(std::move(population))
+        , index_(index) {}
+
+    void update(double dt) override { population_->updateNeuron(index_, dt); }
+    void reset() override { population_->resetNeuron(index_); }
+    bool hasFired() const override { return population_->hasFired(index_); }
+    double getPotential() const override { return population_->getPotential(index_); }
+    void addInput(double current) override { population_->addInput(index_, current); }
+    void addSpike(double /*time*/, double weight) override { population_->addInput(index_, weight); }
+
+    std::vector<double> getState() const override { return population_->getState(index_); }
+    void setState(const std::vector<double>& state) override { population_->setState(index_, state); }
+
+    size_t getIndex() const { return index_; }
+    const std::shared_ptr<Population>& getPopulation() const { return population_; }
+
+private:
+    std::shared_ptr<Population> population_;
+    size_t index_;
+};
+
+extern template class NeuronPopulation<LIFNeuron>;
+extern template class NeuronPopulation<AdaptiveLIFNeuron>;
+extern template class NeuronPopulation<IzhikevichNeuron>;
+extern template class PopulationNeuronView<LIFNeuron>;
+extern template class PopulationNeuronView<AdaptiveLIFNeuron>;
+extern template class PopulationNeuronView<IzhikevichNeuron>;
+
+using LIFPopulation = NeuronPopulation<LIFNeuron>;
+using AdaptiveLIFPopulation = NeuronPopulation<AdaptiveLIFNeuron>;
+using IzhikevichPopulation = NeuronPopulation<IzhikevichNeuron>;
+
+} // namespace BrainLL
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+
+namespace BrainLL {
+
+/**
+ * Packed gate weights shared by the recurrent neurons (GRUNeuron, LSTMNeuron).
+ *
+ * All gates live in one row-major [gates * hidden][input + hidden] matrix, gate-major
+ * rows and columns x | h, so one step is a single pass over the matrix
+ * (SIMDOptimizer::gateMatrixVectorMul) instead of one matrix-vector product per gate
+ * and operand. Input and hidden projections come back separately because the GRU
+ * candidate gate scales only the hidden part by the reset gate.
+ */
+template <typename T>
+struct PackedGateWeights {
+    std::vector<T> weights;  // [gates * hidden][input + hidden]
+    std::vector<T> bias_x;   // [gates * hidden], input-side bias
+    std::vector<T> bias_h;   // [gates * hidden], hidden-side bias
+
+    template <typename U>
+    void assignFrom(const PackedGateWeights<U>& other) {
+        weights.assign(other.weights.begin(), other.weights.end());
+        bias_x.assign(other.bias_x.begin(), other.bias_x.end());
+        bias_h.assign(other.bias_h.begin(), other.bias_h.end());
+    }
+};
+
+// Per-step buffers in the compute precision; sized on first use and reused
+template <typename T>
+struct GateScratch {
+    std::vector<T> x;        // [input]
+    std::vector<T> h;        // [hidden], previous hidden state
+    std::vector<T> gate_x;   // [gates * hidden], W_x x + b_x
+    std::vector<T> gate_h;   // [gates * hidden], W_h h + b_h
+    std::vector<T> act;      // [gates * hidden], activations
+};
+
+} // namespace BrainLL
\ No newline at end of file
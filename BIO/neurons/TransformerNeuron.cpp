@@ -1,4 +1,5 @@
 #include "TransformerNeuron.hpp"
+#include "../../optimization/SIMDOptimizer.hpp"
 #include <algorithm>
 #include <numeric>
 #include <random>
@@ -12,9 +13,17 @@ TransformerNeuron::TransformerNeuron(const AdvancedNeuronParams& params)
     , d_model_(params.d_model)
     , d_k_(params.d_model / params.num_heads)
     , d_v_(params.d_model / params.num_heads)
+    , attn_width_(params.num_heads * (params.d_model / params.num_heads))
+    , ff_hidden_(4 * params.d_model)
     , sequence_length_(32)  // Default sequence length
     , attention_dropout_(params.attention_dropout)
     , ff_dropout_(0.1)
+    , weights_f32_valid_(false)
+    , use_float32_(false)
+    , output_rows_(0)
+    , incremental_(false)
+    , kv_window_(32)
+    , kv_position_(0)
     , attention_threshold_(0.7)
     , attention_decay_(0.95)
 {
@@ -26,12 +35,12 @@ TransformerNeuron::TransformerNeuron(const AdvancedNeuronParams& params)
     temporal_attention_buffer_.resize(d_model_, 0.0);
     
     // Initialize output structures
-    attention_output_.resize(sequence_length_, std::vector<double>(d_model_, 0.0));
-    final_output_.resize(sequence_length_, std::vector<double>(d_model_, 0.0));
+    final_output_.assign(static_cast<size_t>(sequence_length_) * d_model_, 0.0);
 }
 
 void TransformerNeuron::update(double dt) {
-    if (input_sequence_.empty()) {
+    advanceClock(dt);
+    if (incremental_ ? (pending_tokens_.empty() && output_rows_ == 0) : input_sequence_.empty()) {
         return;
     }
     
@@ -39,36 +48,30 @@ void TransformerNeuron::update(double dt) {
     updateTemporalBuffer(dt);
     updateSpikeAttention(dt);
     
-    // Compute transformer forward pass
-    computeMultiHeadAttention();
-    
-    // Apply layer normalization and residual connection
-    for (size_t i = 0; i < attention_output_.size(); ++i) {
-        applyResidualConnection(embedded_sequence_[i], attention_output_[i]);
-        layerNormalization(attention_output_[i]);
-    }
-    
-    // Feed-forward network
-    final_output_ = attention_output_;
-    for (auto& output : final_output_) {
-        feedForward(output);
-    }
-    
-    // Apply second layer norm and residual
-    for (size_t i = 0; i < final_output_.size(); ++i) {
-        applyResidualConnection(attention_output_[i], final_output_[i]);
-        layerNormalization(final_output_[i]);
+    // Compute transformer forward pass (incremental: only the tokens added since the last update)
+    if (incremental_) {
+        if (!pending_tokens_.empty()) {
+            if (use_float32_) {
+                incrementalPass(getFloatWeights(), scratch_f32_, kv_cache_f32_);
+            } else {
+                incrementalPass(weights_, scratch_, kv_cache_);
+            }
+        }
+    } else if (use_float32_) {
+        forwardPass(getFloatWeights(), scratch_f32_);
+    } else {
+        forwardPass(weights_, scratch_);
     }
     
     // Update neuron potential based on output
-    if (!final_output_.empty()) {
-        double output_sum = std::accumulate(final_output_[0].begin(), final_output_[0].end(), 0.0);
-        potential_ = output_sum / final_output_[0].size();
+    if (output_rows_ > 0) {
+        double output_sum = std::accumulate(final_output_.begin(), final_output_.begin() + d_model_, 0.0);
+        potential_ = output_sum / d_model_;
         
         // Check for spike
         if (potential_ > params_.threshold) {
             has_fired_ = true;
-            recordSpike(0.0);  // Time tracking would need global time
+            recordSpike(current_time_);
             potential_ = params_.reset_potential;
         } else {
             has_fired_ = false;
@@ -89,14 +92,12 @@ void TransformerNeuron::reset() {
     // Clear sequences
     input_sequence_.clear();
     embedded_sequence_.clear();
+    clearKVCache();
     
     // Reset output
-    for (auto& output : attention_output_) {
-        std::fill(output.begin(), output.end(), 0.0);
-    }
-    for (auto& output : final_output_) {
-        std::fill(output.begin(), output.end(), 0.0);
-    }
+    std::fill(final_output_.begin(), final_output_.end(), 0.0);
+    attention_weights_.clear();
+    output_rows_ = 0;
 }
 
 void TransformerNeuron::addInput(double current) {
@@ -115,6 +116,18 @@ void TransformerNeuron::setSequenceLength(int length) {
 }
 
 void TransformerNeuron::addSequenceInput(const std::vector<double>& sequence) {
+    if (incremental_) {
+        // Append embedded tokens; update() projects them and extends the K/V cache
+        for (size_t i = 0; i < sequence.size(); i += d_model_) {
+            const size_t row = pending_tokens_.size();
+            const size_t count = std::min<size_t>(d_model_, sequence.size() - i);
+            pending_tokens_.resize(row + d_model_, 0.0);
+            std::copy(sequence.begin() + i, sequence.begin() + i + count, pending_tokens_.begin() + row);
+            addPositionEncoding(&pending_tokens_[row], kv_position_ + static_cast<long long>(row / d_model_));
+        }
+        return;
+    }
+    
     input_sequence_.clear();
     embedded_sequence_.clear();
     
@@ -150,69 +163,294 @@ void TransformerNeuron::addSequenceInput(const std::vector<double>& sequence) {
 void TransformerNeuron::computeMultiHeadAttention() {
     if (embedded_sequence_.empty()) return;
     
-    int seq_len = embedded_sequence_.size();
+    const int seq_len = static_cast<int>(embedded_sequence_.size());
+    if (use_float32_) {
+        auto& scratch = scratch_f32_;
+        scratch.embedded.resize(static_cast<size_t>(seq_len) * d_model_);
+        for (int i = 0; i < seq_len; ++i) {
+            std::copy(embedded_sequence_[i].begin(), embedded_sequence_[i].end(), scratch.embedded.begin() + i * d_model_);
+        }
+        multiHeadAttention(getFloatWeights(), scratch, seq_len);
+    } else {
+        auto& scratch = scratch_;
+        scratch.embedded.resize(static_cast<size_t>(seq_len) * d_model_);
+        for (int i = 0; i < seq_len; ++i) {
+            std::copy(embedded_sequence_[i].begin(), embedded_sequence_[i].end(), scratch.embedded.begin() + i * d_model_);
+        }
+        multiHeadAttention(weights_, scratch, seq_len);
+    }
+}
+
+template <typename T>
+void TransformerNeuron::forwardPass(const WeightSet<T>& weights, AttentionScratch<T>& scratch) {
+    const int seq_len = static_cast<int>(embedded_sequence_.size());
+    const size_t rows_size = static_cast<size_t>(seq_len) * d_model_;
+    
+    scratch.embedded.resize(rows_size);
+    for (int i = 0; i < seq_len; ++i) {
+        std::copy(embedded_sequence_[i].begin(), embedded_sequence_[i].end(), scratch.embedded.begin() + i * d_model_);
+    }
+    
+    // Attention sub-layer: residual + layer norm
+    multiHeadAttention(weights, scratch, seq_len);
+    for (size_t i = 0; i < rows_size; ++i) {
+        scratch.attention[i] += scratch.embedded[i];
+    }
+    normalizeRows(scratch.attention.data(), seq_len, ln1_gamma_, ln1_beta_);
+    
+    // Feed-forward sub-layer: residual + layer norm
+    applyFeedForward(weights, scratch, seq_len);
+    for (size_t i = 0; i < rows_size; ++i) {
+        scratch.output[i] += scratch.attention[i];
+    }
+    normalizeRows(scratch.output.data(), seq_len, ln2_gamma_, ln2_beta_);
+    
+    final_output_.assign(scratch.output.begin(), scratch.output.begin() + rows_size);
+    output_rows_ = seq_len;
+}
+
+template <typename T>
+void TransformerNeuron::multiHeadAttention(const WeightSet<T>& weights, AttentionScratch<T>& scratch, int seq_len) {
+    SIMDOptimizer& simd = getSIMDOptimizer();
+    const size_t seq = static_cast<size_t>(seq_len);
+    const size_t qkv_width = 3 * static_cast<size_t>(attn_width_);
+    
+    // Q, K and V of every head in one GEMM: [seq][d_model] x [d_model][3 * attn_width]
+    scratch.qkv.resize(seq * qkv_width);
+    simd.matrixMatrixMul(scratch.embedded.data(), weights.qkv.data(), scratch.qkv.data(), seq, qkv_width, d_model_);
     
-    // Initialize attention structures
-    queries_.resize(num_heads_);
-    keys_.resize(num_heads_);
-    values_.resize(num_heads_);
-    attention_scores_.resize(num_heads_);
+    scratch.q_head.resize(seq * d_k_);
+    scratch.k_head_t.resize(static_cast<size_t>(d_k_) * seq);
+    scratch.v_head.resize(seq * d_v_);
+    scratch.head_out.resize(seq * d_v_);
+    scratch.scores.resize(static_cast<size_t>(num_heads_) * seq * seq);
+    scratch.context.resize(seq * attn_width_);
+    
+    const T scale = static_cast<T>(1.0 / std::sqrt(static_cast<double>(d_k_)));
     
     for (int h = 0; h < num_heads_; ++h) {
-        queries_[h].resize(seq_len, std::vector<double>(d_k_, 0.0));
-        keys_[h].resize(seq_len, std::vector<double>(d_k_, 0.0));
-        values_[h].resize(seq_len, std::vector<double>(d_v_, 0.0));
-        attention_scores_[h].resize(seq_len, std::vector<double>(seq_len, 0.0));
-        
-        // Compute Q, K, V for this head
-        for (int i = 0; i < seq_len; ++i) {
+        // Pack this head's Q, K^T and V into contiguous blocks
+        for (size_t i = 0; i < seq; ++i) {
+            const T* row = &scratch.qkv[i * qkv_width];
             for (int j = 0; j < d_k_; ++j) {
-                queries_[h][i][j] = dotProduct(embedded_sequence_[i], query_weights_[h][j]);
-                keys_[h][i][j] = dotProduct(embedded_sequence_[i], key_weights_[h][j]);
-            }
-            for (int j = 0; j < d_v_; ++j) {
-                values_[h][i][j] = dotProduct(embedded_sequence_[i], value_weights_[h][j]);
+                scratch.q_head[i * d_k_ + j] = row[h * d_k_ + j];
+                scratch.k_head_t[j * seq + i] = row[attn_width_ + h * d_k_ + j];
             }
+            std::copy(row + 2 * attn_width_ + h * d_v_, row + 2 * attn_width_ + (h + 1) * d_v_,
+                      &scratch.v_head[i * d_v_]);
         }
         
-        // Compute attention scores
-        for (int i = 0; i < seq_len; ++i) {
-            for (int j = 0; j < seq_len; ++j) {
-                attention_scores_[h][i][j] = dotProduct(queries_[h][i], keys_[h][j]) / std::sqrt(d_k_);
+        T* scores = &scratch.scores[h * seq * seq];
+        simd.matrixMatrixMul(scratch.q_head.data(), scratch.k_head_t.data(), scores, seq, seq, d_k_);
+        
+        // Fused scale + stable softmax + spike-based modulation per row
+        for (size_t i = 0; i < seq; ++i) {
+            T* row = scores + i * seq;
+            const T max_val = *std::max_element(row, row + seq);
+            T sum = 0;
+            for (size_t j = 0; j < seq; ++j) {
+                row[j] = std::exp((row[j] - max_val) * scale);
+                sum += row[j];
             }
-            
-            // Apply softmax
-            softmax(attention_scores_[h][i]);
-            
-            // Apply spike-based attention modulation
-            for (int j = 0; j < seq_len; ++j) {
-                attention_scores_[h][i][j] *= (1.0 + spike_attention_weights_[j]);
+            const T inv_sum = static_cast<T>(1) / sum;
+            for (size_t j = 0; j < seq; ++j) {
+                row[j] *= inv_sum * static_cast<T>(1.0 + spike_attention_weights_[j]);
             }
         }
+        
+        simd.matrixMatrixMul(scores, scratch.v_head.data(), scratch.head_out.data(), seq, d_v_, seq);
+        for (size_t i = 0; i < seq; ++i) {
+            std::copy(&scratch.head_out[i * d_v_], &scratch.head_out[(i + 1) * d_v_],
+                      &scratch.context[i * attn_width_ + h * d_v_]);
+        }
     }
     
-    // Compute attention output
-    std::fill(attention_output_.begin(), attention_output_.end(), std::vector<double>(d_model_, 0.0));
+    // Output projection: [seq][attn_width] x [attn_width][d_model]
+    scratch.attention.resize(seq * d_model_);
+    simd.matrixMatrixMul(scratch.context.data(), weights.output.data(), scratch.attention.data(), seq, d_model_, attn_width_);
     
-    for (int h = 0; h < num_heads_; ++h) {
-        for (int i = 0; i < seq_len; ++i) {
-            for (int j = 0; j < seq_len; ++j) {
-                for (int k = 0; k < d_v_; ++k) {
-                    int output_idx = h * d_v_ + k;
-                    if (output_idx < d_model_) {
-                        attention_output_[i][output_idx] += attention_scores_[h][i][j] * values_[h][j][k];
-                    }
+    attention_weights_.assign(scratch.scores.begin(), scratch.scores.begin() + seq);
+}
+
+template <typename T>
+void TransformerNeuron::applyFeedForward(const WeightSet<T>& weights, AttentionScratch<T>& scratch, int seq_len) {
+    SIMDOptimizer& simd = getSIMDOptimizer();
+    const size_t seq = static_cast<size_t>(seq_len);
+    const T keep = static_cast<T>(1.0 - ff_dropout_); // Dropout (simplified - just scaling)
+    
+    scratch.hidden.resize(seq * ff_hidden_);
+    simd.matrixMatrixMul(scratch.attention.data(), weights.ff1.data(), scratch.hidden.data(), seq, ff_hidden_, d_model_);
+    for (size_t i = 0; i < seq; ++i) {
+        T* row = &scratch.hidden[i * ff_hidden_];
+        for (int j = 0; j < ff_hidden_; ++j) {
+            row[j] = std::max(row[j] + weights.ff_bias1[j], static_cast<T>(0)) * keep;
+        }
+    }
+    
+    scratch.output.resize(seq * d_model_);
+    simd.matrixMatrixMul(scratch.hidden.data(), weights.ff2.data(), scratch.output.data(), seq, d_model_, ff_hidden_);
+    for (size_t i = 0; i < seq; ++i) {
+        T* row = &scratch.output[i * d_model_];
+        for (int j = 0; j < d_model_; ++j) {
+            row[j] += weights.ff_bias2[j];
+        }
+    }
+}
+
+template <typename T>
+void TransformerNeuron::incrementalPass(const WeightSet<T>& weights, AttentionScratch<T>& scratch, KVCache<T>& cache) {
+    SIMDOptimizer& simd = getSIMDOptimizer();
+    const size_t rows = pending_tokens_.size() / d_model_;
+    const size_t qkv_width = 3 * static_cast<size_t>(attn_width_);
+    const size_t window = static_cast<size_t>(kv_window_);
+    
+    scratch.embedded.assign(pending_tokens_.begin(), pending_tokens_.end());
+    pending_tokens_.clear();
+    
+    // Q/K/V of the new tokens only
+    scratch.qkv.resize(rows * qkv_width);
+    simd.matrixMatrixMul(scratch.embedded.data(), weights.qkv.data(), scratch.qkv.data(), rows, qkv_width, d_model_);
+    
+    if (cache.keys.empty()) {
+        cache.keys.assign(num_heads_ * window * d_k_, 0);
+        cache.values.assign(num_heads_ * window * d_v_, 0);
+    }
+    scratch.context.resize(rows * attn_width_);
+    scratch.token_scores.resize(window);
+    
+    const T scale = static_cast<T>(1.0 / std::sqrt(static_cast<double>(d_k_)));
+    T* scores = scratch.token_scores.data();
+    
+    // Tokens in order: each one sees the cache up to and including itself
+    for (size_t r = 0; r < rows; ++r) {
+        const T* row = &scratch.qkv[r * qkv_width];
+        const size_t slot = static_cast<size_t>(kv_position_ % kv_window_);
+        for (int h = 0; h < num_heads_; ++h) {
+            std::copy(row + attn_width_ + h * d_k_, row + attn_width_ + (h + 1) * d_k_,
+                      &cache.keys[(h * window + slot) * d_k_]);
+            std::copy(row + 2 * attn_width_ + h * d_v_, row + 2 * attn_width_ + (h + 1) * d_v_,
+                      &cache.values[(h * window + slot) * d_v_]);
+        }
+        ++kv_position_;
+        const size_t cached = static_cast<size_t>(std::min<long long>(kv_position_, kv_window_));
+        
+        for (int h = 0; h < num_heads_; ++h) {
+            simd.matrixVectorMul(&cache.keys[h * window * d_k_], row + h * d_k_, scores, cached, d_k_);
+            
+            // Fused scale + stable softmax + spike-based modulation (by cache slot)
+            const T max_val = *std::max_element(scores, scores + cached);
+            T sum = 0;
+            for (size_t j = 0; j < cached; ++j) {
+                scores[j] = std::exp((scores[j] - max_val) * scale);
+                sum += scores[j];
+            }
+            const T inv_sum = static_cast<T>(1) / sum;
+            for (size_t j = 0; j < cached; ++j) {
+                scores[j] *= inv_sum * static_cast<T>(1.0 + spike_attention_weights_[j % spike_attention_weights_.size()]);
+            }
+            
+            T* context = &scratch.context[r * attn_width_ + h * d_v_];
+            std::fill(context, context + d_v_, static_cast<T>(0));
+            for (size_t j = 0; j < cached; ++j) {
+                const T p = scores[j];
+                const T* value = &cache.values[(h * window + j) * d_v_];
+                for (int c = 0; c < d_v_; ++c) {
+                    context[c] += p * value[c];
+                }
+            }
+            
+            // Head 0 of the newest token, oldest position first
+            if (h == 0 && r + 1 == rows) {
+                const size_t oldest = cached < window ? 0 : (slot + 1) % window;
+                attention_weights_.resize(cached);
+                for (size_t j = 0; j < cached; ++j) {
+                    attention_weights_[j] = scores[(oldest + j) % cached];
                 }
             }
         }
     }
     
-    // Apply output projection
-    for (int i = 0; i < seq_len; ++i) {
-        std::vector<double> projected(d_model_, 0.0);
-        matrixMultiply(output_weights_, attention_output_[i], projected);
-        attention_output_[i] = projected;
+    // Output projection, residual + layer norm, feed-forward for the new rows
+    const size_t rows_size = rows * d_model_;
+    scratch.attention.resize(rows_size);
+    simd.matrixMatrixMul(scratch.context.data(), weights.output.data(), scratch.attention.data(), rows, d_model_, attn_width_);
+    for (size_t i = 0; i < rows_size; ++i) {
+        scratch.attention[i] += scratch.embedded[i];
+    }
+    normalizeRows(scratch.attention.data(), static_cast<int>(rows), ln1_gamma_, ln1_beta_);
+    
+    applyFeedForward(weights, scratch, static_cast<int>(rows));
+    for (size_t i = 0; i < rows_size; ++i) {
+        scratch.output[i] += scratch.attention[i];
+    }
+    normalizeRows(scratch.output.data(), static_cast<int>(rows), ln2_gamma_, ln2_beta_);
+    
+    // Keep only the newest token's output
+    final_output_.assign(scratch.output.begin() + (rows - 1) * d_model_, scratch.output.begin() + rows_size);
+    output_rows_ = 1;
+}
+
+void TransformerNeuron::setUseFloat32(bool use_float32) {
+    if (use_float32 != use_float32_) {
+        clearKVCache();  // The cache is kept in the compute precision
     }
+    use_float32_ = use_float32;
+}
+
+void TransformerNeuron::setIncrementalMode(bool enabled, int window) {
+    incremental_ = enabled;
+    kv_window_ = window > 0 ? window : sequence_length_;
+    clearKVCache();
+    input_sequence_.clear();
+    embedded_sequence_.clear();
+    output_rows_ = 0;
+}
+
+int TransformerNeuron::getCachedLength() const {
+    return static_cast<int>(std::min<long long>(kv_position_, kv_window_));
+}
+
+void TransformerNeuron::clearKVCache() {
+    kv_position_ = 0;
+    kv_cache_.keys.clear();
+    kv_cache_.values.clear();
+    kv_cache_f32_.keys.clear();
+    kv_cache_f32_.values.clear();
+    pending_tokens_.clear();
+}
+
+template <typename T>
+void TransformerNeuron::normalizeRows(T* data, int rows, const std::vector<double>& gamma, const std::vector<double>& beta) {
+    for (int r = 0; r < rows; ++r) {
+        T* row = data + static_cast<size_t>(r) * d_model_;
+        double mean = 0.0;
+        for (int i = 0; i < d_model_; ++i) mean += row[i];
+        mean /= d_model_;
+        double variance = 0.0;
+        for (int i = 0; i < d_model_; ++i) variance += (row[i] - mean) * (row[i] - mean);
+        variance /= d_model_;
+        
+        const double inv_std = 1.0 / std::sqrt(variance + 1e-8);
+        for (int i = 0; i < d_model_; ++i) {
+            row[i] = static_cast<T>((row[i] - mean) * inv_std * gamma[i] + beta[i]);
+        }
+    }
+}
+
+const TransformerNeuron::WeightSet<float>& TransformerNeuron::getFloatWeights() {
+    if (!weights_f32_valid_) {
+        auto convert = [](const std::vector<double>& src, std::vector<float>& dst) {
+            dst.assign(src.begin(), src.end());
+        };
+        convert(weights_.qkv, weights_f32_.qkv);
+        convert(weights_.output, weights_f32_.output);
+        convert(weights_.ff1, weights_f32_.ff1);
+        convert(weights_.ff_bias1, weights_f32_.ff_bias1);
+        convert(weights_.ff2, weights_f32_.ff2);
+        convert(weights_.ff_bias2, weights_f32_.ff_bias2);
+        weights_f32_valid_ = true;
+    }
+    return weights_f32_;
 }
 
 void TransformerNeuron::layerNormalization(std::vector<double>& data) {
@@ -242,27 +480,11 @@ void TransformerNeuron::layerNormalization(std::vector<double>& data) {
 void TransformerNeuron::feedForward(std::vector<double>& data) {
     if (data.empty()) return;
     
-    // First linear layer
-    std::vector<double> hidden(ff_weights1_[0].size(), 0.0);
-    matrixMultiply(ff_weights1_, data, hidden);
-    addBias(hidden, ff_bias1_);
-    
-    // ReLU activation
-    for (double& val : hidden) {
-        val = relu(val);
-    }
-    
-    // Dropout (simplified - just scaling)
-    for (double& val : hidden) {
-        val *= (1.0 - ff_dropout_);
-    }
-    
-    // Second linear layer
-    std::vector<double> output(ff_weights2_[0].size(), 0.0);
-    matrixMultiply(ff_weights2_, hidden, output);
-    addBias(output, ff_bias2_);
-    
-    data = output;
+    // Single row through the same d_model -> 4*d_model -> d_model network
+    scratch_.attention.assign(d_model_, 0.0);
+    std::copy(data.begin(), data.begin() + std::min<size_t>(data.size(), d_model_), scratch_.attention.begin());
+    applyFeedForward(weights_, scratch_, 1);
+    data.assign(scratch_.output.begin(), scratch_.output.begin() + d_model_);
 }
 
 void TransformerNeuron::applyResidualConnection(const std::vector<double>& input, std::vector<double>& output) {
@@ -276,54 +498,23 @@ void TransformerNeuron::initializeWeights() {
     std::mt19937 gen(rd());
     std::normal_distribution<double> dist(0.0, 0.02);
     
-    // Initialize attention weights
-    query_weights_.resize(num_heads_);
-    key_weights_.resize(num_heads_);
-    value_weights_.resize(num_heads_);
-    
-    for (int h = 0; h < num_heads_; ++h) {
-        query_weights_[h].resize(d_k_, std::vector<double>(d_model_));
-        key_weights_[h].resize(d_k_, std::vector<double>(d_model_));
-        value_weights_[h].resize(d_v_, std::vector<double>(d_model_));
-        
-        for (int i = 0; i < d_k_; ++i) {
-            for (int j = 0; j < d_model_; ++j) {
-                query_weights_[h][i][j] = dist(gen);
-                key_weights_[h][i][j] = dist(gen);
-            }
-        }
-        for (int i = 0; i < d_v_; ++i) {
-            for (int j = 0; j < d_model_; ++j) {
-                value_weights_[h][i][j] = dist(gen);
-            }
+    auto fill = [&](std::vector<double>& weights, size_t count) {
+        weights.resize(count);
+        for (double& w : weights) {
+            w = dist(gen);
         }
-    }
+    };
     
-    // Initialize output projection
-    output_weights_.resize(d_model_, std::vector<double>(d_model_));
-    for (int i = 0; i < d_model_; ++i) {
-        for (int j = 0; j < d_model_; ++j) {
-            output_weights_[i][j] = dist(gen);
-        }
-    }
+    // Attention weights: fused Q/K/V projection and output projection
+    fill(weights_.qkv, static_cast<size_t>(d_model_) * 3 * attn_width_);
+    fill(weights_.output, static_cast<size_t>(attn_width_) * d_model_);
     
     // Initialize feed-forward weights
-    int ff_hidden = 4 * d_model_;
-    ff_weights1_.resize(ff_hidden, std::vector<double>(d_model_));
-    ff_bias1_.resize(ff_hidden, 0.0);
-    ff_weights2_.resize(d_model_, std::vector<double>(ff_hidden));
-    ff_bias2_.resize(d_model_, 0.0);
-    
-    for (int i = 0; i < ff_hidden; ++i) {
-        for (int j = 0; j < d_model_; ++j) {
-            ff_weights1_[i][j] = dist(gen);
-        }
-    }
-    for (int i = 0; i < d_model_; ++i) {
-        for (int j = 0; j < ff_hidden; ++j) {
-            ff_weights2_[i][j] = dist(gen);
-        }
-    }
+    fill(weights_.ff1, static_cast<size_t>(d_model_) * ff_hidden_);
+    weights_.ff_bias1.assign(ff_hidden_, 0.0);
+    fill(weights_.ff2, static_cast<size_t>(ff_hidden_) * d_model_);
+    weights_.ff_bias2.assign(d_model_, 0.0);
+    weights_f32_valid_ = false;
     
     // Initialize layer norm parameters
     ln1_gamma_.resize(d_model_, 1.0);
@@ -346,37 +537,20 @@ void TransformerNeuron::initializePositionEncodings() {
     }
 }
 
-double TransformerNeuron::dotProduct(const std::vector<double>& a, const std::vector<double>& b) {
-    double result = 0.0;
-    for (size_t i = 0; i < std::min(a.size(), b.size()); ++i) {
-        result += a[i] * b[i];
-    }
-    return result;
-}
-
-void TransformerNeuron::softmax(std::vector<double>& data) {
-    if (data.empty()) return;
-    
-    double max_val = *std::max_element(data.begin(), data.end());
-    double sum = 0.0;
-    
-    for (double& val : data) {
-        val = std::exp(val - max_val);
-        sum += val;
-    }
-    
-    for (double& val : data) {
-        val /= sum;
+void TransformerNeuron::addPositionEncoding(double* token, long long position) const {
+    if (position < static_cast<long long>(position_encodings_.size())) {
+        const std::vector<double>& encoding = position_encodings_[position];
+        for (int i = 0; i < d_model_; ++i) {
+            token[i] += encoding[i];
+        }
+        return;
     }
-}
-
-void TransformerNeuron::matrixMultiply(const std::vector<std::vector<double>>& A, 
-                                     const std::vector<double>& b, 
-                                     std::vector<double>& result) {
-    if (A.empty() || b.empty()) return;
     
-    for (size_t i = 0; i < A.size() && i < result.size(); ++i) {
-        result[i] = dotProduct(A[i], b);
+    // Past the precomputed table: same sinusoidal encoding
+    for (int i = 0; i < d_model_; ++i) {
+        const int even = i - (i % 2);
+        const double angle = position / std::pow(10000.0, 2.0 * even / d_model_);
+        token[i] += (i % 2 == 0) ? std::sin(angle) : std::cos(angle);
     }
 }
 
@@ -411,17 +585,13 @@ void TransformerNeuron::decayAttentionWeights(double dt) {
 }
 
 std::vector<double> TransformerNeuron::getAttentionWeights() const {
-    std::vector<double> weights;
-    if (!attention_scores_.empty() && !attention_scores_[0].empty()) {
-        weights = attention_scores_[0][0];  // Return first head, first position
-    }
-    return weights;
+    return attention_weights_;  // First head, first position
 }
 
 std::vector<double> TransformerNeuron::getOutput() const {
     std::vector<double> output;
-    if (!final_output_.empty()) {
-        output = final_output_[0];  // Return first position output
+    if (output_rows_ > 0) {
+        output.assign(final_output_.begin(), final_output_.begin() + d_model_);  // First position output
     }
     return output;
 }
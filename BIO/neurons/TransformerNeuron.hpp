@@ -17,6 +17,16 @@ namespace BrainLL {
  * - Layer normalization
  * - Feed-forward network
  * - Residual connections
+ * 
+ * Activations and weights live in contiguous row-major buffers. The Q/K/V projection of
+ * all heads is a single GEMM through SIMDOptimizer, and the scratch buffers persist
+ * across calls. setUseFloat32(true) runs the forward pass in single precision.
+ * 
+ * In incremental mode addSequenceInput() appends tokens instead of replacing the
+ * sequence. K/V of past positions stay in a ring buffer of the last 'window' tokens
+ * and update() computes attention only for the new queries (causal), so a streamed
+ * token costs O(window) instead of a full O(n^2) pass. getOutput() then returns the
+ * output of the newest token.
  */
 class TransformerNeuron : public NeuronBase {
 public:
@@ -35,6 +45,17 @@ public:
     std::vector<double> getAttentionWeights() const;
     std::vector<double> getOutput() const;
     
+    // Precision of the forward pass (weights are kept in double and converted once)
+    void setUseFloat32(bool use_float32);
+    bool isUsingFloat32() const { return use_float32_; }
+    
+    // Incremental decoding with a K/V cache (window <= 0: sequence length)
+    void setIncrementalMode(bool enabled, int window = 0);
+    bool isIncrementalMode() const { return incremental_; }
+    int getCacheWindow() const { return kv_window_; }
+    int getCachedLength() const;
+    void clearKVCache();
+    
     // Attention mechanism
     void computeAttention();
     void computeMultiHeadAttention();
@@ -49,11 +70,60 @@ public:
     void setState(const std::vector<double>& state) override;
     
 private:
+    // Row-major activations and scratch for one forward pass; sized on first use and reused
+    template <typename T>
+    struct AttentionScratch {
+        std::vector<T> embedded;   // [seq][d_model]
+        std::vector<T> qkv;        // [seq][3 * attn_width]: Q heads | K heads | V heads
+        std::vector<T> q_head;     // [seq][d_k]
+        std::vector<T> k_head_t;   // [d_k][seq]
+        std::vector<T> v_head;     // [seq][d_v]
+        std::vector<T> scores;     // [num_heads][seq][seq]
+        std::vector<T> head_out;   // [seq][d_v]
+        std::vector<T> context;    // [seq][attn_width], heads concatenated
+        std::vector<T> attention;  // [seq][d_model]
+        std::vector<T> hidden;     // [seq][ff_hidden]
+        std::vector<T> output;     // [seq][d_model]
+        std::vector<T> token_scores; // [window], one query against the K/V cache
+    };
+    
+    // Ring buffer of past keys/values; slot = position % window
+    template <typename T>
+    struct KVCache {
+        std::vector<T> keys;       // [num_heads][window][d_k]
+        std::vector<T> values;     // [num_heads][window][d_v]
+    };
+    
+    // Weight set in the compute precision
+    template <typename T>
+    struct WeightSet {
+        std::vector<T> qkv;        // [d_model][3 * attn_width]
+        std::vector<T> output;     // [attn_width][d_model]
+        std::vector<T> ff1;        // [d_model][ff_hidden]
+        std::vector<T> ff_bias1;   // [ff_hidden]
+        std::vector<T> ff2;        // [ff_hidden][d_model]
+        std::vector<T> ff_bias2;   // [d_model]
+    };
+    
+    template <typename T>
+    void forwardPass(const WeightSet<T>& weights, AttentionScratch<T>& scratch);
+    template <typename T>
+    void multiHeadAttention(const WeightSet<T>& weights, AttentionScratch<T>& scratch, int seq_len);
+    template <typename T>
+    void applyFeedForward(const WeightSet<T>& weights, AttentionScratch<T>& scratch, int seq_len);
+    template <typename T>
+    void incrementalPass(const WeightSet<T>& weights, AttentionScratch<T>& scratch, KVCache<T>& cache);
+    template <typename T>
+    void normalizeRows(T* data, int rows, const std::vector<double>& gamma, const std::vector<double>& beta);
+    const WeightSet<float>& getFloatWeights();
+    
     // Transformer parameters
     int num_heads_;
     int d_model_;
     int d_k_;  // dimension per head
     int d_v_;  // dimension per head
+    int attn_width_;  // num_heads * d_k (<= d_model)
+    int ff_hidden_;
     int sequence_length_;
     double attention_dropout_;
     double ff_dropout_;
@@ -63,17 +133,11 @@ private:
     std::vector<std::vector<double>> position_encodings_;
     std::vector<std::vector<double>> embedded_sequence_;
     
-    // Attention matrices
-    std::vector<std::vector<std::vector<double>>> query_weights_;  // [num_heads][d_model][d_k]
-    std::vector<std::vector<std::vector<double>>> key_weights_;    // [num_heads][d_model][d_k]
-    std::vector<std::vector<std::vector<double>>> value_weights_;  // [num_heads][d_model][d_v]
-    std::vector<std::vector<double>> output_weights_;              // [d_model][d_model]
-    
-    // Feed-forward weights
-    std::vector<std::vector<double>> ff_weights1_;  // [d_model][4*d_model]
-    std::vector<double> ff_bias1_;                  // [4*d_model]
-    std::vector<std::vector<double>> ff_weights2_;  // [4*d_model][d_model]
-    std::vector<double> ff_bias2_;                  // [d_model]
+    // Attention and feed-forward weights (double master copy, float copy built on demand)
+    WeightSet<double> weights_;
+    WeightSet<float> weights_f32_;
+    bool weights_f32_valid_;
+    bool use_float32_;
     
     // Layer normalization parameters
     std::vector<double> ln1_gamma_;  // [d_model]
@@ -82,12 +146,19 @@ private:
     std::vector<double> ln2_beta_;   // [d_model]
     
     // Intermediate computations
-    std::vector<std::vector<std::vector<double>>> queries_;  // [num_heads][seq_len][d_k]
-    std::vector<std::vector<std::vector<double>>> keys_;     // [num_heads][seq_len][d_k]
-    std::vector<std::vector<std::vector<double>>> values_;   // [num_heads][seq_len][d_v]
-    std::vector<std::vector<std::vector<double>>> attention_scores_;  // [num_heads][seq_len][seq_len]
-    std::vector<std::vector<double>> attention_output_;      // [seq_len][d_model]
-    std::vector<std::vector<double>> final_output_;          // [seq_len][d_model]
+    AttentionScratch<double> scratch_;
+    AttentionScratch<float> scratch_f32_;
+    int output_rows_;                         // Rows of the last forward pass
+    std::vector<double> attention_weights_;   // Head 0, position 0 of the last pass
+    std::vector<double> final_output_;        // [seq_len][d_model]
+    
+    // Incremental decoding state
+    bool incremental_;
+    int kv_window_;
+    long long kv_position_;                   // Tokens processed since the cache was cleared
+    KVCache<double> kv_cache_;
+    KVCache<float> kv_cache_f32_;
+    std::vector<double> pending_tokens_;      // [new tokens][d_model], embedded, not yet processed
     
     // Spike-based adaptations
     std::vector<double> spike_attention_weights_;
@@ -98,11 +169,7 @@ private:
     // Utility functions
     void initializeWeights();
     void initializePositionEncodings();
-    double dotProduct(const std::vector<double>& a, const std::vector<double>& b);
-    void softmax(std::vector<double>& data);
-    void matrixMultiply(const std::vector<std::vector<double>>& A, 
-                       const std::vector<double>& b, 
-                       std::vector<double>& result);
+    void addPositionEncoding(double* token, long long position) const;
     void addBias(std::vector<double>& data, const std::vector<double>& bias);
     void dropout(std::vector<double>& data, double rate);
     
@@ -0,0 +1,94 @@
+// Las comprobaciones usan assert: que sigan activas también en builds Release
+#undef NDEBUG
+
+#include "NeuronPopulation.hpp"
+#include "LIFNeuron.hpp"
+#include "AdaptiveLIFNeuron.hpp"
+#include "IzhikevichNeuron.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace BrainLL {
+namespace Tests {
+
+// 37 neuronas: el último bloque de 4 del kernel AVX2 queda incompleto
+constexpr size_t kPopulationSize = 37;
+
+bool close(double a, double b) {
+    return std::abs(a - b) <= 1e-9 * (1.0 + std::abs(b));
+}
+
+// Compara NeuronPopulation<Model> con kPopulationSize objetos Model independientes
+// alimentados con las mismas corrientes
+template <typename Model>
+void checkPopulationMatchesNeurons(const char* name, const AdvancedNeuronParams& params,
+                                   double max_current, double dt) {
+    std::cout << "Testing NeuronPopulation<" << name << "> against " << name << "::update..." << std::endl;
+
+    auto population = std::make_shared<NeuronPopulation<Model>>(kPopulationSize, params);
+    std::vector<std::unique_ptr<Model>> neurons;
+    for (size_t i = 0; i < kPopulationSize; ++i) {
+        neurons.push_back(std::make_unique<Model>(params));
+    }
+
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<double> current(0.0, max_current);
+    size_t spikes = 0;
+    for (int step = 0; step < 2000; ++step) {
+        for (size_t i = 0; i < kPopulationSize; ++i) {
+            const double input = current(rng);
+            population->addInput(i, input);
+            neurons[i]->addInput(input);
+        }
+        population->update(dt);
+        for (size_t i = 0; i < kPopulationSize; ++i) {
+            neurons[i]->update(dt);
+            assert(population->hasFired(i) == neurons[i]->hasFired());
+            assert(close(population->getPotential(i), neurons[i]->getPotential()));
+            spikes += neurons[i]->hasFired() ? 1 : 0;
+        }
+    }
+    assert(spikes > 0);
+
+    std::cout << "✓ " << name << " population tests passed (" << spikes << " spikes)" << std::endl;
+}
+
+void testLIFPopulation() {
+    AdvancedNeuronParams params;
+    params.model = NeuronModel::LIF;
+    checkPopulationMatchesNeurons<LIFNeuron>("LIFNeuron", params, 3.0, 0.1);
+}
+
+void testAdaptiveLIFPopulation() {
+    AdvancedNeuronParams params;
+    params.model = NeuronModel::ADAPTIVE_LIF;
+    checkPopulationMatchesNeurons<AdaptiveLIFNeuron>("AdaptiveLIFNeuron", params, 3.0, 0.1);
+}
+
+void testIzhikevichPopulation() {
+    AdvancedNeuronParams params;
+    params.model = NeuronModel::IZHIKEVICH;
+    checkPopulationMatchesNeurons<IzhikevichNeuron>("IzhikevichNeuron", params, 20.0, 0.1);
+}
+
+void runAllTests() {
+    std::cout << "=== Running NeuronPopulation Tests ===" << std::endl;
+
+    testLIFPopulation();
+    testAdaptiveLIFPopulation();
+    testIzhikevichPopulation();
+
+    std::cout << "\nAll NeuronPopulation tests passed" << std::endl;
+}
+
+} // namespace Tests
+} // namespace BrainLL
+
+int main() {
+    BrainLL::Tests::runAllTests();
+    return 0;
+}
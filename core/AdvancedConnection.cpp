@@ -25,7 +25,7 @@ namespace brainll {
 
 // AdvancedConnection implementation
 AdvancedConnection::AdvancedConnection(size_t id, size_t source_id, size_t target_id, double weight)
-    : numeric_id_(id), source_id_(source_id), target_id_(target_id),
+    : delay(1.0), numeric_id_(id), source_id_(source_id), target_id_(target_id),
       weight_(weight), delay_(1.0) {
     // Initialize default parameters
     parameters_.learning_rate = 0.01;
@@ -56,7 +56,7 @@ AdvancedConnection::AdvancedConnection(const std::string& id,
                                      std::shared_ptr<AdvancedNeuron> source,
                                      std::shared_ptr<AdvancedNeuron> target,
                                      const AdvancedConnectionParams& params)
-    : id_(id), source_(source), target_(target), parameters_(params),
+    : delay(params.delay), id_(id), source_(source), target_(target), parameters_(params),
       weight_(params.weight), delay_(params.delay) {
     // Initialize plasticity state
     plasticity_state_.last_update_time = 0.0;
@@ -265,7 +265,7 @@ void AdvancedConnection::setState(const std::map<std::string, double>& state) {
     if (it != state.end()) weight_ = it->second;
     
     it = state.find("delay");
-    if (it != state.end()) delay_ = it->second;
+    if (it != state.end()) setDelay(it->second);
     
     it = state.find("plasticity_rule");
     if (it != state.end()) parameters_.plasticity_rule = static_cast<PlasticityRule>(static_cast<int>(it->second));
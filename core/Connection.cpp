@@ -18,37 +18,45 @@
 #include "../../include/Connection.hpp"
 #include "../../include/DebugConfig.hpp"
 #include "../../include/Neuron.hpp" // Incluir la definición completa de Neuron
+#include "../../include/SynapseStore.hpp"
 #include <algorithm> // Para std::min/max
+#include <cmath>
 
 namespace brainll {
 
-Connection::Connection(std::shared_ptr<Neuron> source, std::shared_ptr<Neuron> dest, double weight, bool use_float16)
-    : m_source_neuron(source), m_destination_neuron(dest), m_use_float16(use_float16), m_is_plastic(false), m_learning_rate(0.0), m_delay(0.0) {
-    if (m_use_float16) {
-        m_weight_float16 = float16(weight);
-    } else {
-        m_weight_double = weight;
+namespace {
+    inline NeuronHandle handleOf(const std::shared_ptr<Neuron>& neuron) {
+        return neuron ? neuron->getHandle() : INVALID_NEURON_HANDLE;
     }
 }
 
+Connection::Connection(std::shared_ptr<Neuron> source, std::shared_ptr<Neuron> dest, double weight, bool use_float16)
+    : m_source_neuron(source), m_destination_neuron(dest), m_store(std::make_shared<SynapseStore>()) {
+    m_index = m_store->add(handleOf(source), handleOf(dest), weight, use_float16);
+}
+
 Connection::Connection(std::shared_ptr<Neuron> source, std::shared_ptr<Neuron> dest, float16 weight)
-    : m_source_neuron(source), m_destination_neuron(dest), m_use_float16(true), m_is_plastic(false), m_learning_rate(0.0), m_delay(0.0) {
-    m_weight_float16 = weight;
+    : m_source_neuron(source), m_destination_neuron(dest), m_store(std::make_shared<SynapseStore>()) {
+    m_index = m_store->add(handleOf(source), handleOf(dest), static_cast<float>(weight), true);
 }
 
+Connection::Connection(std::shared_ptr<SynapseStore> store, uint32_t index,
+                       std::shared_ptr<Neuron> source, std::shared_ptr<Neuron> dest)
+    : m_source_neuron(source), m_destination_neuron(dest), m_store(std::move(store)), m_index(index) {}
+
 void Connection::propagate() {
+    // Camino de compatibilidad (ParallelSimulation); DynamicNetwork propaga sobre los SynapseRecord
     if (auto source = m_source_neuron.lock()) {
         if (auto dest = m_destination_neuron.lock()) {
             if (source->hasFired()) {
-                double weight_value = m_use_float16 ? static_cast<double>(m_weight_float16) : m_weight_double;
-                dest->addInput(weight_value);
+                dest->addInput(getWeight());
             }
         }
     }
 }
 
 void Connection::applyPlasticity() {
-    if (!m_is_plastic) {
+    if (!isPlastic()) {
         return;
     }
 
@@ -56,70 +64,57 @@ void Connection::applyPlasticity() {
         if (auto dest = m_destination_neuron.lock()) {
             if (source->hasFired() && dest->hasFired()) {
                 // Regla de Hebb: "Neurons that fire together, wire together"
-                double current_weight = m_use_float16 ? static_cast<double>(m_weight_float16) : m_weight_double;
-                double delta_w = m_learning_rate * (1.0 - current_weight); // Simple rule, decays as it approaches max
-                double new_weight = current_weight + delta_w;
-                new_weight = std::min(new_weight, 1.5); // Clamp to max weight
-                
-                if (m_use_float16) {
-                    m_weight_float16 = float16(new_weight);
-                } else {
-                    m_weight_double = new_weight;
-                }
+                setWeight(hebbianUpdate(getWeight(), getLearningRate()));
             }
         }
     }
 }
 
+double Connection::hebbianUpdate(double current_weight, double learning_rate) {
+    double delta_w = learning_rate * (1.0 - current_weight); // Simple rule, decays as it approaches max
+    return std::min(current_weight + delta_w, 1.5); // Clamp to max weight
+}
+
 void Connection::enablePlasticity(double learning_rate) {
-    m_is_plastic = true;
-    m_learning_rate = learning_rate;
+    auto& record = (*m_store)[m_index];
+    record.flags |= SYNAPSE_PLASTIC;
+    record.learning_rate = bfloat16(learning_rate);
+    m_store->touchWeights();
 }
 
 double Connection::getWeight() const { 
-    return m_use_float16 ? static_cast<double>(m_weight_float16) : m_weight_double; 
+    return (*m_store)[m_index].weight;
 }
 
 float16 Connection::getWeightFloat16() const {
-    return m_use_float16 ? m_weight_float16 : float16(m_weight_double);
+    return float16((*m_store)[m_index].weight);
 }
 
 void Connection::setWeight(double weight) { 
-    if (m_use_float16) {
-        m_weight_float16 = float16(weight);
-    } else {
-        m_weight_double = weight;
-    }
+    m_store->setWeight(m_index, weight);
 }
 
 void Connection::setWeightFloat16(float16 weight) {
-    if (m_use_float16) {
-        m_weight_float16 = weight;
-    } else {
-        m_weight_double = static_cast<double>(weight);
-    }
+    m_store->setWeight(m_index, static_cast<float>(weight));
 }
 
 bool Connection::isUsingFloat16() const {
-    return m_use_float16;
+    return ((*m_store)[m_index].flags & SYNAPSE_FLOAT16) != 0;
 }
 
 void Connection::setUseFloat16(bool use_float16) {
-    if (use_float16 != m_use_float16) {
-        if (use_float16) {
-            // Convert from double to float16
-            float16 temp = float16(m_weight_double);
-            m_weight_float16 = temp;
-        } else {
-            // Convert from float16 to double
-            double temp = static_cast<double>(m_weight_float16);
-            m_weight_double = temp;
-        }
-        m_use_float16 = use_float16;
+    auto& record = (*m_store)[m_index];
+    if (use_float16) {
+        record.flags |= SYNAPSE_FLOAT16;
+        m_store->setWeight(m_index, record.weight); // Redondear el peso actual
+    } else {
+        record.flags &= static_cast<uint8_t>(~SYNAPSE_FLOAT16);
     }
 }
 
-bool Connection::isPlastic() const { return m_is_plastic; }
+bool Connection::isPlastic() const { return (*m_store)[m_index].isPlastic(); }
+
+double Connection::getLearningRate() const { return static_cast<float>((*m_store)[m_index].learning_rate); }
 
 std::shared_ptr<Neuron> Connection::getSourceNeuron() const {
     return m_source_neuron.lock();
@@ -130,32 +125,40 @@ std::shared_ptr<Neuron> Connection::getDestinationNeuron() const {
 }
 
 double Connection::getDelay() const {
-    return m_delay;
+    return static_cast<double>((*m_store)[m_index].delay);
+}
+
+void Connection::setDelay(double delay) {
+    const double steps = delay > 0.0 ? std::min(std::round(delay), 255.0) : 0.0;
+    m_store->setDelay(m_index, static_cast<uint8_t>(steps));
+}
+
+uint32_t Connection::getSynapseIndex() const {
+    return m_index;
 }
 
 void Connection::reset(std::shared_ptr<Neuron> source, std::shared_ptr<Neuron> dest, double weight) {
     m_source_neuron = source;
     m_destination_neuron = dest;
-    if (m_use_float16) {
-        m_weight_float16 = float16(weight);
-    } else {
-        m_weight_double = weight;
-    }
-    m_is_plastic = false;
-    m_learning_rate = 0.0;
+    auto& record = (*m_store)[m_index];
+    record.source = handleOf(source);
+    record.target = handleOf(dest);
+    record.flags &= static_cast<uint8_t>(~SYNAPSE_PLASTIC);
+    record.learning_rate = bfloat16(0.0f);
+    SynapseStore::storeWeight(record, weight);
+    m_store->setDelay(m_index, 0); // Por el store: cambia getDelayVersion() y el CSR se rehace
 }
 
 void Connection::cleanup() {
     // Limpiar referencias débiles
     m_source_neuron.reset();
     m_destination_neuron.reset();
-    if (m_use_float16) {
-        m_weight_float16 = float16(0.0);
-    } else {
-        m_weight_double = 0.0;
-    }
-    m_is_plastic = false;
-    m_learning_rate = 0.0;
+    reset(nullptr, nullptr, 0.0);
+}
+
+void Connection::rebind(std::shared_ptr<SynapseStore> store, uint32_t index) {
+    m_store = std::move(store);
+    m_index = index;
 }
 
 } // namespace brainll
@@ -17,21 +17,60 @@
 
 #include "../../include/DynamicNetwork.hpp"
 #include "../../include/DebugConfig.hpp"
+#include "../../include/WeightFile.hpp"
+#include "../../include/CounterRNG.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <stdexcept>
 #include <random>
+#include <cmath>
+#include <limits>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
 namespace brainll {
 
-DynamicNetwork::DynamicNetwork() : m_neuron_counter(0) {}
+namespace {
+    /**
+     * Llama a visit(j) para cada j en [0, count) aceptado con probabilidad p, de forma
+     * independiente. Para p pequeñas salta entre aceptados con huecos geométricos, así
+     * que el coste es proporcional a las conexiones creadas y no a los pares candidatos.
+     */
+    template <typename Visit>
+    void forEachSampledTarget(CounterRNG& rng, size_t count, double p, Visit&& visit) {
+        if (p <= 0.0 || count == 0) return;
+        if (p >= 1.0) {
+            for (size_t j = 0; j < count; ++j) visit(j);
+            return;
+        }
+        // Con p alta casi todo se acepta y un sorteo por par es más barato que un logaritmo
+        if (p >= 0.5) {
+            for (size_t j = 0; j < count; ++j) {
+                if (rng.nextDouble() < p) visit(j);
+            }
+            return;
+        }
+        const double log_one_minus_p = std::log1p(-p);
+        uint64_t j = rng.nextGeometric(log_one_minus_p);
+        while (j < count) {
+            visit(static_cast<size_t>(j));
+            const uint64_t skip = rng.nextGeometric(log_one_minus_p);
+            if (skip >= count - j) break;
+            j += skip + 1;
+        }
+    }
+}
+
+DynamicNetwork::DynamicNetwork()
+    : m_neuron_store(std::make_shared<NeuronStore>()), m_neuron_counter(0),
+      m_synapse_store(std::make_shared<SynapseStore>()) {}
 
-DynamicNetwork::DynamicNetwork(const NetworkConfig& config) : m_neuron_counter(0), m_config(config) {
+DynamicNetwork::DynamicNetwork(const NetworkConfig& config)
+    : m_neuron_store(std::make_shared<NeuronStore>()), m_neuron_counter(0), m_config(config),
+      m_synapse_store(std::make_shared<SynapseStore>()) {
     auto& debug = DebugConfig::getInstance();
     debug.logDebug("DynamicNetwork initialized with config: sparse=" + 
                    std::to_string(config.use_sparse_matrices) + 
@@ -65,12 +104,21 @@ std::shared_ptr<Neuron> DynamicNetwork::createNeuron(const std::string& type, co
     const NeuronTypeParams& params = it->second;
     std::string id = type + "_" + std::to_string(m_neuron_counter++);
     
-    auto neuron = std::make_shared<Neuron>(id, type, params);
+    // El estado vive en el store SoA; el objeto Neuron es solo una vista por handle
+    NeuronHandle handle = m_neuron_store->add(parseNeuronModelKind(params.model), params.threshold,
+                                              params.reset_potential, params.a, params.b, params.d,
+                                              params.reset_potential);
+    auto neuron = std::make_shared<Neuron>(id, type, m_neuron_store, handle);
     
     // BUG CRÍTICO CORREGIDO: Operación atómica.
+    m_neuron_views.push_back(neuron);
+    m_outgoing.emplace_back();
+    m_incoming.emplace_back();
+    m_handle_by_id[id] = handle;
     m_neurons[id] = neuron;
     m_neuron_ids_by_type[type].push_back(id);
     m_neurons_by_population[population_name].push_back(id); // Registrar en población inmediatamente.
+    m_io_handles_dirty = true;
     
     auto& debug = DebugConfig::getInstance();
     debug.logDebug("Created neuron " + id + " of type " + type + " in population " + population_name);
@@ -102,6 +150,7 @@ void DynamicNetwork::nameNeuron(const std::string& old_id, const std::string& ne
         }
         m_name_to_id[new_name] = old_id;
         m_neurons[old_id]->setName(new_name);
+        m_io_handles_dirty = true;
     } else {
         std::cerr << "Warning: Neuron with ID '" << old_id << "' not found to be named." << std::endl;
     }
@@ -117,17 +166,37 @@ void DynamicNetwork::nameNeuron(const std::string& type, int index, const std::s
 }
 
 std::shared_ptr<Neuron> DynamicNetwork::getNeuron(const std::string& id_or_name) {
+    NeuronHandle handle = getNeuronHandle(id_or_name);
+    return handle != INVALID_NEURON_HANDLE ? m_neuron_views[handle] : nullptr;
+}
+
+std::shared_ptr<Neuron> DynamicNetwork::getNeuron(NeuronHandle handle) const {
+    return handle < m_neuron_views.size() ? m_neuron_views[handle] : nullptr;
+}
+
+NeuronHandle DynamicNetwork::getNeuronHandle(const std::string& id_or_name) const {
     // Primero, buscar por ID
-    auto it_id = m_neurons.find(id_or_name);
-    if (it_id != m_neurons.end()) {
+    auto it_id = m_handle_by_id.find(id_or_name);
+    if (it_id != m_handle_by_id.end()) {
         return it_id->second;
     }
     // Si no, buscar por nombre
     auto it_name = m_name_to_id.find(id_or_name);
     if (it_name != m_name_to_id.end()) {
-        return m_neurons.at(it_name->second);
+        auto it = m_handle_by_id.find(it_name->second);
+        if (it != m_handle_by_id.end()) {
+            return it->second;
+        }
     }
-    return nullptr; // No encontrado
+    return INVALID_NEURON_HANDLE; // No encontrado
+}
+
+NeuronStore& DynamicNetwork::getNeuronStore() {
+    return *m_neuron_store;
+}
+
+const NeuronStore& DynamicNetwork::getNeuronStore() const {
+    return *m_neuron_store;
 }
 
 void DynamicNetwork::createConnection(const std::string& source_id, const std::string& dest_id, double weight, bool is_plastic, double learning_rate) {
@@ -140,20 +209,14 @@ void DynamicNetwork::createConnection(const std::string& source_id, const std::s
     auto dest_neuron = getNeuron(dest_id);
 
     if (source_neuron && dest_neuron) {
-        // Use connection pool for efficient memory management
-        auto connection = m_connection_pool.acquire();
-        connection->reset(source_neuron, dest_neuron, weight);
-        connection->setUseFloat16(m_config.use_float16);
-        
-        if (is_plastic) {
-            connection->enablePlasticity(learning_rate);
-        }
+        auto connection = addSynapse(source_neuron, dest_neuron, weight, is_plastic, learning_rate);
         
         // Reserve space to avoid reallocations
         if (m_connections.size() == m_connections.capacity()) {
             m_connections.reserve(m_connections.size() * 1.5);
         }
         m_connections.push_back(std::move(connection));
+        m_csr_dirty = true;
     } else {
         if (!source_neuron) std::cerr << "Warning: Source neuron '" << source_id << "' not found for connection." << std::endl;
         if (!dest_neuron) std::cerr << "Warning: Destination neuron '" << dest_id << "' not found for connection." << std::endl;
@@ -178,214 +241,303 @@ void DynamicNetwork::connectByType(const std::string& source_type, const std::st
     }
 }
 
-void DynamicNetwork::connectPopulations(const std::string& source_pop, const std::string& target_pop, double weight, bool is_plastic, double learning_rate) {
-    const auto& source_ids = getNeuronIdsForPopulation(source_pop);
-    const auto& target_ids = getNeuronIdsForPopulation(target_pop);
+std::vector<NeuronHandle> DynamicNetwork::resolvePopulationHandles(const std::string& pop_name, const char* role) const {
+    const auto& ids = getNeuronIdsForPopulation(pop_name);
+    std::vector<NeuronHandle> handles;
+    handles.reserve(ids.size());
+    for (const auto& id : ids) {
+        NeuronHandle handle = getNeuronHandle(id);
+        if (handle != INVALID_NEURON_HANDLE) {
+            handles.push_back(handle);
+        } else {
+            std::cerr << "[Error] " << role << " neuron with ID '" << id << "' not found in population '" << pop_name << "'" << std::endl;
+        }
+    }
+    return handles;
+}
 
-    if (source_ids.empty()) {
+void DynamicNetwork::appendSynapses(const std::vector<HandlePairBuffer>& buffers, double weight, bool is_plastic, double learning_rate) {
+    std::vector<size_t> offsets(buffers.size() + 1, 0);
+    for (size_t b = 0; b < buffers.size(); ++b) {
+        offsets[b + 1] = offsets[b] + buffers[b].size();
+    }
+    const size_t total = offsets.back();
+    const size_t base = m_synapse_store->size();
+    if (base + total >= std::numeric_limits<SynapseIndex>::max()) {
+        throw std::runtime_error("SynapseStore capacity exceeded");
+    }
+
+    // Un solo redimensionado; cada buffer escribe su tramo sin coordinarse con los demás
+    auto& records = m_synapse_store->getRecords();
+    const size_t connection_base = m_connections.size();
+    records.resize(base + total);
+    m_synapse_views.resize(base + total);
+    m_connections.resize(connection_base + total);
+
+    const bfloat16 rate(learning_rate);
+    const bool use_float16 = m_config.use_float16;
+    #pragma omp parallel for schedule(dynamic)
+    for (long long b = 0; b < static_cast<long long>(buffers.size()); ++b) {
+        const auto& buffer = buffers[static_cast<size_t>(b)];
+        const size_t offset = offsets[static_cast<size_t>(b)];
+        for (size_t k = 0; k < buffer.size(); ++k) {
+            const SynapseIndex index = static_cast<SynapseIndex>(base + offset + k);
+            SynapseRecord& record = records[index];
+            record = SynapseStore::makeRecord(buffer[k].first, buffer[k].second, weight, use_float16);
+            if (is_plastic) {
+                record.flags |= SYNAPSE_PLASTIC;
+                record.learning_rate = rate;
+            }
+            auto connection = std::make_shared<Connection>(m_synapse_store, index,
+                                                           m_neuron_views[buffer[k].first],
+                                                           m_neuron_views[buffer[k].second]);
+            m_synapse_views[index] = connection;
+            m_connections[connection_base + offset + k] = std::move(connection);
+        }
+    }
+
+    for (size_t i = base; i < base + total; ++i) {
+        m_outgoing[records[i].source].push_back(static_cast<SynapseIndex>(i));
+        m_incoming[records[i].target].push_back(static_cast<SynapseIndex>(i));
+    }
+    m_csr_dirty = true;
+}
+
+void DynamicNetwork::connectPopulations(const std::string& source_pop, const std::string& target_pop, double weight, bool is_plastic, double learning_rate) {
+    if (getNeuronIdsForPopulation(source_pop).empty()) {
         std::cerr << "[Warning] Source population '" << source_pop << "' not found or is empty." << std::endl;
         return;
     }
-    if (target_ids.empty()) {
+    if (getNeuronIdsForPopulation(target_pop).empty()) {
         std::cerr << "[Warning] Target population '" << target_pop << "' not found or is empty." << std::endl;
         return;
     }
 
-    // Calculate total connections with SIMD-optimized batch processing
-    size_t total_connections = 0;
-    const size_t source_size = source_ids.size();
-    const size_t target_size = target_ids.size();
-    
-    // Use SIMD for counting (if arrays are large enough)
-    if (source_size >= 8 && target_size >= 8) {
-        // SIMD-optimized counting would go here
-        total_connections = source_size * target_size;
-    } else {
-        total_connections = source_size * target_size;
-    }
-    
-    // Reserve space efficiently
-    m_connections.reserve(m_connections.size() + total_connections);
-    
-    // Use batch connection creation with memory pool
-    std::vector<std::shared_ptr<Connection>> new_connections;
-    new_connections.reserve(total_connections);
-    
-    // Cache neuron lookups for better performance
-    std::unordered_map<std::string, std::shared_ptr<Neuron>> neuron_cache;
-    
-    // Batch process connections
+    const std::vector<NeuronHandle> sources = resolvePopulationHandles(source_pop, "Source");
+    const std::vector<NeuronHandle> targets = resolvePopulationHandles(target_pop, "Target");
+
+    // Bloques contiguos de filas por hilo (schedule static): concatenar los buffers en
+    // orden de hilo reproduce el orden fila a fila con cualquier número de hilos
+#ifdef _OPENMP
+    std::vector<HandlePairBuffer> buffers(static_cast<size_t>(omp_get_max_threads()));
+#else
+    std::vector<HandlePairBuffer> buffers(1);
+#endif
     #pragma omp parallel
     {
-        std::vector<std::shared_ptr<Connection>> local_connections;
-        
-        #pragma omp for collapse(2) schedule(dynamic)
-        for (int i = 0; i < static_cast<int>(source_ids.size()); ++i) {
-            for (int j = 0; j < static_cast<int>(target_ids.size()); ++j) {
-                if (source_ids[i] != target_ids[j]) {
-                    // Validar que las neuronas existan antes de crear la conexión
-                    auto source_neuron = getNeuron(source_ids[i]);
-                    auto target_neuron = getNeuron(target_ids[j]);
-                    
-                    if (source_neuron && target_neuron) {
-                        // Crear conexión en thread local solo si ambas neuronas existen
-                        auto connection = m_connection_pool.acquire();
-                        connection->reset(source_neuron, target_neuron, weight);
-                        if (is_plastic) {
-                            connection->enablePlasticity(learning_rate);
-                        }
-                        local_connections.push_back(connection);
-                    } else {
-                        // Log de error para debugging
-                        #pragma omp critical
-                        {
-                            if (!source_neuron) {
-                                std::cerr << "[Error] Source neuron with ID '" << source_ids[i] << "' not found in population '" << source_pop << "'" << std::endl;
-                            }
-                            if (!target_neuron) {
-                                std::cerr << "[Error] Target neuron with ID '" << target_ids[j] << "' not found in population '" << target_pop << "'" << std::endl;
-                            }
-                        }
-                    }
+#ifdef _OPENMP
+        HandlePairBuffer& local_pairs = buffers[static_cast<size_t>(omp_get_thread_num())];
+#else
+        HandlePairBuffer& local_pairs = buffers[0];
+#endif
+        #pragma omp for schedule(static)
+        for (long long i = 0; i < static_cast<long long>(sources.size()); ++i) {
+            const NeuronHandle source = sources[static_cast<size_t>(i)];
+            for (NeuronHandle target : targets) {
+                if (source != target) {
+                    local_pairs.emplace_back(source, target);
                 }
             }
         }
-        
-        // Combinar resultados thread-safe
-        #pragma omp critical
-        {
-            new_connections.insert(new_connections.end(), 
-                                 local_connections.begin(), 
-                                 local_connections.end());
-        }
     }
-    
-    // Añadir todas las conexiones al vector principal
-    m_connections.insert(m_connections.end(), new_connections.begin(), new_connections.end());
+
+    appendSynapses(buffers, weight, is_plastic, learning_rate);
 }
 
 void DynamicNetwork::connectPopulationsRandom(const std::string& source_pop, const std::string& target_pop, double weight, double connection_probability, bool is_plastic, double learning_rate) {
-    const auto& source_ids = getNeuronIdsForPopulation(source_pop);
-    const auto& target_ids = getNeuronIdsForPopulation(target_pop);
-
-    if (source_ids.empty()) {
+    if (getNeuronIdsForPopulation(source_pop).empty()) {
         std::cerr << "[Warning] Source population '" << source_pop << "' not found or is empty." << std::endl;
         return;
     }
-    if (target_ids.empty()) {
+    if (getNeuronIdsForPopulation(target_pop).empty()) {
         std::cerr << "[Warning] Target population '" << target_pop << "' not found or is empty." << std::endl;
         return;
     }
 
-    // Configurar generador de números aleatorios
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis(0.0, 1.0);
+    const std::vector<NeuronHandle> sources = resolvePopulationHandles(source_pop, "Source");
+    const std::vector<NeuronHandle> targets = resolvePopulationHandles(target_pop, "Target");
 
-    // Estimar número de conexiones para reservar memoria
-    size_t estimated_connections = static_cast<size_t>(source_ids.size() * target_ids.size() * connection_probability);
-    m_connections.reserve(m_connections.size() + estimated_connections);
-    
-    // Crear vector temporal para conexiones thread-safe
-    std::vector<std::shared_ptr<Connection>> new_connections;
-    new_connections.reserve(estimated_connections);
-    
-    // Paralelizar la creación de conexiones aleatorias
+    // Cada fila usa su propio stream (seed de la red, nº de llamada, fila): la topología
+    // es reproducible desde random_seed y no depende del número de hilos
+    const uint64_t call_seed = CounterRNG::mix(m_config.random_seed ^ CounterRNG::mix(++m_connect_calls));
+
+#ifdef _OPENMP
+    std::vector<HandlePairBuffer> buffers(static_cast<size_t>(omp_get_max_threads()));
+#else
+    std::vector<HandlePairBuffer> buffers(1);
+#endif
     #pragma omp parallel
     {
-        std::vector<std::shared_ptr<Connection>> local_connections;
-        
-        // Cada thread necesita su propio generador de números aleatorios
-        std::random_device local_rd;
-        std::mt19937 local_gen(local_rd());
-        std::uniform_real_distribution<> local_dis(0.0, 1.0);
-        
-        #pragma omp for collapse(2) schedule(dynamic)
-        for (int i = 0; i < static_cast<int>(source_ids.size()); ++i) {
-            for (int j = 0; j < static_cast<int>(target_ids.size()); ++j) {
-                if (source_ids[i] != target_ids[j] && local_dis(local_gen) < connection_probability) {
-                    // Validar que las neuronas existan antes de crear la conexión
-                    auto source_neuron = getNeuron(source_ids[i]);
-                    auto target_neuron = getNeuron(target_ids[j]);
-                    
-                    if (source_neuron && target_neuron) {
-                        // Crear conexión en thread local solo si ambas neuronas existen
-                        auto connection = std::make_shared<Connection>(
-                            source_neuron, 
-                            target_neuron, 
-                            weight
-                        );
-                        if (is_plastic) {
-                            connection->enablePlasticity(learning_rate);
-                        }
-                        local_connections.push_back(connection);
-                    } else {
-                        // Log de error para debugging
-                        #pragma omp critical
-                        {
-                            if (!source_neuron) {
-                                std::cerr << "[Error] Source neuron with ID '" << source_ids[i] << "' not found in population '" << source_pop << "'" << std::endl;
-                            }
-                            if (!target_neuron) {
-                                std::cerr << "[Error] Target neuron with ID '" << target_ids[j] << "' not found in population '" << target_pop << "'" << std::endl;
-                            }
-                        }
-                    }
+#ifdef _OPENMP
+        HandlePairBuffer& local_pairs = buffers[static_cast<size_t>(omp_get_thread_num())];
+#else
+        HandlePairBuffer& local_pairs = buffers[0];
+#endif
+        local_pairs.reserve(static_cast<size_t>(sources.size() * targets.size() * connection_probability / buffers.size()));
+
+        #pragma omp for schedule(static)
+        for (long long i = 0; i < static_cast<long long>(sources.size()); ++i) {
+            const NeuronHandle source = sources[static_cast<size_t>(i)];
+            CounterRNG rng(call_seed, static_cast<uint64_t>(i));
+            forEachSampledTarget(rng, targets.size(), connection_probability, [&](size_t j) {
+                if (source != targets[j]) {
+                    local_pairs.emplace_back(source, targets[j]);
                 }
-            }
-        }
-        
-        // Combinar resultados thread-safe
-        #pragma omp critical
-        {
-            new_connections.insert(new_connections.end(), 
-                                 local_connections.begin(), 
-                                 local_connections.end());
+            });
         }
     }
-    
-    // Añadir todas las conexiones al vector principal
-    m_connections.insert(m_connections.end(), new_connections.begin(), new_connections.end());
+
+    appendSynapses(buffers, weight, is_plastic, learning_rate);
 }
 
 // --- Simulación ---
 
 void DynamicNetwork::reset() {
-    for (auto const& [id, neuron] : m_neurons) {
-        neuron->reset();
+    m_neuron_store->resetAll();
+    m_delay_buffer.clear();
+}
+
+void DynamicNetwork::syncDelayBuffer() {
+    // Un setDelay() deja desactualizadas las latencias copiadas en la matriz CSR
+    const uint64_t version = m_synapse_store->getDelayVersion();
+    if (version != m_delay_version) {
+        m_delay_version = version;
+        m_csr_dirty = true;
+    }
+    // Un Connection::setWeight() o enablePlasticity() desde fuera deja desactualizada la
+    // copia de pesos del CSR; la topología sigue valiendo y basta con volver a copiarlos
+    const uint64_t weight_version = m_synapse_store->getWeightVersion();
+    if (weight_version != m_weight_version) {
+        m_weight_version = weight_version;
+        if (m_csr_matrix && !m_csr_dirty) {
+            m_csr_matrix->refreshWeights();
+        }
     }
+    const size_t depth = SynapticDelayBuffer::latencyOf(m_synapse_store->getMaxDelay());
+    m_delay_buffer.configure(depth > 1 ? m_neuron_store->size() : 0, depth);
+}
+
+size_t DynamicNetwork::getMaxSynapticLatency() const {
+    return SynapticDelayBuffer::latencyOf(m_synapse_store->getMaxDelay());
 }
 
 void DynamicNetwork::update() {
+    syncDelayBuffer();
+    if (m_config.num_threads > 1) {
+        updateParallel();
+        return;
+    }
+
     // --- Corrected Simulation Cycle ---
 
-    // 1. Propagate signals from neurons that fired in the PREVIOUS cycle.
-    if (m_config.use_sparse_matrices) {
-        updateSparseConnections();
-    } else {
-        for (auto& conn : m_connections) {
-            conn->propagate();
+    // 1. Propagate signals from neurons that fired in the PREVIOUS cycle. Synapses with
+    //    latency > 1 are queued in the delay buffer, and the row due now is added on top.
+    SynapticDelayBuffer* delayed = m_delay_buffer.active() ? &m_delay_buffer : nullptr;
+    if (m_config.use_csr_propagation) {
+        if (m_csr_dirty || !m_csr_matrix) {
+            compileCSR();
         }
+        m_csr_matrix->propagateFiredRows(m_neuron_store->getFiredWords(), m_neuron_store->inputs(), delayed);
+    } else {
+        // Both vector and sparse modes hold views over the same compact synapse records
+        m_synapse_store->propagate(m_neuron_store->getFiredWords(), m_neuron_store->inputs(), delayed);
     }
+    m_delay_buffer.deliver(m_neuron_store->inputs());
+    m_delay_buffer.advance();
 
-    // 2. Clear "fired" flags so they represent only the current cycle afterwards.
-    for (auto& pair : m_neurons) {
-        pair.second->resetFiredFlag();
+    // 2-3. Update all neurons in the SoA store: integrate inputs and rebuild the
+    //      fired bitset so it represents only who fires THIS cycle.
+    m_neuron_store->step();
+
+    // 4. Apply Hebbian plasticity using the activity of THIS cycle.
+    if (m_config.use_csr_propagation) {
+        m_csr_matrix->applyHebbianFiredRows(m_neuron_store->getFiredWords());
+    } else {
+        m_synapse_store->applyHebbian(m_neuron_store->getFiredWords());
     }
+}
 
-    // 3. Update all neurons: integrate inputs and determine who fires THIS cycle.
-    for (auto& pair : m_neurons) {
-        pair.second->update();
+void DynamicNetwork::updateParallel() {
+    const bool use_csr = m_config.use_csr_propagation;
+    if (use_csr && (m_csr_dirty || !m_csr_matrix)) {
+        compileCSR();
     }
 
-    // 4. Apply Hebbian plasticity using the activity of THIS cycle.
-    if (m_config.use_sparse_matrices) {
-        // Plasticity is already applied in updateSparseConnections()
-    } else {
-        for (auto& conn : m_connections) {
-            conn->applyPlasticity();
+    // 1. The record list is not target-sorted, so outside CSR mode propagation stays serial.
+    SynapticDelayBuffer* delayed = m_delay_buffer.active() ? &m_delay_buffer : nullptr;
+    if (!use_csr) {
+        m_synapse_store->propagate(m_neuron_store->getFiredWords(), m_neuron_store->inputs(), delayed);
+    }
+
+    NeuronStore& store = *m_neuron_store;
+    SparseConnectionMatrix* csr = use_csr ? m_csr_matrix.get() : nullptr;
+    const std::vector<uint64_t>& fired = store.getFiredWords();
+    double* inputs = store.inputs();
+    const size_t num_neurons = store.size();
+    const size_t words = store.getFiredWordCount();
+
+    // Each thread owns a contiguous range of 64-neuron words: it accumulates input only
+    // for targets in that range, integrates those neurons and applies plasticity for
+    // sources in that range. No two threads write the same element, so no atomics.
+    #pragma omp parallel num_threads(m_config.num_threads)
+    {
+#ifdef _OPENMP
+        const size_t tid = static_cast<size_t>(omp_get_thread_num());
+        const size_t nt = static_cast<size_t>(omp_get_num_threads());
+#else
+        const size_t tid = 0;
+        const size_t nt = 1;
+#endif
+        const size_t first_word = words * tid / nt;
+        const size_t last_word = words * (tid + 1) / nt;
+
+        // 1. Propagate spikes of the PREVIOUS cycle into this thread's targets, then add
+        //    the delayed input due now for the same range.
+        const size_t first_neuron = std::min(first_word * 64, num_neurons);
+        const size_t last_neuron = std::min(last_word * 64, num_neurons);
+        if (csr) {
+            csr->propagateFiredRows(fired, inputs, first_neuron, last_neuron, delayed);
+        }
+        if (delayed) {
+            delayed->deliver(inputs, first_neuron, last_neuron);
+        }
+        #pragma omp barrier
+
+        // 2-3. Integrate this thread's neurons and rebuild their fired words.
+        store.stepWords(first_word, last_word);
+        #pragma omp barrier
+
+        // 4. Hebbian plasticity for synapses whose source lives in this range.
+        if (csr) {
+            csr->applyHebbianFiredRows(fired, first_word, last_word);
         }
     }
+
+    if (!use_csr) {
+        m_synapse_store->applyHebbian(fired);
+    }
+    m_delay_buffer.advance();
+}
+
+void DynamicNetwork::setRandomSeed(uint64_t seed) {
+    m_config.random_seed = seed;
+    m_connect_calls = 0;
+}
+
+uint64_t DynamicNetwork::getRandomSeed() const {
+    return m_config.random_seed;
+}
+
+const NetworkConfig& DynamicNetwork::getNetworkConfig() const {
+    return m_config;
+}
+
+void DynamicNetwork::setThreadCount(int num_threads) {
+    m_config.num_threads = std::max(1, num_threads);
+}
+
+int DynamicNetwork::getThreadCount() const {
+    return m_config.num_threads;
 }
 
 // --- Consulta de la Red ---
@@ -408,14 +560,65 @@ const std::vector<std::string>& DynamicNetwork::getNeuronIdsForPopulation(const
 
 std::vector<std::shared_ptr<Connection>> DynamicNetwork::getConnectionsForNeuron(const std::string& neuron_id) {
     std::vector<std::shared_ptr<Connection>> result;
-    for (const auto& conn : m_connections) {
-        if (conn->getSourceNeuron()->getId() == neuron_id || conn->getDestinationNeuron()->getId() == neuron_id) {
-            result.push_back(conn);
+    auto it = m_handle_by_id.find(neuron_id);
+    if (it == m_handle_by_id.end()) {
+        return result;
+    }
+
+    // Mezcla de salientes y entrantes en orden de creación; un autolazo aparece una sola vez
+    const auto& outgoing = m_outgoing[it->second];
+    const auto& incoming = m_incoming[it->second];
+    result.reserve(outgoing.size() + incoming.size());
+    size_t o = 0, i = 0;
+    while (o < outgoing.size() || i < incoming.size()) {
+        SynapseIndex next;
+        if (i == incoming.size() || (o < outgoing.size() && outgoing[o] <= incoming[i])) {
+            next = outgoing[o++];
+            if (i < incoming.size() && incoming[i] == next) ++i;
+        } else {
+            next = incoming[i++];
+        }
+        result.push_back(m_synapse_views[next]);
+    }
+    return result;
+}
+
+std::vector<std::shared_ptr<Connection>> DynamicNetwork::getOutgoingConnections(NeuronHandle handle) const {
+    std::vector<std::shared_ptr<Connection>> result;
+    if (handle < m_outgoing.size()) {
+        result.reserve(m_outgoing[handle].size());
+        for (SynapseIndex index : m_outgoing[handle]) {
+            result.push_back(m_synapse_views[index]);
+        }
+    }
+    return result;
+}
+
+std::vector<std::shared_ptr<Connection>> DynamicNetwork::getIncomingConnections(NeuronHandle handle) const {
+    std::vector<std::shared_ptr<Connection>> result;
+    if (handle < m_incoming.size()) {
+        result.reserve(m_incoming[handle].size());
+        for (SynapseIndex index : m_incoming[handle]) {
+            result.push_back(m_synapse_views[index]);
         }
     }
     return result;
 }
 
+std::shared_ptr<Connection> DynamicNetwork::getConnection(const std::string& source_id, const std::string& dest_id) const {
+    const NeuronHandle source = getNeuronHandle(source_id);
+    const NeuronHandle dest = getNeuronHandle(dest_id);
+    if (source == INVALID_NEURON_HANDLE || dest == INVALID_NEURON_HANDLE) {
+        return nullptr;
+    }
+    for (SynapseIndex index : m_outgoing[source]) {
+        if ((*m_synapse_store)[index].target == dest) {
+            return m_synapse_views[index];
+        }
+    }
+    return nullptr;
+}
+
 std::shared_ptr<Neuron> DynamicNetwork::getMostActiveNeuron(const std::string& type_prefix) const {
     std::shared_ptr<Neuron> most_active_neuron = nullptr;
     double max_potential = -1.0; // Usar un valor muy bajo para la comparación inicial
@@ -435,7 +638,31 @@ std::shared_ptr<Neuron> DynamicNetwork::getMostActiveNeuron(const std::string& t
 
 // --- Persistencia ---
 
-bool DynamicNetwork::saveWeights(const std::string& filepath) const {
+bool DynamicNetwork::saveWeights(const std::string& filepath, WeightFileFormat format) const {
+    if (format == WeightFileFormat::AUTO) {
+        const bool csv = filepath.size() >= 4 && filepath.compare(filepath.size() - 4, 4, ".csv") == 0;
+        format = csv ? WeightFileFormat::CSV : WeightFileFormat::BINARY;
+    }
+    return format == WeightFileFormat::CSV ? saveWeightsCSV(filepath) : saveWeightsBinary(filepath);
+}
+
+bool DynamicNetwork::loadWeights(const std::string& filepath) {
+    return isWeightFile(filepath) ? loadWeightsBinary(filepath) : loadWeightsCSV(filepath);
+}
+
+std::unordered_map<uint64_t, SynapseIndex> DynamicNetwork::buildSynapsePairIndex() const {
+    // (fuente, destino) -> primer registro con ese par, igual que la búsqueda lineal anterior
+    const auto& records = m_synapse_store->getRecords();
+    std::unordered_map<uint64_t, SynapseIndex> index;
+    index.reserve(records.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+        const uint64_t key = (static_cast<uint64_t>(records[i].source) << 32) | records[i].target;
+        index.emplace(key, static_cast<SynapseIndex>(i));
+    }
+    return index;
+}
+
+bool DynamicNetwork::saveWeightsCSV(const std::string& filepath) const {
     std::ofstream outfile(filepath);
     if (!outfile.is_open()) {
         std::cerr << "Error: Could not open file for writing: " << filepath << std::endl;
@@ -443,10 +670,10 @@ bool DynamicNetwork::saveWeights(const std::string& filepath) const {
     }
 
     outfile << "source_id,dest_id,weight\n";
-    for (const auto& conn : m_connections) {
-        outfile << conn->getSourceNeuron()->getId() << ","
-                << conn->getDestinationNeuron()->getId() << ","
-                << conn->getWeight() << "\n";
+    for (const auto& record : m_synapse_store->getRecords()) {
+        outfile << m_neuron_views[record.source]->getId() << ","
+                << m_neuron_views[record.target]->getId() << ","
+                << record.weight << "\n";
     }
 
     outfile.close();
@@ -454,13 +681,14 @@ bool DynamicNetwork::saveWeights(const std::string& filepath) const {
     return true;
 }
 
-bool DynamicNetwork::loadWeights(const std::string& filepath) {
+bool DynamicNetwork::loadWeightsCSV(const std::string& filepath) {
     std::ifstream infile(filepath);
     if (!infile.is_open()) {
         std::cerr << "Error: Could not open file for reading: " << filepath << std::endl;
         return false;
     }
 
+    const auto pair_index = buildSynapsePairIndex();
     std::string line;
     std::getline(infile, line); // Skip header
 
@@ -474,15 +702,15 @@ bool DynamicNetwork::loadWeights(const std::string& filepath) {
 
         try {
             double weight = std::stod(weight_str);
-            bool found = false;
-            for (auto& conn : m_connections) {
-                if (conn->getSourceNeuron()->getId() == source_id && conn->getDestinationNeuron()->getId() == dest_id) {
-                    conn->setWeight(weight);
-                    found = true;
-                    break;
-                }
+            auto it = pair_index.end();
+            auto source_it = m_handle_by_id.find(source_id);
+            auto dest_it = m_handle_by_id.find(dest_id);
+            if (source_it != m_handle_by_id.end() && dest_it != m_handle_by_id.end()) {
+                it = pair_index.find((static_cast<uint64_t>(source_it->second) << 32) | dest_it->second);
             }
-            if (!found) {
+            if (it != pair_index.end()) {
+                SynapseStore::storeWeight((*m_synapse_store)[it->second], weight);
+            } else {
                 std::cerr << "Warning: Connection not found for " << source_id << " -> " << dest_id << std::endl;
             }
         } catch (const std::invalid_argument& ia) {
@@ -493,6 +721,98 @@ bool DynamicNetwork::loadWeights(const std::string& filepath) {
     }
 
     infile.close();
+    m_csr_dirty = true;
+    std::cout << "[C++] Network weights loaded from " << filepath << std::endl;
+    return true;
+}
+
+bool DynamicNetwork::saveWeightsBinary(const std::string& filepath) const {
+    std::vector<std::string> neuron_ids;
+    neuron_ids.reserve(m_neuron_views.size());
+    for (const auto& neuron : m_neuron_views) {
+        neuron_ids.push_back(neuron->getId());
+    }
+
+    std::string error;
+    if (!writeWeightFile(filepath, neuron_ids, m_synapse_store->getRecords(), m_config.use_float16, error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return false;
+    }
+    std::cout << "[C++] Network weights saved to " << filepath << std::endl;
+    return true;
+}
+
+bool DynamicNetwork::loadWeightsBinary(const std::string& filepath) {
+    MappedWeightFile file;
+    if (!file.open(filepath)) {
+        std::cerr << "Error: " << file.getError() << std::endl;
+        return false;
+    }
+
+    // Tabla de IDs del archivo -> handles de esta red. Si la red se construyó igual
+    // que la guardada, los handles coinciden y no hace falta tocar ningún hash.
+    const size_t neuron_count = file.getNeuronCount();
+    std::vector<NeuronHandle> remap(neuron_count, INVALID_NEURON_HANDLE);
+    for (size_t i = 0; i < neuron_count; ++i) {
+        const std::string_view id = file.getNeuronId(i);
+        if (i < m_neuron_views.size() && m_neuron_views[i]->getId() == id) {
+            remap[i] = static_cast<NeuronHandle>(i);
+        } else {
+            auto it = m_handle_by_id.find(std::string(id));
+            if (it != m_handle_by_id.end()) {
+                remap[i] = it->second;
+            }
+        }
+    }
+
+    // Una sola pasada: el registro i suele ser la sinapsis i del archivo; si no, se
+    // construye (una vez) el índice por par (fuente, destino).
+    auto& records = m_synapse_store->getRecords();
+    const uint32_t* sources = file.getSources();
+    const uint32_t* targets = file.getTargets();
+    const size_t synapse_count = file.getSynapseCount();
+    std::unordered_map<uint64_t, SynapseIndex> pair_index;
+    bool pair_index_built = false;
+    size_t missing = 0;
+
+    for (size_t i = 0; i < synapse_count; ++i) {
+        if (sources[i] >= neuron_count || targets[i] >= neuron_count) {
+            ++missing;
+            continue;
+        }
+        const NeuronHandle source = remap[sources[i]];
+        const NeuronHandle target = remap[targets[i]];
+        if (source == INVALID_NEURON_HANDLE || target == INVALID_NEURON_HANDLE) {
+            ++missing;
+            continue;
+        }
+
+        SynapseRecord* record = nullptr;
+        if (i < records.size() && records[i].source == source && records[i].target == target) {
+            record = &records[i];
+        } else {
+            if (!pair_index_built) {
+                pair_index = buildSynapsePairIndex();
+                pair_index_built = true;
+            }
+            auto it = pair_index.find((static_cast<uint64_t>(source) << 32) | target);
+            if (it != pair_index.end()) {
+                record = &records[it->second];
+            }
+        }
+
+        if (record) {
+            SynapseStore::storeWeight(*record, file.getWeight(i));
+        } else {
+            ++missing;
+        }
+    }
+
+    if (missing > 0) {
+        std::cerr << "Warning: " << missing << " connections in " << filepath
+                  << " were not found in the network" << std::endl;
+    }
+    m_csr_dirty = true;
     std::cout << "[C++] Network weights loaded from " << filepath << std::endl;
     return true;
 }
@@ -508,11 +828,16 @@ const std::vector<std::shared_ptr<Connection>>& DynamicNetwork::getConnections()
     return m_connections;
 }
 
+const SynapseStore& DynamicNetwork::getSynapseStore() const {
+    return *m_synapse_store;
+}
+
 size_t DynamicNetwork::getMemoryUsage() const {
     size_t memory = 0;
     
     // Memory for neurons
     memory += m_neurons.size() * sizeof(std::shared_ptr<Neuron>);
+    memory += m_neuron_store->getMemoryUsage();
     
     // Memory for connections
     if (m_config.use_sparse_matrices) {
@@ -521,10 +846,18 @@ size_t DynamicNetwork::getMemoryUsage() const {
         memory += m_connections.size() * sizeof(std::shared_ptr<Connection>);
     }
     
-    // Estimate connection object memory
-    size_t connection_size = m_config.use_float16 ? 
-        (sizeof(Connection) - sizeof(double) + sizeof(float16)) : sizeof(Connection);
-    memory += getConnectionCount() * connection_size;
+    // Compact synapse records plus the Connection views handed out to the API
+    memory += m_synapse_store->getMemoryUsage();
+    memory += getConnectionCount() * sizeof(Connection);
+    
+    // Adjacency index
+    memory += m_synapse_views.capacity() * sizeof(std::shared_ptr<Connection>);
+    memory += (m_outgoing.capacity() + m_incoming.capacity()) * sizeof(std::vector<SynapseIndex>);
+    memory += 2 * m_synapse_views.size() * sizeof(SynapseIndex);
+    
+    if (m_csr_matrix) {
+        memory += m_csr_matrix->getStats().memory_usage_bytes;
+    }
     
     return memory;
 }
@@ -551,38 +884,44 @@ void DynamicNetwork::connectPopulationsRandomSparse(const std::string& source_po
         return;
     }
 
-    // Configurar generador de números aleatorios
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis(0.0, 1.0);
-
     DebugConfig::getInstance().logDebug("Creating sparse random connections between " + source_pop 
               + " (" + std::to_string(source_ids.size()) + " neurons) and " + target_pop 
               + " (" + std::to_string(target_ids.size()) + " neurons) with probability " + std::to_string(connection_probability));
 
+    // Solo crear conexiones si el peso es significativo
+    if (std::abs(weight) <= m_config.sparsity_threshold) {
+        DebugConfig::getInstance().logDebug("Created 0 sparse connections");
+        return;
+    }
+
+    const uint64_t call_seed = CounterRNG::mix(m_config.random_seed ^ CounterRNG::mix(++m_connect_calls));
     size_t connections_created = 0;
     
-    // Crear conexiones aleatorias dispersas
-    for (const auto& source_id : source_ids) {
-        for (const auto& target_id : target_ids) {
-            if (source_id != target_id && dis(gen) < connection_probability) {
-                // Solo crear conexión si el peso es significativo
-                if (std::abs(weight) > m_config.sparsity_threshold) {
-                    addSparseConnection(source_id, target_id, weight, is_plastic, learning_rate);
-                    connections_created++;
-                }
+    // Crear conexiones aleatorias dispersas, saltando directamente entre pares aceptados
+    for (size_t i = 0; i < source_ids.size(); ++i) {
+        CounterRNG rng(call_seed, static_cast<uint64_t>(i));
+        forEachSampledTarget(rng, target_ids.size(), connection_probability, [&](size_t j) {
+            if (source_ids[i] != target_ids[j]) {
+                addSparseConnection(source_ids[i], target_ids[j], weight, is_plastic, learning_rate);
+                connections_created++;
             }
-        }
+        });
     }
     
     DebugConfig::getInstance().logDebug("Created " + std::to_string(connections_created) + " sparse connections");
 }
 
 void DynamicNetwork::enableSparseMode(bool enable) {
+    m_csr_dirty = true;
     if (enable && !m_config.use_sparse_matrices) {
         DebugConfig::getInstance().logDebug("Converting to sparse matrix representation");
+        const size_t connection_count = m_connections.size();
         convertToSparse();
         m_config.use_sparse_matrices = true;
+        // Las conexiones duplicadas (mismo par) se sustituyen: sus registros quedan huérfanos
+        if (m_sparse_connections.size() < connection_count) {
+            compactSynapses();
+        }
     } else if (!enable && m_config.use_sparse_matrices) {
         DebugConfig::getInstance().logDebug("Converting from sparse matrix representation");
         convertFromSparse();
@@ -632,13 +971,125 @@ void DynamicNetwork::pruneWeakConnections(double threshold) {
         }
         DebugConfig::getInstance().logDebug("Pruned " + std::to_string(pruned) + " weak connections");
     }
+    compactSynapses();
+    m_csr_dirty = true;
 }
 
 void DynamicNetwork::setNetworkConfig(const NetworkConfig& config) {
     m_config = config;
+    m_csr_dirty = true;
     DebugConfig::getInstance().logDebug("Network configuration updated");
 }
 
+void DynamicNetwork::enableCSRPropagation(bool enable) {
+    m_config.use_csr_propagation = enable;
+    if (enable) {
+        compileCSR();
+    } else {
+        m_csr_matrix.reset();
+        m_csr_dirty = true;
+    }
+}
+
+void DynamicNetwork::compileCSR() {
+    // Los índices de la matriz coinciden con los NeuronHandle del store
+    auto matrix = std::make_unique<SparseConnectionMatrix>(m_neuron_views.size());
+    for (const auto& neuron : m_neuron_views) {
+        matrix->addNeuron(neuron->getId());
+    }
+
+    // Índices y peso salen del registro compacto, sin bloquear los weak_ptr de la vista
+    auto add_connection = [&](const std::shared_ptr<Connection>& conn) {
+        const SynapseRecord& record = (*m_synapse_store)[conn->getSynapseIndex()];
+        matrix->addConnectionByIndex(record.source, record.target, record.weight, conn, record.delay);
+    };
+
+    if (m_config.use_sparse_matrices) {
+        for (const auto& [key, conn] : m_sparse_connections) {
+            add_connection(conn);
+        }
+    } else {
+        for (const auto& conn : m_connections) {
+            add_connection(conn);
+        }
+    }
+
+    matrix->finalize();
+    matrix->bindSynapseStore(m_synapse_store.get());
+    m_csr_matrix = std::move(matrix);
+    m_csr_dirty = false;
+    m_delay_version = m_synapse_store->getDelayVersion();
+    m_weight_version = m_synapse_store->getWeightVersion();
+
+    DebugConfig::getInstance().logDebug("Compiled CSR propagation matrix with " +
+                                        std::to_string(m_csr_matrix->getNumConnections()) + " connections");
+}
+
+std::shared_ptr<Connection> DynamicNetwork::addSynapse(const std::shared_ptr<Neuron>& source, const std::shared_ptr<Neuron>& dest, double weight, bool is_plastic, double learning_rate) {
+    SynapseIndex index = m_synapse_store->add(source->getHandle(), dest->getHandle(), weight, m_config.use_float16);
+    auto connection = std::make_shared<Connection>(m_synapse_store, index, source, dest);
+    if (is_plastic) {
+        connection->enablePlasticity(learning_rate);
+    }
+
+    m_synapse_views.push_back(connection);
+    m_outgoing[source->getHandle()].push_back(index);
+    m_incoming[dest->getHandle()].push_back(index);
+    return connection;
+}
+
+void DynamicNetwork::compactSynapses() {
+    // Copia los registros vivos a un store nuevo y reubica sus vistas. Las vistas
+    // eliminadas siguen apuntando al store anterior, que se libera con la última de ellas.
+    auto compacted = std::make_shared<SynapseStore>();
+    compacted->reserve(getConnectionCount());
+
+    auto keep = [&](const std::shared_ptr<Connection>& conn) {
+        SynapseIndex index = static_cast<SynapseIndex>(compacted->size());
+        compacted->getRecords().push_back((*m_synapse_store)[conn->getSynapseIndex()]);
+        conn->rebind(compacted, index);
+    };
+
+    if (m_config.use_sparse_matrices) {
+        for (const auto& [key, conn] : m_sparse_connections) {
+            keep(conn);
+        }
+    } else {
+        for (const auto& conn : m_connections) {
+            keep(conn);
+        }
+    }
+
+    compacted->refreshMaxDelay();
+    m_synapse_store = std::move(compacted);
+    rebuildConnectionIndex();
+}
+
+void DynamicNetwork::rebuildConnectionIndex() {
+    m_synapse_views.assign(m_synapse_store->size(), nullptr);
+    auto index_view = [&](const std::shared_ptr<Connection>& conn) {
+        m_synapse_views[conn->getSynapseIndex()] = conn;
+    };
+    if (m_config.use_sparse_matrices) {
+        for (const auto& [key, conn] : m_sparse_connections) {
+            index_view(conn);
+        }
+    } else {
+        for (const auto& conn : m_connections) {
+            index_view(conn);
+        }
+    }
+
+    for (auto& list : m_outgoing) list.clear();
+    for (auto& list : m_incoming) list.clear();
+    for (size_t i = 0; i < m_synapse_views.size(); ++i) {
+        if (!m_synapse_views[i]) continue;
+        const SynapseRecord& record = (*m_synapse_store)[static_cast<SynapseIndex>(i)];
+        m_outgoing[record.source].push_back(static_cast<SynapseIndex>(i));
+        m_incoming[record.target].push_back(static_cast<SynapseIndex>(i));
+    }
+}
+
 // Helper methods for sparse operations
 void DynamicNetwork::addSparseConnection(const std::string& source_id, const std::string& dest_id, double weight, bool is_plastic, double learning_rate) {
     auto source_neuron = getNeuron(source_id);
@@ -646,11 +1097,17 @@ void DynamicNetwork::addSparseConnection(const std::string& source_id, const std
 
     if (source_neuron && dest_neuron) {
         ConnectionKey key = std::make_pair(source_id, dest_id);
-        auto connection = std::make_shared<Connection>(source_neuron, dest_neuron, weight, m_config.use_float16);
-        if (is_plastic) {
-            connection->enablePlasticity(learning_rate);
+        auto it = m_sparse_connections.find(key);
+        if (it != m_sparse_connections.end()) {
+            // Reutilizar el registro existente para no dejar sinapsis huérfanas en el store
+            it->second->reset(source_neuron, dest_neuron, weight);
+            if (is_plastic) {
+                it->second->enablePlasticity(learning_rate);
+            }
+        } else {
+            m_sparse_connections[key] = addSynapse(source_neuron, dest_neuron, weight, is_plastic, learning_rate);
         }
-        m_sparse_connections[key] = connection;
+        m_csr_dirty = true;
     }
 }
 
@@ -660,14 +1117,6 @@ std::shared_ptr<Connection> DynamicNetwork::getSparseConnection(const std::strin
     return (it != m_sparse_connections.end()) ? it->second : nullptr;
 }
 
-void DynamicNetwork::updateSparseConnections() {
-    // Update sparse connections during simulation
-    for (auto& [key, conn] : m_sparse_connections) {
-        conn->propagate();
-        conn->applyPlasticity();
-    }
-}
-
 void DynamicNetwork::convertToSparse() {
     DebugConfig::getInstance().logDebug("Converting " + std::to_string(m_connections.size()) + " connections to sparse format");
     
@@ -700,66 +1149,304 @@ void DynamicNetwork::convertFromSparse() {
 
 // --- Inferencia y Procesamiento ---
 
+namespace {
+    enum class InferenceExit { BUDGET, CONVERGED, SILENT };
+
+    void recordInferenceRun(InferenceStats& stats, int steps, InferenceExit exit) {
+        stats.samples++;
+        stats.total_steps += static_cast<size_t>(steps);
+        stats.last_steps = steps;
+        stats.max_steps = std::max(stats.max_steps, steps);
+        if (exit == InferenceExit::CONVERGED) stats.converged_exits++;
+        if (exit == InferenceExit::SILENT) stats.silent_exits++;
+    }
+
+    bool outputsStable(const double* previous, const double* current, size_t count, double tolerance) {
+        for (size_t j = 0; j < count; ++j) {
+            if (std::abs(current[j] - previous[j]) > tolerance) return false;
+        }
+        return true;
+    }
+}
+
 void DynamicNetwork::setInputNeurons(const std::vector<std::string>& neuron_ids) {
     m_input_neuron_ids = neuron_ids;
+    m_io_handles_dirty = true;
     DebugConfig::getInstance().logDebug("Set " + std::to_string(neuron_ids.size()) + " input neurons");
 }
 
 void DynamicNetwork::setOutputNeurons(const std::vector<std::string>& neuron_ids) {
     m_output_neuron_ids = neuron_ids;
+    m_io_handles_dirty = true;
     DebugConfig::getInstance().logDebug("Set " + std::to_string(neuron_ids.size()) + " output neurons");
 }
 
+void DynamicNetwork::resolveIOHandles() const {
+    if (!m_io_handles_dirty) return;
+
+    auto resolve = [this](const std::vector<std::string>& ids, std::vector<NeuronHandle>& handles, const char* kind) {
+        handles.clear();
+        handles.reserve(ids.size());
+        for (const auto& neuron_id : ids) {
+            NeuronHandle handle = getNeuronHandle(neuron_id);
+            if (handle == INVALID_NEURON_HANDLE) {
+                std::cerr << "[Warning] " << kind << " neuron '" << neuron_id << "' not found" << std::endl;
+            }
+            handles.push_back(handle);
+        }
+    };
+    resolve(m_input_neuron_ids, m_input_handles, "Input");
+    resolve(m_output_neuron_ids, m_output_handles, "Output");
+    m_io_handles_dirty = false;
+}
+
 std::vector<double> DynamicNetwork::getOutputActivations() const {
+    resolveIOHandles();
+
     std::vector<double> activations;
-    activations.reserve(m_output_neuron_ids.size());
-    
-    for (const auto& neuron_id : m_output_neuron_ids) {
-        auto neuron = const_cast<DynamicNetwork*>(this)->getNeuron(neuron_id);
-        if (neuron) {
-            activations.push_back(neuron->getPotential());
-        } else {
-            activations.push_back(0.0);
-            std::cerr << "[Warning] Output neuron '" << neuron_id << "' not found" << std::endl;
-        }
+    activations.reserve(m_output_handles.size());
+    for (NeuronHandle handle : m_output_handles) {
+        activations.push_back(handle != INVALID_NEURON_HANDLE ? m_neuron_store->potential(handle) : 0.0);
     }
     
     return activations;
 }
 
-std::vector<double> DynamicNetwork::processInput(const std::vector<double>& input) {
+std::vector<double> DynamicNetwork::processInput(const std::vector<double>& input, int max_steps) {
     if (input.size() != m_input_neuron_ids.size()) {
         throw std::runtime_error("Input size (" + std::to_string(input.size()) + 
                                ") does not match number of input neurons (" + 
                                std::to_string(m_input_neuron_ids.size()) + ")");
     }
+    resolveIOHandles();
     
     // Reset network state
     reset();
     
     // Apply input to input neurons
     for (size_t i = 0; i < input.size(); ++i) {
-        auto neuron = getNeuron(m_input_neuron_ids[i]);
-        if (neuron) {
-            neuron->stimulate(input[i]);
-        } else {
-            std::cerr << "[Warning] Input neuron '" << m_input_neuron_ids[i] << "' not found" << std::endl;
+        if (m_input_handles[i] != INVALID_NEURON_HANDLE) {
+            m_neuron_store->input(m_input_handles[i]) += input[i];
         }
     }
     
-    // Run network simulation for several timesteps to allow signal propagation
-    const int simulation_steps = 10;
-    for (int step = 0; step < simulation_steps; ++step) {
+    // Run the network until the step budget runs out or an early-exit criterion holds
+    const int budget = max_steps < 0 ? m_config.inference_steps : max_steps;
+    const int window = m_config.convergence_steps;
+    std::vector<double> previous = window > 0 ? getOutputActivations() : std::vector<double>();
+    int stable = 0;
+    int steps = 0;
+    InferenceExit exit = InferenceExit::BUDGET;
+    while (steps < budget) {
         update();
+        ++steps;
+        if (m_config.stop_when_silent && m_neuron_store->countFired() == 0) {
+            exit = InferenceExit::SILENT;
+            break;
+        }
+        if (window > 0) {
+            std::vector<double> current = getOutputActivations();
+            stable = outputsStable(previous.data(), current.data(), current.size(), m_config.convergence_tolerance) ? stable + 1 : 0;
+            previous.swap(current);
+            if (stable >= window) {
+                exit = InferenceExit::CONVERGED;
+                break;
+            }
+        }
     }
+    recordInferenceRun(m_inference_stats, steps, exit);
     
     // Collect output activations
     return getOutputActivations();
 }
 
-std::vector<double> DynamicNetwork::forward(const std::vector<double>& input) {
+const InferenceStats& DynamicNetwork::getInferenceStats() const {
+    return m_inference_stats;
+}
+
+void DynamicNetwork::resetInferenceStats() {
+    m_inference_stats = InferenceStats();
+}
+
+std::vector<std::vector<double>> DynamicNetwork::processBatch(const std::vector<std::vector<double>>& inputs, int max_steps) {
+    const size_t num_inputs = m_input_neuron_ids.size();
+    std::vector<double> flat;
+    flat.reserve(inputs.size() * num_inputs);
+    for (const auto& row : inputs) {
+        if (row.size() != num_inputs) {
+            throw std::runtime_error("Input size (" + std::to_string(row.size()) +
+                                   ") does not match number of input neurons (" +
+                                   std::to_string(num_inputs) + ")");
+        }
+        flat.insert(flat.end(), row.begin(), row.end());
+    }
+
+    const std::vector<double> flat_outputs = processBatch(flat, inputs.size(), max_steps);
+    const size_t num_outputs = m_output_neuron_ids.size();
+    std::vector<std::vector<double>> outputs(inputs.size());
+    for (size_t s = 0; s < inputs.size(); ++s) {
+        outputs[s].assign(flat_outputs.begin() + s * num_outputs, flat_outputs.begin() + (s + 1) * num_outputs);
+    }
+    return outputs;
+}
+
+std::vector<double> DynamicNetwork::processBatch(const std::vector<double>& flat_inputs, size_t batch_size, int max_steps) {
+    const size_t num_inputs = m_input_neuron_ids.size();
+    const size_t num_outputs = m_output_neuron_ids.size();
+    if (flat_inputs.size() != batch_size * num_inputs) {
+        throw std::runtime_error("Batch input size (" + std::to_string(flat_inputs.size()) +
+                               ") does not match batch_size x input neurons (" +
+                               std::to_string(batch_size) + " x " + std::to_string(num_inputs) + ")");
+    }
+    resolveIOHandles();
+
+    // Misma topología, retardos y orden de acumulación que update() en el modo configurado
+    syncDelayBuffer();
+    const size_t delay_depth = m_delay_buffer.depth();
+    const bool use_csr = m_config.use_csr_propagation;
+    if (use_csr && (m_csr_dirty || !m_csr_matrix)) {
+        compileCSR();
+    }
+
+    std::vector<double> flat_outputs(batch_size * num_outputs, 0.0);
+    const NeuronStore& store = *m_neuron_store;
+    const SynapseStore& synapses = *m_synapse_store;
+    const SparseConnectionMatrix* csr = use_csr ? m_csr_matrix.get() : nullptr;
+    const size_t num_neurons = store.size();
+    const size_t num_tiles = (batch_size + BATCH_TILE - 1) / BATCH_TILE;
+    if (num_neurons == 0 || num_tiles == 0) {
+        return flat_outputs;
+    }
+
+    const int budget = max_steps < 0 ? m_config.inference_steps : max_steps;
+    const int window = m_config.convergence_steps;
+    const double tolerance = m_config.convergence_tolerance;
+    const bool stop_when_silent = m_config.stop_when_silent;
+    std::vector<int> sample_steps(batch_size, 0);
+    std::vector<InferenceExit> sample_exit(batch_size, InferenceExit::BUDGET);
+
+    // Cada bloque de hasta BATCH_TILE muestras es independiente: los hilos se reparten
+    // bloques y cada uno reutiliza sus buffers [handle * tile + muestra].
+    // Una muestra que cumple el criterio de salida fija sus salidas en ese paso (igual
+    // que processInput) y el bloque termina cuando todas sus muestras han salido.
+    // Nunca más hilos que bloques: cada hilo reserva buffers de num_neurons * BATCH_TILE
+    #pragma omp parallel num_threads(std::max(1, std::min(m_config.num_threads, static_cast<int>(num_tiles))))
+    {
+        std::vector<double> v(num_neurons * BATCH_TILE);
+        std::vector<double> u(num_neurons * BATCH_TILE);
+        std::vector<double> in(num_neurons * BATCH_TILE);
+        std::vector<double> fired(num_neurons * BATCH_TILE);
+        std::vector<uint8_t> any_fired(num_neurons);
+        std::vector<double> previous(num_outputs * BATCH_TILE);
+        std::vector<double> current(num_outputs);
+        std::vector<double> spikes(BATCH_TILE);
+        std::vector<int> stable(BATCH_TILE);
+        std::vector<uint8_t> done(BATCH_TILE);
+        SynapticDelayBuffer delayed;
+        delayed.configure(delay_depth > 1 ? num_neurons * BATCH_TILE : 0, delay_depth);
+        SynapticDelayBuffer* delayed_ptr = delayed.active() ? &delayed : nullptr;
+
+        #pragma omp for schedule(dynamic)
+        for (long long t = 0; t < static_cast<long long>(num_tiles); ++t) {
+            const size_t first = static_cast<size_t>(t) * BATCH_TILE;
+            const size_t tile = std::min(BATCH_TILE, batch_size - first);
+            auto gather_outputs = [&](size_t s, double* out) {
+                for (size_t j = 0; j < num_outputs; ++j) {
+                    const NeuronHandle handle = m_output_handles[j];
+                    out[j] = handle != INVALID_NEURON_HANDLE ? v[static_cast<size_t>(handle) * tile + s] : 0.0;
+                }
+            };
+
+            store.initBatch(v.data(), u.data(), tile);
+            std::fill(in.begin(), in.begin() + num_neurons * tile, 0.0);
+            std::fill(any_fired.begin(), any_fired.end(), 0);
+            std::fill(stable.begin(), stable.end(), 0);
+            std::fill(done.begin(), done.end(), 0);
+            delayed.clear();
+
+            for (size_t i = 0; i < num_inputs; ++i) {
+                const NeuronHandle handle = m_input_handles[i];
+                if (handle == INVALID_NEURON_HANDLE) continue;
+                double* dst = in.data() + static_cast<size_t>(handle) * tile;
+                for (size_t s = 0; s < tile; ++s) {
+                    dst[s] += flat_inputs[(first + s) * num_inputs + i];
+                }
+            }
+            if (window > 0) {
+                for (size_t s = 0; s < tile; ++s) {
+                    gather_outputs(s, previous.data() + s * num_outputs);
+                }
+            }
+
+            size_t remaining = tile;
+            int steps = 0;
+            while (steps < budget && remaining > 0) {
+                // Tras el reseteo nadie ha disparado, así que el primer paso no propaga
+                if (steps > 0) {
+                    if (csr) {
+                        csr->propagateBatch(fired.data(), any_fired.data(), in.data(), tile, delayed_ptr);
+                    } else {
+                        synapses.propagateBatch(fired.data(), any_fired.data(), in.data(), tile, delayed_ptr);
+                    }
+                    delayed.deliver(in.data(), 0, num_neurons * tile);
+                    delayed.advance();
+                }
+                store.stepBatch(v.data(), u.data(), in.data(), fired.data(), any_fired.data(), tile);
+                ++steps;
+
+                if (stop_when_silent) {
+                    std::fill(spikes.begin(), spikes.begin() + tile, 0.0);
+                    for (size_t h = 0; h < num_neurons; ++h) {
+                        if (!any_fired[h]) continue;
+                        const double* fh = fired.data() + h * tile;
+                        for (size_t s = 0; s < tile; ++s) {
+                            spikes[s] += fh[s];
+                        }
+                    }
+                }
+
+                for (size_t s = 0; s < tile; ++s) {
+                    if (done[s]) continue;
+                    InferenceExit exit = InferenceExit::BUDGET;
+                    if (stop_when_silent && spikes[s] == 0.0) {
+                        exit = InferenceExit::SILENT;
+                    } else if (window > 0) {
+                        double* prev = previous.data() + s * num_outputs;
+                        gather_outputs(s, current.data());
+                        stable[s] = outputsStable(prev, current.data(), num_outputs, tolerance) ? stable[s] + 1 : 0;
+                        std::copy(current.begin(), current.end(), prev);
+                        if (stable[s] >= window) {
+                            exit = InferenceExit::CONVERGED;
+                        }
+                    }
+                    if (exit != InferenceExit::BUDGET) {
+                        done[s] = 1;
+                        --remaining;
+                        gather_outputs(s, flat_outputs.data() + (first + s) * num_outputs);
+                        sample_steps[first + s] = steps;
+                        sample_exit[first + s] = exit;
+                    }
+                }
+            }
+
+            for (size_t s = 0; s < tile; ++s) {
+                if (done[s]) continue;
+                gather_outputs(s, flat_outputs.data() + (first + s) * num_outputs);
+                sample_steps[first + s] = steps;
+            }
+        }
+    }
+
+    for (size_t s = 0; s < batch_size; ++s) {
+        recordInferenceRun(m_inference_stats, sample_steps[s], sample_exit[s]);
+    }
+
+    return flat_outputs;
+}
+
+std::vector<double> DynamicNetwork::forward(const std::vector<double>& input, int max_steps) {
     // Forward is an alias for processInput in this implementation
-    return processInput(input);
+    return processInput(input, max_steps);
 }
 
 std::vector<double> DynamicNetwork::predict(const std::string& text_input) {
@@ -328,6 +328,9 @@ void EnhancedBrainLLParser::processGlobalBlock(const std::string& content) {
             m_global_config.noise_level = std::stod(value);
         } else if (key == "random_seed") {
             m_global_config.random_seed = std::stoi(value);
+            if (m_network) {
+                m_network->setRandomSeed(static_cast<uint64_t>(m_global_config.random_seed));
+            }
         } else if (key == "parallel_processing") {
             m_global_config.parallel_processing = (value == "true");
         } else if (key == "gpu_acceleration") {
@@ -829,7 +832,8 @@ void EnhancedBrainLLParser::processExperimentBlock(const std::string& name, cons
 void EnhancedBrainLLParser::processOptimizationBlock(const std::string& name, const std::string& content) {
     // Check if this is a memory optimization block
     if (name == "memory" || name == "sparse_memory_optimization") {
-        NetworkConfig config;
+        // Partir de la configuración actual para no perder random_seed ni otros ajustes
+        NetworkConfig config = m_network ? m_network->getNetworkConfig() : NetworkConfig();
         auto params = parseKeyValuePairs(content);
         
         for (const auto& [key, value] : params) {
@@ -841,6 +845,14 @@ void EnhancedBrainLLParser::processOptimizationBlock(const std::string& name, co
                 config.batch_size = std::stoi(value);
             } else if (key == "sparsity_threshold") {
                 config.sparsity_threshold = std::stod(value);
+            } else if (key == "inference_steps") {
+                config.inference_steps = std::stoi(value);
+            } else if (key == "convergence_steps") {
+                config.convergence_steps = std::stoi(value);
+            } else if (key == "convergence_tolerance") {
+                config.convergence_tolerance = std::stod(value);
+            } else if (key == "stop_when_silent") {
+                config.stop_when_silent = (value == "true");
             } else {
                 addWarning("Unknown memory optimization parameter: " + key);
             }
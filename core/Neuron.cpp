@@ -18,132 +18,92 @@
 #include "../../include/Neuron.hpp"
 #include "../../include/DebugConfig.hpp"
 #include "../../include/DynamicNetwork.hpp" // For NeuronTypeParams definition
+#include <algorithm>
 #include <cmath> // For std::exp
 
 namespace brainll {
 
 // Constructor con modelo Izhikevich para tipos de neuronas
 Neuron::Neuron(const std::string& id, const std::string& type)
-    : m_id(id), m_type(type), m_name(""), m_potential(-65.0), m_input(0.0), m_threshold(30.0), m_fired_this_cycle(false) {
+    : m_id(id), m_type(type), m_name(""), m_store(std::make_shared<NeuronStore>()) {
     
     // Parámetros por defecto (Regular Spiking - RS)
-    m_a = 0.02;
-    m_b = 0.2;
-    m_c = -65.0;
-    m_d = 8.0;
+    double a = 0.02;
+    double b = 0.2;
+    double c = -65.0;
+    double d = 8.0;
 
     if (type == "IB") { // Intrinsically Bursting
-        m_c = -55.0;
-        m_d = 4.0;
+        c = -55.0;
+        d = 4.0;
     } else if (type == "FS") { // Fast Spiking
-        m_a = 0.1;
-        m_b = 0.2;
-        m_c = -65.0;
-        m_d = 2.0;
+        a = 0.1;
+        b = 0.2;
+        c = -65.0;
+        d = 2.0;
     }
-    m_u = m_b * m_potential;
+    m_handle = m_store->add(NeuronModelKind::NONE, 30.0, c, a, b, d, -65.0);
 }
 
 Neuron::Neuron(const std::string& id, const std::string& type, const NeuronTypeParams& params)
     : m_id(id),
       m_type(type),
-      m_model(params.model),
       m_name(""),
-      m_potential(params.reset_potential), // Start at reset potential
-      m_input(0.0),
-      m_threshold(params.threshold),
-      m_fired_this_cycle(false),
-      // BUG CRÍTICO CORREGIDO: Usar los parámetros del modelo
-      m_u(0.0), // 'u' se inicializa abajo
-      m_a(params.a),
-      m_b(params.b),
-      m_c(params.reset_potential),
-      m_d(params.d)
+      m_store(std::make_shared<NeuronStore>())
 {
-    // Inicializar 'u' basado en el potencial de reposo
-    m_u = m_b * m_potential;
+    // Empieza en el potencial de reseteo; 'u' se inicializa a b * V dentro del store
+    m_handle = m_store->add(parseNeuronModelKind(params.model), params.threshold, params.reset_potential,
+                            params.a, params.b, params.d, params.reset_potential);
 }
 
+Neuron::Neuron(const std::string& id, const std::string& type, std::shared_ptr<NeuronStore> store, NeuronHandle handle)
+    : m_id(id), m_type(type), m_name(""), m_store(std::move(store)), m_handle(handle) {}
+
 void Neuron::addInput(double value) {
-    m_input += value;
+    m_store->input(m_handle) += value;
 }
 
 void Neuron::resetInput() {
-    m_input = 0.0;
+    m_store->input(m_handle) = 0.0;
 }
 
 void Neuron::resetFiredFlag() {
-    m_fired_this_cycle = false;
+    m_store->setFired(m_handle, false);
 }
 
 void Neuron::update() {
-    // BUG CRÍTICO CORREGIDO: Seleccionar el modelo de simulación correcto.
-    if (m_model == "Izhikevich") {
-        // Actualización del potencial de membrana (usando dos pasos de 0.5ms para estabilidad)
-        m_potential += 0.5 * (0.04 * m_potential * m_potential + 5 * m_potential + 140 - m_u + m_input);
-        m_potential += 0.5 * (0.04 * m_potential * m_potential + 5 * m_potential + 140 - m_u + m_input);
-
-        // Actualización de la variable de recuperación (se hace siempre)
-        m_u += m_a * (m_b * m_potential - m_u);
-
-    } else if (m_model == "LIF") {
-        // Simplified Leaky Integrate-and-Fire model in abstract units
-        // Resting potential is configured via neuron type parameter 'c'
-        double tau = 10.0;   // Time constant (arbitrary units)
-        double dt = 1.0;     // Simulation timestep (1 arbitrary unit)
-
-        // dV/dt = (-(V - m_c) + I) / tau
-        m_potential += (dt / tau) * (-(m_potential - m_c) + m_input);
-    } else {
-        // Modelo desconocido o no especificado, no hacer nada.
-    }
-
-    // Comprobar si la neurona ha disparado CON el nuevo potencial (común a todos los modelos)
-    m_fired_this_cycle = (m_potential >= m_threshold);
-
-    if (m_fired_this_cycle) {
-        m_potential = m_c; // Resetear potencial
-        if (m_model == "Izhikevich") {
-            m_u += m_d;       // Actualizar variable de recuperación solo para Izhikevich
-        }
-    }
-
-    // Limpiar el input para el siguiente ciclo
-    resetInput();
+    // Integra el modelo, evalúa el disparo y limpia el input para el siguiente ciclo
+    m_store->stepNeuron(m_handle);
 }
 
 const std::string& Neuron::getId() const { return m_id; }
 const std::string& Neuron::getType() const { return m_type; }
 const std::string& Neuron::getName() const { return m_name; }
-double Neuron::getPotential() const { return m_potential; }
-bool Neuron::hasFired() const { return m_fired_this_cycle; }
+double Neuron::getPotential() const { return m_store->potential(m_handle); }
+bool Neuron::hasFired() const { return m_store->hasFired(m_handle); }
+NeuronHandle Neuron::getHandle() const { return m_handle; }
 
 void Neuron::setName(const std::string& name) { m_name = name; }
-void Neuron::setPotential(double potential) { m_potential = potential; }
+void Neuron::setPotential(double potential) { m_store->potential(m_handle) = potential; }
 
 void Neuron::stimulate(double potential) {
     addInput(potential);
 }
 
 void Neuron::reset() {
-    // BUG CRÍTICO CORREGIDO: Resetear el estado completamente.
-    m_potential = m_c; // Usar el potencial de reseteo configurado.
-    m_input = 0.0;
-    m_fired_this_cycle = false;
-    if (m_model == "Izhikevich") {
-        m_u = m_b * m_potential; // Resetear variable de recuperación.
-    }
+    m_store->reset(m_handle);
 }
 
 double Neuron::getActivityLevel() const {
     // Retorna un nivel de actividad basado en el potencial actual
     // Normalizado entre 0 y 1, donde 1 es el umbral de disparo
-    return std::max(0.0, std::min(1.0, (m_potential - m_c) / (m_threshold - m_c)));
+    const double c = m_store->resetPotential(m_handle);
+    return std::max(0.0, std::min(1.0, (getPotential() - c) / (m_store->threshold(m_handle) - c)));
 }
 
 bool Neuron::isActive() const {
     // Una neurona se considera activa si su potencial está por encima del potencial de reposo
-    return m_potential > m_c;
+    return getPotential() > m_store->resetPotential(m_handle);
 }
 
 } // namespace brainll
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2024 Behavior Logical Language (BrainLL)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../../include/NeuronStore.hpp"
+#include <algorithm>
+#include <bitset>
+#include <stdexcept>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace brainll {
+
+NeuronModelKind parseNeuronModelKind(const std::string& model) {
+    if (model == "Izhikevich") return NeuronModelKind::IZHIKEVICH;
+    if (model == "LIF") return NeuronModelKind::LIF;
+    return NeuronModelKind::NONE;
+}
+
+NeuronHandle NeuronStore::add(NeuronModelKind model, double threshold, double reset_potential,
+                              double a, double b, double d, double initial_potential) {
+    if (m_potential.size() >= INVALID_NEURON_HANDLE) {
+        throw std::runtime_error("NeuronStore capacity exceeded");
+    }
+
+    NeuronHandle h = static_cast<NeuronHandle>(m_potential.size());
+    m_potential.push_back(initial_potential);
+    m_u.push_back(b * initial_potential);
+    m_input.push_back(0.0);
+    m_threshold.push_back(threshold);
+    m_a.push_back(a);
+    m_b.push_back(b);
+    m_c.push_back(reset_potential);
+    m_d.push_back(d);
+    m_model.push_back(static_cast<uint8_t>(model));
+
+    if ((h >> 6) >= m_fired.size()) {
+        m_fired.push_back(0);
+    }
+    return h;
+}
+
+void NeuronStore::reserve(size_t count) {
+    m_potential.reserve(count);
+    m_u.reserve(count);
+    m_input.reserve(count);
+    m_threshold.reserve(count);
+    m_a.reserve(count);
+    m_b.reserve(count);
+    m_c.reserve(count);
+    m_d.reserve(count);
+    m_model.reserve(count);
+    m_fired.reserve((count + 63) / 64);
+}
+
+void NeuronStore::step() {
+    stepWords(0, m_fired.size());
+}
+
+void NeuronStore::stepWords(size_t first_word, size_t last_word) {
+    const size_t n = m_potential.size();
+    double* v = m_potential.data();
+    double* u = m_u.data();
+    double* in = m_input.data();
+    const double* th = m_threshold.data();
+    const double* a = m_a.data();
+    const double* b = m_b.data();
+    const double* c = m_c.data();
+    const double* d = m_d.data();
+    const uint8_t* model = m_model.data();
+
+    // Cada palabra del bitset cubre 64 neuronas consecutivas, así que rangos de
+    // palabras disjuntos pueden procesarse en paralelo sin compartir escrituras.
+    for (size_t w = first_word; w < last_word; ++w) {
+        const size_t begin = w * 64;
+        const size_t end = std::min(n, begin + 64);
+        uint64_t bits = 0;
+        for (size_t i = begin; i < end; ++i) {
+            if (integrate(static_cast<NeuronModelKind>(model[i]), v[i], u[i], in[i],
+                          th[i], a[i], b[i], c[i], d[i])) {
+                bits |= 1ULL << (i - begin);
+            }
+        }
+        m_fired[w] = bits;
+    }
+}
+
+bool NeuronStore::stepNeuron(NeuronHandle h) {
+    bool fired = integrate(static_cast<NeuronModelKind>(m_model[h]), m_potential[h], m_u[h], m_input[h],
+                           m_threshold[h], m_a[h], m_b[h], m_c[h], m_d[h]);
+    setFired(h, fired);
+    return fired;
+}
+
+void NeuronStore::resetAll() {
+    for (size_t i = 0; i < m_potential.size(); ++i) {
+        reset(static_cast<NeuronHandle>(i));
+    }
+    clearFired();
+}
+
+void NeuronStore::reset(NeuronHandle h) {
+    m_potential[h] = m_c[h];
+    m_input[h] = 0.0;
+    setFired(h, false);
+    if (static_cast<NeuronModelKind>(m_model[h]) == NeuronModelKind::IZHIKEVICH) {
+        m_u[h] = m_b[h] * m_potential[h];
+    }
+}
+
+void NeuronStore::initBatch(double* v, double* u, size_t batch) const {
+    for (size_t h = 0; h < m_potential.size(); ++h) {
+        const double c = m_c[h];
+        const double bc = static_cast<NeuronModelKind>(m_model[h]) == NeuronModelKind::IZHIKEVICH ? m_b[h] * c : m_u[h];
+        double* vh = v + h * batch;
+        double* uh = u + h * batch;
+        for (size_t s = 0; s < batch; ++s) {
+            vh[s] = c;
+            uh[s] = bc;
+        }
+    }
+}
+
+void NeuronStore::stepBatch(double* v, double* u, double* in, double* fired, uint8_t* any_fired, size_t batch) const {
+    // Misma aritmética que integrate(), pero con el reseteo expresado como selección
+    // para que el bucle sobre muestras no tenga saltos y el compilador lo vectorice.
+    for (size_t h = 0; h < m_potential.size(); ++h) {
+        const NeuronModelKind model = static_cast<NeuronModelKind>(m_model[h]);
+        const double th = m_threshold[h];
+        const double a = m_a[h];
+        const double b = m_b[h];
+        const double c = m_c[h];
+        const double d = m_d[h];
+        double* vh = v + h * batch;
+        double* uh = u + h * batch;
+        double* inh = in + h * batch;
+        double* fh = fired + h * batch;
+
+        double count = 0.0;
+        if (model == NeuronModelKind::IZHIKEVICH) {
+            for (size_t s = 0; s < batch; ++s) {
+                double vs = vh[s];
+                const double us = uh[s];
+                const double is = inh[s];
+                vs += 0.5 * (0.04 * vs * vs + 5.0 * vs + 140.0 - us + is);
+                vs += 0.5 * (0.04 * vs * vs + 5.0 * vs + 140.0 - us + is);
+                const double un = us + a * (b * vs - us);
+                const bool f = vs >= th;
+                vh[s] = f ? c : vs;
+                uh[s] = f ? un + d : un;
+                inh[s] = 0.0;
+                fh[s] = f ? 1.0 : 0.0;
+                count += fh[s];
+            }
+        } else {
+            const bool lif = model == NeuronModelKind::LIF;
+            for (size_t s = 0; s < batch; ++s) {
+                const double vs = lif ? vh[s] + LIF_DT_OVER_TAU * (-(vh[s] - c) + inh[s]) : vh[s];
+                const bool f = vs >= th;
+                vh[s] = f ? c : vs;
+                inh[s] = 0.0;
+                fh[s] = f ? 1.0 : 0.0;
+                count += fh[s];
+            }
+        }
+        any_fired[h] = count > 0.0;
+    }
+}
+
+void NeuronStore::setFired(NeuronHandle h, bool fired) {
+    // Escritura atómica del bit: neuronas distintas que comparten palabra pueden
+    // integrarse desde hilos distintos (p. ej. carriles de ParallelSimulation)
+    const uint64_t mask = 1ULL << (h & 63);
+    uint64_t& word = m_fired[h >> 6];
+#if defined(_MSC_VER)
+    if (fired) {
+        _InterlockedOr64(reinterpret_cast<volatile long long*>(&word), static_cast<long long>(mask));
+    } else {
+        _InterlockedAnd64(reinterpret_cast<volatile long long*>(&word), static_cast<long long>(~mask));
+    }
+#else
+    if (fired) {
+        __atomic_fetch_or(&word, mask, __ATOMIC_RELAXED);
+    } else {
+        __atomic_fetch_and(&word, ~mask, __ATOMIC_RELAXED);
+    }
+#endif
+}
+
+void NeuronStore::clearFired() {
+    std::fill(m_fired.begin(), m_fired.end(), 0ULL);
+}
+
+size_t NeuronStore::countFired() const {
+    size_t count = 0;
+    for (uint64_t word : m_fired) {
+        count += std::bitset<64>(word).count();
+    }
+    return count;
+}
+
+size_t NeuronStore::getMemoryUsage() const {
+    return m_potential.capacity() * sizeof(double) * 8 +
+           m_model.capacity() * sizeof(uint8_t) +
+           m_fired.capacity() * sizeof(uint64_t);
+}
+
+} // namespace brainll
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2024 Behavior Logical Language (BrainLL)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../../include/SynapseStore.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace brainll {
+
+namespace {
+    inline bool firedBit(const std::vector<uint64_t>& fired_words, NeuronHandle h) {
+        return (fired_words[h >> 6] >> (h & 63)) & 1ULL;
+    }
+}
+
+SynapseIndex SynapseStore::add(NeuronHandle source, NeuronHandle target, double weight, bool use_float16) {
+    if (m_records.size() >= std::numeric_limits<SynapseIndex>::max()) {
+        throw std::runtime_error("SynapseStore capacity exceeded");
+    }
+
+    m_records.push_back(makeRecord(source, target, weight, use_float16));
+    return static_cast<SynapseIndex>(m_records.size() - 1);
+}
+
+SynapseRecord SynapseStore::makeRecord(NeuronHandle source, NeuronHandle target, double weight, bool use_float16) {
+    SynapseRecord record;
+    record.source = source;
+    record.target = target;
+    record.learning_rate = bfloat16(0.0f);
+    record.delay = 0;
+    record.flags = use_float16 ? SYNAPSE_FLOAT16 : 0;
+    storeWeight(record, weight);
+    return record;
+}
+
+void SynapseStore::storeWeight(SynapseRecord& record, double weight) {
+    if (record.flags & SYNAPSE_FLOAT16) {
+        record.weight = static_cast<float>(float16(weight));
+    } else {
+        record.weight = static_cast<float>(weight);
+    }
+}
+
+void SynapseStore::setWeight(SynapseIndex i, double weight) {
+    storeWeight(m_records[i], weight);
+    touchWeights();
+}
+
+void SynapseStore::touchWeights() {
+#if defined(_MSC_VER)
+    _InterlockedIncrement64(reinterpret_cast<volatile long long*>(&m_weight_version));
+#else
+    __atomic_fetch_add(&m_weight_version, 1, __ATOMIC_RELAXED);
+#endif
+}
+
+uint64_t SynapseStore::getWeightVersion() const {
+#if defined(_MSC_VER)
+    return static_cast<uint64_t>(*reinterpret_cast<const volatile long long*>(&m_weight_version));
+#else
+    return __atomic_load_n(&m_weight_version, __ATOMIC_RELAXED);
+#endif
+}
+
+void SynapseStore::setDelay(SynapseIndex i, uint8_t delay) {
+    m_records[i].delay = delay;
+    m_max_delay = std::max(m_max_delay, delay);
+    ++m_delay_version;
+}
+
+void SynapseStore::refreshMaxDelay() {
+    m_max_delay = 0;
+    for (const auto& record : m_records) {
+        m_max_delay = std::max(m_max_delay, record.delay);
+    }
+    ++m_delay_version;
+}
+
+void SynapseStore::propagate(const std::vector<uint64_t>& fired_words, double* neuron_inputs,
+                             SynapticDelayBuffer* delayed) const {
+    if (delayed && !delayed->active()) {
+        delayed = nullptr;
+    }
+    for (const auto& record : m_records) {
+        if (record.source != INVALID_NEURON_HANDLE && record.target != INVALID_NEURON_HANDLE &&
+            firedBit(fired_words, record.source)) {
+            const size_t latency = delayed ? SynapticDelayBuffer::latencyOf(record.delay) : 1;
+            double* dst = latency == 1 ? neuron_inputs : delayed->row(latency);
+            dst[record.target] += record.weight;
+        }
+    }
+}
+
+void SynapseStore::propagateBatch(const double* fired, const uint8_t* any_fired, double* neuron_inputs, size_t batch,
+                                  SynapticDelayBuffer* delayed) const {
+    if (delayed && !delayed->active()) {
+        delayed = nullptr;
+    }
+    for (const auto& record : m_records) {
+        if (record.source == INVALID_NEURON_HANDLE || record.target == INVALID_NEURON_HANDLE ||
+            !any_fired[record.source]) {
+            continue;
+        }
+        const double w = record.weight;
+        const double* src = fired + static_cast<size_t>(record.source) * batch;
+        const size_t latency = delayed ? SynapticDelayBuffer::latencyOf(record.delay) : 1;
+        double* dst = (latency == 1 ? neuron_inputs : delayed->row(latency)) + static_cast<size_t>(record.target) * batch;
+        for (size_t s = 0; s < batch; ++s) {
+            dst[s] += w * src[s];
+        }
+    }
+}
+
+void SynapseStore::applyHebbian(const std::vector<uint64_t>& fired_words) {
+    for (auto& record : m_records) {
+        if (!record.isPlastic() || record.source == INVALID_NEURON_HANDLE || record.target == INVALID_NEURON_HANDLE) {
+            continue;
+        }
+        if (firedBit(fired_words, record.source) && firedBit(fired_words, record.target)) {
+            storeWeight(record, Connection::hebbianUpdate(record.weight, static_cast<float>(record.learning_rate)));
+        }
+    }
+}
+
+} // namespace brainll
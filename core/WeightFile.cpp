@@ -0,0 +1,295 @@
+/*
+ * Copyright (C) 2024 Behavior Logical Language (BrainLL)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../../include/WeightFile.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace brainll {
+
+namespace {
+    inline uint64_t alignTo8(uint64_t offset) {
+        return (offset + 7) & ~static_cast<uint64_t>(7);
+    }
+
+    void writePadding(std::ofstream& out, uint64_t& position, uint64_t target) {
+        static const char zeros[8] = {};
+        out.write(zeros, static_cast<std::streamsize>(target - position));
+        position = target;
+    }
+}
+
+bool writeWeightFile(const std::string& filepath, const std::vector<std::string>& neuron_ids,
+                     const std::vector<SynapseRecord>& records, bool use_float16, std::string& error) {
+    std::ofstream out(filepath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        error = "Could not open file for writing: " + filepath;
+        return false;
+    }
+
+    const uint64_t neuron_count = neuron_ids.size();
+    const uint64_t synapse_count = records.size();
+
+    std::vector<uint64_t> id_offsets;
+    id_offsets.reserve(neuron_count + 1);
+    uint64_t chars = 0;
+    for (const auto& id : neuron_ids) {
+        id_offsets.push_back(chars);
+        chars += id.size();
+    }
+    id_offsets.push_back(chars);
+
+    WeightFileHeader header = {};
+    std::memcpy(header.magic, WEIGHT_FILE_MAGIC, sizeof(header.magic));
+    header.version = WEIGHT_FILE_VERSION;
+    header.flags = use_float16 ? static_cast<uint32_t>(WEIGHT_FILE_FLOAT16) : static_cast<uint32_t>(0);
+    header.neuron_count = neuron_count;
+    header.synapse_count = synapse_count;
+    header.id_offsets_offset = sizeof(WeightFileHeader);
+    header.id_chars_offset = header.id_offsets_offset + (neuron_count + 1) * sizeof(uint64_t);
+    header.indices_offset = alignTo8(header.id_chars_offset + chars);
+    header.weights_offset = alignTo8(header.indices_offset + 2 * synapse_count * sizeof(uint32_t));
+
+    uint64_t position = 0;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(id_offsets.data()),
+              static_cast<std::streamsize>(id_offsets.size() * sizeof(uint64_t)));
+    for (const auto& id : neuron_ids) {
+        out.write(id.data(), static_cast<std::streamsize>(id.size()));
+    }
+    position = header.id_chars_offset + chars;
+    writePadding(out, position, header.indices_offset);
+
+    // Los arrays se escriben por bloques para no duplicar el archivo completo en memoria
+    const size_t chunk = 1 << 16;
+    std::vector<uint32_t> indices;
+    indices.reserve(chunk);
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t begin = 0; begin < records.size(); begin += chunk) {
+            const size_t end = std::min(records.size(), begin + chunk);
+            indices.clear();
+            for (size_t i = begin; i < end; ++i) {
+                indices.push_back(pass == 0 ? records[i].source : records[i].target);
+            }
+            out.write(reinterpret_cast<const char*>(indices.data()),
+                      static_cast<std::streamsize>(indices.size() * sizeof(uint32_t)));
+        }
+    }
+    position = header.indices_offset + 2 * synapse_count * sizeof(uint32_t);
+    writePadding(out, position, header.weights_offset);
+
+    if (use_float16) {
+        std::vector<uint16_t> weights;
+        weights.reserve(chunk);
+        for (size_t begin = 0; begin < records.size(); begin += chunk) {
+            const size_t end = std::min(records.size(), begin + chunk);
+            weights.clear();
+            for (size_t i = begin; i < end; ++i) {
+                weights.push_back(float16(records[i].weight).bits());
+            }
+            out.write(reinterpret_cast<const char*>(weights.data()),
+                      static_cast<std::streamsize>(weights.size() * sizeof(uint16_t)));
+        }
+    } else {
+        std::vector<float> weights;
+        weights.reserve(chunk);
+        for (size_t begin = 0; begin < records.size(); begin += chunk) {
+            const size_t end = std::min(records.size(), begin + chunk);
+            weights.clear();
+            for (size_t i = begin; i < end; ++i) {
+                weights.push_back(records[i].weight);
+            }
+            out.write(reinterpret_cast<const char*>(weights.data()),
+                      static_cast<std::streamsize>(weights.size() * sizeof(float)));
+        }
+    }
+
+    if (!out.good()) {
+        error = "Write failed: " + filepath;
+        return false;
+    }
+    return true;
+}
+
+bool isWeightFile(const std::string& filepath) {
+    std::ifstream in(filepath, std::ios::binary);
+    char magic[sizeof(WEIGHT_FILE_MAGIC)] = {};
+    if (!in.read(magic, sizeof(magic))) {
+        return false;
+    }
+    return std::memcmp(magic, WEIGHT_FILE_MAGIC, sizeof(magic)) == 0;
+}
+
+MappedWeightFile::~MappedWeightFile() {
+    close();
+}
+
+bool MappedWeightFile::open(const std::string& filepath) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) {
+                const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (view) {
+                    m_file = file;
+                    m_mapping = mapping;
+                    m_data = static_cast<const uint8_t*>(view);
+                    m_size = static_cast<size_t>(size.QuadPart);
+                    return validate();
+                }
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+    }
+#else
+    int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED) {
+                ::close(fd); // El mapeo sigue siendo válido sin el descriptor
+                m_mapping = view;
+                m_data = static_cast<const uint8_t*>(view);
+                m_size = static_cast<size_t>(st.st_size);
+                return validate();
+            }
+        }
+        ::close(fd);
+    }
+#endif
+
+    // Sin mmap: leer el archivo completo a memoria
+    std::ifstream in(filepath, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) {
+        m_error = "Could not open file for reading: " + filepath;
+        return false;
+    }
+    m_buffer.resize(static_cast<size_t>(in.tellg()));
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+    return validate();
+}
+
+void MappedWeightFile::close() {
+#ifdef _WIN32
+    if (m_mapping) {
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+        CloseHandle(static_cast<HANDLE>(m_file));
+    }
+#else
+    if (m_mapping) {
+        munmap(m_mapping, m_size);
+    }
+#endif
+    m_mapping = nullptr;
+    m_file = nullptr;
+    m_data = nullptr;
+    m_size = 0;
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+}
+
+bool MappedWeightFile::validate() {
+    auto fail = [this](const std::string& message) {
+        m_error = message;
+        close();
+        return false;
+    };
+
+    if (m_size < sizeof(WeightFileHeader)) {
+        return fail("File too small for a weight file header");
+    }
+    const WeightFileHeader& h = header();
+    if (std::memcmp(h.magic, WEIGHT_FILE_MAGIC, sizeof(h.magic)) != 0) {
+        return fail("Not a BrainLL weight file");
+    }
+    if (h.version != WEIGHT_FILE_VERSION) {
+        return fail("Unsupported weight file version " + std::to_string(h.version));
+    }
+
+    const uint64_t weight_size = (h.flags & WEIGHT_FILE_FLOAT16) ? sizeof(uint16_t) : sizeof(float);
+    const uint64_t id_offsets_end = h.id_offsets_offset + (h.neuron_count + 1) * sizeof(uint64_t);
+    if (h.neuron_count >= INVALID_NEURON_HANDLE || h.neuron_count > m_size || h.synapse_count > m_size ||
+        id_offsets_end > m_size ||
+        h.id_chars_offset < id_offsets_end ||
+        h.indices_offset % 8 != 0 || h.weights_offset % 8 != 0 ||
+        h.indices_offset + 2 * h.synapse_count * sizeof(uint32_t) > h.weights_offset ||
+        h.weights_offset + h.synapse_count * weight_size > m_size) {
+        return fail("Corrupt weight file: section offsets out of range");
+    }
+
+    const uint64_t* id_offsets = reinterpret_cast<const uint64_t*>(m_data + h.id_offsets_offset);
+    if (h.id_chars_offset + id_offsets[h.neuron_count] > h.indices_offset) {
+        return fail("Corrupt weight file: ID table out of range");
+    }
+    for (uint64_t i = 0; i < h.neuron_count; ++i) {
+        if (id_offsets[i] > id_offsets[i + 1]) {
+            return fail("Corrupt weight file: ID table is not monotonic");
+        }
+    }
+
+    m_error.clear();
+    return true;
+}
+
+std::string_view MappedWeightFile::getNeuronId(size_t index) const {
+    const uint64_t* id_offsets = reinterpret_cast<const uint64_t*>(m_data + header().id_offsets_offset);
+    const char* chars = reinterpret_cast<const char*>(m_data + header().id_chars_offset);
+    return std::string_view(chars + id_offsets[index], static_cast<size_t>(id_offsets[index + 1] - id_offsets[index]));
+}
+
+const uint32_t* MappedWeightFile::getSources() const {
+    return reinterpret_cast<const uint32_t*>(m_data + header().indices_offset);
+}
+
+const uint32_t* MappedWeightFile::getTargets() const {
+    return getSources() + header().synapse_count;
+}
+
+double MappedWeightFile::getWeight(size_t index) const {
+    const uint8_t* weights = m_data + header().weights_offset;
+    if (isFloat16()) {
+        uint16_t bits;
+        std::memcpy(&bits, weights + index * sizeof(uint16_t), sizeof(bits));
+        return static_cast<float>(float16::fromBits(bits));
+    }
+    return reinterpret_cast<const float*>(weights)[index];
+}
+
+} // namespace brainll
@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ * Licensed under AGPL v3 License - 17/7/2025
+ */
+
+// Las comprobaciones usan assert: que sigan activas también en builds Release
+#undef NDEBUG
+
+#include "../../include/DynamicNetwork.hpp"
+#include "../../include/DebugConfig.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace brainll {
+namespace Tests {
+
+constexpr size_t kNeurons = 300;
+
+// Red aleatoria reproducible: misma semilla + mismas llamadas = misma topología
+void buildNetwork(DynamicNetwork& network, bool plastic) {
+    NeuronTypeParams params;
+    params.model = "Izhikevich";
+    network.registerNeuronType("RS", params);
+    std::vector<std::string> ids;
+    for (size_t i = 0; i < kNeurons; ++i) {
+        ids.push_back(network.createNeuron("RS", "pop")->getId());
+    }
+    std::mt19937 rng(3);
+    std::bernoulli_distribution connect(0.05);
+    for (const auto& source : ids) {
+        for (const auto& target : ids) {
+            if (connect(rng)) {
+                network.createConnection(source, target, 0.4, plastic, 0.02);
+            }
+        }
+    }
+}
+
+// Mismo estímulo en todas las redes: corriente pseudoaleatoria por neurona
+void drive(DynamicNetwork& network, std::mt19937& rng) {
+    std::uniform_real_distribution<double> current(0.0, 12.0);
+    NeuronStore& store = network.getNeuronStore();
+    for (NeuronHandle h = 0; h < store.size(); ++h) {
+        store.input(h) += current(rng);
+    }
+}
+
+void assertSameState(const DynamicNetwork& a, const DynamicNetwork& b) {
+    const NeuronStore& sa = a.getNeuronStore();
+    const NeuronStore& sb = b.getNeuronStore();
+    assert(sa.getFiredWords() == sb.getFiredWords());
+    for (NeuronHandle h = 0; h < sa.size(); ++h) {
+        assert(sa.potential(h) == sb.potential(h));
+    }
+    const auto& ca = a.getConnections();
+    const auto& cb = b.getConnections();
+    assert(ca.size() == cb.size());
+    for (size_t i = 0; i < ca.size(); ++i) {
+        assert(ca[i]->getWeight() == cb[i]->getWeight());
+    }
+}
+
+void testCSRMatchesDensePropagation() {
+    std::cout << "Testing CSR propagation against a dense weight matrix..." << std::endl;
+
+    DynamicNetwork network;
+    buildNetwork(network, false);
+    network.enableCSRPropagation();
+
+    // Matriz densa de referencia a partir de las conexiones
+    std::vector<double> dense(kNeurons * kNeurons, 0.0);
+    for (const auto& connection : network.getConnections()) {
+        const NeuronHandle source = connection->getSourceNeuron()->getHandle();
+        const NeuronHandle target = connection->getDestinationNeuron()->getHandle();
+        dense[source * kNeurons + target] += connection->getWeight();
+    }
+
+    SparseConnectionMatrix matrix(kNeurons);
+    for (size_t i = 0; i < kNeurons; ++i) {
+        matrix.addNeuron("n" + std::to_string(i));
+    }
+    for (const auto& connection : network.getConnections()) {
+        matrix.addConnectionByIndex(connection->getSourceNeuron()->getHandle(),
+                                    connection->getDestinationNeuron()->getHandle(),
+                                    connection->getWeight(), connection);
+    }
+    matrix.finalize();
+
+    std::mt19937 rng(5);
+    std::bernoulli_distribution fires(0.2);
+    for (int round = 0; round < 20; ++round) {
+        std::vector<uint64_t> words((kNeurons + 63) / 64, 0);
+        std::vector<bool> fired(kNeurons, false);
+        for (size_t i = 0; i < kNeurons; ++i) {
+            if (fires(rng)) {
+                fired[i] = true;
+                words[i >> 6] |= 1ULL << (i & 63);
+            }
+        }
+
+        std::vector<double> csr_inputs(kNeurons, 0.0);
+        matrix.propagateFiredRows(words, csr_inputs.data());
+
+        for (size_t target = 0; target < kNeurons; ++target) {
+            double expected = 0.0;
+            for (size_t source = 0; source < kNeurons; ++source) {
+                if (fired[source]) {
+                    expected += dense[source * kNeurons + target];
+                }
+            }
+            assert(std::abs(csr_inputs[target] - expected) <= 1e-12 * (1.0 + std::abs(expected)));
+        }
+    }
+
+    std::cout << "✓ CSR/dense propagation tests passed" << std::endl;
+}
+
+void testCSRUpdateMatchesConnectionPath() {
+    std::cout << "Testing CSR update against the Connection path..." << std::endl;
+
+    DynamicNetwork reference, csr;
+    buildNetwork(reference, true);
+    buildNetwork(csr, true);
+    csr.enableCSRPropagation();
+
+    std::mt19937 rng_reference(9), rng_csr(9);
+    size_t spikes = 0;
+    for (int step = 0; step < 300; ++step) {
+        drive(reference, rng_reference);
+        drive(csr, rng_csr);
+        reference.update();
+        csr.update();
+        assertSameState(reference, csr);
+        spikes += reference.getNeuronStore().countFired();
+    }
+    assert(spikes > 0);
+
+    std::cout << "✓ CSR/Connection update tests passed (" << spikes << " spikes)" << std::endl;
+}
+
+void testCSRPicksUpExternalWeightEdits() {
+    std::cout << "Testing CSR refresh after Connection::setWeight..." << std::endl;
+
+    DynamicNetwork reference, csr;
+    buildNetwork(reference, true);
+    buildNetwork(csr, true);
+    csr.enableCSRPropagation();
+
+    std::mt19937 rng_reference(21), rng_csr(21);
+    for (int step = 0; step < 200; ++step) {
+        // Editar pesos y plasticidad desde fuera a mitad de la simulación
+        if (step == 50 || step == 120) {
+            const auto& a = reference.getConnections();
+            const auto& b = csr.getConnections();
+            for (size_t i = 0; i < a.size(); i += 7) {
+                const double weight = step == 50 ? 1.2 : 0.05;
+                a[i]->setWeight(weight);
+                b[i]->setWeight(weight);
+                a[i]->enablePlasticity(0.05);
+                b[i]->enablePlasticity(0.05);
+            }
+        }
+        drive(reference, rng_reference);
+        drive(csr, rng_csr);
+        reference.update();
+        csr.update();
+        assertSameState(reference, csr);
+    }
+
+    std::cout << "✓ CSR refresh tests passed" << std::endl;
+}
+
+void testParallelStepMatchesSerial() {
+    std::cout << "Testing the multi-threaded step against the serial one..." << std::endl;
+
+    for (bool use_csr : {false, true}) {
+        for (int threads : {2, 3, 8}) {
+            DynamicNetwork parallel;
+            buildNetwork(parallel, true);
+            if (use_csr) {
+                parallel.enableCSRPropagation();
+            }
+            parallel.setThreadCount(threads);
+
+            DynamicNetwork reference;
+            buildNetwork(reference, true);
+            if (use_csr) {
+                reference.enableCSRPropagation();
+            }
+            std::mt19937 rng_reference(13), rng_parallel(13);
+            for (int step = 0; step < 200; ++step) {
+                drive(reference, rng_reference);
+                drive(parallel, rng_parallel);
+                reference.update();
+                parallel.update();
+                assertSameState(reference, parallel);
+            }
+        }
+    }
+
+    std::cout << "✓ Parallel step tests passed" << std::endl;
+}
+
+void testUpdatePlasticityUsesFiredNeurons() {
+    std::cout << "Testing SparseConnectionMatrix::updatePlasticity..." << std::endl;
+
+    DynamicNetwork network;
+    buildNetwork(network, true);
+    const auto& connections = network.getConnections();
+
+    SparseConnectionMatrix matrix(kNeurons);
+    for (size_t i = 0; i < kNeurons; ++i) {
+        matrix.addNeuron("n" + std::to_string(i));
+    }
+    for (const auto& connection : connections) {
+        matrix.addConnectionByIndex(connection->getSourceNeuron()->getHandle(),
+                                    connection->getDestinationNeuron()->getHandle(),
+                                    connection->getWeight(), connection);
+    }
+    matrix.finalize();
+
+    std::vector<double> before;
+    for (const auto& connection : connections) {
+        before.push_back(connection->getWeight());
+    }
+
+    // Solo las neuronas pares disparan: solo cambian las sinapsis par -> par
+    std::vector<bool> fired(kNeurons, false);
+    for (size_t i = 0; i < kNeurons; i += 2) {
+        fired[i] = true;
+    }
+    matrix.updatePlasticity(fired);
+
+    size_t changed = 0;
+    for (size_t i = 0; i < connections.size(); ++i) {
+        const bool both = fired[connections[i]->getSourceNeuron()->getHandle()] &&
+                          fired[connections[i]->getDestinationNeuron()->getHandle()];
+        const double expected = both ? Connection::hebbianUpdate(before[i], connections[i]->getLearningRate()) : before[i];
+        assert(std::abs(connections[i]->getWeight() - expected) <= 1e-6);
+        changed += both ? 1 : 0;
+    }
+    assert(changed > 0);
+
+    std::cout << "✓ updatePlasticity tests passed" << std::endl;
+}
+
+// Retardos aleatorios de 0 a 6 pasos, los mismos en todas las redes
+void setRandomDelays(DynamicNetwork& network) {
+    std::mt19937 rng(31);
+    for (const auto& connection : network.getConnections()) {
+        connection->setDelay(static_cast<double>(rng() % 7));
+    }
+}
+
+void testDelayedSynapseArrival() {
+    std::cout << "Testing delayed synapse arrival step..." << std::endl;
+
+    NeuronTypeParams params;
+    params.model = "LIF";
+    params.threshold = -55.0;
+    for (int delay = 0; delay <= 6; ++delay) {
+        DynamicNetwork network;
+        network.registerNeuronType("LIF", params);
+        auto source = network.createNeuron("LIF", "in");
+        auto target = network.createNeuron("LIF", "out");
+        network.createConnection(source->getId(), target->getId(), 5.0);
+        network.getConnections().back()->setDelay(delay);
+
+        // La fuente dispara en el paso 0; el destino (LIF en reposo) no cambia hasta que llega
+        NeuronStore& store = network.getNeuronStore();
+        const NeuronHandle src = source->getHandle();
+        const NeuronHandle dst = target->getHandle();
+        const double rest = store.potential(dst);
+        store.input(src) += 1000.0;
+        int arrived = -1;
+        for (int step = 0; step < 12 && arrived < 0; ++step) {
+            network.update();
+            if (step == 0) {
+                assert(store.hasFired(src));
+            }
+            if (store.potential(dst) != rest) {
+                arrived = step;
+            }
+        }
+        assert(arrived == std::max(delay, 1));
+    }
+
+    std::cout << "✓ Delay arrival tests passed" << std::endl;
+}
+
+void testDelayedPathsMatch() {
+    std::cout << "Testing delayed propagation across record, CSR and threaded paths..." << std::endl;
+
+    DynamicNetwork reference;
+    buildNetwork(reference, true);
+    setRandomDelays(reference);
+    assert(reference.getMaxSynapticLatency() == 6);
+
+    struct Variant { bool csr; int threads; };
+    const Variant variants[] = {{true, 1}, {false, 3}, {false, 4}, {true, 3}, {true, 4}};
+    std::vector<std::unique_ptr<DynamicNetwork>> networks;
+    std::vector<std::mt19937> rngs;
+    for (const Variant& variant : variants) {
+        networks.push_back(std::make_unique<DynamicNetwork>());
+        buildNetwork(*networks.back(), true);
+        setRandomDelays(*networks.back());
+        if (variant.csr) {
+            networks.back()->enableCSRPropagation();
+        }
+        networks.back()->setThreadCount(variant.threads);
+        rngs.emplace_back(17);
+    }
+
+    std::mt19937 rng_reference(17);
+    size_t spikes = 0;
+    for (int step = 0; step < 200; ++step) {
+        drive(reference, rng_reference);
+        reference.update();
+        spikes += reference.getNeuronStore().countFired();
+        for (size_t i = 0; i < networks.size(); ++i) {
+            drive(*networks[i], rngs[i]);
+            networks[i]->update();
+            assertSameState(reference, *networks[i]);
+        }
+    }
+    assert(spikes > 0);
+
+    std::cout << "✓ Delayed path tests passed (" << spikes << " spikes)" << std::endl;
+}
+
+void testBatchMatchesProcessInputWithDelays() {
+    std::cout << "Testing processBatch against processInput with delays..." << std::endl;
+
+    for (bool use_csr : {false, true}) {
+        for (int threads : {1, 3}) {
+            DynamicNetwork network;
+            buildNetwork(network, false);
+            setRandomDelays(network);
+            if (use_csr) {
+                network.enableCSRPropagation();
+            }
+            network.setThreadCount(threads);
+
+            const auto& ids = network.getNeuronIdsForPopulation("pop");
+            network.setInputNeurons(std::vector<std::string>(ids.begin(), ids.begin() + 20));
+            network.setOutputNeurons(std::vector<std::string>(ids.end() - 20, ids.end()));
+
+            // 21 muestras: el segundo bloque de BATCH_TILE queda incompleto
+            std::mt19937 rng(23);
+            std::uniform_real_distribution<double> current(0.0, 40.0);
+            std::vector<std::vector<double>> inputs(21, std::vector<double>(20));
+            for (auto& sample : inputs) {
+                for (double& x : sample) {
+                    x = current(rng);
+                }
+            }
+
+            // Segunda ronda tras editar pesos: processBatch también debe ver la edición
+            for (int round = 0; round < 2; ++round) {
+                if (round == 1) {
+                    const auto& connections = network.getConnections();
+                    for (size_t i = 0; i < connections.size(); i += 3) {
+                        connections[i]->setWeight(2.5);
+                    }
+                }
+                const auto batch = network.processBatch(inputs);
+                for (size_t s = 0; s < inputs.size(); ++s) {
+                    assert(batch[s] == network.processInput(inputs[s]));
+                }
+            }
+        }
+    }
+
+    std::cout << "✓ processBatch delay tests passed" << std::endl;
+}
+
+void runAllTests() {
+    std::cout << "=== Running DynamicNetwork Tests ===" << std::endl;
+    DebugConfig::getInstance().setDebugLevel(DebugLevel::WARNING);
+
+    testCSRMatchesDensePropagation();
+    testCSRUpdateMatchesConnectionPath();
+    testCSRPicksUpExternalWeightEdits();
+    testParallelStepMatchesSerial();
+    testUpdatePlasticityUsesFiredNeurons();
+    testDelayedSynapseArrival();
+    testDelayedPathsMatch();
+    testBatchMatchesProcessInputWithDelays();
+
+    std::cout << "\nAll DynamicNetwork tests passed" << std::endl;
+}
+
+} // namespace Tests
+} // namespace brainll
+
+int main() {
+    brainll::Tests::runAllTests();
+    return 0;
+}
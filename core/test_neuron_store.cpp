@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ * Licensed under AGPL v3 License - 17/7/2025
+ */
+
+// Las comprobaciones usan assert: que sigan activas también en builds Release
+#undef NDEBUG
+
+#include "../../include/NeuronStore.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace brainll {
+namespace Tests {
+
+// Neurona escalar tal como la integraba Neuron::update() antes del NeuronStore
+struct ScalarNeuron {
+    std::string model;
+    double v, u, input, threshold, a, b, c, d;
+    bool fired;
+
+    void update() {
+        if (model == "Izhikevich") {
+            v += 0.5 * (0.04 * v * v + 5 * v + 140 - u + input);
+            v += 0.5 * (0.04 * v * v + 5 * v + 140 - u + input);
+            u += a * (b * v - u);
+        } else if (model == "LIF") {
+            double tau = 10.0;
+            double dt = 1.0;
+            v += (dt / tau) * (-(v - c) + input);
+        }
+        fired = v >= threshold;
+        if (fired) {
+            v = c;
+            if (model == "Izhikevich") {
+                u += d;
+            }
+        }
+        input = 0.0;
+    }
+};
+
+// 200 neuronas (la última palabra del bitset queda incompleta) con modelos mezclados
+void buildPopulation(NeuronStore& store, std::vector<ScalarNeuron>& reference) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> jitter(0.0, 1.0);
+    const char* models[] = {"Izhikevich", "LIF", "Unknown"};
+    for (int i = 0; i < 200; ++i) {
+        ScalarNeuron n;
+        n.model = models[i % 3];
+        n.threshold = n.model == "LIF" ? -55.0 + 5.0 * jitter(rng) : 30.0;
+        n.a = 0.02 + 0.08 * jitter(rng);
+        n.b = 0.2 + 0.05 * jitter(rng);
+        n.c = -65.0 + 10.0 * jitter(rng);
+        n.d = 2.0 + 6.0 * jitter(rng);
+        n.v = n.c;
+        n.u = n.b * n.v;
+        n.input = 0.0;
+        n.fired = false;
+        reference.push_back(n);
+        store.add(parseNeuronModelKind(n.model), n.threshold, n.c, n.a, n.b, n.d, n.v);
+    }
+}
+
+void testStepMatchesScalarPath() {
+    std::cout << "Testing NeuronStore::step against the scalar neuron update..." << std::endl;
+
+    NeuronStore store;
+    std::vector<ScalarNeuron> reference;
+    buildPopulation(store, reference);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> drive(0.0, 25.0);
+    size_t spikes = 0;
+    for (int step = 0; step < 500; ++step) {
+        for (NeuronHandle h = 0; h < store.size(); ++h) {
+            const double in = drive(rng);
+            store.input(h) += in;
+            reference[h].input += in;
+        }
+        store.step();
+        for (NeuronHandle h = 0; h < store.size(); ++h) {
+            reference[h].update();
+            assert(store.hasFired(h) == reference[h].fired);
+            assert(std::abs(store.potential(h) - reference[h].v) <= 1e-9 * (1.0 + std::abs(reference[h].v)));
+            assert(std::abs(store.recovery(h) - reference[h].u) <= 1e-9 * (1.0 + std::abs(reference[h].u)));
+            assert(store.input(h) == 0.0);
+            spikes += reference[h].fired ? 1 : 0;
+        }
+    }
+    // La prueba solo tiene sentido si hubo disparos que comparar
+    assert(spikes > 0);
+
+    std::cout << "✓ Step parity tests passed (" << spikes << " spikes)" << std::endl;
+}
+
+void testStepWordsAndStepNeuronMatchStep() {
+    std::cout << "Testing stepWords/stepNeuron against step..." << std::endl;
+
+    NeuronStore whole, words, single;
+    std::vector<ScalarNeuron> unused;
+    buildPopulation(whole, unused);
+    buildPopulation(words, unused);
+    buildPopulation(single, unused);
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> drive(0.0, 25.0);
+    for (int step = 0; step < 200; ++step) {
+        for (NeuronHandle h = 0; h < whole.size(); ++h) {
+            const double in = drive(rng);
+            whole.input(h) += in;
+            words.input(h) += in;
+            single.input(h) += in;
+        }
+        whole.step();
+
+        // Un hilo por palabra del bitset, como el paso multihilo de DynamicNetwork
+        std::vector<std::thread> threads;
+        for (size_t w = 0; w < words.getFiredWordCount(); ++w) {
+            threads.emplace_back([&words, w]() { words.stepWords(w, w + 1); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (NeuronHandle h = 0; h < single.size(); ++h) {
+            single.stepNeuron(h);
+        }
+
+        assert(whole.getFiredWords() == words.getFiredWords());
+        assert(whole.getFiredWords() == single.getFiredWords());
+        for (NeuronHandle h = 0; h < whole.size(); ++h) {
+            assert(whole.potential(h) == words.potential(h));
+            assert(whole.potential(h) == single.potential(h));
+        }
+    }
+
+    std::cout << "✓ stepWords/stepNeuron tests passed" << std::endl;
+}
+
+void testConcurrentSetFired() {
+    std::cout << "Testing concurrent setFired on shared words..." << std::endl;
+
+    NeuronStore store;
+    std::vector<ScalarNeuron> unused;
+    buildPopulation(store, unused);
+
+    // Hilos con handles intercalados: todos escriben en las mismas palabras
+    const size_t thread_count = 4;
+    for (int round = 0; round < 50; ++round) {
+        store.clearFired();
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&store, t, thread_count]() {
+                for (NeuronHandle h = static_cast<NeuronHandle>(t); h < store.size(); h += thread_count) {
+                    store.setFired(h, true);
+                    if (h % 5 == 0) {
+                        store.setFired(h, false);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (NeuronHandle h = 0; h < store.size(); ++h) {
+            assert(store.hasFired(h) == (h % 5 != 0));
+        }
+        assert(store.countFired() == store.size() - (store.size() + 4) / 5);
+    }
+
+    std::cout << "✓ Concurrent setFired tests passed" << std::endl;
+}
+
+void runAllTests() {
+    std::cout << "=== Running NeuronStore Tests ===" << std::endl;
+
+    testStepMatchesScalarPath();
+    testStepWordsAndStepNeuronMatchStep();
+    testConcurrentSetFired();
+
+    std::cout << "\nAll NeuronStore tests passed" << std::endl;
+}
+
+} // namespace Tests
+} // namespace brainll
+
+int main() {
+    brainll::Tests::runAllTests();
+    return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ * Licensed under AGPL v3 License - 17/7/2025
+ */
+
+// Las comprobaciones usan assert: que sigan activas también en builds Release
+#undef NDEBUG
+
+#include "../../include/SpikeHistory.hpp"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace brainll {
+namespace Tests {
+
+// Modelo de referencia: un std::vector con los spikes retenidos, recortado a mano
+struct ReferenceHistory {
+    std::vector<double> kept;
+    size_t capacity;
+    uint64_t total = 0;
+
+    explicit ReferenceHistory(size_t cap) : capacity(cap) {}
+
+    void record(double time) {
+        kept.push_back(time);
+        if (kept.size() > capacity) {
+            kept.erase(kept.begin());
+        }
+        ++total;
+    }
+
+    void setCapacity(size_t cap) {
+        capacity = std::max<size_t>(cap, 1);
+        if (kept.size() > capacity) {
+            kept.erase(kept.begin(), kept.end() - capacity);
+        }
+    }
+
+    size_t countSince(double cutoff) const {
+        size_t count = 0;
+        for (double t : kept) {
+            count += t >= cutoff ? 1 : 0;
+        }
+        return count;
+    }
+
+    double firingRate(double now, double window) const {
+        if (kept.empty() || window <= 0.0) {
+            return 0.0;
+        }
+        const size_t recent = countSince(now - window);
+        double span = window;
+        if (kept.size() == capacity && recent == kept.size() && total > kept.size()) {
+            span = now - kept.front();
+            if (span <= 0.0) {
+                return 0.0;
+            }
+        }
+        return static_cast<double>(recent) * 1000.0 / span;
+    }
+};
+
+void assertMatches(const SpikeHistory& history, const ReferenceHistory& reference, double now) {
+    assert(history.capacity() == reference.capacity);
+    assert(history.size() == reference.kept.size());
+    assert(history.totalRecorded() == reference.total);
+    assert(history.full() == (reference.kept.size() == reference.capacity));
+    assert(history.view().toVector() == reference.kept);
+    assert(history.lastSpikeTime() == (reference.kept.empty() ? -1.0 : reference.kept.back()));
+    for (double window : {0.5, 3.0, 10.0, 50.0, 1000.0}) {
+        assert(history.countSince(now - window) == reference.countSince(now - window));
+        assert(history.firingRate(now, window) == reference.firingRate(now, window));
+    }
+}
+
+void testRingMatchesVector() {
+    std::cout << "Testing SpikeHistory against a std::vector model..." << std::endl;
+
+    SpikeHistory history(16);
+    ReferenceHistory reference(16);
+    assertMatches(history, reference, 0.0);
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> gap(0.0, 2.0);
+    double now = 0.0;
+    // Varias vueltas del buffer con cambios de capacidad intercalados
+    const size_t capacities[] = {16, 5, 5, 40, 1, 7, 64};
+    for (size_t capacity : capacities) {
+        history.setCapacity(capacity);
+        reference.setCapacity(capacity);
+        assertMatches(history, reference, now);
+        for (int i = 0; i < 100; ++i) {
+            // Algunos spikes repetidos en el mismo instante
+            now += (i % 9 == 0) ? 0.0 : gap(rng);
+            history.record(now);
+            reference.record(now);
+            assertMatches(history, reference, now);
+        }
+    }
+
+    std::cout << "✓ Ring/vector tests passed" << std::endl;
+}
+
+void testSetCapacityKeepsNewest() {
+    std::cout << "Testing SpikeHistory::setCapacity..." << std::endl;
+
+    SpikeHistory history(8);
+    for (int i = 0; i < 21; ++i) {
+        history.record(static_cast<double>(i));
+    }
+    assert(history.view().toVector() == std::vector<double>({13, 14, 15, 16, 17, 18, 19, 20}));
+
+    history.setCapacity(3);
+    assert(history.view().toVector() == std::vector<double>({18, 19, 20}));
+    history.record(21.0);
+    assert(history.view().toVector() == std::vector<double>({19, 20, 21}));
+
+    // Al crecer no vuelve nada descartado y los nuevos se añaden detrás
+    history.setCapacity(6);
+    assert(history.view().toVector() == std::vector<double>({19, 20, 21}));
+    history.record(22.0);
+    history.record(23.0);
+    history.record(24.0);
+    history.record(25.0);
+    assert(history.view().toVector() == std::vector<double>({20, 21, 22, 23, 24, 25}));
+    assert(history.lastSpikeTime() == 25.0);
+    assert(history.totalRecorded() == 26);
+
+    // setCapacity(0) se trata como 1
+    history.setCapacity(0);
+    assert(history.capacity() == 1);
+    assert(history.view().toVector() == std::vector<double>({25}));
+
+    history.clear();
+    assert(history.empty());
+    assert(history.lastSpikeTime(-7.0) == -7.0);
+    assert(history.firingRate(30.0, 10.0) == 0.0);
+
+    std::cout << "✓ setCapacity tests passed" << std::endl;
+}
+
+void testFiringRateOnFullBuffer() {
+    std::cout << "Testing SpikeHistory::firingRate on a full buffer..." << std::endl;
+
+    // Un spike por ms con capacidad 10: una ventana de 100 ms solo tiene los últimos 10
+    // spikes, así que la tasa se estima sobre los 9 ms que cubren
+    SpikeHistory history(10);
+    for (int i = 0; i < 50; ++i) {
+        history.record(static_cast<double>(i));
+    }
+    assert(history.firingRate(49.0, 100.0) == 10.0 * 1000.0 / 9.0);
+    // Una ventana que el buffer sí cubre usa su propia longitud
+    assert(history.firingRate(49.0, 4.5) == 5.0 * 1000.0 / 4.5);
+
+    // Sin descartes (total == size) la ventana se respeta aunque el buffer esté lleno
+    SpikeHistory exact(10);
+    for (int i = 0; i < 10; ++i) {
+        exact.record(static_cast<double>(i));
+    }
+    assert(exact.firingRate(9.0, 100.0) == 10.0 * 1000.0 / 100.0);
+
+    std::cout << "✓ Full-buffer firing rate tests passed" << std::endl;
+}
+
+void runAllTests() {
+    std::cout << "=== Running SpikeHistory Tests ===" << std::endl;
+
+    testRingMatchesVector();
+    testSetCapacityKeepsNewest();
+    testFiringRateOnFullBuffer();
+
+    std::cout << "\nAll SpikeHistory tests passed" << std::endl;
+}
+
+} // namespace Tests
+} // namespace brainll
+
+int main() {
+    brainll::Tests::runAllTests();
+    return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ * Licensed under AGPL v3 License - 17/7/2025
+ */
+
+// Las comprobaciones usan assert: que sigan activas también en builds Release
+#undef NDEBUG
+
+#include "../../include/DynamicNetwork.hpp"
+#include "../../include/DebugConfig.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace brainll {
+namespace Tests {
+
+const double kRates[] = {1e-7, 1e-6, 1e-5, 6e-5, 1e-4, 1e-3, 0.01, 0.02, 0.1, 0.5};
+
+// bfloat16 guarda 8 bits de mantisa: error relativo de redondeo <= 2^-9
+constexpr double kRateTolerance = 1.0 / 512.0;
+
+double storedRate(double rate) {
+    return static_cast<float>(bfloat16(rate));
+}
+
+void testRecordSize() {
+    std::cout << "Testing SynapseRecord size..." << std::endl;
+    assert(sizeof(SynapseRecord) == 16);
+    std::cout << "✓ SynapseRecord is 16 bytes" << std::endl;
+}
+
+void testLearningRateRoundTrip() {
+    std::cout << "Testing learning rate round-trip through SynapseRecord..." << std::endl;
+
+    NeuronTypeParams params;
+    params.model = "LIF";
+    params.threshold = -55.0;
+
+    DynamicNetwork network;
+    network.registerNeuronType("LIF", params);
+    auto source = network.createNeuron("LIF", "in");
+    auto target = network.createNeuron("LIF", "out");
+
+    for (double rate : kRates) {
+        // Conexión independiente y vista sobre el store de la red
+        Connection standalone(source, target, 0.5);
+        standalone.enablePlasticity(rate);
+        assert(standalone.getLearningRate() == storedRate(rate));
+        assert(std::abs(standalone.getLearningRate() - rate) <= kRateTolerance * rate);
+
+        network.createConnection(source->getId(), target->getId(), 0.5, true, rate);
+        auto view = network.getConnections().back();
+        assert(view->isPlastic());
+        assert(view->getLearningRate() == storedRate(rate));
+    }
+
+    // Conexiones creadas en bloque por connectPopulations
+    network.connectPopulations("in", "out", 0.5, true, 1e-5);
+    auto bulk = network.getConnections().back();
+    assert(std::abs(bulk->getLearningRate() - 1e-5) <= kRateTolerance * 1e-5);
+
+    std::cout << "✓ Learning rate round-trip tests passed" << std::endl;
+}
+
+void testSmallRatesStillLearn() {
+    std::cout << "Testing Hebbian updates with small learning rates..." << std::endl;
+
+    for (double rate : kRates) {
+        SynapseStore store;
+        const SynapseIndex index = store.add(0, 1, 0.5);
+        store[index].flags |= SYNAPSE_PLASTIC;
+        store[index].learning_rate = bfloat16(rate);
+
+        // Fuente y destino activos: la regla de Hebb debe mover el peso
+        const std::vector<uint64_t> fired = {0x3};
+        const float before = store[index].weight;
+        store.applyHebbian(fired);
+        const float expected = static_cast<float>(Connection::hebbianUpdate(before, storedRate(rate)));
+        assert(store[index].weight == expected);
+        // Con float32 el incremento de las tasas más pequeñas se pierde en el redondeo del peso,
+        // pero la tasa en sí sigue intacta
+        assert(static_cast<float>(store[index].learning_rate) == storedRate(rate));
+        if (rate >= 1e-6) {
+            assert(store[index].weight > before);
+        }
+    }
+
+    std::cout << "✓ Small learning rate tests passed" << std::endl;
+}
+
+void runAllTests() {
+    std::cout << "=== Running SynapseStore Tests ===" << std::endl;
+    DebugConfig::getInstance().setDebugLevel(DebugLevel::WARNING);
+
+    testRecordSize();
+    testLearningRateRoundTrip();
+    testSmallRatesStillLearn();
+
+    std::cout << "\nAll SynapseStore tests passed" << std::endl;
+}
+
+} // namespace Tests
+} // namespace brainll
+
+int main() {
+    brainll::Tests::runAllTests();
+    return 0;
+}
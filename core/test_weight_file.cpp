@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ * Licensed under AGPL v3 License - 17/7/2025
+ */
+
+// Las comprobaciones usan assert: que sigan activas también en builds Release
+#undef NDEBUG
+
+#include "../../include/DynamicNetwork.hpp"
+#include "../../include/DebugConfig.hpp"
+#include "../../include/WeightFile.hpp"
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace brainll {
+namespace Tests {
+
+void buildNetwork(DynamicNetwork& network) {
+    NeuronTypeParams params;
+    params.model = "Izhikevich";
+    network.registerNeuronType("RS", params);
+    std::vector<std::string> ids;
+    for (int i = 0; i < 120; ++i) {
+        ids.push_back(network.createNeuron("RS", "pop")->getId());
+    }
+    // Misma semilla, misma topología en todas las redes
+    std::mt19937 rng(5);
+    std::bernoulli_distribution connect(0.1);
+    for (const auto& source : ids) {
+        for (const auto& target : ids) {
+            if (connect(rng)) {
+                network.createConnection(source, target, 0.3);
+            }
+        }
+    }
+    // Pesos distintos por sinapsis, incluidos valores pequeños y negativos
+    const auto& connections = network.getConnections();
+    for (size_t i = 0; i < connections.size(); ++i) {
+        connections[i]->setWeight((static_cast<double>(i % 97) - 48.0) * 1.37e-3);
+    }
+}
+
+std::vector<float> weightsOf(const DynamicNetwork& network) {
+    std::vector<float> weights;
+    for (const auto& record : network.getSynapseStore().getRecords()) {
+        weights.push_back(record.weight);
+    }
+    return weights;
+}
+
+void roundTrip(bool use_float16) {
+    const std::string path = use_float16 ? "test_weights_f16.bllw" : "test_weights_f32.bllw";
+
+    NetworkConfig config;
+    config.use_float16 = use_float16;
+    DynamicNetwork network(config);
+    buildNetwork(network);
+    const std::vector<float> saved = weightsOf(network);
+
+    assert(network.saveWeights(path, WeightFileFormat::BINARY));
+    assert(isWeightFile(path));
+    {
+        MappedWeightFile file;
+        assert(file.open(path));
+        assert(file.isFloat16() == use_float16);
+        assert(file.getSynapseCount() == saved.size());
+    }
+
+    // Pisar los pesos y recuperarlos del archivo: deben volver bit a bit
+    for (const auto& connection : network.getConnections()) {
+        connection->setWeight(0.75);
+    }
+    assert(network.loadWeights(path));
+    assert(weightsOf(network) == saved);
+
+    // Una red nueva con la misma topología carga los mismos pesos
+    DynamicNetwork fresh(config);
+    buildNetwork(fresh);
+    for (const auto& connection : fresh.getConnections()) {
+        connection->setWeight(0.0);
+    }
+    assert(fresh.loadWeights(path));
+    assert(weightsOf(fresh) == saved);
+
+    std::remove(path.c_str());
+}
+
+void testBinaryRoundTrip() {
+    std::cout << "Testing binary weight file round-trip (float32)..." << std::endl;
+    roundTrip(false);
+    std::cout << "✓ float32 round-trip tests passed" << std::endl;
+
+    std::cout << "Testing binary weight file round-trip (float16)..." << std::endl;
+    roundTrip(true);
+    std::cout << "✓ float16 round-trip tests passed" << std::endl;
+}
+
+void runAllTests() {
+    std::cout << "=== Running WeightFile Tests ===" << std::endl;
+    DebugConfig::getInstance().setDebugLevel(DebugLevel::WARNING);
+
+    testBinaryRoundTrip();
+
+    std::cout << "\nAll WeightFile tests passed" << std::endl;
+}
+
+} // namespace Tests
+} // namespace brainll
+
+int main() {
+    brainll::Tests::runAllTests();
+    return 0;
+}
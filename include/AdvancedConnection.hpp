@@ -41,7 +41,7 @@ namespace brainll {
     // Connection parameters
     struct ConnectionParameters {
         double weight = 1.0;
-        double delay = 1.0;
+        double delay = 1.0;              // ms
         bool is_plastic = false;
         PlasticityRule plasticity_rule = PlasticityRule::NONE;
         
@@ -94,7 +94,9 @@ namespace brainll {
         // State access
         double getWeight() const { return weight_; }
         void setWeight(double weight) { weight_ = weight; }
+        // Synaptic delay in ms, the time base of AdvancedNeuralNetwork::update()
         double getDelay() const { return delay_; }
+        void setDelay(double delay_ms) { delay_ = delay_ms; delay = delay_ms; }
         bool isPlastic() const { return parameters_.is_plastic; }
         
         // Plasticity
@@ -132,7 +134,7 @@ namespace brainll {
         std::map<std::string, double> getState() const;
         void setState(const std::map<std::string, double>& state);
         
-        // Public member variables for compatibility
+        // Public member variables for compatibility (read-only mirror of delay_; use setDelay)
         double delay;
         
     private:
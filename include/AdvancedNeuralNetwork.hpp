@@ -25,10 +25,15 @@
 #include "AdvancedConnection.hpp"
 #include "OptimizationEngine.hpp"
 
+namespace BrainLL {
+    enum class NeuronModel;  // BIO/neurons/NeuronBase.hpp
+}
+
 namespace brainll {
 
     // Forward declarations
     class OptimizationEngine;
+    class NeuronModelGroup;
     struct ParserStateMachine;
 
     // Plasticity rules (using PlasticityRule from AdvancedConnection.hpp)
@@ -122,7 +127,9 @@ namespace brainll {
         
         // Neuron management
         size_t addNeuron(const std::string& type, const std::map<std::string, double>& params = {});
-        size_t addConnection(size_t source_id, size_t target_id, double weight, const std::string& plasticity_type = "NONE");
+        // delay in ms, like dt; -1 delivers in the next step of the global timestep
+        size_t addConnection(size_t source_id, size_t target_id, double weight, const std::string& plasticity_type = "NONE",
+                             double delay = -1.0);
         
         // Component management
         void addRegion(const std::string& name, const RegionConfig& region_config);
@@ -242,6 +249,23 @@ namespace brainll {
         std::vector<std::shared_ptr<AdvancedNeuron>> m_neurons;
         std::vector<std::shared_ptr<AdvancedConnection>> m_connections;
         
+        // Neurons grouped by model at build time. Each group owns the BIO/neurons
+        // implementation of its model and steps it in a monomorphized loop.
+        std::vector<std::unique_ptr<NeuronModelGroup>> m_model_groups;
+        std::vector<std::pair<size_t, size_t>> m_neuron_slots;  // Neuron id -> (group, index in group)
+        std::vector<size_t> m_fired_neurons;                    // Scratch: neurons that fired this step
+        
+        // Event-driven spike delivery. Outgoing synapses are indexed per source neuron
+        // (CSR over m_connections) and spikes wait in a ring with one slot per step
+        // until their delay elapses, so a step only touches synapses of fired neurons.
+        std::vector<size_t> m_out_offsets;                      // Source id -> range in m_out_synapses
+        std::vector<size_t> m_out_synapses;                     // Connection indices grouped by source
+        std::vector<size_t> m_out_delay_steps;                  // Delay of each entry, in steps of m_delivery_dt
+        std::vector<std::vector<size_t>> m_delivery_ring;       // Pending connection indices per future step
+        size_t m_delivery_head;                                 // Slot delivered at the start of the next step
+        double m_delivery_dt;                                   // Step the delays were discretized with
+        bool m_adjacency_dirty;
+        
         // Engines and systems
         std::unique_ptr<OptimizationEngine> m_optimization_engine;
         
@@ -307,15 +331,9 @@ namespace brainll {
                                std::shared_ptr<AdvancedNeuron> source, 
                                std::shared_ptr<AdvancedNeuron> target, 
                                double dt);
-        void updateNeuron(std::shared_ptr<AdvancedNeuron> neuron, double dt);
-        
-        // Model-specific update functions
-        void updateLIFNeuron(std::shared_ptr<AdvancedNeuron> neuron, double dt, double input);
-        void updateAdaptiveLIFNeuron(std::shared_ptr<AdvancedNeuron> neuron, double dt, double input);
-        void updateIzhikevichNeuron(std::shared_ptr<AdvancedNeuron> neuron, double dt, double input);
-        void updateLSTMNeuron(std::shared_ptr<AdvancedNeuron> neuron, double dt, double input);
-        void updateTransformerNeuron(std::shared_ptr<AdvancedNeuron> neuron, double dt, double input);
-        void updateGRUNeuron(std::shared_ptr<AdvancedNeuron> neuron, double dt, double input);
+        size_t getModelGroup(BrainLL::NeuronModel model);  // Index in m_model_groups, created on first use
+        void rebuildSpikeAdjacency(double dt);
+        void deliverPendingSpikes();
         
         // Connection pattern implementations
         void createOneToOneConnections(const std::string& source_pop, const std::string& target_pop, const AdvancedConnectionParams& params);
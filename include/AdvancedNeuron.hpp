@@ -8,6 +8,7 @@
 #include <functional>
 #include <variant>
 #include <queue>
+#include "SpikeHistory.hpp"
 
 namespace brainll {
 
@@ -73,6 +74,9 @@ namespace brainll {
         int key_dim = 64;
         int value_dim = 64;
         
+        // Spike history ring buffer (spikes kept per neuron)
+        size_t spike_history_capacity = SpikeHistory::DEFAULT_CAPACITY;
+        
         // Custom parameters
         std::map<std::string, std::variant<double, int, std::string>> custom_params;
     };
@@ -88,6 +92,7 @@ namespace brainll {
         void addInput(double current);
         void addSpike(double time, double weight);
         bool hasFired() const { return has_fired_; }
+        void setFired(bool fired) { has_fired_ = fired; }
         void reset();
         
         // State access
@@ -100,8 +105,15 @@ namespace brainll {
         void setAdaptationCurrent(double current) { adaptation_current_ = current; }
         double getIzhikevichU() const { return recovery_variable_; }
         void setIzhikevichU(double u) { recovery_variable_ = u; }
-        std::vector<double> getSpikeHistory(double time_window = 1000.0) const;
+        SpikeTimesView getSpikeHistory(double time_window = 1000.0) const;  // Zero-copy, invalidated by the next spike
         double getFiringRate(double time_window = 1000.0) const;
+        void recordSpike(double time);
+        void setSpikeHistoryCapacity(size_t capacity);
+        size_t getSpikeHistoryCapacity() const { return spike_history_.capacity(); }
+        
+        // Local clock (ms): advanced by update(), or set by a network that drives the neuron
+        double getCurrentTime() const { return current_time_; }
+        void setCurrentTime(double time) { current_time_ = time; }
         
         // Configuration
         void setParameters(const AdvancedNeuronParams& params);
@@ -151,6 +163,7 @@ namespace brainll {
         double adaptation_current_;
         double input_current_;
         double last_spike_time_;
+        double current_time_;
         bool has_fired_;
         double refractory_end_time_;
         
@@ -165,7 +178,7 @@ namespace brainll {
         std::vector<std::vector<double>> attention_weights_;
         
         // History
-        std::vector<double> spike_times_;
+        SpikeHistory spike_history_;
         std::vector<double> potential_history_;
         
         // Connections
@@ -192,7 +205,6 @@ namespace brainll {
         
         // Utility functions
         double generateNoise(double dt);
-        void recordSpike(double time);
         void updateHistory();
         double sigmoid(double x) const;
         double tanh_activation(double x) const;
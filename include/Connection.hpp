@@ -9,6 +9,7 @@
 #include <string>
 #include <memory>
 #include <cstdint>
+#include <cstring>
 
 // Simple float16 implementation using uint16_t
 namespace brainll {
@@ -46,7 +47,7 @@ namespace brainll {
         float16& operator=(float f) {
             uint32_t bits = *reinterpret_cast<uint32_t*>(&f);
             uint32_t sign = (bits & 0x80000000) >> 16;
-            uint32_t exp = (bits & 0x7F800000) >> 23;
+            int32_t exp = static_cast<int32_t>((bits & 0x7F800000) >> 23); // Con signo: el rebias puede ser negativo
             uint32_t mant = (bits & 0x007FFFFF) >> 13;
             
             if (exp == 0) {
@@ -60,12 +61,47 @@ namespace brainll {
                 } else if (exp >= 0x1F) {
                     data = static_cast<uint16_t>(sign | 0x7C00); // Overflow to infinity
                 } else {
-                    data = static_cast<uint16_t>(sign | (exp << 10) | mant);
+                    data = static_cast<uint16_t>(sign | (static_cast<uint32_t>(exp) << 10) | mant);
                 }
             }
             return *this;
         }
         
+        // Acceso a la representación binaria (serialización)
+        uint16_t bits() const { return data; }
+        static float16 fromBits(uint16_t bits) { float16 h; h.data = bits; return h; }
+        
+    private:
+        uint16_t data;
+    };
+
+    // bfloat16: los 16 bits altos de un float. Conserva el exponente de 8 bits (rango de
+    // float, sin subnormales que se anulen) a cambio de 8 bits de mantisa
+    class bfloat16 {
+    public:
+        bfloat16() : data(0) {}
+        bfloat16(float f) { *this = f; }
+        bfloat16(double d) { *this = static_cast<float>(d); }
+        
+        operator float() const {
+            uint32_t bits = static_cast<uint32_t>(data) << 16;
+            float f;
+            std::memcpy(&f, &bits, sizeof(f));
+            return f;
+        }
+        
+        bfloat16& operator=(float f) {
+            uint32_t bits;
+            std::memcpy(&bits, &f, sizeof(bits));
+            if ((bits & 0x7FFFFFFF) > 0x7F800000) {
+                data = static_cast<uint16_t>((bits >> 16) | 0x0040); // NaN sigue siendo NaN
+            } else {
+                bits += 0x7FFF + ((bits >> 16) & 1); // Redondeo al par más cercano
+                data = static_cast<uint16_t>(bits >> 16);
+            }
+            return *this;
+        }
+        
     private:
         uint16_t data;
     };
@@ -75,15 +111,23 @@ namespace brainll {
 
     // Forward declaration para evitar dependencia circular
     class Neuron;
+    class SynapseStore;
 
+    // Los datos de la sinapsis (índices, peso, delay, plasticidad) viven en un
+    // SynapseRecord. Connection es una vista sobre ese registro; una conexión
+    // independiente es dueña de un SynapseStore de un solo elemento.
     class Connection {
 public:
     Connection(std::shared_ptr<Neuron> source, std::shared_ptr<Neuron> dest, double weight, bool use_float16 = false);
     Connection(std::shared_ptr<Neuron> source, std::shared_ptr<Neuron> dest, float16 weight);
+    // Vista sobre el registro 'index' de un SynapseStore compartido (DynamicNetwork)
+    Connection(std::shared_ptr<SynapseStore> store, uint32_t index,
+               std::shared_ptr<Neuron> source, std::shared_ptr<Neuron> dest);
 
     // Métodos de simulación
     void propagate();
     void applyPlasticity(); // Aplica aprendizaje Hebbiano
+    static double hebbianUpdate(double current_weight, double learning_rate);
 
     // Configuración
     void enablePlasticity(double learning_rate);
@@ -94,33 +138,32 @@ public:
     std::shared_ptr<Neuron> getSourceNeuron() const;
     std::shared_ptr<Neuron> getDestinationNeuron() const;
     bool isPlastic() const;
+    double getLearningRate() const;
     bool isUsingFloat16() const;
     double getDelay() const;
+    uint32_t getSynapseIndex() const;
 
     // Setters
     void setWeight(double weight);
     void setWeightFloat16(float16 weight);
     void setUseFloat16(bool use_float16);
+    // Retardo en pasos de simulación: se redondea al paso y se limita a [0, 255]
+    void setDelay(double delay);
     
     // Métodos para pool de conexiones
     void reset(std::shared_ptr<Neuron> source, std::shared_ptr<Neuron> dest, double weight);
     void cleanup();
+    
+    // Reubicación de la vista (compactación del SynapseStore)
+    void rebind(std::shared_ptr<SynapseStore> store, uint32_t index);
 
 private:
+    // Solo para la API (getSourceNeuron/getDestinationNeuron); la simulación usa índices
     std::weak_ptr<Neuron> m_source_neuron;
     std::weak_ptr<Neuron> m_destination_neuron;
-    union {
-        double m_weight_double;
-        float16 m_weight_float16;
-    };
-    bool m_use_float16;
-    
-    // Miembros para la plasticidad
-    bool m_is_plastic;
-    double m_learning_rate;
     
-    // Delay de la conexión (en pasos de simulación)
-    double m_delay;
+    std::shared_ptr<SynapseStore> m_store;
+    uint32_t m_index;
 };
 }
 
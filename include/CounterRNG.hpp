@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ * Licensed under AGPL v3 License - 17/7/2025
+ */
+
+#ifndef BRAINLL_COUNTERRNG_HPP
+#define BRAINLL_COUNTERRNG_HPP
+
+#include <cmath>
+#include <cstdint>
+
+namespace brainll {
+
+    /**
+     * Generador aleatorio basado en contador (SplitMix64 con clave por stream).
+     * El n-ésimo valor de un stream es una función pura de (seed, stream, n), así que
+     * cada fila o bloque de trabajo puede tener su propio stream sin estado compartido
+     * y el resultado no depende del número de hilos ni de cómo se reparta el trabajo.
+     */
+    class CounterRNG {
+    public:
+        CounterRNG(uint64_t seed, uint64_t stream, uint64_t counter = 0)
+            : m_key(mix(seed ^ mix(stream + GOLDEN_GAMMA))), m_counter(counter) {}
+
+        uint64_t next() { return mix(m_key + (m_counter++) * GOLDEN_GAMMA); }
+
+        // Uniforme en [0, 1) con 53 bits de mantisa
+        double nextDouble() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+
+        /**
+         * Número de fracasos antes del siguiente éxito en ensayos Bernoulli(p), con
+         * log_one_minus_p = log(1 - p). Permite saltar directamente al siguiente par
+         * aceptado: O(aceptados) en lugar de O(candidatos). Satura en UINT64_MAX.
+         */
+        uint64_t nextGeometric(double log_one_minus_p) {
+            const double skip = std::floor(std::log1p(-nextDouble()) / log_one_minus_p);
+            return skip < 1.8e19 ? static_cast<uint64_t>(skip) : UINT64_MAX;
+        }
+
+        void seek(uint64_t counter) { m_counter = counter; }
+        uint64_t getCounter() const { return m_counter; }
+
+        static uint64_t mix(uint64_t z) {
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+    private:
+        static constexpr uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+        uint64_t m_key;
+        uint64_t m_counter;
+    };
+
+}
+
+#endif // BRAINLL_COUNTERRNG_HPP
@@ -117,11 +117,9 @@ private:
     std::unordered_map<std::string, std::shared_ptr<NetworkNode>> nodes_;
     std::unique_ptr<LoadBalancer> load_balancer_;
     
-    // Threading
+    // Threading: a single mostly-blocked service thread; compute goes to the shared TaskScheduler
     std::atomic<bool> is_running_;
-    std::thread heartbeat_thread_;
-    std::thread message_thread_;
-    std::thread monitor_thread_;
+    std::thread service_thread_;
     
     // Message queue
     std::queue<NetworkMessage> message_queue_;
@@ -136,11 +134,10 @@ private:
     mutable std::mutex stats_mutex_;
     std::atomic<size_t> message_counter_;
     
-    // Background workers
+    // Background service (messages, heartbeats and node monitoring)
     void startBackgroundThreads();
-    void heartbeatWorker();
-    void messageWorker();
-    void networkMonitor();
+    void serviceLoop();
+    void sendHeartbeat();
     
     // Message processing
     void processMessage(const NetworkMessage& message);
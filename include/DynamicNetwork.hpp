@@ -16,7 +16,11 @@
 #include <mutex>
 
 #include "Neuron.hpp"
+#include "NeuronStore.hpp"
 #include "Connection.hpp"
+#include "SynapseStore.hpp"
+#include "SynapticDelayBuffer.hpp"
+#include "SparseConnectionMatrix.hpp"
 
 namespace brainll {
 
@@ -38,6 +42,33 @@ namespace brainll {
         bool use_float16 = false;
         size_t batch_size = 10000;
         double sparsity_threshold = 0.1; // Connections below this weight are pruned
+        bool use_csr_propagation = false; // Propagate through a compiled CSR matrix (only fired rows)
+        int num_threads = 1; // >1 enables the deterministic parallel step (OpenMP)
+        uint64_t random_seed = 42; // Seed for random connectivity (connectPopulationsRandom)
+        // Inference (processInput / forward / processBatch)
+        int inference_steps = 10; // Step budget per sample
+        int convergence_steps = 0; // K > 0: stop once outputs stay stable for K consecutive steps
+        double convergence_tolerance = 1e-6; // Max per-output change counted as "stable"
+        bool stop_when_silent = false; // Stop when no neuron fired in the last step
+    };
+
+    // Formato de saveWeights(); AUTO elige CSV para rutas *.csv y binario (.bllw) para el resto
+    enum class WeightFileFormat {
+        AUTO,
+        BINARY,
+        CSV
+    };
+
+    // Estadísticas acumuladas de pasos de inferencia
+    struct InferenceStats {
+        size_t samples = 0;         // Muestras procesadas
+        size_t total_steps = 0;
+        size_t converged_exits = 0; // Salidas estables durante convergence_steps pasos
+        size_t silent_exits = 0;    // Salidas porque nadie disparó
+        int last_steps = 0;
+        int max_steps = 0;
+
+        double getAverageSteps() const { return samples ? static_cast<double>(total_steps) / samples : 0.0; }
     };
 
     // Hash function for connection key
@@ -78,6 +109,28 @@ namespace brainll {
         void enableFloat16(bool enable = true);
         void pruneWeakConnections(double threshold = 0.01);
         void setNetworkConfig(const NetworkConfig& config);
+        const NetworkConfig& getNetworkConfig() const;
+        // Reinicia también el contador de llamadas: misma semilla + mismas llamadas = misma red
+        void setRandomSeed(uint64_t seed);
+        uint64_t getRandomSeed() const;
+        
+        // CSR propagation: la topología se compila en un SparseConnectionMatrix y cada
+        // paso solo recorre las filas de las neuronas que dispararon. La matriz se
+        // recompila sola al cambiar la topología y recoge en el siguiente paso los
+        // pesos editados desde fuera (Connection::setWeight).
+        void enableCSRPropagation(bool enable = true);
+        void compileCSR();
+        
+        // Paso paralelo: los hilos se reparten rangos de neuronas destino (alineados a
+        // palabras de 64 bits), así que el resultado es idéntico bit a bit para
+        // cualquier número de hilos. La propagación solo se paraleliza en modo CSR.
+        void setThreadCount(int num_threads);
+        int getThreadCount() const;
+        
+        // Retardos sinápticos (Connection::setDelay, en pasos): una sinapsis de retardo d
+        // entrega su spike max(d, 1) pasos después de que dispare la fuente, a través de
+        // un buffer circular de entrada por destino con tantas filas como el retardo máximo.
+        size_t getMaxSynapticLatency() const;
 
         // --- Simulación ---
         void update();
@@ -85,30 +138,51 @@ namespace brainll {
 
         // --- Consulta de la Red ---
         std::shared_ptr<Neuron> getNeuron(const std::string& id_or_name);
+        std::shared_ptr<Neuron> getNeuron(NeuronHandle handle) const;
+        NeuronHandle getNeuronHandle(const std::string& id_or_name) const;
+        NeuronStore& getNeuronStore();
+        const NeuronStore& getNeuronStore() const;
         const std::map<std::string, std::shared_ptr<Neuron>>& getAllNeurons() const;
         const std::vector<std::string>& getNeuronIdsForPopulation(const std::string& pop_name) const;
         std::vector<std::shared_ptr<Connection>> getConnectionsForNeuron(const std::string& neuron_id);
+        std::vector<std::shared_ptr<Connection>> getOutgoingConnections(NeuronHandle handle) const;
+        std::vector<std::shared_ptr<Connection>> getIncomingConnections(NeuronHandle handle) const;
+        // Primera conexión source -> dest (recorre solo las salientes de source)
+        std::shared_ptr<Connection> getConnection(const std::string& source_id, const std::string& dest_id) const;
         std::shared_ptr<Neuron> getMostActiveNeuron(const std::string& type_prefix = "") const;
         size_t getConnectionCount() const;
         const std::vector<std::shared_ptr<Connection>>& getConnections() const;
+        const SynapseStore& getSynapseStore() const;
         size_t getMemoryUsage() const;
         double getSparsityRatio() const;
         const std::map<std::string, std::vector<std::string>>& getAllPopulations() const;
 
         // --- Inferencia y Procesamiento ---
-        std::vector<double> processInput(const std::vector<double>& input);
-        std::vector<double> forward(const std::vector<double>& input);
+        // max_steps < 0 usa NetworkConfig::inference_steps
+        std::vector<double> processInput(const std::vector<double>& input, int max_steps = -1);
+        // Inferencia por lotes: cada muestra corre sobre su propia copia del estado
+        // (equivale a processInput con los pesos congelados; no aplica plasticidad)
+        std::vector<std::vector<double>> processBatch(const std::vector<std::vector<double>>& inputs, int max_steps = -1);
+        // Igual, con entradas y salidas planas en orden fila-mayor (muestra × neurona)
+        std::vector<double> processBatch(const std::vector<double>& flat_inputs, size_t batch_size, int max_steps = -1);
+        std::vector<double> forward(const std::vector<double>& input, int max_steps = -1);
         std::vector<double> predict(const std::string& text_input);
         void setInputNeurons(const std::vector<std::string>& neuron_ids);
         void setOutputNeurons(const std::vector<std::string>& neuron_ids);
         std::vector<double> getOutputActivations() const;
+        const InferenceStats& getInferenceStats() const;
+        void resetInferenceStats();
         
         // --- Persistencia ---
-        bool saveWeights(const std::string& filepath) const;
+        bool saveWeights(const std::string& filepath, WeightFileFormat format = WeightFileFormat::AUTO) const;
+        // Detecta el formato por la cabecera: binario mapeado en memoria o CSV heredado
         bool loadWeights(const std::string& filepath);
 
     private:
         std::map<std::string, NeuronTypeParams> m_neuron_types;
+        std::shared_ptr<NeuronStore> m_neuron_store; // Estado SoA indexado por NeuronHandle
+        std::vector<std::shared_ptr<Neuron>> m_neuron_views; // Handle -> vista Neuron
+        std::unordered_map<std::string, NeuronHandle> m_handle_by_id; // ID -> Handle
         std::map<std::string, std::shared_ptr<Neuron>> m_neurons; // ID -> Neurona
         std::vector<std::shared_ptr<Connection>> m_connections;
         SparseConnectionMap m_sparse_connections; // Sparse matrix representation
@@ -118,55 +192,54 @@ namespace brainll {
         int m_neuron_counter;
         NetworkConfig m_config;
         
-        // Memory optimization - Connection pool
-        class ConnectionPool {
-        private:
-            std::vector<std::shared_ptr<Connection>> available_connections;
-            std::mutex pool_mutex;
-            size_t max_size = 10000;
-            
-        public:
-            std::shared_ptr<Connection> acquire() {
-                std::lock_guard<std::mutex> lock(pool_mutex);
-                if (available_connections.empty()) {
-                    return std::make_shared<Connection>(nullptr, nullptr, 0.0, true);
-                }
-                
-                auto connection = available_connections.back();
-                available_connections.pop_back();
-                return connection;
-            }
-            
-            void release(std::shared_ptr<Connection> connection) {
-                std::lock_guard<std::mutex> lock(pool_mutex);
-                if (available_connections.size() < max_size) {
-                    connection->cleanup();
-                    available_connections.push_back(std::move(connection));
-                }
-            }
-            
-            void clear() {
-                std::lock_guard<std::mutex> lock(pool_mutex);
-                available_connections.clear();
-            }
-            
-            size_t size() const {
-                return available_connections.size();
-            }
-        };
+        // Registros compactos de sinapsis; m_connections y m_sparse_connections guardan vistas
+        std::shared_ptr<SynapseStore> m_synapse_store;
+        
+        // Índice de adyacencia: SynapseIndex -> vista y listas por NeuronHandle (orden ascendente)
+        std::vector<std::shared_ptr<Connection>> m_synapse_views;
+        std::vector<std::vector<SynapseIndex>> m_outgoing;
+        std::vector<std::vector<SynapseIndex>> m_incoming;
+        uint64_t m_connect_calls = 0; // Stream de CounterRNG por llamada de conexión aleatoria
+        
+        // Compiled CSR topology for use_csr_propagation
+        std::unique_ptr<SparseConnectionMatrix> m_csr_matrix;
+        bool m_csr_dirty = true;
         
-        ConnectionPool m_connection_pool;
+        // Entradas en vuelo de sinapsis con latencia > 1 (ancho 0 si no hay ninguna)
+        SynapticDelayBuffer m_delay_buffer;
+        uint64_t m_delay_version = 0; // SynapseStore::getDelayVersion() ya visto por el CSR
+        uint64_t m_weight_version = 0; // SynapseStore::getWeightVersion() ya visto por el CSR
         
         // Inference-related members
         std::vector<std::string> m_input_neuron_ids;
         std::vector<std::string> m_output_neuron_ids;
+        // Handles resueltos una vez; se invalidan al crear o renombrar neuronas
+        mutable std::vector<NeuronHandle> m_input_handles;
+        mutable std::vector<NeuronHandle> m_output_handles;
+        mutable bool m_io_handles_dirty = true;
+        InferenceStats m_inference_stats;
+        static constexpr size_t BATCH_TILE = 16; // Muestras que avanzan juntas en el bucle interno
         
         // Helper methods for sparse operations
         void addSparseConnection(const std::string& source_id, const std::string& dest_id, double weight, bool is_plastic = false, double learning_rate = 0.0);
         std::shared_ptr<Connection> getSparseConnection(const std::string& source_id, const std::string& dest_id) const;
-        void updateSparseConnections();
+        std::shared_ptr<Connection> addSynapse(const std::shared_ptr<Neuron>& source, const std::shared_ptr<Neuron>& dest, double weight, bool is_plastic, double learning_rate);
+        void compactSynapses();
+        using HandlePairBuffer = std::vector<std::pair<NeuronHandle, NeuronHandle>>;
+        std::vector<NeuronHandle> resolvePopulationHandles(const std::string& pop_name, const char* role) const;
+        // Vuelca buffers de pares (fuente, destino) al store en paralelo, en orden de buffer
+        void appendSynapses(const std::vector<HandlePairBuffer>& buffers, double weight, bool is_plastic, double learning_rate);
+        void rebuildConnectionIndex();
         void convertToSparse();
         void convertFromSparse();
+        void updateParallel();
+        void syncDelayBuffer();
+        void resolveIOHandles() const;
+        bool saveWeightsCSV(const std::string& filepath) const;
+        bool loadWeightsCSV(const std::string& filepath);
+        bool saveWeightsBinary(const std::string& filepath) const;
+        bool loadWeightsBinary(const std::string& filepath);
+        std::unordered_map<uint64_t, SynapseIndex> buildSynapsePairIndex() const;
     };
 
 }
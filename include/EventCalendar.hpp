@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ * Licensed under AGPL v3 License - 17/7/2025
+ */
+
+#ifndef BRAINLL_EVENTCALENDAR_HPP
+#define BRAINLL_EVENTCALENDAR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace brainll {
+
+    /**
+     * Cola de eventos en tiempo simulado (pasos enteros) tipo calendario.
+     *
+     * Una rueda de horizon() cubos, uno por paso, guarda los eventos de [now, now + horizon);
+     * insertar y extraer son O(1). Los eventos más lejanos esperan en un heap de
+     * desbordamiento y bajan a su cubo justo cuando entran en la ventana, así que cada
+     * cubo se entrega en orden de inserción y el resultado no depende del reloj de pared
+     * ni del orden en que el heap desempata.
+     */
+    class EventCalendar {
+    public:
+        struct Event {
+            uint32_t target;   // Índice denso de la neurona destino
+            double stimulus;
+        };
+
+        // horizon se redondea a potencia de dos; conviene que cubra el retardo máximo
+        explicit EventCalendar(size_t horizon = 256) {
+            size_t size = 1;
+            while (size < std::max<size_t>(horizon, 2)) {
+                size <<= 1;
+            }
+            m_buckets.resize(size);
+            m_mask = size - 1;
+        }
+
+        uint64_t now() const { return m_now; }
+        size_t horizon() const { return m_buckets.size(); }
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        // Un paso anterior a now() se entrega en now()
+        void schedule(uint64_t step, uint32_t target, double stimulus) {
+            step = std::max(step, m_now);
+            if (step - m_now < m_buckets.size()) {
+                m_buckets[step & m_mask].push_back({target, stimulus});
+            } else {
+                m_overflow.push({step, m_sequence++, {target, stimulus}});
+            }
+            ++m_size;
+        }
+
+        // Deja en 'due' los eventos del paso now() (en orden de inserción) y avanza un paso
+        void advance(std::vector<Event>& due) {
+            due.clear();
+            due.swap(m_buckets[m_now & m_mask]);
+            m_size -= due.size();
+            ++m_now;
+
+            // El último cubo de la ventana acaba de quedar libre
+            const uint64_t horizon_end = m_now + m_buckets.size();
+            while (!m_overflow.empty() && m_overflow.top().step < horizon_end) {
+                const FarEvent& far = m_overflow.top();
+                m_buckets[far.step & m_mask].push_back(far.event);
+                m_overflow.pop();
+            }
+        }
+
+        // Primer paso con eventos pendientes (now() si no hay ninguno)
+        uint64_t nextEventStep() const {
+            if (m_size == 0) {
+                return m_now;
+            }
+            for (uint64_t step = m_now; step < m_now + m_buckets.size(); ++step) {
+                if (!m_buckets[step & m_mask].empty()) {
+                    return step;
+                }
+            }
+            return m_overflow.top().step;
+        }
+
+        // Vacía la cola sin mover el reloj y deja en 'pending' cada evento con su paso,
+        // por orden de paso y de inserción dentro de cada paso
+        void drain(std::vector<std::pair<uint64_t, Event>>& pending) {
+            for (uint64_t step = m_now; step < m_now + m_buckets.size(); ++step) {
+                auto& bucket = m_buckets[step & m_mask];
+                for (const Event& event : bucket) {
+                    pending.push_back({step, event});
+                }
+                bucket.clear();
+            }
+            while (!m_overflow.empty()) {
+                pending.push_back({m_overflow.top().step, m_overflow.top().event});
+                m_overflow.pop();
+            }
+            m_size = 0;
+        }
+
+        void clear(uint64_t now = 0) {
+            for (auto& bucket : m_buckets) {
+                bucket.clear();
+            }
+            m_overflow = decltype(m_overflow)();
+            m_now = now;
+            m_size = 0;
+            m_sequence = 0;
+        }
+
+    private:
+        struct FarEvent {
+            uint64_t step;
+            uint64_t sequence;   // Desempate FIFO entre eventos del mismo paso
+            Event event;
+
+            bool operator>(const FarEvent& other) const {
+                return step != other.step ? step > other.step : sequence > other.sequence;
+            }
+        };
+
+        std::vector<std::vector<Event>> m_buckets;
+        uint64_t m_mask = 0;
+        std::priority_queue<FarEvent, std::vector<FarEvent>, std::greater<FarEvent>> m_overflow;
+        uint64_t m_now = 0;
+        uint64_t m_sequence = 0;
+        size_t m_size = 0;
+    };
+
+}
+
+#endif // BRAINLL_EVENTCALENDAR_HPP
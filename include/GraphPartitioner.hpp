@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ * Licensed under AGPL v3 License - 17/7/2025
+ */
+
+#ifndef BRAINLL_GRAPHPARTITIONER_HPP
+#define BRAINLL_GRAPHPARTITIONER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace brainll {
+
+    /**
+     * Grafo no dirigido y ponderado en CSR para particionar. Los vértices son índices
+     * densos de neurona; el peso de un vértice es su coste estimado por paso y el de una
+     * arista, cuántas sinapsis unen a sus dos extremos (en cualquier sentido).
+     */
+    struct PartitionGraph {
+        std::vector<size_t> offsets;          // [vértices + 1]
+        std::vector<uint32_t> neighbors;
+        std::vector<double> edge_weights;     // Paralelo a neighbors
+        std::vector<double> vertex_weights;
+
+        size_t vertexCount() const { return vertex_weights.size(); }
+
+        // Simetriza aristas dirigidas (u, v) sumando duplicadas y sentidos opuestos;
+        // descarta lazos y aristas con extremos fuera de rango
+        static PartitionGraph fromEdges(const std::vector<double>& vertex_weights,
+                                        const std::vector<std::pair<uint32_t, uint32_t>>& edges);
+    };
+
+    struct PartitionOptions {
+        size_t parts = 2;
+        double imbalance = 1.05;                // Peso máximo de una parte = objetivo * imbalance
+        std::vector<double> target_fractions;   // Fracción del peso total por parte; vacío = iguales
+        int refinement_passes = 8;
+        size_t coarsen_to = 0;                  // Vértices del grafo más grueso; 0 = 32 por parte
+    };
+
+    struct PartitionResult {
+        std::vector<uint32_t> assignment;       // Parte de cada vértice
+        std::vector<double> part_weights;
+        double edge_cut = 0.0;                  // Peso de las aristas entre partes distintas
+        double total_edge_weight = 0.0;
+        double max_imbalance = 0.0;             // max(peso / objetivo) sobre las partes
+
+        double cutFraction() const { return total_edge_weight > 0.0 ? edge_cut / total_edge_weight : 0.0; }
+    };
+
+    /**
+     * Particionado multinivel al estilo METIS: engrosa el grafo por emparejamiento de
+     * aristas pesadas, hace crecer una región por parte en el grafo más grueso y al
+     * deshacer cada nivel refina la frontera moviendo vértices a la parte con la que
+     * más aristas comparten, sin superar la capacidad de la parte destino. Minimiza el
+     * corte respetando el equilibrio de peso. Es determinista.
+     */
+    class GraphPartitioner {
+    public:
+        static PartitionResult partition(const PartitionGraph& graph, const PartitionOptions& options);
+
+        // Reequilibra una asignación existente hacia options.target_fractions moviendo
+        // solo los vértices necesarios (migración mínima en lugar de reparticionar)
+        static PartitionResult refine(const PartitionGraph& graph, std::vector<uint32_t> assignment,
+                                      const PartitionOptions& options);
+
+        static PartitionResult evaluate(const PartitionGraph& graph, const std::vector<uint32_t>& assignment,
+                                        const PartitionOptions& options);
+    };
+
+}
+
+#endif // BRAINLL_GRAPHPARTITIONER_HPP
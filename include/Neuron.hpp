@@ -11,6 +11,8 @@
 #include <memory>
 #include <functional>
 
+#include "NeuronStore.hpp"
+
 namespace brainll {
 
     // Forward-declare NeuronTypeParams to avoid circular dependency
@@ -22,6 +24,8 @@ public:
     // Constructors
     Neuron(const std::string& id, const std::string& type); // Legacy or for simple types
     Neuron(const std::string& id, const std::string& type, const NeuronTypeParams& params);
+    // Vista sobre una neurona alojada en un NeuronStore compartido (DynamicNetwork)
+    Neuron(const std::string& id, const std::string& type, std::shared_ptr<NeuronStore> store, NeuronHandle handle);
 
     // Métodos para el ciclo de simulación
     void addInput(double value);
@@ -39,6 +43,7 @@ public:
     bool hasFired() const;
     double getActivityLevel() const;
     bool isActive() const;
+    NeuronHandle getHandle() const;
 
     // Setters para modificar el estado
     void setName(const std::string& name);
@@ -47,17 +52,12 @@ public:
 private:
     std::string m_id;
     std::string m_type;
-    std::string m_model;
     std::string m_name; // Nombre opcional definido por el usuario
 
-    double m_potential;
-    double m_input;
-    double m_threshold;
-    bool m_fired_this_cycle;
-    
-    // Parámetros del modelo de neurona (ej. Izhikevich)
-    double m_u; // Variable de recuperación
-    double m_a, m_b, m_c, m_d; // Parámetros del modelo
+    // El estado dinámico (potencial, u, input, parámetros del modelo) vive en el store.
+    // Una neurona independiente es dueña de un store de un solo elemento.
+    std::shared_ptr<NeuronStore> m_store;
+    NeuronHandle m_handle;
 };
 
 }
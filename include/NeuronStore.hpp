@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ * Licensed under AGPL v3 License - 17/7/2025
+ */
+
+#ifndef BRAINLL_NEURONSTORE_HPP
+#define BRAINLL_NEURONSTORE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace brainll {
+
+    // Índice denso de una neurona dentro de un NeuronStore
+    using NeuronHandle = uint32_t;
+    constexpr NeuronHandle INVALID_NEURON_HANDLE = std::numeric_limits<NeuronHandle>::max();
+
+    // Modelos soportados por el integrador de DynamicNetwork
+    enum class NeuronModelKind : uint8_t {
+        NONE = 0,      // Modelo desconocido: solo se evalúa el umbral
+        IZHIKEVICH = 1,
+        LIF = 2
+    };
+
+    NeuronModelKind parseNeuronModelKind(const std::string& model);
+
+    /**
+     * Almacenamiento structure-of-arrays del estado de las neuronas.
+     * Cada campo vive en un vector contiguo indexado por NeuronHandle, de modo que
+     * un paso de simulación recorre memoria lineal en lugar de perseguir punteros.
+     * Los IDs y nombres de texto no se guardan aquí: son una tabla auxiliar de DynamicNetwork.
+     */
+    class NeuronStore {
+    public:
+        NeuronStore() = default;
+
+        NeuronHandle add(NeuronModelKind model, double threshold, double reset_potential,
+                         double a, double b, double d, double initial_potential);
+        void reserve(size_t count);
+        size_t size() const { return m_potential.size(); }
+
+        // --- Simulación ---
+        // Integra todas las neuronas, consume su input y recalcula el bitset de disparos
+        void step();
+        // Igual que step() pero solo para [first_word*64, last_word*64); seguro entre hilos
+        void stepWords(size_t first_word, size_t last_word);
+        bool stepNeuron(NeuronHandle h);
+        void resetAll();
+        void reset(NeuronHandle h);
+
+        // --- Lotes ---
+        // Estado externo de `batch` copias independientes con layout [handle * batch + muestra].
+        // Los parámetros siguen siendo los del store; el bucle interno recorre muestras.
+        // Deja v/u como tras reset(); el input y los disparos quedan a cargo del llamador
+        void initBatch(double* v, double* u, size_t batch) const;
+        // Un paso para todas las copias: fired[i] vale 1.0/0.0 y any_fired[h] indica si
+        // alguna copia de la neurona h disparó. Consume el input igual que step()
+        void stepBatch(double* v, double* u, double* in, double* fired, uint8_t* any_fired, size_t batch) const;
+
+        // --- Bitset de disparos ---
+        // Lectura atómica de la palabra: otros hilos pueden estar escribiendo bits vecinos
+        bool hasFired(NeuronHandle h) const {
+#if defined(_MSC_VER)
+            const uint64_t word = static_cast<uint64_t>(
+                *reinterpret_cast<const volatile long long*>(&m_fired[h >> 6]));
+#else
+            const uint64_t word = __atomic_load_n(&m_fired[h >> 6], __ATOMIC_RELAXED);
+#endif
+            return (word >> (h & 63)) & 1ULL;
+        }
+        void setFired(NeuronHandle h, bool fired);
+        void clearFired();
+        const std::vector<uint64_t>& getFiredWords() const { return m_fired; }
+        size_t getFiredWordCount() const { return m_fired.size(); }
+        size_t countFired() const;
+
+        // --- Acceso al estado ---
+        double& potential(NeuronHandle h) { return m_potential[h]; }
+        double potential(NeuronHandle h) const { return m_potential[h]; }
+        double& recovery(NeuronHandle h) { return m_u[h]; }
+        double recovery(NeuronHandle h) const { return m_u[h]; }
+        double& input(NeuronHandle h) { return m_input[h]; }
+        double input(NeuronHandle h) const { return m_input[h]; }
+        double threshold(NeuronHandle h) const { return m_threshold[h]; }
+        double resetPotential(NeuronHandle h) const { return m_c[h]; }
+        NeuronModelKind model(NeuronHandle h) const { return static_cast<NeuronModelKind>(m_model[h]); }
+
+        double* potentials() { return m_potential.data(); }
+        double* inputs() { return m_input.data(); }
+        const double* potentials() const { return m_potential.data(); }
+        const double* inputs() const { return m_input.data(); }
+
+        size_t getMemoryUsage() const;
+
+        // Un paso del modelo sobre variables sueltas; devuelve true si la neurona dispara
+        static inline bool integrate(NeuronModelKind model, double& v, double& u, double& in,
+                                     double threshold, double a, double b, double c, double d) {
+            switch (model) {
+                case NeuronModelKind::IZHIKEVICH:
+                    // Dos semipasos de 0.5ms para estabilidad
+                    v += 0.5 * (0.04 * v * v + 5.0 * v + 140.0 - u + in);
+                    v += 0.5 * (0.04 * v * v + 5.0 * v + 140.0 - u + in);
+                    u += a * (b * v - u);
+                    break;
+                case NeuronModelKind::LIF:
+                    // dV/dt = (-(V - c) + I) / tau, con dt = 1 y tau = 10 (unidades abstractas)
+                    v += LIF_DT_OVER_TAU * (-(v - c) + in);
+                    break;
+                default:
+                    break;
+            }
+
+            bool fired = v >= threshold;
+            if (fired) {
+                v = c;
+                if (model == NeuronModelKind::IZHIKEVICH) {
+                    u += d;
+                }
+            }
+            in = 0.0;
+            return fired;
+        }
+
+    private:
+        static constexpr double LIF_DT_OVER_TAU = 1.0 / 10.0;
+
+        std::vector<double> m_potential;
+        std::vector<double> m_u;        // Variable de recuperación (Izhikevich)
+        std::vector<double> m_input;
+        std::vector<double> m_threshold;
+        std::vector<double> m_a;
+        std::vector<double> m_b;
+        std::vector<double> m_c;        // Potencial de reseteo
+        std::vector<double> m_d;
+        std::vector<uint8_t> m_model;
+        std::vector<uint64_t> m_fired;  // Un bit por neurona
+    };
+
+}
+
+#endif // BRAINLL_NEURONSTORE_HPP
@@ -12,6 +12,12 @@
 #include <future>
 #include <queue>
 #include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "EventCalendar.hpp"
+#include "GraphPartitioner.hpp"
+#include "SpikeExchange.hpp"
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -67,8 +73,9 @@ public:
     
     // Simulación
     void update();
+    void run(size_t steps); // Varios pasos; en modo por eventos, sincronizando por épocas
     void reset();
-    void updateAsync(); // Simulación asíncrona
+    std::future<void> updateAsync(); // Simulación asíncrona; get() relanza los errores de update()
     
     // Estadísticas y monitoreo
     struct SimulationStats {
@@ -81,15 +88,60 @@ public:
     
     SimulationStats getLastStats() const { return m_last_stats; }
     
-    // Event-driven simulation
-    void scheduleEvent(const std::string& neuron_id, double time, double stimulus);
-    void processEvents(double current_time);
+    // Modo síncrono particionado: una parte por hilo configurado, elegida minimizando las
+    // sinapsis entre partes con carga equilibrada. Cada parte integra sus neuronas y
+    // procesa sus sinapsis entrantes; cada N pasos se reequilibra con el tiempo medido.
+    struct PartitionStats {
+        size_t partitions;
+        double edge_cut_fraction;           // Sinapsis entre partes / total
+        double weight_imbalance;            // max(peso de la parte / objetivo)
+        std::vector<double> step_time_ms;   // Media móvil del tiempo por parte y paso
+        size_t rebalances;
+    };
+    
+    PartitionStats getPartitionStats() const;
+    void setRebalanceInterval(size_t steps) { m_rebalance_interval = steps; } // 0 lo desactiva
     
-    // Distributed simulation
+    // Event-driven simulation. El tiempo es simulado y se mide en pasos enteros: cada
+    // update() en modo "event_driven" procesa un paso y solo integra las neuronas que
+    // reciben eventos o que aún no se han asentado (|dV| por paso > tolerancia);
+    // un spike llega max(Connection::getDelay(), 1) pasos después.
+    //
+    // Las neuronas se reparten en carriles, uno por hilo, con su propia cola. Un spike
+    // hacia otro carril u otro rango no puede llegar antes del retardo mínimo de las
+    // sinapsis cortadas, así que carriles y rangos avanzan épocas de getEpochSteps()
+    // pasos sin sincronizarse y solo intercambian esos spikes al cerrar cada época.
+    // Los eventos de un paso se suman en orden canónico: el resultado no depende del
+    // número de carriles ni de rangos.
+    void scheduleEvent(const std::string& neuron_id, double time, double stimulus); // time en pasos
+    void processEvents(double current_time); // Entrega como input los eventos con paso <= current_time
+    uint64_t getCurrentStep() const { return m_calendar.now(); }
+    size_t getPendingEventCount() const;
+    size_t getEpochSteps() const; // 0 si ninguna sinapsis cruza de carril ni de rango
+    
+    // Distributed simulation. Cada proceso (rango) construye la misma red en el mismo
+    // orden, fija su rango con setNodeId(), dónde escucha con setListenAddress() y dónde
+    // escuchan los demás con addRemoteNode(). synchronizeWithRemoteNodes() conecta la
+    // malla y reparte las neuronas entre rangos minimizando las sinapsis cortadas; desde
+    // entonces update() va por eventos, solo integra las neuronas propias y al cerrar cada
+    // época envía a cada rango los spikes de las neuronas con sinapsis hacia él.
     void enableDistributedMode(bool enable);
     void setNodeId(int node_id);
+    void setListenAddress(const std::string& address, int port); // "unix:/ruta" para socket Unix
     void addRemoteNode(int node_id, const std::string& address, int port);
     void synchronizeWithRemoteNodes();
+    bool ownsNeuron(const std::string& neuron_id) const; // Siempre true fuera del modo distribuido
+    
+    struct DistributedStats {
+        int node_id;
+        size_t ranks;
+        size_t owned_neurons;
+        size_t boundary_neurons;            // Propias con sinapsis hacia otros rangos
+        double edge_cut_fraction;
+        SpikeExchange::Stats exchange;
+    };
+    
+    DistributedStats getDistributedStats() const;
     
     // Dynamic network growth
     void enableDynamicGrowth(bool enable);
@@ -120,6 +172,19 @@ private:
     };
     std::vector<RemoteNode> m_remote_nodes;
     std::mutex m_distributed_mutex;
+    std::string m_listen_address;
+    int m_listen_port;
+    std::unique_ptr<SpikeExchange> m_exchange;
+    std::vector<int> m_rank_ids;                // Rangos ordenados; la posición es la parte
+    size_t m_rank_position;                     // Parte de este proceso
+    std::vector<uint32_t> m_rank_of;            // Parte de cada índice denso
+    std::vector<uint8_t> m_rank_owned;          // Vacío fuera del modo distribuido
+    std::vector<size_t> m_rank_peer_offsets;    // CSR: pares que esperan los spikes de cada neurona
+    std::vector<uint32_t> m_rank_peers;
+    std::vector<std::vector<uint32_t>> m_rank_outbox;
+    std::vector<SpikeExchange::RemoteSpike> m_remote_spikes;
+    double m_rank_cut_fraction;
+    uint32_t m_rank_min_delay;                  // Entre rangos; 0 si ninguna sinapsis cruza
     
     // Dynamic network growth
     bool m_dynamic_growth_enabled;
@@ -128,20 +193,70 @@ private:
     std::atomic<size_t> m_neuron_counter;
     std::mutex m_growth_mutex;
     
-    // Event-driven simulation
-    struct ScheduledEvent {
-        std::string neuron_id;
-        double time;
-        double stimulus;
-        
-        bool operator<(const ScheduledEvent& other) const {
-            return time > other.time; // Para priority_queue (min-heap)
-        }
+    // Event-driven simulation: neuronas con índice denso estable (las eliminadas dejan
+    // un hueco nulo) y sinapsis salientes en CSR por índice de fuente
+    struct EventSynapse {
+        uint32_t target;
+        uint32_t latency;          // En pasos, >= 1
+        Connection* connection;    // Vive mientras esté en m_connections
+    };
+    
+    std::vector<std::shared_ptr<Neuron>> m_event_neurons;
+    std::unordered_map<std::string, uint32_t> m_event_index;
+    std::vector<size_t> m_event_out_offsets;
+    std::vector<EventSynapse> m_event_synapses;
+    bool m_event_topology_dirty;
+    
+    // Carril: parte de las neuronas propias con su propia cola. Durante una época solo
+    // toca las entradas de m_event_input / m_event_active_flag de sus neuronas.
+    struct EventLane {
+        EventCalendar calendar;
+        std::vector<EventCalendar::Event> due;
+        std::vector<uint32_t> active;       // Neuronas a integrar: sin asentar + destinos del paso
+        std::vector<uint32_t> next_active;
+        std::vector<uint32_t> fired;        // Disparadas en el último paso
+        std::vector<SpikeExchange::RemoteSpike> crossing;   // Spikes hacia otros carriles en la época
+        std::vector<SpikeExchange::RemoteSpike> outgoing;   // Spikes hacia otros rangos en la época
+        size_t neurons_updated = 0;
+        size_t deliveries = 0;
     };
     
-    std::priority_queue<ScheduledEvent> m_event_queue;
+    EventCalendar m_calendar;                   // Reloj y eventos externos (scheduleEvent)
+    std::vector<EventCalendar::Event> m_due_events;
+    std::vector<double> m_event_input;          // Input acumulado por índice en el paso
+    std::vector<uint8_t> m_event_active_flag;
+    std::vector<EventLane> m_event_lanes;
+    std::vector<uint32_t> m_lane_of;            // Carril de cada índice; UINT32_MAX si no es propio
+    std::vector<uint8_t> m_lane_boundary;       // Tiene sinapsis hacia otro carril
+    int m_lane_threads;                         // m_thread_count con el que se repartieron
+    bool m_lanes_dirty;
+    uint32_t m_lane_min_delay;                  // Entre carriles; 0 si ninguna sinapsis cruza
+    uint64_t m_epoch_begin;                     // Primer paso de la época abierta
+    size_t m_event_neurons_updated;
+    size_t m_event_deliveries;
+    size_t m_event_fired_count;
     std::mutex m_event_mutex;
     
+    // Particionado por localidad (modo síncrono), sobre los mismos índices densos
+    struct PartitionSynapse {
+        Connection* connection;
+        uint32_t target;                    // Índice denso, o UINT32_MAX si el destino no está registrado
+    };
+    
+    PartitionGraph m_partition_graph;
+    std::vector<uint32_t> m_partition_of;
+    std::vector<std::vector<uint32_t>> m_partition_neurons;
+    std::vector<std::vector<PartitionSynapse>> m_partition_incoming;   // Por parte del destino
+    std::vector<double> m_partition_step_ms;    // Tiempo de cada parte en el paso en curso
+    std::vector<double> m_partition_time_ms;    // Media móvil de m_partition_step_ms
+    std::vector<double> m_sync_input;
+    double m_partition_cut_fraction;
+    double m_partition_imbalance;
+    bool m_partition_dirty;
+    size_t m_rebalance_interval;
+    size_t m_steps_since_rebalance;
+    size_t m_rebalance_count;
+    
     // Estadísticas
     mutable SimulationStats m_last_stats;
     
@@ -152,14 +267,28 @@ private:
     
     // Métodos internos
     void updateSynchronous();
-    void updateEventDriven();
+    void advanceEventDriven(size_t steps);
+    void rebuildEventTopology();
+    void rebuildEventLanes();
+    void catchUpLanes();
+    void stepLane(uint32_t lane_index, uint64_t step);
+    void closeEpoch(uint64_t begin, uint64_t end);
+    void deliverSpikes(uint32_t lane_index, const std::vector<SpikeExchange::RemoteSpike>& spikes);
+    PartitionGraph eventGraph(bool owned_only) const;
+    void rebuildRankBoundary();
+    uint64_t networkFingerprint();
     void updateNeuronsParallel();
     void propagateSignalsParallel();
     void applyPlasticityParallel();
+    template<typename Body>
+    void forEachPartition(Body&& body);
     
     // Optimizaciones específicas
     void partitionNeurons(std::vector<std::vector<std::string>>& partitions);
     void balanceLoad(std::vector<std::vector<std::string>>& partitions);
+    void ensurePartitions();
+    void buildPartitionGraph();
+    void installPartition(const PartitionResult& result, std::vector<std::vector<std::string>>& partitions);
     
     // GPU acceleration (placeholder para futuras implementaciones)
     void updateNeuronsGPU();
@@ -4,12 +4,22 @@
 #include <vector>
 #include <unordered_map>
 #include <memory>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
 #include "Connection.hpp"
+#include "SynapseStore.hpp"
+#include "SynapticDelayBuffer.hpp"
 
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 namespace brainll {
 
 /**
@@ -22,15 +32,23 @@ public:
         size_t target_id;
         double weight;
         std::shared_ptr<Connection> connection_ptr;
+        uint8_t delay; // SynapseRecord::delay
         
-        ConnectionData(size_t target, double w, std::shared_ptr<Connection> conn)
-            : target_id(target), weight(w), connection_ptr(conn) {}
+        ConnectionData(size_t target, double w, std::shared_ptr<Connection> conn, uint8_t d = 0)
+            : target_id(target), weight(w), connection_ptr(conn), delay(d) {}
     };
     
 private:
-    // CSR format: row_ptr[i] apunta al inicio de las conexiones de la neurona i
+    // CSR format: row_ptr[i] apunta al inicio de las conexiones de la neurona i.
+    // Los datos de cada sinapsis se guardan en arrays empaquetados paralelos.
     std::vector<size_t> m_row_ptr;
-    std::vector<ConnectionData> m_connections;
+    std::vector<uint32_t> m_targets;
+    std::vector<double> m_weights;
+    std::vector<double> m_learning_rates; // 0.0 para sinapsis no plásticas
+    std::vector<std::shared_ptr<Connection>> m_connection_ptrs;
+    std::vector<uint8_t> m_latencies;     // Solo si alguna sinapsis tiene latencia > 1
+    bool m_has_plastic;
+    SynapseStore* m_synapse_store = nullptr; // Registros de las vistas, si se compiló desde uno
     
     // Mapeo de IDs de neuronas a índices
     std::unordered_map<std::string, size_t> m_neuron_id_to_index;
@@ -45,7 +63,7 @@ private:
     
 public:
     explicit SparseConnectionMatrix(size_t estimated_neurons = 1000)
-        : m_num_neurons(0), m_num_connections(0), m_is_finalized(false) {
+        : m_has_plastic(false), m_num_neurons(0), m_num_connections(0), m_is_finalized(false) {
         m_neuron_id_to_index.reserve(estimated_neurons);
         m_index_to_neuron_id.reserve(estimated_neurons);
         m_temp_matrix.reserve(estimated_neurons);
@@ -88,6 +106,22 @@ public:
         m_num_connections++;
     }
     
+    /**
+     * Añade una conexión usando índices ya registrados con addNeuron()
+     */
+    void addConnectionByIndex(size_t source_idx, size_t target_idx,
+                              double weight, std::shared_ptr<Connection> connection, uint8_t delay = 0) {
+        if (m_is_finalized) {
+            throw std::runtime_error("Cannot add connections after finalization");
+        }
+        if (source_idx >= m_num_neurons || target_idx >= m_num_neurons) {
+            throw std::out_of_range("Connection index out of range");
+        }
+        
+        m_temp_matrix[source_idx].emplace_back(target_idx, weight, std::move(connection), delay);
+        m_num_connections++;
+    }
+    
     /**
      * Finaliza la construcción y optimiza la estructura
      */
@@ -96,24 +130,44 @@ public:
         
         // Construir CSR format
         m_row_ptr.resize(m_num_neurons + 1);
-        m_connections.reserve(m_num_connections);
+        m_targets.reserve(m_num_connections);
+        m_weights.reserve(m_num_connections);
+        m_learning_rates.reserve(m_num_connections);
+        m_connection_ptrs.reserve(m_num_connections);
+        m_latencies.reserve(m_num_connections);
+        bool has_delays = false;
         
         size_t current_pos = 0;
         for (size_t i = 0; i < m_num_neurons; ++i) {
             m_row_ptr[i] = current_pos;
             
             // Ordenar conexiones por target_id para mejor cache locality
-            std::sort(m_temp_matrix[i].begin(), m_temp_matrix[i].end(),
+            // (estable para que el orden de acumulación sea reproducible)
+            std::stable_sort(m_temp_matrix[i].begin(), m_temp_matrix[i].end(),
                      [](const ConnectionData& a, const ConnectionData& b) {
                          return a.target_id < b.target_id;
                      });
             
             for (const auto& conn : m_temp_matrix[i]) {
-                m_connections.push_back(conn);
+                double learning_rate = 0.0;
+                if (conn.connection_ptr && conn.connection_ptr->isPlastic()) {
+                    learning_rate = conn.connection_ptr->getLearningRate();
+                    m_has_plastic = true;
+                }
+                m_targets.push_back(static_cast<uint32_t>(conn.target_id));
+                m_weights.push_back(conn.weight);
+                m_learning_rates.push_back(learning_rate);
+                m_connection_ptrs.push_back(conn.connection_ptr);
+                m_latencies.push_back(static_cast<uint8_t>(SynapticDelayBuffer::latencyOf(conn.delay)));
+                has_delays = has_delays || m_latencies.back() > 1;
                 current_pos++;
             }
         }
         m_row_ptr[m_num_neurons] = current_pos;
+        if (!has_delays) {
+            m_latencies.clear();
+            m_latencies.shrink_to_fit();
+        }
         
         // Liberar memoria temporal
         m_temp_matrix.clear();
@@ -149,9 +203,8 @@ public:
                 size_t end = m_row_ptr[source + 1];
                 
                 for (size_t i = start; i < end; ++i) {
-                    const auto& conn = m_connections[i];
-                    size_t target = conn.target_id;
-                    double weight = conn.weight;
+                    size_t target = m_targets[i];
+                    double weight = m_weights[i];
                     
 #ifdef _OPENMP
                     #pragma omp atomic
@@ -163,24 +216,168 @@ public:
     }
     
     /**
-     * Actualiza pesos de conexiones con plasticidad
+     * Propaga solo las filas de las neuronas cuyo bit está activo en fired_words.
+     * El coste es proporcional a spikes × fan-out, no al total de sinapsis.
+     */
+    void propagateFiredRows(const std::vector<uint64_t>& fired_words, double* neuron_inputs,
+                            SynapticDelayBuffer* delayed = nullptr) const {
+        propagateFiredRows(fired_words, neuron_inputs, 0, m_num_neurons, delayed);
+    }
+    
+    /**
+     * Igual que la anterior pero solo acumula en destinos de [target_begin, target_end).
+     * Como las filas están ordenadas por destino, cada destino recibe sus entradas en
+     * orden ascendente de fuente sea cual sea la partición: repartir rangos de destino
+     * entre hilos da resultados idénticos bit a bit y sin atomics.
+     * Con 'delayed' activo, las sinapsis de latencia > 1 acumulan en su fila del buffer.
+     */
+    void propagateFiredRows(const std::vector<uint64_t>& fired_words, double* neuron_inputs,
+                            size_t target_begin, size_t target_end,
+                            SynapticDelayBuffer* delayed = nullptr) const {
+        if (!m_is_finalized) {
+            throw std::runtime_error("Matrix must be finalized before propagation");
+        }
+        
+        const bool use_delays = delayed && delayed->active() && !m_latencies.empty();
+        const bool full_range = target_begin == 0 && target_end >= m_num_neurons;
+        const size_t words = std::min(fired_words.size(), (m_num_neurons + 63) / 64);
+        for (size_t w = 0; w < words; ++w) {
+            uint64_t bits = fired_words[w];
+            while (bits) {
+                const size_t source = w * 64 + static_cast<size_t>(countTrailingZeros(bits));
+                bits &= bits - 1;
+                
+                size_t i = m_row_ptr[source];
+                const size_t end = m_row_ptr[source + 1];
+                if (!full_range) {
+                    i = static_cast<size_t>(std::lower_bound(m_targets.begin() + i, m_targets.begin() + end,
+                                                             static_cast<uint32_t>(target_begin)) - m_targets.begin());
+                }
+                for (; i < end; ++i) {
+                    const uint32_t target = m_targets[i];
+                    if (target >= target_end) break;
+                    double* dst = (use_delays && m_latencies[i] > 1) ? delayed->row(m_latencies[i]) : neuron_inputs;
+                    dst[target] += m_weights[i];
+                }
+            }
+        }
+    }
+    
+    /**
+     * Propagación para `batch` copias independientes del estado (layout [neurona * batch + muestra]).
+     * fired contiene 1.0/0.0 por copia y row_active salta las fuentes que no dispararon en
+     * ninguna copia. El bucle interno recorre muestras contiguas y se vectoriza.
+     */
+    void propagateBatch(const double* fired, const uint8_t* row_active,
+                        double* neuron_inputs, size_t batch,
+                        SynapticDelayBuffer* delayed = nullptr) const {
+        if (!m_is_finalized) {
+            throw std::runtime_error("Matrix must be finalized before propagation");
+        }
+        
+        const bool use_delays = delayed && delayed->active() && !m_latencies.empty();
+        for (size_t source = 0; source < m_num_neurons; ++source) {
+            if (!row_active[source]) continue;
+            
+            const double* src = fired + source * batch;
+            const size_t end = m_row_ptr[source + 1];
+            for (size_t i = m_row_ptr[source]; i < end; ++i) {
+                const double w = m_weights[i];
+                double* row = (use_delays && m_latencies[i] > 1) ? delayed->row(m_latencies[i]) : neuron_inputs;
+                double* dst = row + static_cast<size_t>(m_targets[i]) * batch;
+                for (size_t s = 0; s < batch; ++s) {
+                    dst[s] += w * src[s];
+                }
+            }
+        }
+    }
+    
+    /**
+     * Regla de Hebb sobre los arrays empaquetados: solo recorre las filas de
+     * neuronas que dispararon y actualiza las sinapsis cuyo destino también disparó.
+     * El peso resultante se vuelca en el objeto Connection asociado.
+     */
+    void applyHebbianFiredRows(const std::vector<uint64_t>& fired_words) {
+        applyHebbianFiredRows(fired_words, 0, fired_words.size());
+    }
+    
+    /**
+     * Variante restringida a las fuentes de las palabras [first_word, last_word) del bitset.
+     * Cada sinapsis pertenece a una sola fila, así que rangos disjuntos no comparten escrituras.
+     */
+    void applyHebbianFiredRows(const std::vector<uint64_t>& fired_words, size_t first_word, size_t last_word) {
+        if (!m_is_finalized || !m_has_plastic) return;
+        
+        last_word = std::min({last_word, fired_words.size(), (m_num_neurons + 63) / 64});
+        for (size_t w = first_word; w < last_word; ++w) {
+            uint64_t bits = fired_words[w];
+            while (bits) {
+                const size_t source = w * 64 + static_cast<size_t>(countTrailingZeros(bits));
+                bits &= bits - 1;
+                
+                const size_t end = m_row_ptr[source + 1];
+                for (size_t i = m_row_ptr[source]; i < end; ++i) {
+                    const uint32_t target = m_targets[i];
+                    if (m_learning_rates[i] == 0.0 ||
+                        !((fired_words[target >> 6] >> (target & 63)) & 1ULL)) {
+                        continue;
+                    }
+                    storeLearnedWeight(i, Connection::hebbianUpdate(m_weights[i], m_learning_rates[i]));
+                }
+            }
+        }
+    }
+    
+    /**
+     * Actualiza pesos de conexiones con plasticidad. fired_neurons está indexado por
+     * índice de neurona de la matriz; solo se recorren las filas de las fuentes que
+     * dispararon (las que falten en el vector cuentan como inactivas).
      */
     void updatePlasticity(const std::vector<bool>& fired_neurons) {
-        if (!m_is_finalized) return;
+        if (!m_is_finalized || !m_has_plastic) return;
         
+        const size_t rows = std::min(m_num_neurons, fired_neurons.size());
+        // Cada sinapsis pertenece a una sola fila: filas distintas no comparten escrituras
 #ifdef _OPENMP
-        #pragma omp parallel for schedule(static)
+        #pragma omp parallel for schedule(dynamic, 64)
 #endif
-        for (size_t i = 0; i < m_connections.size(); ++i) {
-            auto& conn_data = m_connections[i];
-            if (conn_data.connection_ptr && conn_data.connection_ptr->isPlastic()) {
-                conn_data.connection_ptr->applyPlasticity();
-                // Sincronizar peso actualizado
-                conn_data.weight = conn_data.connection_ptr->getWeight();
+        for (size_t source = 0; source < rows; ++source) {
+            if (!fired_neurons[source]) continue;
+            const size_t end = m_row_ptr[source + 1];
+            for (size_t i = m_row_ptr[source]; i < end; ++i) {
+                const uint32_t target = m_targets[i];
+                if (m_learning_rates[i] == 0.0 || target >= rows || !fired_neurons[target]) {
+                    continue;
+                }
+                storeLearnedWeight(i, Connection::hebbianUpdate(m_weights[i], m_learning_rates[i]));
             }
         }
     }
     
+    /**
+     * Escribe los pesos aprendidos en los registros de 'store' sin pasar por
+     * Connection::setWeight, que cuenta como edición externa y marcaría esta
+     * matriz como desactualizada. Las conexiones deben ser vistas sobre 'store'.
+     */
+    void bindSynapseStore(SynapseStore* store) { m_synapse_store = store; }
+    
+    /**
+     * Copia de nuevo pesos y tasas de aprendizaje desde las conexiones, para
+     * recoger ediciones externas sin recompilar la topología
+     */
+    void refreshWeights() {
+        if (!m_is_finalized) return;
+        
+        m_has_plastic = false;
+        for (size_t i = 0; i < m_connection_ptrs.size(); ++i) {
+            const auto& conn_ptr = m_connection_ptrs[i];
+            if (!conn_ptr) continue;
+            m_weights[i] = conn_ptr->getWeight();
+            m_learning_rates[i] = conn_ptr->isPlastic() ? conn_ptr->getLearningRate() : 0.0;
+            m_has_plastic = m_has_plastic || m_learning_rates[i] != 0.0;
+        }
+    }
+    
     /**
      * Obtiene conexiones salientes de una neurona
      */
@@ -198,7 +395,7 @@ public:
         result.reserve(end - start);
         
         for (size_t i = start; i < end; ++i) {
-            result.push_back(m_connections[i]);
+            result.emplace_back(m_targets[i], m_weights[i], m_connection_ptrs[i]);
         }
         
         return result;
@@ -227,7 +424,11 @@ public:
         // Calcular uso de memoria aproximado
         stats.memory_usage_bytes = 
             m_row_ptr.size() * sizeof(size_t) +
-            m_connections.size() * sizeof(ConnectionData) +
+            m_targets.size() * sizeof(uint32_t) +
+            m_weights.size() * sizeof(double) +
+            m_learning_rates.size() * sizeof(double) +
+            m_connection_ptrs.size() * sizeof(std::shared_ptr<Connection>) +
+            m_latencies.size() * sizeof(uint8_t) +
             m_neuron_id_to_index.size() * (sizeof(std::string) + sizeof(size_t)) +
             m_index_to_neuron_id.size() * sizeof(std::string);
         
@@ -246,7 +447,10 @@ public:
         // (ya se hace en finalize(), pero se puede mejorar aquí)
         
         // Compactar memoria
-        m_connections.shrink_to_fit();
+        m_targets.shrink_to_fit();
+        m_weights.shrink_to_fit();
+        m_learning_rates.shrink_to_fit();
+        m_connection_ptrs.shrink_to_fit();
         m_row_ptr.shrink_to_fit();
     }
     
@@ -271,6 +475,31 @@ public:
         return index < m_index_to_neuron_id.size() ? 
                m_index_to_neuron_id[index] : empty_string;
     }
+    
+private:
+    // Escribe un peso aprendido en la conexión y guarda el valor redondeado (float16)
+    void storeLearnedWeight(size_t i, double weight) {
+        const auto& conn_ptr = m_connection_ptrs[i];
+        if (conn_ptr && m_synapse_store) {
+            SynapseRecord& record = (*m_synapse_store)[conn_ptr->getSynapseIndex()];
+            SynapseStore::storeWeight(record, weight);
+            weight = record.weight;
+        } else if (conn_ptr) {
+            conn_ptr->setWeight(weight);
+            weight = conn_ptr->getWeight();
+        }
+        m_weights[i] = weight;
+    }
+    
+    static inline unsigned countTrailingZeros(uint64_t bits) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+    }
 };
 
 } // namespace brainll
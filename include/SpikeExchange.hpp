@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ * Licensed under AGPL v3 License - 17/7/2025
+ */
+
+#ifndef BRAINLL_SPIKEEXCHANGE_HPP
+#define BRAINLL_SPIKEEXCHANGE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace brainll {
+
+    /**
+     * Dirección de un proceso (rango) de la simulación distribuida. Una dirección
+     * "unix:/ruta" usa un socket Unix (el puerto se ignora); cualquier otra es una
+     * dirección IPv4 para TCP.
+     */
+    struct RankEndpoint {
+        int rank;
+        std::string address;
+        int port;
+    };
+
+    /**
+     * Intercambio de spikes entre procesos por una malla completa de sockets.
+     *
+     * Cada par de rangos comparte una conexión: el de rango mayor se conecta al menor
+     * y ambos comprueban en el saludo que construyeron la misma red (fingerprint).
+     * Los paquetes son binarios y compactos: cabecera {paso: u64, spikes: u32,
+     * flags: u32} seguida de un u32 por spike con el índice denso de la neurona
+     * fuente, en el orden de bytes del host (procesos en la misma máquina o
+     * arquitectura). send() solo encola y escribe lo que el socket acepte sin
+     * bloquear; progress() avanza envíos y recepciones pendientes, así que la
+     * transferencia se solapa con el cómputo local hasta que waitFor() hace falta.
+     */
+    class SpikeExchange {
+    public:
+        struct RemoteSpike {
+            uint64_t step;
+            uint32_t source;
+        };
+
+        struct Stats {
+            uint64_t packets_sent = 0;
+            uint64_t packets_received = 0;
+            uint64_t spikes_sent = 0;
+            uint64_t spikes_received = 0;
+            uint64_t bytes_sent = 0;
+            uint64_t bytes_received = 0;
+            double wait_ms = 0.0;            // Tiempo bloqueado en waitFor()
+        };
+
+        SpikeExchange() = default;
+        ~SpikeExchange();
+
+        SpikeExchange(const SpikeExchange&) = delete;
+        SpikeExchange& operator=(const SpikeExchange&) = delete;
+
+        // Escucha en el endpoint de 'rank' y conecta con todos los demás; devuelve false
+        // (y deja la causa en lastError()) si no lo consigue antes del timeout
+        bool connect(int rank, const std::vector<RankEndpoint>& endpoints, uint64_t fingerprint,
+                     std::chrono::milliseconds timeout = std::chrono::milliseconds(30000));
+        void close();
+
+        bool isConnected() const { return !m_peers.empty() || m_connected_alone; }
+        size_t peerCount() const { return m_peers.size(); }
+        int peerRank(size_t peer) const { return m_peers[peer].rank; }
+        const std::string& lastError() const { return m_error; }
+
+        // Encola los spikes del paso 'step' para un par. epoch_end marca que ese par ya
+        // tiene todos los spikes de este rango hasta 'step' inclusive.
+        void send(size_t peer, uint64_t step, const uint32_t* sources, size_t count, bool epoch_end);
+
+        // E/S sin bloquear; devuelve false si una conexión se cerró o falló
+        bool progress();
+
+        // Bloquea hasta que todos los pares hayan cerrado una época en un paso >= 'step'
+        bool waitFor(uint64_t step, std::chrono::milliseconds timeout = std::chrono::milliseconds(60000));
+
+        // Extrae los spikes recibidos con paso <= 'step', par a par y en orden de
+        // llegada, de modo que el orden no depende de la velocidad de la red
+        void takeReceived(uint64_t step, std::vector<RemoteSpike>& spikes);
+
+        const Stats& getStats() const { return m_stats; }
+
+    private:
+        struct Peer {
+            int rank = -1;
+            int fd = -1;
+            std::vector<uint8_t> outbox;
+            size_t out_offset = 0;           // Bytes de outbox ya escritos
+            std::vector<uint8_t> inbox;      // Bytes recibidos aún sin decodificar
+            std::vector<RemoteSpike> received;
+            uint64_t closed_through = 0;     // Último paso con epoch_end + 1 (0: ninguno)
+            bool closed = false;             // El otro extremo cerró la conexión
+        };
+
+        std::vector<Peer> m_peers;
+        int m_listen_fd = -1;
+        std::string m_unix_path;             // Socket Unix propio, se borra al cerrar
+        bool m_connected_alone = false;
+        std::string m_error;
+        Stats m_stats;
+
+        bool fail(const std::string& message);
+        bool flush(Peer& peer);
+        bool receive(Peer& peer);
+    };
+
+}
+
+#endif // BRAINLL_SPIKEEXCHANGE_HPP
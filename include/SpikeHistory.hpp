@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ * Licensed under AGPL v3 License - 17/7/2025
+ */
+
+#ifndef BRAINLL_SPIKEHISTORY_HPP
+#define BRAINLL_SPIKEHISTORY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace brainll {
+
+    /**
+     * Vista de solo lectura sobre tiempos de spike contiguos y en orden cronológico.
+     * No es dueña de los datos: queda invalidada por el siguiente record(), clear()
+     * o setCapacity() del SpikeHistory que la produjo.
+     */
+    class SpikeTimesView {
+    public:
+        SpikeTimesView() : m_data(nullptr), m_size(0) {}
+        SpikeTimesView(const double* data, size_t size) : m_data(data), m_size(size) {}
+
+        const double* data() const { return m_data; }
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        const double* begin() const { return m_data; }
+        const double* end() const { return m_data + m_size; }
+        double operator[](size_t i) const { return m_data[i]; }
+        double front() const { return m_data[0]; }
+        double back() const { return m_data[m_size - 1]; }
+
+        // Spikes con tiempo >= cutoff (sufijo de la vista), por búsqueda binaria
+        SpikeTimesView since(double cutoff) const {
+            const double* first = std::lower_bound(begin(), end(), cutoff);
+            return SpikeTimesView(first, static_cast<size_t>(end() - first));
+        }
+
+        std::vector<double> toVector() const { return std::vector<double>(begin(), end()); }
+
+    private:
+        const double* m_data;
+        size_t m_size;
+    };
+
+    /**
+     * Historial de spikes de capacidad fija: al llenarse descarta el más antiguo.
+     *
+     * El buffer circular está espejado (cada tiempo se escribe en i y en i + capacidad),
+     * así que los últimos size() spikes siempre ocupan un tramo contiguo y view() no copia.
+     * Los tiempos deben llegar en orden no decreciente; las consultas por ventana son
+     * una búsqueda binaria sobre como mucho capacity() elementos.
+     */
+    class SpikeHistory {
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+        explicit SpikeHistory(size_t capacity = DEFAULT_CAPACITY) { setCapacity(capacity); }
+
+        void record(double time) {
+            m_last = m_size == 0 ? 0 : (m_last + 1) % m_capacity;
+            m_buffer[m_last] = time;
+            m_buffer[m_last + m_capacity] = time;
+            m_size = std::min(m_size + 1, m_capacity);
+            ++m_total;
+        }
+
+        void clear() {
+            m_size = 0;
+            m_last = 0;
+            m_total = 0;
+        }
+
+        // Cambia la capacidad conservando los spikes más recientes que quepan
+        void setCapacity(size_t capacity) {
+            capacity = std::max<size_t>(capacity, 1);
+            const SpikeTimesView kept = view();
+            const size_t keep = std::min(kept.size(), capacity);
+            std::vector<double> buffer(2 * capacity, 0.0);
+            std::copy(kept.end() - keep, kept.end(), buffer.begin());
+            std::copy(kept.end() - keep, kept.end(), buffer.begin() + capacity);
+            m_buffer.swap(buffer);
+            m_capacity = capacity;
+            m_size = keep;
+            m_last = keep == 0 ? 0 : keep - 1;
+        }
+
+        size_t capacity() const { return m_capacity; }
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        bool full() const { return m_size == m_capacity; }
+        uint64_t totalRecorded() const { return m_total; }   // Incluye los ya descartados
+
+        double lastSpikeTime(double fallback = -1.0) const {
+            return m_size == 0 ? fallback : m_buffer[m_last + m_capacity];
+        }
+
+        // Spikes retenidos, del más antiguo al más reciente
+        SpikeTimesView view() const {
+            if (m_size == 0) {
+                return SpikeTimesView();
+            }
+            return SpikeTimesView(m_buffer.data() + m_last + m_capacity + 1 - m_size, m_size);
+        }
+
+        size_t countSince(double cutoff) const { return view().since(cutoff).size(); }
+
+        /**
+         * Tasa de disparo en Hz sobre [now - time_window, now], con tiempos en ms.
+         * Si el buffer lleno ya no cubre la ventana completa, la tasa se estima sobre
+         * el intervalo que sí cubre (desde el spike retenido más antiguo).
+         */
+        double firingRate(double now, double time_window) const {
+            if (m_size == 0 || time_window <= 0.0) {
+                return 0.0;
+            }
+            const double cutoff = now - time_window;
+            const SpikeTimesView recent = view().since(cutoff);
+            double span = time_window;
+            if (full() && recent.size() == m_size && m_total > m_size) {
+                span = now - recent.front();
+                if (span <= 0.0) {
+                    return 0.0;
+                }
+            }
+            return static_cast<double>(recent.size()) * 1000.0 / span;
+        }
+
+    private:
+        std::vector<double> m_buffer;   // [2 * capacidad], mitades espejadas
+        size_t m_capacity = 0;
+        size_t m_size = 0;
+        size_t m_last = 0;              // Posición del spike más reciente en [0, capacidad)
+        uint64_t m_total = 0;
+    };
+
+}
+
+#endif // BRAINLL_SPIKEHISTORY_HPP
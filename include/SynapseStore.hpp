@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ * Licensed under AGPL v3 License - 17/7/2025
+ */
+
+#ifndef BRAINLL_SYNAPSESTORE_HPP
+#define BRAINLL_SYNAPSESTORE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "Connection.hpp"
+#include "NeuronStore.hpp"
+#include "SynapticDelayBuffer.hpp"
+
+namespace brainll {
+
+    // Índice de una sinapsis dentro de un SynapseStore
+    using SynapseIndex = uint32_t;
+
+    enum SynapseFlags : uint8_t {
+        SYNAPSE_PLASTIC = 1 << 0,
+        SYNAPSE_FLOAT16 = 1 << 1  // El peso se redondea a precisión float16 al escribirse
+    };
+
+    /**
+     * Registro compacto de una sinapsis para el camino de simulación.
+     * Solo contiene índices de neurona (NeuronHandle), sin shared_ptr/weak_ptr,
+     * así que recorrerlo no genera tráfico de contadores de referencia.
+     */
+    struct SynapseRecord {
+        NeuronHandle source;
+        NeuronHandle target;
+        float weight;
+        bfloat16 learning_rate; // bfloat16 y no float16: en float16 las tasas < 6.1e-5 se anulaban
+        uint8_t delay;      // En pasos de simulación; 0 y 1 llegan al paso siguiente
+        uint8_t flags;      // SynapseFlags
+
+        bool isPlastic() const { return (flags & SYNAPSE_PLASTIC) != 0; }
+    };
+
+    static_assert(sizeof(SynapseRecord) <= 16, "SynapseRecord must fit in 16 bytes");
+
+    /**
+     * Almacenamiento contiguo de SynapseRecord. Los objetos Connection que entrega
+     * DynamicNetwork son vistas (store + índice) sobre estos registros.
+     */
+    class SynapseStore {
+    public:
+        SynapseStore() = default;
+
+        SynapseIndex add(NeuronHandle source, NeuronHandle target, double weight, bool use_float16 = false);
+        static SynapseRecord makeRecord(NeuronHandle source, NeuronHandle target, double weight, bool use_float16 = false);
+        void reserve(size_t count) { m_records.reserve(count); }
+        void clear() { m_records.clear(); m_max_delay = 0; ++m_delay_version; }
+        size_t size() const { return m_records.size(); }
+
+        SynapseRecord& operator[](SynapseIndex i) { return m_records[i]; }
+        const SynapseRecord& operator[](SynapseIndex i) const { return m_records[i]; }
+        const std::vector<SynapseRecord>& getRecords() const { return m_records; }
+        std::vector<SynapseRecord>& getRecords() { return m_records; }
+
+        // Escribe el peso respetando el modo float16 del registro
+        static void storeWeight(SynapseRecord& record, double weight);
+
+        // Escrituras desde la API (Connection::setWeight, enablePlasticity...): cambian
+        // getWeightVersion() para que las copias compiladas (CSR) se rehagan. Los caminos
+        // de simulación escriben con storeWeight() y mantienen sus copias por sí mismos.
+        // El contador es atómico: ParallelSimulation aplica plasticidad desde varios hilos
+        void setWeight(SynapseIndex i, double weight);
+        void touchWeights();
+        uint64_t getWeightVersion() const;
+
+        // Retardos: getMaxDelay() dimensiona el SynapticDelayBuffer y getDelayVersion()
+        // cambia con cada setDelay() para que las copias compiladas (CSR) se rehagan
+        void setDelay(SynapseIndex i, uint8_t delay);
+        uint8_t getMaxDelay() const { return m_max_delay; }
+        uint64_t getDelayVersion() const { return m_delay_version; }
+        void refreshMaxDelay(); // Tras escribir registros directamente con getRecords()
+
+        // --- Simulación ---
+        // Suma el peso de cada sinapsis cuya fuente disparó en el input de su destino;
+        // con 'delayed' activo, las sinapsis de latencia > 1 van a su fila del buffer
+        void propagate(const std::vector<uint64_t>& fired_words, double* neuron_inputs,
+                       SynapticDelayBuffer* delayed = nullptr) const;
+        // Igual que propagate() para `batch` copias con layout [handle * batch + muestra];
+        // fired vale 1.0/0.0 por copia y any_fired salta fuentes inactivas en todas
+        void propagateBatch(const double* fired, const uint8_t* any_fired, double* neuron_inputs, size_t batch,
+                            SynapticDelayBuffer* delayed = nullptr) const;
+        // Regla de Hebb para sinapsis plásticas con fuente y destino activos
+        void applyHebbian(const std::vector<uint64_t>& fired_words);
+
+        size_t getMemoryUsage() const { return m_records.capacity() * sizeof(SynapseRecord); }
+
+    private:
+        std::vector<SynapseRecord> m_records;
+        uint8_t m_max_delay = 0;
+        uint64_t m_delay_version = 0;
+        uint64_t m_weight_version = 0;
+    };
+
+}
+
+#endif // BRAINLL_SYNAPSESTORE_HPP
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ * Licensed under AGPL v3 License - 17/7/2025
+ */
+
+#ifndef BRAINLL_SYNAPTICDELAYBUFFER_HPP
+#define BRAINLL_SYNAPTICDELAYBUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace brainll {
+
+    /**
+     * Buffer circular de entrada por neurona destino para sinapsis con retardo.
+     *
+     * Guarda depth() filas de width() entradas; la fila (head + L - 1) mod depth acumula
+     * lo que llega L pasos después del paso en curso. Encolar un spike es una suma en
+     * O(1) sin reservar memoria, y cada paso entrega y vacía una sola fila. Las
+     * latencias van de 1 a depth(): con depth() == 1 el buffer no guarda nada y todas
+     * las sinapsis se suman directamente al input del paso siguiente.
+     */
+    class SynapticDelayBuffer {
+    public:
+        // Latencia efectiva en pasos de un SynapseRecord::delay (0 y 1 llegan al paso siguiente)
+        static size_t latencyOf(uint8_t delay) { return delay > 1 ? delay : 1; }
+
+        // Cambia ancho y profundidad conservando las entradas pendientes; las que quedan
+        // más allá de la nueva profundidad se entregan en el último paso que cabe
+        void configure(size_t width, size_t depth) {
+            depth = std::max<size_t>(depth, 1);
+            if (width == m_width && depth == m_depth) {
+                return;
+            }
+            std::vector<double> slots(depth > 1 ? width * depth : 0, 0.0);
+            if (depth > 1 && m_depth > 1) {
+                const size_t keep = std::min(width, m_width);
+                for (size_t k = 0; k < m_depth; ++k) {
+                    const double* src = m_slots.data() + ((m_head + k) % m_depth) * m_width;
+                    double* dst = slots.data() + std::min(k, depth - 1) * width;
+                    for (size_t i = 0; i < keep; ++i) {
+                        dst[i] += src[i];
+                    }
+                }
+            }
+            m_slots.swap(slots);
+            m_width = width;
+            m_depth = depth;
+            m_head = 0;
+        }
+
+        size_t width() const { return m_width; }
+        size_t depth() const { return m_depth; }
+        bool active() const { return m_depth > 1; }
+
+        // Fila que se suma al input 'latency' pasos después del actual (1 <= latency <= depth)
+        double* row(size_t latency) {
+            return m_slots.data() + ((m_head + std::min(latency, m_depth) - 1) % m_depth) * m_width;
+        }
+
+        // Suma la fila que vence en este paso sobre inputs[begin, end) y la deja a cero
+        void deliver(double* inputs, size_t begin, size_t end) {
+            if (!active()) {
+                return;
+            }
+            double* due = m_slots.data() + m_head * m_width;
+            end = std::min(end, m_width);
+            for (size_t i = begin; i < end; ++i) {
+                inputs[i] += due[i];
+                due[i] = 0.0;
+            }
+        }
+
+        void deliver(double* inputs) { deliver(inputs, 0, m_width); }
+
+        // Pasa al paso siguiente; llamar una vez por paso, tras deliver()
+        void advance() {
+            if (active()) {
+                m_head = (m_head + 1) % m_depth;
+            }
+        }
+
+        void clear() {
+            std::fill(m_slots.begin(), m_slots.end(), 0.0);
+            m_head = 0;
+        }
+
+    private:
+        std::vector<double> m_slots;   // [depth][width]
+        size_t m_width = 0;
+        size_t m_depth = 1;
+        size_t m_head = 0;             // Fila que se entrega en el paso en curso
+    };
+
+}
+
+#endif // BRAINLL_SYNAPTICDELAYBUFFER_HPP
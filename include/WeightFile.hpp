@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ * Licensed under AGPL v3 License - 17/7/2025
+ */
+
+#ifndef BRAINLL_WEIGHTFILE_HPP
+#define BRAINLL_WEIGHTFILE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SynapseStore.hpp"
+
+namespace brainll {
+
+    /**
+     * Formato binario de pesos de DynamicNetwork (.bllw), little-endian:
+     *
+     *   WeightFileHeader                      (64 bytes)
+     *   uint64 id_offsets[neuron_count + 1]   Offsets dentro del bloque de caracteres
+     *   char   id_chars[...]                  IDs concatenados, en orden de NeuronHandle
+     *   uint32 sources[synapse_count]         Índices en la tabla de IDs
+     *   uint32 targets[synapse_count]
+     *   float  weights[synapse_count]         (uint16 float16 si WEIGHT_FILE_FLOAT16)
+     *
+     * Cada sección empieza alineada a 8 bytes, así el archivo se puede mapear con mmap
+     * y leer los arrays directamente sin copiarlos.
+     */
+    constexpr char WEIGHT_FILE_MAGIC[8] = {'B', 'L', 'L', 'W', 'G', 'H', 'T', '\0'};
+    constexpr uint32_t WEIGHT_FILE_VERSION = 1;
+
+    enum WeightFileFlags : uint32_t {
+        WEIGHT_FILE_FLOAT16 = 1u << 0
+    };
+
+    struct WeightFileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t flags;
+        uint64_t neuron_count;
+        uint64_t synapse_count;
+        uint64_t id_offsets_offset;
+        uint64_t id_chars_offset;
+        uint64_t indices_offset;
+        uint64_t weights_offset;
+    };
+
+    static_assert(sizeof(WeightFileHeader) == 64, "WeightFileHeader layout must stay fixed");
+
+    // Escribe los registros con índices = NeuronHandle; neuron_ids[h] es el ID del handle h
+    bool writeWeightFile(const std::string& filepath, const std::vector<std::string>& neuron_ids,
+                         const std::vector<SynapseRecord>& records, bool use_float16, std::string& error);
+
+    // true si el archivo empieza con WEIGHT_FILE_MAGIC
+    bool isWeightFile(const std::string& filepath);
+
+    /**
+     * Vista de solo lectura sobre un archivo .bllw mapeado en memoria.
+     * Si la plataforma no permite mmap, el contenido se lee a un buffer interno.
+     */
+    class MappedWeightFile {
+    public:
+        MappedWeightFile() = default;
+        ~MappedWeightFile();
+        MappedWeightFile(const MappedWeightFile&) = delete;
+        MappedWeightFile& operator=(const MappedWeightFile&) = delete;
+
+        bool open(const std::string& filepath);
+        void close();
+        const std::string& getError() const { return m_error; }
+
+        size_t getNeuronCount() const { return static_cast<size_t>(header().neuron_count); }
+        size_t getSynapseCount() const { return static_cast<size_t>(header().synapse_count); }
+        bool isFloat16() const { return (header().flags & WEIGHT_FILE_FLOAT16) != 0; }
+
+        std::string_view getNeuronId(size_t index) const;
+        const uint32_t* getSources() const;
+        const uint32_t* getTargets() const;
+        double getWeight(size_t index) const;
+
+    private:
+        const WeightFileHeader& header() const { return *reinterpret_cast<const WeightFileHeader*>(m_data); }
+        bool validate();
+
+        const uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+        std::vector<uint8_t> m_buffer; // Respaldo cuando no hay mmap
+        void* m_mapping = nullptr;     // Dirección mapeada (POSIX) o handle de mapeo (Windows)
+        void* m_file = nullptr;        // Handle de archivo (Windows)
+        std::string m_error;
+    };
+
+}
+
+#endif // BRAINLL_WEIGHTFILE_HPP
@@ -18,6 +18,8 @@
 #include "../../include/PerformanceAnalyzer.hpp"
 #include "../../include/DebugConfig.hpp"
 #include "../../include/AdvancedNeuralNetwork.hpp"
+#include "../../include/DynamicNetwork.hpp"
+#include "../BIO/neurons/NeuronFactory.hpp"
 #include <vector>
 #include <string>
 #include <map>
@@ -26,6 +28,7 @@
 #include <algorithm>
 #include <cmath>
 #include <random>
+#include <cstdio>
 #include <functional>
 #include <iomanip>
 #include <set>
@@ -357,6 +360,285 @@ private:
             return metrics;
         };
         addBenchmark(energy_test);
+        
+        // DynamicNetwork propagation: per-synapse SynapseStore record path vs compiled CSR
+        const std::vector<std::pair<std::string, size_t>> propagation_sizes = {
+            {"10k", 10000}, {"100k", 100000}, {"1M", 1000000}
+        };
+        for (const auto& size : propagation_sizes) {
+            BenchmarkTest propagation_test("CSR_Propagation_" + size.first,
+                                           "Spike propagation, record path vs CSR rows (" + size.first + " synapses)",
+                                           "Simulation_Performance");
+            const size_t num_synapses = size.second;
+            propagation_test.test_function = [num_synapses]() {
+                return benchmarkPropagation(num_synapses);
+            };
+            addBenchmark(propagation_test);
+        }
+        
+        // DynamicNetwork weight loading: legacy CSV vs memory-mapped binary
+        const std::vector<std::pair<std::string, size_t>> weight_load_sizes = {
+            {"100k", 100000}, {"1M", 1000000}
+        };
+        for (const auto& size : weight_load_sizes) {
+            BenchmarkTest load_test("Weight_Load_" + size.first,
+                                    "Weight file load, CSV vs binary .bllw (" + size.first + " synapses)",
+                                    "Simulation_Performance");
+            const size_t num_synapses = size.second;
+            load_test.test_function = [num_synapses]() {
+                return benchmarkWeightLoad(num_synapses);
+            };
+            addBenchmark(load_test);
+        }
+        
+        // Hodgkin-Huxley: forward Euler per neuron vs table-driven Rush-Larsen population
+        const std::vector<std::pair<std::string, size_t>> hh_sizes = {
+            {"1k", 1000}, {"10k", 10000}
+        };
+        for (const auto& size : hh_sizes) {
+            BenchmarkTest hh_test("HH_Integrator_" + size.first,
+                                  "Hodgkin-Huxley accuracy vs throughput, Euler vs Rush-Larsen (" + size.first + " neurons)",
+                                  "Simulation_Performance");
+            const size_t num_neurons = size.second;
+            hh_test.test_function = [num_neurons]() {
+                return benchmarkHodgkinHuxley(num_neurons);
+            };
+            addBenchmark(hh_test);
+        }
+    }
+    
+    static PerformanceMetrics benchmarkPropagation(size_t num_synapses) {
+        PerformanceMetrics metrics;
+        
+        const size_t fan_out = 100;
+        const size_t num_neurons = std::max<size_t>(num_synapses / fan_out, 2);
+        const int steps = 100;
+        
+        brainll::DynamicNetwork network;
+        brainll::NeuronTypeParams params;
+        params.model = "Izhikevich";
+        network.registerNeuronType("Bench", params);
+        
+        std::vector<std::string> ids;
+        ids.reserve(num_neurons);
+        for (size_t i = 0; i < num_neurons; ++i) {
+            ids.push_back(network.createNeuron("Bench", "bench")->getId());
+        }
+        
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<size_t> pick(0, num_neurons - 1);
+        std::uniform_real_distribution<> weight_dis(0.0, 2.0);
+        for (size_t i = 0; i < num_synapses; ++i) {
+            size_t src = pick(gen);
+            size_t dst = pick(gen);
+            if (src == dst) dst = (dst + 1) % num_neurons;
+            network.createConnection(ids[src], ids[dst], weight_dis(gen));
+        }
+        
+        // Same external drive for both paths: ~5% of neurons per step
+        std::vector<std::vector<brainll::NeuronHandle>> drive(steps);
+        std::uniform_real_distribution<> coin(0.0, 1.0);
+        for (auto& step_drive : drive) {
+            for (size_t h = 0; h < num_neurons; ++h) {
+                if (coin(gen) < 0.05) step_drive.push_back(static_cast<brainll::NeuronHandle>(h));
+            }
+        }
+        
+        size_t total_spikes = 0;
+        auto run = [&](bool count_spikes) {
+            network.reset();
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int step = 0; step < steps; ++step) {
+                for (auto h : drive[step]) {
+                    network.getNeuronStore().input(h) += 20.0;
+                }
+                network.update();
+                if (count_spikes) total_spikes += network.getNeuronStore().countFired();
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            return std::chrono::duration<double, std::milli>(end - start).count() / steps;
+        };
+        
+        double record_step_ms = run(false);
+        network.enableCSRPropagation(true);
+        double csr_step_ms = run(true);
+        
+        metrics.inference_time = csr_step_ms / 1000.0;
+        metrics.memory_usage = static_cast<double>(network.getMemoryUsage());
+        metrics.parameters_count = num_synapses;
+        metrics.custom_metrics["neurons"] = static_cast<double>(num_neurons);
+        metrics.custom_metrics["synapses"] = static_cast<double>(num_synapses);
+        metrics.custom_metrics["record_step_ms"] = record_step_ms;
+        metrics.custom_metrics["csr_step_ms"] = csr_step_ms;
+        metrics.custom_metrics["speedup"] = csr_step_ms > 0.0 ? record_step_ms / csr_step_ms : 0.0;
+        metrics.custom_metrics["spikes_per_step"] = static_cast<double>(total_spikes) / steps;
+        
+        return metrics;
+    }
+    
+    static PerformanceMetrics benchmarkWeightLoad(size_t num_synapses) {
+        PerformanceMetrics metrics;
+        
+        const size_t fan_out = 100;
+        const size_t num_neurons = std::max<size_t>(num_synapses / fan_out, 2);
+        
+        brainll::DynamicNetwork network;
+        brainll::NeuronTypeParams params;
+        params.model = "LIF";
+        network.registerNeuronType("Bench", params);
+        
+        std::vector<std::string> ids;
+        ids.reserve(num_neurons);
+        for (size_t i = 0; i < num_neurons; ++i) {
+            ids.push_back(network.createNeuron("Bench", "bench")->getId());
+        }
+        
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<size_t> pick(0, num_neurons - 1);
+        std::uniform_real_distribution<> weight_dis(0.0, 2.0);
+        for (size_t i = 0; i < num_synapses; ++i) {
+            size_t src = pick(gen);
+            size_t dst = pick(gen);
+            if (src == dst) dst = (dst + 1) % num_neurons;
+            network.createConnection(ids[src], ids[dst], weight_dis(gen));
+        }
+        
+        const std::string csv_path = "benchmark_weights.csv";
+        const std::string binary_path = "benchmark_weights.bllw";
+        network.saveWeights(csv_path, brainll::WeightFileFormat::CSV);
+        network.saveWeights(binary_path, brainll::WeightFileFormat::BINARY);
+        
+        auto time_load = [&](const std::string& path) {
+            auto start = std::chrono::high_resolution_clock::now();
+            network.loadWeights(path);
+            auto end = std::chrono::high_resolution_clock::now();
+            return std::chrono::duration<double, std::milli>(end - start).count();
+        };
+        
+        double csv_load_ms = time_load(csv_path);
+        double binary_load_ms = time_load(binary_path);
+        
+        auto file_size = [](const std::string& path) {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            return file.is_open() ? static_cast<double>(file.tellg()) : 0.0;
+        };
+        metrics.custom_metrics["csv_bytes"] = file_size(csv_path);
+        metrics.custom_metrics["binary_bytes"] = file_size(binary_path);
+        std::remove(csv_path.c_str());
+        std::remove(binary_path.c_str());
+        
+        metrics.inference_time = binary_load_ms / 1000.0;
+        metrics.parameters_count = num_synapses;
+        metrics.custom_metrics["synapses"] = static_cast<double>(num_synapses);
+        metrics.custom_metrics["csv_load_ms"] = csv_load_ms;
+        metrics.custom_metrics["binary_load_ms"] = binary_load_ms;
+        metrics.custom_metrics["speedup"] = binary_load_ms > 0.0 ? csv_load_ms / binary_load_ms : 0.0;
+        
+        return metrics;
+    }
+    
+    static PerformanceMetrics benchmarkHodgkinHuxley(size_t num_neurons) {
+        PerformanceMetrics metrics;
+        
+        using BrainLL::HodgkinHuxleyNeuron;
+        const BrainLL::AdvancedNeuronParams params =
+            BrainLL::NeuronFactory::getDefaultParams(BrainLL::NeuronModel::HODGKIN_HUXLEY);
+        const double drive = 10.0;        // uA/cm^2, tonic firing
+        const double accuracy_ms = 200.0; // Simulated time for the spike-timing comparison
+        const double throughput_ms = 20.0;
+        
+        // Spike times of a single tonically driven neuron
+        auto euler_spikes = [&](double dt) {
+            HodgkinHuxleyNeuron neuron(params);
+            std::vector<double> spikes;
+            const int steps = static_cast<int>(std::lround(accuracy_ms / dt));
+            for (int step = 1; step <= steps; ++step) {
+                neuron.addInput(drive);
+                neuron.update(dt);
+                if (neuron.hasFired()) spikes.push_back(step * dt);
+            }
+            return spikes;
+        };
+        auto population_spikes = [&](double dt) {
+            auto population = BrainLL::NeuronFactory::createPopulation<HodgkinHuxleyNeuron>(1, params);
+            std::vector<double> spikes;
+            const int steps = static_cast<int>(std::lround(accuracy_ms / dt));
+            for (int step = 0; step < steps; ++step) {
+                population->addInput(0, drive);
+                population->update(dt);
+                if (population->hasFired(0)) spikes.push_back(population->getTime());
+            }
+            return spikes;
+        };
+        // Largest spike-time deviation from the reference; a missing or extra spike counts as the full window
+        const std::vector<double> reference = euler_spikes(0.001);
+        auto spike_error = [&](const std::vector<double>& spikes) {
+            if (spikes.size() != reference.size()) return accuracy_ms;
+            double error = 0.0;
+            for (size_t i = 0; i < spikes.size(); ++i) {
+                error = std::max(error, std::abs(spikes[i] - reference[i]));
+            }
+            return error;
+        };
+        
+        // Heterogeneous drive so the population is not in lockstep
+        std::vector<double> currents(num_neurons);
+        for (size_t i = 0; i < num_neurons; ++i) {
+            currents[i] = drive * (0.5 + static_cast<double>(i % 8) / 8.0);
+        }
+        
+        const double euler_dt = 0.01;
+        double euler_ms = 0.0;
+        {
+            std::vector<HodgkinHuxleyNeuron> neurons(num_neurons, HodgkinHuxleyNeuron(params));
+            const int steps = static_cast<int>(std::lround(throughput_ms / euler_dt));
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int step = 0; step < steps; ++step) {
+                for (size_t i = 0; i < num_neurons; ++i) {
+                    neurons[i].addInput(currents[i]);
+                    neurons[i].update(euler_dt);
+                }
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            euler_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        }
+        metrics.custom_metrics["euler_dt0.01_ms"] = euler_ms;
+        metrics.custom_metrics["euler_dt0.01_spike_error_ms"] = spike_error(euler_spikes(euler_dt));
+        metrics.custom_metrics["euler_dt0.1_spike_error_ms"] = spike_error(euler_spikes(0.1));
+        
+        const std::vector<std::pair<std::string, double>> population_dts = {
+            {"0.01", 0.01}, {"0.05", 0.05}, {"0.1", 0.1}
+        };
+        double fastest_ms = euler_ms;
+        for (const auto& entry : population_dts) {
+            const double dt = entry.second;
+            auto population = BrainLL::NeuronFactory::createPopulation<HodgkinHuxleyNeuron>(num_neurons, params);
+            const int steps = static_cast<int>(std::lround(throughput_ms / dt));
+            size_t substeps = 0;
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int step = 0; step < steps; ++step) {
+                population->addInputs(currents.data());
+                population->update(dt);
+                substeps += population->getSubstepCount();
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            const double population_ms = std::chrono::duration<double, std::milli>(end - start).count();
+            
+            const std::string key = "rush_larsen_dt" + entry.first;
+            metrics.custom_metrics[key + "_ms"] = population_ms;
+            metrics.custom_metrics[key + "_spike_error_ms"] = spike_error(population_spikes(dt));
+            metrics.custom_metrics[key + "_substeps_per_step"] =
+                static_cast<double>(substeps) / (static_cast<double>(steps) * num_neurons);
+            metrics.custom_metrics[key + "_speedup"] = population_ms > 0.0 ? euler_ms / population_ms : 0.0;
+            fastest_ms = std::min(fastest_ms, population_ms);
+        }
+        
+        metrics.inference_time = fastest_ms / 1000.0;
+        metrics.parameters_count = num_neurons;
+        metrics.custom_metrics["neurons"] = static_cast<double>(num_neurons);
+        metrics.custom_metrics["simulated_ms"] = throughput_ms;
+        
+        return metrics;
     }
     
     void exportToJSON(const std::string& filename) {
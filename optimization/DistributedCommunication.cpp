@@ -145,17 +145,24 @@ bool DistributedCommunication::sendMessage(const NetworkMessage& message) {
 }
 
 bool DistributedCommunication::broadcastMessage(const NetworkMessage& message) {
-    std::lock_guard<std::mutex> lock(nodes_mutex_);
+    // sendMessage() takes nodes_mutex_ itself, so collect the receivers first
+    std::vector<std::string> receivers;
+    {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        for (const auto& [node_id, node] : nodes_) {
+            if (node_id != local_node_id_) {
+                receivers.push_back(node_id);
+            }
+        }
+    }
     
     bool success = true;
-    for (const auto& [node_id, node] : nodes_) {
-        if (node_id != local_node_id_) {
-            NetworkMessage broadcast_msg = message;
-            broadcast_msg.receiver_id = node_id;
-            
-            if (!sendMessage(broadcast_msg)) {
-                success = false;
-            }
+    for (const auto& node_id : receivers) {
+        NetworkMessage broadcast_msg = message;
+        broadcast_msg.receiver_id = node_id;
+        
+        if (!sendMessage(broadcast_msg)) {
+            success = false;
         }
     }
     
@@ -205,58 +212,37 @@ std::vector<std::string> DistributedCommunication::getActiveNodes() const {
 void DistributedCommunication::startBackgroundThreads() {
     is_running_ = true;
     
-    // Start heartbeat thread
-    heartbeat_thread_ = std::thread(&DistributedCommunication::heartbeatWorker, this);
-    
-    // Start message processing thread
-    message_thread_ = std::thread(&DistributedCommunication::messageWorker, this);
-    
-    // Start network monitoring thread
-    monitor_thread_ = std::thread(&DistributedCommunication::networkMonitor, this);
+    // One service thread handles messages, heartbeats and monitoring; it sleeps on
+    // message_cv_ between deadlines instead of keeping three threads alive
+    service_thread_ = std::thread(&DistributedCommunication::serviceLoop, this);
 }
 
 void DistributedCommunication::shutdown() {
-    is_running_ = false;
+    {
+        // Under the queue lock so the service thread can't miss the wake-up
+        std::lock_guard<std::mutex> lock(message_queue_mutex_);
+        is_running_ = false;
+    }
     
     // Notify all waiting threads
     message_cv_.notify_all();
     
-    // Join threads
-    if (heartbeat_thread_.joinable()) {
-        heartbeat_thread_.join();
-    }
-    if (message_thread_.joinable()) {
-        message_thread_.join();
-    }
-    if (monitor_thread_.joinable()) {
-        monitor_thread_.join();
-    }
-}
-
-void DistributedCommunication::heartbeatWorker() {
-    while (is_running_) {
-        // Send heartbeat to all nodes
-        NetworkMessage heartbeat(MessageType::HEARTBEAT, local_node_id_, "broadcast");
-        heartbeat.data = "ping";
-        
-        broadcastMessage(heartbeat);
-        
-        // Sleep for heartbeat interval
-        std::this_thread::sleep_for(std::chrono::seconds(10));
+    // Join the service thread
+    if (service_thread_.joinable()) {
+        service_thread_.join();
     }
 }
 
-void DistributedCommunication::messageWorker() {
+void DistributedCommunication::serviceLoop() {
+    const auto heartbeat_interval = std::chrono::seconds(10);
+    const auto monitor_interval = std::chrono::seconds(5);
+    auto next_heartbeat = std::chrono::steady_clock::now();
+    auto next_monitor = next_heartbeat;
+    
+    std::unique_lock<std::mutex> lock(message_queue_mutex_);
     while (is_running_) {
-        std::unique_lock<std::mutex> lock(message_queue_mutex_);
-        
-        // Wait for messages or shutdown signal
-        message_cv_.wait(lock, [this] { return !message_queue_.empty() || !is_running_; });
-        
-        if (!is_running_) break;
-        
         // Process messages
-        while (!message_queue_.empty()) {
+        while (!message_queue_.empty() && is_running_) {
             NetworkMessage msg = message_queue_.front();
             message_queue_.pop();
             
@@ -264,22 +250,38 @@ void DistributedCommunication::messageWorker() {
             processMessage(msg);
             lock.lock();
         }
-    }
-}
-
-void DistributedCommunication::networkMonitor() {
-    while (is_running_) {
-        // Check node health
-        checkNodeHealth();
         
-        // Update network statistics
-        updateNetworkMetrics();
+        // Periodic work runs without the queue lock (sendMessage() needs it)
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= next_heartbeat || now >= next_monitor) {
+            lock.unlock();
+            if (now >= next_heartbeat) {
+                sendHeartbeat();
+                next_heartbeat = now + heartbeat_interval;
+            }
+            if (now >= next_monitor) {
+                checkNodeHealth();
+                updateNetworkMetrics();
+                next_monitor = now + monitor_interval;
+            }
+            lock.lock();
+            continue;
+        }
         
-        // Sleep for monitoring interval
-        std::this_thread::sleep_for(std::chrono::seconds(5));
+        // Wait for messages, shutdown or the next deadline
+        message_cv_.wait_until(lock, std::min(next_heartbeat, next_monitor),
+                               [this] { return !message_queue_.empty() || !is_running_; });
     }
 }
 
+void DistributedCommunication::sendHeartbeat() {
+    // Send heartbeat to all nodes
+    NetworkMessage heartbeat(MessageType::HEARTBEAT, local_node_id_, "broadcast");
+    heartbeat.data = "ping";
+    
+    broadcastMessage(heartbeat);
+}
+
 void DistributedCommunication::processMessage(const NetworkMessage& message) {
     switch (message.type) {
         case MessageType::HEARTBEAT:
@@ -0,0 +1,475 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../../include/GraphPartitioner.hpp"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+namespace brainll {
+
+namespace {
+    constexpr uint32_t kUnassigned = std::numeric_limits<uint32_t>::max();
+    constexpr size_t kMaxLevels = 40;
+
+    std::vector<double> partTargets(const PartitionGraph& graph, const PartitionOptions& options) {
+        const size_t parts = std::max<size_t>(options.parts, 1);
+        const double total = std::accumulate(graph.vertex_weights.begin(), graph.vertex_weights.end(), 0.0);
+
+        std::vector<double> fractions(parts, 1.0 / static_cast<double>(parts));
+        if (options.target_fractions.size() == parts) {
+            double sum = 0.0;
+            for (double fraction : options.target_fractions) {
+                sum += std::max(fraction, 0.0);
+            }
+            if (sum > 0.0) {
+                for (size_t p = 0; p < parts; ++p) {
+                    fractions[p] = std::max(options.target_fractions[p], 0.0) / sum;
+                }
+            }
+        }
+
+        std::vector<double> targets(parts);
+        for (size_t p = 0; p < parts; ++p) {
+            targets[p] = total * fractions[p];
+        }
+        return targets;
+    }
+
+    // Emparejamiento de aristas pesadas: cada vértice libre se une al vecino libre con
+    // el que comparte más peso; los de grado bajo se emparejan primero
+    PartitionGraph coarsen(const PartitionGraph& graph, std::vector<uint32_t>& coarse_of, double max_vertex_weight) {
+        const size_t n = graph.vertexCount();
+        std::vector<uint32_t> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            return graph.offsets[a + 1] - graph.offsets[a] < graph.offsets[b + 1] - graph.offsets[b];
+        });
+
+        std::vector<uint32_t> match(n, kUnassigned);
+        for (uint32_t v : order) {
+            if (match[v] != kUnassigned) {
+                continue;
+            }
+            uint32_t best = v;
+            double best_weight = -1.0;
+            for (size_t e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+                const uint32_t u = graph.neighbors[e];
+                if (u == v || match[u] != kUnassigned ||
+                    graph.vertex_weights[v] + graph.vertex_weights[u] > max_vertex_weight) {
+                    continue;
+                }
+                if (graph.edge_weights[e] > best_weight ||
+                    (graph.edge_weights[e] == best_weight && graph.vertex_weights[u] < graph.vertex_weights[best])) {
+                    best = u;
+                    best_weight = graph.edge_weights[e];
+                }
+            }
+            match[v] = best;
+            match[best] = v;
+        }
+
+        coarse_of.assign(n, kUnassigned);
+        std::vector<uint32_t> first_member;
+        for (uint32_t v = 0; v < n; ++v) {
+            if (coarse_of[v] == kUnassigned) {
+                const uint32_t id = static_cast<uint32_t>(first_member.size());
+                coarse_of[v] = id;
+                coarse_of[match[v]] = id;
+                first_member.push_back(v);
+            }
+        }
+
+        const size_t cn = first_member.size();
+        PartitionGraph coarse;
+        coarse.vertex_weights.assign(cn, 0.0);
+        coarse.offsets.assign(1, 0);
+        std::vector<uint32_t> stamp(cn, kUnassigned);
+        std::vector<size_t> slot(cn, 0);
+        for (uint32_t c = 0; c < cn; ++c) {
+            const uint32_t members[2] = {first_member[c], match[first_member[c]]};
+            const int member_count = members[0] == members[1] ? 1 : 2;
+            for (int m = 0; m < member_count; ++m) {
+                const uint32_t v = members[m];
+                coarse.vertex_weights[c] += graph.vertex_weights[v];
+                for (size_t e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+                    const uint32_t cu = coarse_of[graph.neighbors[e]];
+                    if (cu == c) {
+                        continue;
+                    }
+                    if (stamp[cu] != c) {
+                        stamp[cu] = c;
+                        slot[cu] = coarse.neighbors.size();
+                        coarse.neighbors.push_back(cu);
+                        coarse.edge_weights.push_back(graph.edge_weights[e]);
+                    } else {
+                        coarse.edge_weights[slot[cu]] += graph.edge_weights[e];
+                    }
+                }
+            }
+            coarse.offsets.push_back(coarse.neighbors.size());
+        }
+        return coarse;
+    }
+
+    // Crecimiento voraz: cada parte parte de un vértice libre y absorbe el vecino libre
+    // más conectado a ella hasta alcanzar su peso objetivo; la última recoge el resto
+    void growInitial(const PartitionGraph& graph, const std::vector<double>& targets, std::vector<uint32_t>& assignment) {
+        const size_t n = graph.vertexCount();
+        const size_t parts = targets.size();
+        assignment.assign(n, kUnassigned);
+        std::vector<double> connection(n, 0.0);
+        size_t cursor = 0;
+
+        for (size_t p = 0; p + 1 < parts; ++p) {
+            std::priority_queue<std::pair<double, uint32_t>> frontier;   // (conexión, ~índice)
+            double weight = 0.0;
+            while (weight < targets[p]) {
+                uint32_t v = kUnassigned;
+                while (!frontier.empty()) {
+                    const auto top = frontier.top();
+                    frontier.pop();
+                    const uint32_t candidate = ~top.second;
+                    if (assignment[candidate] == kUnassigned && connection[candidate] == top.first) {
+                        v = candidate;
+                        break;
+                    }
+                }
+                if (v == kUnassigned) {
+                    while (cursor < n && assignment[cursor] != kUnassigned) {
+                        ++cursor;
+                    }
+                    if (cursor == n) {
+                        break;
+                    }
+                    v = static_cast<uint32_t>(cursor);
+                }
+                // Detenerse si el vértice deja la parte más lejos del objetivo que sin él
+                const double next = weight + graph.vertex_weights[v];
+                if (weight > 0.0 && next - targets[p] > targets[p] - weight) {
+                    break;
+                }
+                assignment[v] = static_cast<uint32_t>(p);
+                weight = next;
+                for (size_t e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+                    const uint32_t u = graph.neighbors[e];
+                    if (assignment[u] == kUnassigned) {
+                        connection[u] += graph.edge_weights[e];
+                        frontier.push({connection[u], ~u});
+                    }
+                }
+            }
+            std::fill(connection.begin(), connection.end(), 0.0);
+        }
+        for (auto& part : assignment) {
+            if (part == kUnassigned) {
+                part = static_cast<uint32_t>(parts - 1);
+            }
+        }
+    }
+
+    class Refiner {
+    public:
+        Refiner(const PartitionGraph& graph, std::vector<uint32_t>& assignment,
+                const std::vector<double>& targets, double imbalance)
+            : m_graph(graph), m_assignment(assignment), m_targets(targets)
+            , m_weights(targets.size(), 0.0), m_capacity(targets.size()), m_connection(targets.size(), 0.0) {
+            for (size_t v = 0; v < graph.vertexCount(); ++v) {
+                m_weights[assignment[v]] += graph.vertex_weights[v];
+            }
+            for (size_t p = 0; p < targets.size(); ++p) {
+                m_capacity[p] = targets[p] * std::max(imbalance, 1.0);
+            }
+        }
+
+        // Saca vértices de las partes que superan su capacidad, perdiendo el mínimo corte
+        void balance() {
+            const size_t parts = m_targets.size();
+            for (int round = 0; round < 4; ++round) {
+                bool overweight = false;
+                for (size_t p = 0; p < parts; ++p) {
+                    if (m_weights[p] > m_capacity[p]) {
+                        overweight = true;
+                        drain(static_cast<uint32_t>(p));
+                    }
+                }
+                if (!overweight) {
+                    return;
+                }
+            }
+        }
+
+        // Pasadas de refinamiento de frontera; devuelve el número de vértices movidos
+        size_t improve(int passes) {
+            size_t total_moved = 0;
+            for (int pass = 0; pass < passes; ++pass) {
+                size_t moved = 0;
+                for (uint32_t v = 0; v < m_graph.vertexCount(); ++v) {
+                    const uint32_t from = m_assignment[v];
+                    gatherConnections(v);
+                    if (m_touched.size() > 1 || (m_touched.size() == 1 && m_touched[0] != from)) {
+                        const double weight = m_graph.vertex_weights[v];
+                        const double internal = m_connection[from];
+                        uint32_t best = from;
+                        double best_gain = 0.0;
+                        for (uint32_t p : m_touched) {
+                            if (p == from || m_weights[p] + weight > m_capacity[p]) {
+                                continue;
+                            }
+                            const double gain = m_connection[p] - internal;
+                            // A igual corte, mover solo si mejora el equilibrio
+                            const bool balances = gain == 0.0 && best == from &&
+                                                  m_weights[p] + weight < m_weights[from];
+                            if (gain > best_gain || balances) {
+                                best = p;
+                                best_gain = gain;
+                            }
+                        }
+                        if (best != from) {
+                            move(v, best);
+                            ++moved;
+                        }
+                    }
+                    clearConnections();
+                }
+                total_moved += moved;
+                if (moved == 0) {
+                    break;
+                }
+            }
+            return total_moved;
+        }
+
+    private:
+        const PartitionGraph& m_graph;
+        std::vector<uint32_t>& m_assignment;
+        const std::vector<double>& m_targets;
+        std::vector<double> m_weights;
+        std::vector<double> m_capacity;
+        std::vector<double> m_connection;     // Peso de aristas del vértice actual hacia cada parte
+        std::vector<uint32_t> m_touched;
+
+        void gatherConnections(uint32_t v) {
+            for (size_t e = m_graph.offsets[v]; e < m_graph.offsets[v + 1]; ++e) {
+                const uint32_t p = m_assignment[m_graph.neighbors[e]];
+                if (m_connection[p] == 0.0) {
+                    m_touched.push_back(p);
+                }
+                m_connection[p] += m_graph.edge_weights[e];
+            }
+        }
+
+        void clearConnections() {
+            for (uint32_t p : m_touched) {
+                m_connection[p] = 0.0;
+            }
+            m_touched.clear();
+        }
+
+        void move(uint32_t v, uint32_t to) {
+            m_weights[m_assignment[v]] -= m_graph.vertex_weights[v];
+            m_weights[to] += m_graph.vertex_weights[v];
+            m_assignment[v] = to;
+        }
+
+        void drain(uint32_t from) {
+            // Candidatos ordenados por la pérdida de corte al moverlos a su mejor destino
+            struct Candidate {
+                double gain;
+                uint32_t vertex;
+            };
+            std::vector<Candidate> candidates;
+            for (uint32_t v = 0; v < m_graph.vertexCount(); ++v) {
+                if (m_assignment[v] != from) {
+                    continue;
+                }
+                gatherConnections(v);
+                double best = -std::numeric_limits<double>::infinity();
+                for (uint32_t p : m_touched) {
+                    if (p != from) {
+                        best = std::max(best, m_connection[p] - m_connection[from]);
+                    }
+                }
+                if (best == -std::numeric_limits<double>::infinity()) {
+                    best = -m_connection[from];
+                }
+                candidates.push_back({best, v});
+                clearConnections();
+            }
+            std::stable_sort(candidates.begin(), candidates.end(),
+                             [](const Candidate& a, const Candidate& b) { return a.gain > b.gain; });
+
+            for (const auto& candidate : candidates) {
+                if (m_weights[from] <= m_capacity[from]) {
+                    break;
+                }
+                const uint32_t v = candidate.vertex;
+                const double weight = m_graph.vertex_weights[v];
+                gatherConnections(v);
+                // Mejor parte con sitio: la más conectada y, a igualdad, la más descargada
+                uint32_t best = from;
+                double best_score = -std::numeric_limits<double>::infinity();
+                for (uint32_t p = 0; p < m_targets.size(); ++p) {
+                    if (p == from || m_weights[p] + weight > m_capacity[p]) {
+                        continue;
+                    }
+                    const double load = m_targets[p] > 0.0 ? m_weights[p] / m_targets[p] : 1.0;
+                    const double score = m_connection[p] - 1e-9 * load;
+                    if (score > best_score) {
+                        best = p;
+                        best_score = score;
+                    }
+                }
+                clearConnections();
+                if (best != from) {
+                    move(v, best);
+                }
+            }
+        }
+    };
+}
+
+PartitionGraph PartitionGraph::fromEdges(const std::vector<double>& vertex_weights,
+                                         const std::vector<std::pair<uint32_t, uint32_t>>& edges) {
+    const size_t n = vertex_weights.size();
+    std::vector<std::pair<uint32_t, uint32_t>> both;
+    both.reserve(edges.size() * 2);
+    for (const auto& edge : edges) {
+        if (edge.first != edge.second && edge.first < n && edge.second < n) {
+            both.push_back(edge);
+            both.push_back({edge.second, edge.first});
+        }
+    }
+    std::sort(both.begin(), both.end());
+
+    PartitionGraph graph;
+    graph.vertex_weights = vertex_weights;
+    graph.offsets.assign(n + 1, 0);
+    for (size_t i = 0; i < both.size();) {
+        size_t j = i;
+        while (j < both.size() && both[j] == both[i]) {
+            ++j;
+        }
+        graph.neighbors.push_back(both[i].second);
+        graph.edge_weights.push_back(static_cast<double>(j - i));
+        ++graph.offsets[both[i].first + 1];
+        i = j;
+    }
+    for (size_t v = 0; v < n; ++v) {
+        graph.offsets[v + 1] += graph.offsets[v];
+    }
+    return graph;
+}
+
+PartitionResult GraphPartitioner::partition(const PartitionGraph& graph, const PartitionOptions& options) {
+    const size_t parts = std::max<size_t>(options.parts, 1);
+    const size_t n = graph.vertexCount();
+    if (parts == 1 || n == 0) {
+        return evaluate(graph, std::vector<uint32_t>(n, 0), options);
+    }
+
+    // 1. Engrosar hasta unas decenas de vértices por parte o hasta que deje de encoger
+    const size_t coarsen_to = std::max(options.coarsen_to > 0 ? options.coarsen_to : 32 * parts, parts);
+    const double total = std::accumulate(graph.vertex_weights.begin(), graph.vertex_weights.end(), 0.0);
+    const double max_vertex_weight = 1.5 * total / static_cast<double>(coarsen_to);
+
+    std::vector<PartitionGraph> levels;
+    std::vector<std::vector<uint32_t>> coarse_maps;
+    const PartitionGraph* current = &graph;
+    while (current->vertexCount() > coarsen_to && levels.size() < kMaxLevels) {
+        std::vector<uint32_t> coarse_of;
+        PartitionGraph coarse = coarsen(*current, coarse_of, max_vertex_weight);
+        if (coarse.vertexCount() * 20 > current->vertexCount() * 19) {
+            break;
+        }
+        coarse_maps.push_back(std::move(coarse_of));
+        levels.push_back(std::move(coarse));
+        current = &levels.back();
+    }
+
+    // 2. Partición inicial del grafo más grueso
+    const std::vector<double> targets = partTargets(graph, options);
+    std::vector<uint32_t> assignment;
+    growInitial(*current, targets, assignment);
+    {
+        Refiner refiner(*current, assignment, targets, options.imbalance);
+        refiner.balance();
+        refiner.improve(options.refinement_passes);
+    }
+
+    // 3. Deshacer niveles proyectando y refinando la frontera en cada uno
+    for (size_t level = levels.size(); level-- > 0;) {
+        const PartitionGraph& finer = level == 0 ? graph : levels[level - 1];
+        const std::vector<uint32_t>& coarse_of = coarse_maps[level];
+        std::vector<uint32_t> projected(finer.vertexCount());
+        for (size_t v = 0; v < projected.size(); ++v) {
+            projected[v] = assignment[coarse_of[v]];
+        }
+        assignment.swap(projected);
+
+        Refiner refiner(finer, assignment, targets, options.imbalance);
+        refiner.balance();
+        refiner.improve(options.refinement_passes);
+    }
+
+    return evaluate(graph, assignment, options);
+}
+
+PartitionResult GraphPartitioner::refine(const PartitionGraph& graph, std::vector<uint32_t> assignment,
+                                         const PartitionOptions& options) {
+    const size_t parts = std::max<size_t>(options.parts, 1);
+    assignment.resize(graph.vertexCount(), 0);
+    for (auto& part : assignment) {
+        part = std::min<uint32_t>(part, static_cast<uint32_t>(parts - 1));
+    }
+
+    const std::vector<double> targets = partTargets(graph, options);
+    Refiner refiner(graph, assignment, targets, options.imbalance);
+    refiner.balance();
+    refiner.improve(options.refinement_passes);
+    return evaluate(graph, assignment, options);
+}
+
+PartitionResult GraphPartitioner::evaluate(const PartitionGraph& graph, const std::vector<uint32_t>& assignment,
+                                           const PartitionOptions& options) {
+    const size_t parts = std::max<size_t>(options.parts, 1);
+    PartitionResult result;
+    result.assignment = assignment;
+    result.part_weights.assign(parts, 0.0);
+
+    for (size_t v = 0; v < graph.vertexCount(); ++v) {
+        result.part_weights[assignment[v]] += graph.vertex_weights[v];
+        for (size_t e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+            // Cada arista aparece una vez por extremo
+            result.total_edge_weight += 0.5 * graph.edge_weights[e];
+            if (assignment[graph.neighbors[e]] != assignment[v]) {
+                result.edge_cut += 0.5 * graph.edge_weights[e];
+            }
+        }
+    }
+
+    const std::vector<double> targets = partTargets(graph, options);
+    for (size_t p = 0; p < parts; ++p) {
+        if (targets[p] > 0.0) {
+            result.max_imbalance = std::max(result.max_imbalance, result.part_weights[p] / targets[p]);
+        }
+    }
+    return result;
+}
+
+} // namespace brainll
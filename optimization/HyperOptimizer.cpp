@@ -1,4 +1,5 @@
 #include "HyperOptimizer.hpp"
+#include "TaskScheduler.hpp"
 #include <immintrin.h>
 #include <algorithm>
 #include <cmath>
@@ -38,9 +39,8 @@ HyperOptimizer& getHyperOptimizer() {
     return *g_hyper_optimizer;
 }
 
-HyperOptimizer::HyperOptimizer() : global_strategy_(OptimizationStrategy::ADAPTIVE), shutdown_threads_(false) {
+HyperOptimizer::HyperOptimizer() : global_strategy_(OptimizationStrategy::ADAPTIVE) {
     detectHardwareCapabilities();
-    initializeThreadPool();
     
     std::cout << "HyperOptimizer initialized with revolutionary optimizations!" << std::endl;
     std::cout << "Hardware capabilities detected:" << std::endl;
@@ -52,7 +52,6 @@ HyperOptimizer::HyperOptimizer() : global_strategy_(OptimizationStrategy::ADAPTI
 }
 
 HyperOptimizer::~HyperOptimizer() {
-    shutdownThreadPool();
 }
 
 void HyperOptimizer::detectHardwareCapabilities() {
@@ -84,7 +83,7 @@ void HyperOptimizer::detectHardwareCapabilities() {
     
     // Core count
     hw_caps_.num_cores = std::thread::hardware_concurrency();
-    hw_caps_.numa_nodes = 1; // Simplified for now
+    hw_caps_.numa_nodes = getTaskScheduler().numaNodeCount();
     hw_caps_.supports_hyperthreading = hw_caps_.num_cores > 4; // Heuristic
 }
 
@@ -279,27 +278,17 @@ void HyperOptimizer::vectorAddAVX2Ultra(const float* a, const float* b, float* r
 }
 
 void HyperOptimizer::vectorAddParallel(const float* a, const float* b, float* result, size_t size) {
-    const size_t num_threads = std::max(size_t(1), (std::min)(hw_caps_.num_cores, size / 1000));
-    if (num_threads <= 1 || size < 1000) {
+    TaskScheduler& scheduler = getTaskScheduler();
+    if (scheduler.workerCount() == 0 || size < 1000) {
         vectorAddAVX2Ultra(a, b, result, size);
         return;
     }
     
-    const size_t chunk_size = size / num_threads;
-    std::vector<std::future<void>> futures;
-    
-    for (size_t t = 0; t < num_threads; ++t) {
-        size_t start = t * chunk_size;
-        size_t end = (t == num_threads - 1) ? size : start + chunk_size;
-        
-        futures.push_back(std::async(std::launch::async, [=]() {
-            vectorAddAVX2Ultra(&a[start], &b[start], &result[start], end - start);
-        }));
-    }
-    
-    for (auto& future : futures) {
-        future.wait();
-    }
+    // Chunks of at least 4096 floats so the split cost stays negligible
+    const size_t chunk_size = std::max<size_t>(4096, size / (scheduler.concurrency() * 4));
+    scheduler.parallelFor(0, size, chunk_size, [=](size_t start, size_t end) {
+        vectorAddAVX2Ultra(&a[start], &b[start], &result[start], end - start);
+    });
 }
 
 // ============================================================================
@@ -448,58 +437,42 @@ void HyperOptimizer::matrixMatrixMulAVX2Ultra(const float* a, const float* b, fl
 // ============================================================================
 
 void HyperOptimizer::matrixMatrixMulParallel(const float* a, const float* b, float* result, size_t m, size_t n, size_t k) {
-    // Revolutionary parallel matrix multiplication with optimal thread distribution
-    const size_t num_threads = hw_caps_.num_cores;
-    const size_t rows_per_thread = (m + num_threads - 1) / num_threads;
+    // Revolutionary parallel matrix multiplication: row blocks on the shared work-stealing scheduler
+    TaskScheduler& scheduler = getTaskScheduler();
+    const size_t rows_per_task = std::max<size_t>(1, m / (scheduler.concurrency() * 4));
     
     // Initialize result matrix
     std::fill(result, result + m * n, 0.0f);
     
-    std::vector<std::thread> threads;
-    threads.reserve(num_threads);
-    
-    for (size_t t = 0; t < num_threads; ++t) {
-        size_t start_row = t * rows_per_thread;
-        size_t end_row = (std::min)(start_row + rows_per_thread, m);
-        
-        if (start_row < end_row) {
-            threads.emplace_back([=]() {
-                // Each thread processes a block of rows
-                for (size_t i = start_row; i < end_row; ++i) {
-                    for (size_t j = 0; j < n; j += 8) { // Process 8 columns at once with AVX2
-                        size_t cols_to_process = (std::min)(8ULL, n - j);
-                        
-                        if (cols_to_process == 8 && hw_caps_.has_avx2) {
-                            // AVX2 optimized path
-                            __m256 sum = _mm256_setzero_ps();
-                            
-                            for (size_t l = 0; l < k; ++l) {
-                                __m256 a_vec = _mm256_set1_ps(a[i * k + l]);
-                                __m256 b_vec = _mm256_loadu_ps(&b[l * n + j]);
-                                sum = _mm256_fmadd_ps(a_vec, b_vec, sum);
-                            }
-                            
-                            _mm256_storeu_ps(&result[i * n + j], sum);
-                        } else {
-                            // Scalar fallback
-                            for (size_t jj = j; jj < j + cols_to_process; ++jj) {
-                                float sum = 0.0f;
-                                for (size_t l = 0; l < k; ++l) {
-                                    sum += a[i * k + l] * b[l * n + jj];
-                                }
-                                result[i * n + jj] = sum;
-                            }
+    scheduler.parallelFor(0, m, rows_per_task, [=](size_t start_row, size_t end_row) {
+        for (size_t i = start_row; i < end_row; ++i) {
+            for (size_t j = 0; j < n; j += 8) { // Process 8 columns at once with AVX2
+                size_t cols_to_process = (std::min)(size_t(8), n - j);
+                
+                if (cols_to_process == 8 && hw_caps_.has_avx2) {
+                    // AVX2 optimized path
+                    __m256 sum = _mm256_setzero_ps();
+                    
+                    for (size_t l = 0; l < k; ++l) {
+                        __m256 a_vec = _mm256_set1_ps(a[i * k + l]);
+                        __m256 b_vec = _mm256_loadu_ps(&b[l * n + j]);
+                        sum = _mm256_fmadd_ps(a_vec, b_vec, sum);
+                    }
+                    
+                    _mm256_storeu_ps(&result[i * n + j], sum);
+                } else {
+                    // Scalar fallback
+                    for (size_t jj = j; jj < j + cols_to_process; ++jj) {
+                        float sum = 0.0f;
+                        for (size_t l = 0; l < k; ++l) {
+                            sum += a[i * k + l] * b[l * n + jj];
                         }
+                        result[i * n + jj] = sum;
                     }
                 }
-            });
+            }
         }
-    }
-    
-    // Wait for all threads to complete
-    for (auto& thread : threads) {
-        thread.join();
-    }
+    });
 }
 
 void HyperOptimizer::matrixMatrixMulCacheOptimized(const float* a, const float* b, float* result, size_t m, size_t n, size_t k) {
@@ -619,29 +592,6 @@ void HyperOptimizer::updatePerformanceProfile(const std::string& operation, doub
     profile.last_update = std::chrono::steady_clock::now();
 }
 
-void HyperOptimizer::initializeThreadPool() {
-    // Initialize thread pool for parallel operations
-    const size_t num_threads = hw_caps_.num_cores;
-    thread_pool_.reserve(num_threads);
-    
-    for (size_t i = 0; i < num_threads; ++i) {
-        thread_pool_.emplace_back([this]() {
-            while (!shutdown_threads_.load()) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
-            }
-        });
-    }
-}
-
-void HyperOptimizer::shutdownThreadPool() {
-    shutdown_threads_.store(true);
-    for (auto& thread : thread_pool_) {
-        if (thread.joinable()) {
-            thread.join();
-        }
-    }
-}
-
 // ============================================================================
 // PLACEHOLDER IMPLEMENTATIONS
 // ============================================================================
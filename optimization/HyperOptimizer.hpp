@@ -187,10 +187,6 @@ private:
     std::vector<std::unique_ptr<char[]>> memory_pools_;
     std::mutex memory_mutex_;
     
-    // Thread pool for parallel operations
-    std::vector<std::thread> thread_pool_;
-    std::atomic<bool> shutdown_threads_;
-    
     // ============================================================================
     // IMPLEMENTATION METHODS
     // ============================================================================
@@ -226,10 +222,6 @@ private:
     void prefetchMemory(const void* addr, size_t size) const;
     bool isMemoryAligned(const void* ptr, size_t alignment) const;
     
-    // Thread management
-    void initializeThreadPool();
-    void shutdownThreadPool();
-    
     // Fast math implementations
     float fastSigmoidApprox(float x) const;
     float fastTanhApprox(float x) const;
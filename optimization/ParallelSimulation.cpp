@@ -19,6 +19,7 @@
 #include "../../include/DebugConfig.hpp"
 #include "../../include/Neuron.hpp"
 #include "../../include/Connection.hpp"
+#include "TaskScheduler.hpp"
 #include <algorithm>
 #include <chrono>
 #include <iostream>
@@ -27,6 +28,8 @@
 #include <tuple>
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
+#include <cmath>
 
 #ifdef _WIN32
 #define NOMINMAX
@@ -44,9 +47,6 @@
 #include "../../include/CudaKernels.hpp"
 #endif
 
-#ifdef _OPENMP
-#include <omp.h>
-#endif
 
 #ifdef __AVX2__
 #include <immintrin.h>
@@ -64,17 +64,33 @@ ParallelSimulation::ParallelSimulation()
     , m_simulation_mode("synchronous")
     , m_distributed_enabled(false)
     , m_node_id(0)
+    , m_listen_address("127.0.0.1")
+    , m_listen_port(0)
+    , m_rank_position(0)
+    , m_rank_cut_fraction(0.0)
+    , m_rank_min_delay(0)
     , m_dynamic_growth_enabled(false)
     , m_growth_rate(0.01)
     , m_max_neurons(10000)
-    , m_neuron_counter(0) {
-    
-    // Configurar número de hilos OpenMP
-#ifdef _OPENMP
-    m_thread_count = omp_get_max_threads();
-#else
-    m_thread_count = 1;
-#endif
+    , m_neuron_counter(0)
+    , m_event_topology_dirty(true)
+    , m_lane_threads(0)
+    , m_lanes_dirty(true)
+    , m_lane_min_delay(0)
+    , m_epoch_begin(0)
+    , m_event_neurons_updated(0)
+    , m_event_deliveries(0)
+    , m_event_fired_count(0)
+    , m_partition_cut_fraction(0.0)
+    , m_partition_imbalance(0.0)
+    , m_partition_dirty(true)
+    , m_rebalance_interval(100)
+    , m_steps_since_rebalance(0)
+    , m_rebalance_count(0) {
+    
+    // Los hilos son los del TaskScheduler global; m_thread_count fija en cuántos trozos
+    // se reparte cada fase
+    m_thread_count = static_cast<int>(BrainLL::getTaskScheduler().concurrency());
     
     std::cout << "ParallelSimulation initialized with " << m_thread_count << " threads" << std::endl;
 }
@@ -122,21 +138,18 @@ void ParallelSimulation::enableGPUAcceleration(bool enable) {
 }
 
 void ParallelSimulation::setThreadCount(int thread_count) {
-    m_thread_count = thread_count;
-#ifdef _OPENMP
-    if (thread_count > 0) {
-        omp_set_num_threads(thread_count);
-    }
-#endif
+    // No toca el pool compartido: solo cambia el reparto de trabajo de esta simulación
+    m_thread_count = std::max(1, thread_count);
 }
 
 void ParallelSimulation::setSimulationMode(const std::string& mode) {
     m_simulation_mode = mode;
     if (mode == "event_driven") {
-        // Inicializar cola de eventos
+        // Inicializar cola de eventos (el reloj simulado se conserva)
         std::lock_guard<std::mutex> lock(m_event_mutex);
-        while (!m_event_queue.empty()) {
-            m_event_queue.pop();
+        m_calendar.clear(m_calendar.now());
+        for (auto& lane : m_event_lanes) {
+            lane.calendar.clear(m_calendar.now());
         }
     }
 }
@@ -149,6 +162,17 @@ void ParallelSimulation::addNeuron(std::shared_ptr<Neuron> neuron) {
     auto result = m_neuron_connections.emplace(std::piecewise_construct,
                                                std::forward_as_tuple(neuron_id),
                                                std::forward_as_tuple());
+    
+    // Índice denso para el modo por eventos; se reutiliza si el ID ya estaba registrado
+    auto index_it = m_event_index.find(neuron_id);
+    if (index_it != m_event_index.end()) {
+        m_event_neurons[index_it->second] = neuron;
+    } else {
+        m_event_index[neuron_id] = static_cast<uint32_t>(m_event_neurons.size());
+        m_event_neurons.push_back(neuron);
+    }
+    m_event_topology_dirty = true;
+    m_partition_dirty = true;
 }
 
 void ParallelSimulation::removeNeuron(const std::string& neuron_id) {
@@ -162,13 +186,22 @@ void ParallelSimulation::removeNeuron(const std::string& neuron_id) {
             m_neuron_connections.erase(conn_it);
         }
         
-        // Remover neurona
+        // Remover neurona; su índice queda vacío y los eventos pendientes hacia él se descartan
         m_neurons.erase(neuron_it);
+        auto index_it = m_event_index.find(neuron_id);
+        if (index_it != m_event_index.end()) {
+            m_event_neurons[index_it->second].reset();
+            m_event_index.erase(index_it);
+        }
+        m_event_topology_dirty = true;
+        m_partition_dirty = true;
     }
 }
 
 void ParallelSimulation::addConnection(std::shared_ptr<Connection> connection) {
     m_connections.push_back(connection);
+    m_event_topology_dirty = true;
+    m_partition_dirty = true;
     
     // Actualizar estructuras de conexión
     std::string source_id = connection->getSourceNeuron()->getId();
@@ -187,6 +220,8 @@ void ParallelSimulation::removeConnection(std::shared_ptr<Connection> connection
     auto it = std::find(m_connections.begin(), m_connections.end(), connection);
     if (it != m_connections.end()) {
         m_connections.erase(it);
+        m_event_topology_dirty = true;
+        m_partition_dirty = true;
         
         // Remover de estructuras de conexión
         std::string source_id = connection->getSourceNeuron()->getId();
@@ -206,12 +241,18 @@ void ParallelSimulation::removeConnection(std::shared_ptr<Connection> connection
 }
 
 void ParallelSimulation::update() {
+    run(1);
+}
+
+void ParallelSimulation::run(size_t steps) {
     auto start_time = std::chrono::high_resolution_clock::now();
     
     if (m_simulation_mode == "synchronous") {
-        updateSynchronous();
+        for (size_t i = 0; i < steps; ++i) {
+            updateSynchronous();
+        }
     } else {
-        updateEventDriven();
+        advanceEventDriven(steps);
     }
     
     auto end_time = std::chrono::high_resolution_clock::now();
@@ -219,15 +260,22 @@ void ParallelSimulation::update() {
     
     // Actualizar estadísticas de rendimiento
     m_last_stats.update_time_ms = duration.count() / 1000.0;
-    m_last_stats.neurons_updated = m_neurons.size();
-    m_last_stats.connections_processed = m_connections.size();
-    m_last_stats.active_neurons = 0;
-    
-    // Contar neuronas activas
-    for (const auto& pair : m_neurons) {
-        if (pair.second->hasFired()) {
-            m_last_stats.active_neurons++;
+    if (m_simulation_mode == "synchronous") {
+        m_last_stats.neurons_updated = m_neurons.size() * steps;
+        m_last_stats.connections_processed = m_connections.size() * steps;
+        m_last_stats.active_neurons = 0;
+        
+        // Contar neuronas activas
+        for (const auto& pair : m_neurons) {
+            if (pair.second->hasFired()) {
+                m_last_stats.active_neurons++;
+            }
         }
+    } else {
+        // Solo cuenta el trabajo hecho: neuronas integradas y eventos entregados
+        m_last_stats.neurons_updated = m_event_neurons_updated;
+        m_last_stats.connections_processed = m_event_deliveries;
+        m_last_stats.active_neurons = m_event_fired_count;
     }
     
     if (m_last_stats.update_time_ms > 0) {
@@ -236,6 +284,9 @@ void ParallelSimulation::update() {
 }
 
 void ParallelSimulation::updateSynchronous() {
+    ensurePartitions();
+    std::fill(m_partition_step_ms.begin(), m_partition_step_ms.end(), 0.0);
+    
     // Fase 1: Propagar señales en paralelo
     propagateSignalsParallel();
     
@@ -244,160 +295,586 @@ void ParallelSimulation::updateSynchronous() {
     
     // Fase 3: Aplicar plasticidad en paralelo
     applyPlasticityParallel();
+    
+    // Media móvil del tiempo por parte; si una parte tarda claramente más que la media,
+    // reequilibrar hacia las más rápidas
+    double total_ms = 0.0;
+    double slowest_ms = 0.0;
+    for (size_t p = 0; p < m_partition_time_ms.size(); ++p) {
+        const double previous = m_partition_time_ms[p];
+        m_partition_time_ms[p] = previous > 0.0 ? 0.9 * previous + 0.1 * m_partition_step_ms[p]
+                                                : m_partition_step_ms[p];
+        total_ms += m_partition_time_ms[p];
+        slowest_ms = std::max(slowest_ms, m_partition_time_ms[p]);
+    }
+    if (m_rebalance_interval > 0 && ++m_steps_since_rebalance >= m_rebalance_interval) {
+        m_steps_since_rebalance = 0;
+        const double mean_ms = total_ms / std::max<size_t>(m_partition_time_ms.size(), 1);
+        if (m_partition_time_ms.size() > 1 && slowest_ms > 1.1 * mean_ms) {
+            std::vector<std::vector<std::string>> partitions;
+            balanceLoad(partitions);
+        }
+    }
 }
 
-void ParallelSimulation::updateEventDriven() {
-    auto current_time = std::chrono::high_resolution_clock::now();
-    double time_ms = std::chrono::duration<double, std::milli>(current_time.time_since_epoch()).count();
-    
+void ParallelSimulation::advanceEventDriven(size_t steps) {
     std::lock_guard<std::mutex> lock(m_event_mutex);
+    if (m_event_topology_dirty) {
+        rebuildEventTopology();
+    }
+    if (m_lanes_dirty || m_lane_threads != m_thread_count) {
+        rebuildEventLanes();
+    }
+    catchUpLanes();
+    for (auto& lane : m_event_lanes) {
+        lane.neurons_updated = 0;
+        lane.deliveries = 0;
+    }
+    
+    const uint64_t epoch = getEpochSteps();
+    uint64_t step = m_calendar.now();
+    const uint64_t last = step + steps;
+    while (step < last) {
+        // La época acaba en el siguiente múltiplo de su longitud, así que todos los rangos
+        // con la misma longitud cierran en los mismos pasos. Puede abarcar varias llamadas:
+        // update() paso a paso solo sincroniza al llegar al final de la época.
+        uint64_t end = last;
+        bool closes = true;
+        if (epoch > 0) {
+            const uint64_t boundary = (step / epoch + 1) * epoch;
+            closes = boundary <= last;
+            end = std::min(end, boundary);
+        }
+        
+        // Eventos externos de la época, a la cola del carril de su destino
+        for (uint64_t s = step; s < end; ++s) {
+            m_calendar.advance(m_due_events);
+            for (const auto& event : m_due_events) {
+                if (event.target < m_lane_of.size() && m_lane_of[event.target] != UINT32_MAX) {
+                    m_event_lanes[m_lane_of[event.target]].calendar.schedule(s, event.target, event.stimulus);
+                }
+            }
+        }
+        
+        // Cada carril avanza la época entera sin esperar a los demás
+        if (m_event_lanes.size() == 1) {
+            for (uint64_t s = step; s < end; ++s) {
+                stepLane(0, s);
+            }
+        } else {
+            BrainLL::getTaskScheduler().parallelFor(0, m_event_lanes.size(), 1, [&](size_t begin, size_t finish) {
+                for (size_t lane = begin; lane < finish; ++lane) {
+                    for (uint64_t s = step; s < end; ++s) {
+                        stepLane(static_cast<uint32_t>(lane), s);
+                    }
+                }
+            });
+        }
+        
+        if (closes) {
+            closeEpoch(m_epoch_begin, end);
+            m_epoch_begin = end;
+        }
+        step = end;
+    }
+    
+    m_event_neurons_updated = 0;
+    m_event_deliveries = 0;
+    m_event_fired_count = 0;
+    for (const auto& lane : m_event_lanes) {
+        m_event_neurons_updated += lane.neurons_updated;
+        m_event_deliveries += lane.deliveries;
+        m_event_fired_count += lane.fired.size();
+    }
+}
+
+void ParallelSimulation::stepLane(uint32_t lane_index, uint64_t step) {
+    EventLane& lane = m_event_lanes[lane_index];
     
-    // Procesar eventos que deben ejecutarse ahora
-    std::vector<ScheduledEvent> events_to_process;
-    while (!m_event_queue.empty() && m_event_queue.top().time <= time_ms) {
-        events_to_process.push_back(m_event_queue.top());
-        m_event_queue.pop();
+    // Las neuronas sin eventos no se integran, así que su disparo del paso anterior caduca aquí
+    for (uint32_t index : lane.fired) {
+        if (m_event_neurons[index]) {
+            m_event_neurons[index]->resetFiredFlag();
+        }
+    }
+    lane.fired.clear();
+    
+    // 1. Eventos de este paso en orden canónico (destino, estímulo): la suma no depende
+    //    de en qué orden llegaron ni de qué carril o rango los generó. Los destinos
+    //    nuevos se añaden a las neuronas activas.
+    lane.calendar.advance(lane.due);
+    std::sort(lane.due.begin(), lane.due.end(), [](const EventCalendar::Event& a, const EventCalendar::Event& b) {
+        return a.target != b.target ? a.target < b.target : a.stimulus < b.stimulus;
+    });
+    for (const auto& event : lane.due) {
+        if (!m_event_neurons[event.target]) {
+            continue;
+        }
+        if (!m_event_active_flag[event.target]) {
+            m_event_active_flag[event.target] = 1;
+            lane.active.push_back(event.target);
+        }
+        m_event_input[event.target] += event.stimulus;
     }
     
-    // Procesar eventos en paralelo si hay suficientes
-    if (events_to_process.size() > 10) {
-#ifdef _OPENMP
-        #pragma omp parallel for schedule(dynamic)
-#endif
-        for (int i = 0; i < static_cast<int>(events_to_process.size()); ++i) {
-            const auto& event = events_to_process[i];
-            auto neuron_it = m_neurons.find(event.neuron_id);
-            if (neuron_it != m_neurons.end()) {
-                neuron_it->second->addInput(event.stimulus);
-                neuron_it->second->update();
-                
-                // Si la neurona dispara, programar eventos para sus conexiones
-                if (neuron_it->second->hasFired()) {
-                    auto conn_it = m_neuron_connections.find(event.neuron_id);
-                    if (conn_it != m_neuron_connections.end()) {
-                        for (auto& connection : conn_it->second.outgoing) {
-                            double delay = connection->getDelay();
-                            double weight = connection->getWeight();
-                            std::string target_id = connection->getDestinationNeuron()->getId();
-                            
-                            // Programar evento futuro
-                            ScheduledEvent future_event;
-                            future_event.neuron_id = target_id;
-                            future_event.time = time_ms + delay;
-                            future_event.stimulus = weight;
-                            
-                            // Agregar a cola de forma thread-safe
-                            #pragma omp critical
-                            {
-                                m_event_queue.push(future_event);
-                            }
-                        }
+    // 2. Integrar una vez cada neurona activa. Sigue activa mientras dispare o su potencial
+    //    cambie más que la tolerancia; el resto se considera en reposo hasta su próximo evento.
+    constexpr double kQuiescentDeltaV = 1e-3;
+    lane.next_active.clear();
+    for (uint32_t index : lane.active) {
+        auto& neuron = m_event_neurons[index];
+        if (!neuron) {
+            m_event_active_flag[index] = 0;
+            continue;
+        }
+        const double previous = neuron->getPotential();
+        neuron->addInput(m_event_input[index]);
+        m_event_input[index] = 0.0;
+        neuron->update();
+        const bool fired = neuron->hasFired();
+        if (fired) {
+            lane.fired.push_back(index);
+        }
+        if (fired || std::abs(neuron->getPotential() - previous) > kQuiescentDeltaV) {
+            lane.next_active.push_back(index);
+        } else {
+            m_event_active_flag[index] = 0;
+        }
+    }
+    lane.neurons_updated += lane.active.size();
+    lane.deliveries += lane.due.size();
+    lane.active.swap(lane.next_active);
+    
+    // 3. Los spikes hacia el propio carril van directos a su cola; los que cruzan de carril
+    //    o de rango esperan al cierre de la época, que llega antes que el más rápido de ellos
+    for (uint32_t index : lane.fired) {
+        for (size_t i = m_event_out_offsets[index]; i < m_event_out_offsets[index + 1]; ++i) {
+            const EventSynapse& synapse = m_event_synapses[i];
+            if (m_lane_of[synapse.target] == lane_index) {
+                lane.calendar.schedule(step + synapse.latency, synapse.target, synapse.connection->getWeight());
+            }
+        }
+        if (m_lane_boundary[index]) {
+            lane.crossing.push_back({step, index});
+        }
+        if (index + 1 < m_rank_peer_offsets.size() && m_rank_peer_offsets[index + 1] > m_rank_peer_offsets[index]) {
+            lane.outgoing.push_back({step, index});
+        }
+    }
+}
+
+void ParallelSimulation::closeEpoch(uint64_t begin, uint64_t end) {
+    const bool distributed = m_exchange && m_exchange->peerCount() > 0 && !m_rank_owned.empty();
+    
+    // 1. Enviar a cada rango los spikes de la época que le afectan, un paquete por paso
+    //    con spikes; el último paso se envía siempre y cierra la época para el receptor
+    if (distributed) {
+        m_rank_outbox.resize(m_exchange->peerCount());
+        std::vector<size_t> cursor(m_event_lanes.size(), 0);
+        for (uint64_t step = begin; step < end; ++step) {
+            for (size_t l = 0; l < m_event_lanes.size(); ++l) {
+                const auto& outgoing = m_event_lanes[l].outgoing;
+                for (; cursor[l] < outgoing.size() && outgoing[cursor[l]].step == step; ++cursor[l]) {
+                    const uint32_t source = outgoing[cursor[l]].source;
+                    for (size_t k = m_rank_peer_offsets[source]; k < m_rank_peer_offsets[source + 1]; ++k) {
+                        m_rank_outbox[m_rank_peers[k]].push_back(source);
                     }
                 }
             }
+            const bool epoch_end = step + 1 == end;
+            for (size_t peer = 0; peer < m_rank_outbox.size(); ++peer) {
+                if (epoch_end || !m_rank_outbox[peer].empty()) {
+                    m_exchange->send(peer, step, m_rank_outbox[peer].data(), m_rank_outbox[peer].size(), epoch_end);
+                    m_rank_outbox[peer].clear();
+                }
+            }
         }
-    } else {
-        // Procesar secuencialmente si hay pocos eventos
-        for (const auto& event : events_to_process) {
-            auto neuron_it = m_neurons.find(event.neuron_id);
-            if (neuron_it != m_neurons.end()) {
-                neuron_it->second->addInput(event.stimulus);
-                neuron_it->second->update();
-                
-                // Programar eventos futuros si la neurona dispara
-                if (neuron_it->second->hasFired()) {
-                    auto conn_it = m_neuron_connections.find(event.neuron_id);
-                    if (conn_it != m_neuron_connections.end()) {
-                        for (auto& connection : conn_it->second.outgoing) {
-                            double delay = connection->getDelay();
-                            double weight = connection->getWeight();
-                            std::string target_id = connection->getDestinationNeuron()->getId();
-                            
-                            ScheduledEvent future_event;
-                            future_event.neuron_id = target_id;
-                            future_event.time = time_ms + delay;
-                            future_event.stimulus = weight;
-                            
-                            m_event_queue.push(future_event);
-                        }
+        for (auto& lane : m_event_lanes) {
+            lane.outgoing.clear();
+        }
+    }
+    
+    // 2. Mientras los paquetes viajan, entregar los spikes entre carriles
+    BrainLL::TaskScheduler& scheduler = BrainLL::getTaskScheduler();
+    if (m_event_lanes.size() > 1) {
+        scheduler.parallelFor(0, m_event_lanes.size(), 1, [&](size_t first, size_t last) {
+            for (size_t lane = first; lane < last; ++lane) {
+                for (size_t source = 0; source < m_event_lanes.size(); ++source) {
+                    if (source != lane) {
+                        deliverSpikes(static_cast<uint32_t>(lane), m_event_lanes[source].crossing);
                     }
                 }
             }
+        });
+        for (auto& lane : m_event_lanes) {
+            lane.crossing.clear();
+        }
+    }
+    
+    // 3. Esperar los spikes de la época de los demás rangos y entregarlos
+    if (distributed) {
+        if (!m_exchange->waitFor(end - 1)) {
+            throw std::runtime_error("Distributed spike exchange failed: " + m_exchange->lastError());
         }
+        m_exchange->takeReceived(end - 1, m_remote_spikes);
+        scheduler.parallelFor(0, m_event_lanes.size(), 1, [&](size_t first, size_t last) {
+            for (size_t lane = first; lane < last; ++lane) {
+                deliverSpikes(static_cast<uint32_t>(lane), m_remote_spikes);
+            }
+        });
     }
 }
 
-void ParallelSimulation::propagateSignalsParallel() {
-#ifdef _OPENMP
-    #pragma omp parallel for schedule(dynamic)
-#endif
-    for (int i = 0; i < static_cast<int>(m_connections.size()); ++i) {
-        auto& connection = m_connections[i];
-        if (connection->getSourceNeuron()->hasFired()) {
-            connection->propagate();
+void ParallelSimulation::deliverSpikes(uint32_t lane_index, const std::vector<SpikeExchange::RemoteSpike>& spikes) {
+    // El carril programa en su cola los spikes que van a sus neuronas
+    EventLane& lane = m_event_lanes[lane_index];
+    for (const auto& spike : spikes) {
+        if (spike.source >= m_event_neurons.size()) {
+            continue;
+        }
+        for (size_t i = m_event_out_offsets[spike.source]; i < m_event_out_offsets[spike.source + 1]; ++i) {
+            const EventSynapse& synapse = m_event_synapses[i];
+            if (synapse.target < m_lane_of.size() && m_lane_of[synapse.target] == lane_index) {
+                lane.calendar.schedule(spike.step + synapse.latency, synapse.target, synapse.connection->getWeight());
+            }
         }
     }
 }
 
-void ParallelSimulation::updateNeuronsParallel() {
-    // Usar arrays locales para reducir contención de memoria
-    std::vector<std::string> neuron_ids;
-    std::vector<double> local_inputs;
+void ParallelSimulation::catchUpLanes() {
+    // processEvents() mueve el reloj sin integrar; los carriles entregan como input lo que
+    // tenían hasta ese paso, igual que la cola externa
+    for (auto& lane : m_event_lanes) {
+        while (lane.calendar.now() < m_calendar.now()) {
+            if (lane.calendar.empty()) {
+                lane.calendar.clear(m_calendar.now());
+                break;
+            }
+            lane.calendar.advance(lane.due);
+            for (const auto& event : lane.due) {
+                if (m_event_neurons[event.target]) {
+                    m_event_neurons[event.target]->addInput(event.stimulus);
+                }
+            }
+        }
+    }
+}
+
+size_t ParallelSimulation::getEpochSteps() const {
+    uint32_t epoch = m_event_lanes.size() > 1 ? m_lane_min_delay : 0;
+    const bool distributed = m_exchange && m_exchange->peerCount() > 0 && !m_rank_owned.empty();
+    if (distributed && m_rank_min_delay > 0) {
+        epoch = epoch == 0 ? m_rank_min_delay : std::min(epoch, m_rank_min_delay);
+    }
+    return epoch;
+}
+
+size_t ParallelSimulation::getPendingEventCount() const {
+    size_t pending = m_calendar.size();
+    for (const auto& lane : m_event_lanes) {
+        pending += lane.calendar.size();
+    }
+    return pending;
+}
+
+void ParallelSimulation::rebuildEventTopology() {
+    // Resolver cada conexión a índices una sola vez y ordenarla por fuente (counting sort
+    // estable: dentro de una fuente se conserva el orden de m_connections)
+    const size_t count = m_event_neurons.size();
+    std::vector<std::pair<uint32_t, EventSynapse>> resolved;
+    resolved.reserve(m_connections.size());
+    m_event_out_offsets.assign(count + 1, 0);
+    for (const auto& connection : m_connections) {
+        auto source = connection->getSourceNeuron();
+        auto target = connection->getDestinationNeuron();
+        if (!source || !target) {
+            continue;
+        }
+        auto source_it = m_event_index.find(source->getId());
+        auto target_it = m_event_index.find(target->getId());
+        if (source_it == m_event_index.end() || target_it == m_event_index.end()) {
+            continue;
+        }
+        // Igual que SynapticDelayBuffer::latencyOf: pasos redondeados, mínimo uno
+        const long steps = std::lround(connection->getDelay());
+        const uint32_t latency = steps > 1 ? static_cast<uint32_t>(steps) : 1;
+        resolved.push_back({source_it->second, {target_it->second, latency, connection.get()}});
+        ++m_event_out_offsets[source_it->second + 1];
+    }
+    for (size_t i = 0; i < count; ++i) {
+        m_event_out_offsets[i + 1] += m_event_out_offsets[i];
+    }
     
-    neuron_ids.reserve(m_neurons.size());
-    local_inputs.reserve(m_neurons.size());
+    m_event_synapses.resize(resolved.size());
+    std::vector<size_t> fill(m_event_out_offsets.begin(), m_event_out_offsets.end() - 1);
+    for (const auto& entry : resolved) {
+        m_event_synapses[fill[entry.first]++] = entry.second;
+    }
     
-    // Crear mapeo de IDs a índices para acceso O(1)
-    std::unordered_map<std::string, size_t> id_to_index;
-    size_t index = 0;
-    for (const auto& pair : m_neurons) {
-        neuron_ids.push_back(pair.first);
-        local_inputs.push_back(0.0);
-        id_to_index[pair.first] = index++;
+    m_event_input.resize(count, 0.0);
+    m_event_active_flag.resize(count, 0);
+    m_event_topology_dirty = false;
+    m_lanes_dirty = true;
+    
+    if (!m_rank_owned.empty()) {
+        rebuildRankBoundary();
+    }
+}
+
+void ParallelSimulation::rebuildEventLanes() {
+    const size_t count = m_event_neurons.size();
+    auto owned = [this](size_t index) {
+        return m_event_neurons[index] && (m_rank_owned.empty() || m_rank_owned[index]);
+    };
+    
+    // 1. Recoger el estado de los carriles anteriores. Los spikes entre carriles de la
+    //    época abierta se entregan ya; los que van a otros rangos siguen pendientes.
+    const uint64_t now = m_event_lanes.empty() ? m_calendar.now() : m_event_lanes.front().calendar.now();
+    for (size_t lane = 0; lane < m_event_lanes.size(); ++lane) {
+        for (size_t source = 0; source < m_event_lanes.size(); ++source) {
+            if (source != lane) {
+                deliverSpikes(static_cast<uint32_t>(lane), m_event_lanes[source].crossing);
+            }
+        }
+    }
+    std::vector<std::pair<uint64_t, EventCalendar::Event>> pending;
+    std::vector<uint32_t> active;
+    std::vector<uint32_t> fired;
+    std::vector<SpikeExchange::RemoteSpike> outgoing;
+    for (auto& lane : m_event_lanes) {
+        outgoing.insert(outgoing.end(), lane.outgoing.begin(), lane.outgoing.end());
+        lane.calendar.drain(pending);
+        active.insert(active.end(), lane.active.begin(), lane.active.end());
+        fired.insert(fired.end(), lane.fired.begin(), lane.fired.end());
     }
     
-    // Fase 1: Acumular entradas en paralelo con menos locks
-#ifdef _OPENMP
-    #pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < static_cast<int>(m_connections.size()); ++i) {
-        auto& connection = m_connections[i];
-        if (connection->getSourceNeuron()->hasFired()) {
-            std::string target_id = connection->getDestinationNeuron()->getId();
-            auto it = id_to_index.find(target_id);
-            if (it != id_to_index.end()) {
-                size_t idx = it->second;
-#ifdef _OPENMP
-                #pragma omp atomic
-#endif
-                local_inputs[idx] += connection->getWeight();
+    // 2. Repartir las neuronas propias, un carril por hilo, minimizando las sinapsis entre
+    //    carriles: cada una obliga a cerrar la época antes de su retardo
+    size_t owned_count = 0;
+    for (size_t index = 0; index < count; ++index) {
+        owned_count += owned(index) ? 1 : 0;
+    }
+    const size_t lanes = std::max<size_t>(1, std::min(static_cast<size_t>(std::max(1, m_thread_count)), owned_count));
+    m_lane_of.assign(count, UINT32_MAX);
+    std::vector<uint32_t> assignment;
+    if (lanes > 1) {
+        PartitionOptions options;
+        options.parts = lanes;
+        assignment = GraphPartitioner::partition(eventGraph(true), options).assignment;
+    }
+    for (size_t index = 0; index < count; ++index) {
+        if (owned(index)) {
+            m_lane_of[index] = assignment.empty() ? 0 : assignment[index];
+        }
+    }
+    
+    // 3. Retardo mínimo entre carriles y neuronas con sinapsis hacia otro carril
+    m_lane_boundary.assign(count, 0);
+    m_lane_min_delay = 0;
+    for (size_t source = 0; source < count; ++source) {
+        if (m_lane_of[source] == UINT32_MAX) {
+            continue;
+        }
+        for (size_t i = m_event_out_offsets[source]; i < m_event_out_offsets[source + 1]; ++i) {
+            const EventSynapse& synapse = m_event_synapses[i];
+            const uint32_t lane = m_lane_of[synapse.target];
+            if (lane != UINT32_MAX && lane != m_lane_of[source]) {
+                m_lane_boundary[source] = 1;
+                m_lane_min_delay = m_lane_min_delay == 0 ? synapse.latency : std::min(m_lane_min_delay, synapse.latency);
             }
         }
     }
     
-    // Fase 2: Actualizar neuronas en paralelo
-#ifdef _OPENMP
-    #pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < static_cast<int>(neuron_ids.size()); ++i) {
-        auto& neuron = m_neurons[neuron_ids[i]];
-        if (local_inputs[i] != 0.0) {
-            neuron->addInput(local_inputs[i]);
+    // 4. Reinstalar el estado; lo que ya no corresponde a una neurona propia se descarta
+    m_event_lanes.clear();
+    m_event_lanes.resize(lanes);
+    for (auto& lane : m_event_lanes) {
+        lane.calendar.clear(now);
+    }
+    std::stable_sort(outgoing.begin(), outgoing.end(),
+                     [](const SpikeExchange::RemoteSpike& a, const SpikeExchange::RemoteSpike& b) { return a.step < b.step; });
+    m_event_lanes.front().outgoing.swap(outgoing);
+    for (const auto& entry : pending) {
+        const uint32_t target = entry.second.target;
+        if (target < count && m_lane_of[target] != UINT32_MAX) {
+            m_event_lanes[m_lane_of[target]].calendar.schedule(entry.first, target, entry.second.stimulus);
+        }
+    }
+    for (uint32_t index : active) {
+        if (index < count && m_lane_of[index] != UINT32_MAX) {
+            m_event_lanes[m_lane_of[index]].active.push_back(index);
+        } else if (index < m_event_active_flag.size()) {
+            m_event_active_flag[index] = 0;
         }
-        neuron->update();
     }
+    for (uint32_t index : fired) {
+        if (index < count && m_lane_of[index] != UINT32_MAX) {
+            m_event_lanes[m_lane_of[index]].fired.push_back(index);
+        } else if (index < count && m_event_neurons[index]) {
+            m_event_neurons[index]->resetFiredFlag();
+        }
+    }
+    
+    m_lane_threads = m_thread_count;
+    m_lanes_dirty = false;
 }
 
-void ParallelSimulation::applyPlasticityParallel() {
-#ifdef _OPENMP
-    #pragma omp parallel for schedule(dynamic)
-#endif
-    for (int i = 0; i < static_cast<int>(m_connections.size()); ++i) {
-        auto& connection = m_connections[i];
-        if (connection->isPlastic()) {
-            connection->applyPlasticity();
+PartitionGraph ParallelSimulation::eventGraph(bool owned_only) const {
+    // El coste de una neurona crece con sus sinapsis entrantes, que son las que procesa
+    // quien la posee. Con owned_only solo cuentan las neuronas de este rango.
+    const size_t count = m_event_neurons.size();
+    auto counted = [&](size_t index) {
+        return m_event_neurons[index] && (!owned_only || m_rank_owned.empty() || m_rank_owned[index]);
+    };
+    std::vector<double> vertex_weights(count, 0.0);
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    edges.reserve(m_event_synapses.size());
+    for (size_t source = 0; source < count; ++source) {
+        const bool source_counted = counted(source);
+        if (source_counted) {
+            vertex_weights[source] += 1.0;
+        }
+        for (size_t s = m_event_out_offsets[source]; s < m_event_out_offsets[source + 1]; ++s) {
+            const uint32_t target = m_event_synapses[s].target;
+            const bool target_counted = counted(target);
+            if (target_counted) {
+                vertex_weights[target] += 1.0;
+            }
+            if (!owned_only || (source_counted && target_counted)) {
+                edges.push_back({static_cast<uint32_t>(source), target});
+            }
         }
     }
+    return PartitionGraph::fromEdges(vertex_weights, edges);
+}
+
+void ParallelSimulation::rebuildRankBoundary() {
+    // Las neuronas añadidas tras repartir se asignan por índice, igual en todos los rangos
+    const size_t count = m_event_neurons.size();
+    const uint32_t ranks = static_cast<uint32_t>(m_rank_ids.size());
+    for (size_t index = m_rank_of.size(); index < count; ++index) {
+        m_rank_of.push_back(static_cast<uint32_t>(index % ranks));
+    }
+    m_rank_owned.resize(count);
+    for (size_t index = 0; index < count; ++index) {
+        m_rank_owned[index] = m_rank_of[index] == m_rank_position ? 1 : 0;
+    }
+    
+    // Pares destino de cada neurona propia, sin repetir: las partes distintas a la propia
+    // corresponden a los pares en el mismo orden, saltando la nuestra. El retardo mínimo
+    // entre rangos se mide sobre todas las sinapsis para que todos obtengan el mismo.
+    m_rank_peer_offsets.assign(count + 1, 0);
+    m_rank_peers.clear();
+    m_rank_min_delay = 0;
+    std::vector<uint8_t> seen(ranks, 0);
+    for (size_t source = 0; source < count; ++source) {
+        for (size_t i = m_event_out_offsets[source]; i < m_event_out_offsets[source + 1]; ++i) {
+            const EventSynapse& synapse = m_event_synapses[i];
+            if (m_rank_of[synapse.target] != m_rank_of[source]) {
+                m_rank_min_delay = m_rank_min_delay == 0 ? synapse.latency : std::min(m_rank_min_delay, synapse.latency);
+            }
+        }
+        if (m_rank_owned[source]) {
+            for (size_t i = m_event_out_offsets[source]; i < m_event_out_offsets[source + 1]; ++i) {
+                const uint32_t part = m_rank_of[m_event_synapses[i].target];
+                if (part != m_rank_position && !seen[part]) {
+                    seen[part] = 1;
+                    m_rank_peers.push_back(part < m_rank_position ? part : part - 1);
+                }
+            }
+            for (size_t k = m_rank_peer_offsets[source]; k < m_rank_peers.size(); ++k) {
+                const uint32_t peer = m_rank_peers[k];
+                seen[peer < m_rank_position ? peer : peer + 1] = 0;
+            }
+        }
+        m_rank_peer_offsets[source + 1] = m_rank_peers.size();
+    }
+    m_lanes_dirty = true;
+}
+
+uint64_t ParallelSimulation::networkFingerprint() {
+    // FNV-1a sobre los IDs por índice denso y la topología resuelta: dos rangos solo
+    // coinciden si construyeron la misma red en el mismo orden
+    std::lock_guard<std::mutex> lock(m_event_mutex);
+    if (m_event_topology_dirty) {
+        rebuildEventTopology();
+    }
+    uint64_t hash = 1469598103934665603ULL;
+    auto mix = [&hash](const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+    };
+    for (const auto& neuron : m_event_neurons) {
+        const std::string id = neuron ? neuron->getId() : std::string();
+        mix(id.data(), id.size() + 1);
+    }
+    for (const auto& synapse : m_event_synapses) {
+        mix(&synapse.target, sizeof(synapse.target));
+        mix(&synapse.latency, sizeof(synapse.latency));
+    }
+    return hash;
+}
+
+template<typename Body>
+void ParallelSimulation::forEachPartition(Body&& body) {
+    // Una tarea por parte; el tiempo de cada una se suma a su parte para el reequilibrado
+    BrainLL::getTaskScheduler().parallelFor(0, m_partition_neurons.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; ++p) {
+            const auto start = std::chrono::steady_clock::now();
+            body(p);
+            m_partition_step_ms[p] += std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+    });
+}
+
+void ParallelSimulation::propagateSignalsParallel() {
+    // Cada parte propaga sus sinapsis entrantes: ningún destino recibe de dos tareas a la vez
+    forEachPartition([this](size_t p) {
+        for (const auto& synapse : m_partition_incoming[p]) {
+            if (synapse.connection->getSourceNeuron()->hasFired()) {
+                synapse.connection->propagate();
+            }
+        }
+    });
+}
+
+void ParallelSimulation::updateNeuronsParallel() {
+    // Usar arrays locales para reducir contención de memoria
+    // Fase 1: Acumular entradas por parte del destino, sin atómicos; solo las sinapsis
+    //         cortadas leen el estado de neuronas de otra parte
+    forEachPartition([this](size_t p) {
+        for (const auto& synapse : m_partition_incoming[p]) {
+            if (synapse.target != UINT32_MAX && synapse.connection->getSourceNeuron()->hasFired()) {
+                m_sync_input[synapse.target] += synapse.connection->getWeight();
+            }
+        }
+    });
+    
+    // Fase 2: Actualizar las neuronas de cada parte
+    forEachPartition([this](size_t p) {
+        for (uint32_t index : m_partition_neurons[p]) {
+            auto& neuron = m_event_neurons[index];
+            const double input = m_sync_input[index];
+            m_sync_input[index] = 0.0;
+            if (input != 0.0) {
+                neuron->addInput(input);
+            }
+            neuron->update();
+        }
+    });
+}
+
+void ParallelSimulation::applyPlasticityParallel() {
+    forEachPartition([this](size_t p) {
+        for (const auto& synapse : m_partition_incoming[p]) {
+            if (synapse.connection->isPlastic()) {
+                synapse.connection->applyPlasticity();
+            }
+        }
+    });
 }
 
 void ParallelSimulation::reset() {
@@ -416,135 +893,166 @@ void ParallelSimulation::reset() {
         // Las conexiones no tienen estado que resetear por ahora
     }
     
-    // Limpiar cola de eventos
+    // Limpiar cola de eventos y volver al paso 0
     std::lock_guard<std::mutex> lock(m_event_mutex);
-    while (!m_event_queue.empty()) {
-        m_event_queue.pop();
+    m_calendar.clear();
+    m_epoch_begin = 0;
+    for (auto& lane : m_event_lanes) {
+        lane.calendar.clear();
+        lane.active.clear();
+        lane.fired.clear();
+        lane.crossing.clear();
+        lane.outgoing.clear();
     }
+    std::fill(m_event_input.begin(), m_event_input.end(), 0.0);
+    std::fill(m_event_active_flag.begin(), m_event_active_flag.end(), 0);
 }
 
 void ParallelSimulation::scheduleEvent(const std::string& neuron_id, double time, double stimulus) {
     std::lock_guard<std::mutex> lock(m_event_mutex);
     
-    ScheduledEvent event;
-    event.neuron_id = neuron_id;
-    event.time = time;
-    event.stimulus = stimulus;
-    
-    m_event_queue.push(event);
+    auto index_it = m_event_index.find(neuron_id);
+    if (index_it == m_event_index.end()) {
+        return;
+    }
+    // Un tiempo fraccionario cae en el primer paso que no es anterior a él
+    const double step = std::ceil(time);
+    m_calendar.schedule(step > 0.0 ? static_cast<uint64_t>(step) : 0, index_it->second, stimulus);
 }
 
 void ParallelSimulation::processEvents(double current_time) {
     std::lock_guard<std::mutex> lock(m_event_mutex);
     
-    while (!m_event_queue.empty() && m_event_queue.top().time <= current_time) {
-        ScheduledEvent event = m_event_queue.top();
-        m_event_queue.pop();
-        
-        auto neuron_it = m_neurons.find(event.neuron_id);
-        if (neuron_it != m_neurons.end()) {
-            neuron_it->second->addInput(event.stimulus);
+    // Avanza el reloj simulado mientras queden eventos con paso <= current_time
+    while (!m_calendar.empty() && static_cast<double>(m_calendar.now()) <= current_time) {
+        m_calendar.advance(m_due_events);
+        for (const auto& event : m_due_events) {
+            if (event.target < m_event_neurons.size() && m_event_neurons[event.target]) {
+                m_event_neurons[event.target]->addInput(event.stimulus);
+            }
         }
     }
+    catchUpLanes();
 }
 
-void ParallelSimulation::updateAsync() {
-    // Implementación básica de actualización asíncrona
-    std::thread([this]() {
+std::future<void> ParallelSimulation::updateAsync() {
+    // Se ejecuta en el pool compartido en lugar de lanzar un hilo propio; el future
+    // guarda la excepción (p. ej. un fallo del intercambio distribuido) para el llamador
+    return BrainLL::getTaskScheduler().submit([this]() {
         this->update();
-    }).detach();
+    });
 }
 
 // Métodos eliminados - implementados como inline en el header
 
 void ParallelSimulation::partitionNeurons(std::vector<std::vector<std::string>>& partitions) {
-    // Implementación básica de particionado
-    partitions.clear();
-    partitions.resize(m_thread_count);
+    // Particionado por localidad: minimiza las sinapsis entre partes con carga equilibrada
+    buildPartitionGraph();
     
-    size_t partition_idx = 0;
-    for (const auto& pair : m_neurons) {
-        partitions[partition_idx % m_thread_count].push_back(pair.first);
-        partition_idx++;
-    }
+    PartitionOptions options;
+    options.parts = static_cast<size_t>(std::max(1, m_thread_count));
+    installPartition(GraphPartitioner::partition(m_partition_graph, options), partitions);
 }
 
 void ParallelSimulation::balanceLoad(std::vector<std::vector<std::string>>& partitions) {
-    // Implementación avanzada de balanceado de carga basada en actividad
-    
-    // 1. Recopilar todas las neuronas con sus métricas de carga
-    std::vector<std::pair<std::string, double>> neuron_loads;
-    
-    for (auto& partition : partitions) {
-        for (const auto& neuron_id : partition) {
-            auto neuron_it = m_neurons.find(neuron_id);
-            if (neuron_it != m_neurons.end()) {
-                // Calcular carga basada en actividad y conexiones
-                double load = 1.0; // Carga base
-                
-                // Aumentar carga si la neurona ha disparado recientemente
-                if (neuron_it->second->hasFired()) {
-                    load += 2.0;
-                }
-                
-                // Aumentar carga basada en número de conexiones
-                auto conn_it = m_neuron_connections.find(neuron_id);
-                if (conn_it != m_neuron_connections.end()) {
-                    load += conn_it->second.incoming.size() * 0.1;
-                    load += conn_it->second.outgoing.size() * 0.1;
-                }
-                
-                neuron_loads.push_back({neuron_id, load});
-            }
-        }
-        partition.clear();
+    // Reequilibrado con el tiempo medido: cada parte recibe una fracción del peso
+    // proporcional a su velocidad (peso / tiempo) y solo se migran los vértices necesarios
+    if (m_partition_dirty || m_partition_of.size() != m_partition_graph.vertexCount()) {
+        partitionNeurons(partitions);
+        return;
     }
     
-    // 2. Ordenar neuronas por carga (mayor carga primero)
-    std::sort(neuron_loads.begin(), neuron_loads.end(),
-        [](const auto& a, const auto& b) {
-            return a.second > b.second;
-        });
-    
-    // 3. Distribuir usando algoritmo greedy (asignar a partición con menor carga)
-    std::vector<double> partition_loads(partitions.size(), 0.0);
+    const size_t parts = m_partition_neurons.size();
+    std::vector<double> part_weights(parts, 0.0);
+    for (size_t v = 0; v < m_partition_of.size(); ++v) {
+        part_weights[m_partition_of[v]] += m_partition_graph.vertex_weights[v];
+    }
     
-    for (const auto& neuron_load : neuron_loads) {
-        // Encontrar partición con menor carga
-        size_t min_partition = 0;
-        double min_load = partition_loads[0];
-        
-        for (size_t i = 1; i < partition_loads.size(); ++i) {
-            if (partition_loads[i] < min_load) {
-                min_load = partition_loads[i];
-                min_partition = i;
-            }
+    PartitionOptions options;
+    options.parts = parts;
+    options.target_fractions.assign(parts, 1.0);
+    double total_speed = 0.0;
+    for (size_t p = 0; p < parts; ++p) {
+        if (p < m_partition_time_ms.size() && m_partition_time_ms[p] > 0.0 && part_weights[p] > 0.0) {
+            options.target_fractions[p] = part_weights[p] / m_partition_time_ms[p];
         }
-        
-        // Asignar neurona a la partición con menor carga
-        partitions[min_partition].push_back(neuron_load.first);
-        partition_loads[min_partition] += neuron_load.second;
+        total_speed += options.target_fractions[p];
     }
-    
-    // 4. Imprimir estadísticas de balanceado
-    double total_load = 0.0;
-    for (double load : partition_loads) {
-        total_load += load;
+    if (total_speed <= 0.0) {
+        options.target_fractions.clear();
     }
     
-    double avg_load = total_load / partition_loads.size();
-    double max_deviation = 0.0;
+    const double imbalance_before = m_partition_imbalance;
+    installPartition(GraphPartitioner::refine(m_partition_graph, m_partition_of, options), partitions);
+    ++m_rebalance_count;
     
-    for (double load : partition_loads) {
-        double deviation = std::abs(load - avg_load) / avg_load;
-        max_deviation = std::max(max_deviation, deviation);
+    std::ostringstream message;
+    message << "Load balancing: " << parts << " partitions, edge cut "
+            << (m_partition_cut_fraction * 100) << "%, imbalance "
+            << imbalance_before << " -> " << m_partition_imbalance;
+    BRAINLL_VERBOSE(message.str());
+}
+
+void ParallelSimulation::ensurePartitions() {
+    if (!m_partition_dirty && m_partition_neurons.size() == static_cast<size_t>(std::max(1, m_thread_count))) {
+        return;
+    }
+    std::vector<std::vector<std::string>> partitions;
+    partitionNeurons(partitions);
+}
+
+void ParallelSimulation::buildPartitionGraph() {
+    // Mismos índices densos que el motor de eventos
+    std::lock_guard<std::mutex> lock(m_event_mutex);
+    if (m_event_topology_dirty) {
+        rebuildEventTopology();
+    }
+    m_partition_graph = eventGraph(false);
+}
+
+void ParallelSimulation::installPartition(const PartitionResult& result,
+                                          std::vector<std::vector<std::string>>& partitions) {
+    const size_t parts = result.part_weights.empty() ? 1 : result.part_weights.size();
+    m_partition_of = result.assignment;
+    m_partition_neurons.assign(parts, {});
+    partitions.assign(parts, {});
+    for (size_t v = 0; v < m_partition_of.size(); ++v) {
+        if (m_event_neurons[v]) {
+            m_partition_neurons[m_partition_of[v]].push_back(static_cast<uint32_t>(v));
+            partitions[m_partition_of[v]].push_back(m_event_neurons[v]->getId());
+        }
     }
     
-    if (max_deviation < 0.1) {
-        std::cout << "Load balancing: Well balanced (max deviation: " << (max_deviation * 100) << "%)" << std::endl;
-    } else {
-        std::cout << "Load balancing: Imbalanced (max deviation: " << (max_deviation * 100) << "%)" << std::endl;
+    // Cada sinapsis la procesa la parte de su destino, en el orden de m_connections;
+    // las de destino sin registrar quedan en la parte 0 y solo propagan
+    m_partition_incoming.assign(parts, {});
+    for (const auto& connection : m_connections) {
+        auto target = connection->getDestinationNeuron();
+        auto target_it = target ? m_event_index.find(target->getId()) : m_event_index.end();
+        if (target_it == m_event_index.end()) {
+            m_partition_incoming[0].push_back({connection.get(), UINT32_MAX});
+        } else {
+            m_partition_incoming[m_partition_of[target_it->second]].push_back({connection.get(), target_it->second});
+        }
     }
+    
+    m_sync_input.assign(m_event_neurons.size(), 0.0);
+    m_partition_step_ms.assign(parts, 0.0);
+    m_partition_time_ms.resize(parts, 0.0);
+    m_partition_cut_fraction = result.cutFraction();
+    m_partition_imbalance = result.max_imbalance;
+    m_partition_dirty = false;
+    m_steps_since_rebalance = 0;
+}
+
+ParallelSimulation::PartitionStats ParallelSimulation::getPartitionStats() const {
+    PartitionStats stats;
+    stats.partitions = m_partition_neurons.size();
+    stats.edge_cut_fraction = m_partition_cut_fraction;
+    stats.weight_imbalance = m_partition_imbalance;
+    stats.step_time_ms = m_partition_time_ms;
+    stats.rebalances = m_rebalance_count;
+    return stats;
 }
 
 // GPU implementations
@@ -903,6 +1411,19 @@ void ParallelSimulation::enableDistributedMode(bool enable) {
     if (enable) {
         std::cout << "Distributed simulation enabled for node " << m_node_id << std::endl;
     } else {
+        // Volver a integrar la red completa en este proceso
+        m_exchange.reset();
+        {
+            std::lock_guard<std::mutex> event_lock(m_event_mutex);
+            m_rank_owned.clear();
+            m_rank_of.clear();
+            m_rank_ids.clear();
+            m_rank_peer_offsets.clear();
+            m_rank_peers.clear();
+        }
+        for (auto& node : m_remote_nodes) {
+            node.connected = false;
+        }
         std::cout << "Distributed simulation disabled" << std::endl;
     }
 }
@@ -913,6 +1434,12 @@ void ParallelSimulation::setNodeId(int node_id) {
     std::cout << "Node ID set to: " << node_id << std::endl;
 }
 
+void ParallelSimulation::setListenAddress(const std::string& address, int port) {
+    std::lock_guard<std::mutex> lock(m_distributed_mutex);
+    m_listen_address = address;
+    m_listen_port = port;
+}
+
 void ParallelSimulation::addRemoteNode(int node_id, const std::string& address, int port) {
     std::lock_guard<std::mutex> lock(m_distributed_mutex);
     RemoteNode node;
@@ -931,21 +1458,84 @@ void ParallelSimulation::synchronizeWithRemoteNodes() {
     }
     
     std::lock_guard<std::mutex> lock(m_distributed_mutex);
+    if (m_exchange && m_exchange->isConnected()) {
+        return; // Ya conectado: los spikes se intercambian en cada update()
+    }
     
-    // Implementación básica de sincronización
+    // 1. Conectar la malla; todos los rangos deben haber construido la misma red
+    std::vector<RankEndpoint> endpoints;
+    endpoints.push_back({m_node_id, m_listen_address, m_listen_port});
+    for (const auto& node : m_remote_nodes) {
+        endpoints.push_back({node.node_id, node.address, node.port});
+    }
+    auto exchange = std::make_unique<SpikeExchange>();
+    if (!exchange->connect(m_node_id, endpoints, networkFingerprint())) {
+        std::cerr << "Distributed simulation: node " << m_node_id << " could not connect: "
+                  << exchange->lastError() << std::endl;
+        return;
+    }
     for (auto& node : m_remote_nodes) {
-        if (!node.connected) {
-            // TODO: Implementar conexión TCP/UDP real
-            std::cout << "Attempting to connect to node " << node.node_id 
-                      << " at " << node.address << ":" << node.port << std::endl;
-            
-            // Simular conexión exitosa
-            node.connected = true;
+        node.connected = true;
+    }
+    
+    // 2. Repartir las neuronas entre rangos. El particionado es determinista, así que
+    //    todos los rangos llegan a la misma asignación sin intercambiarla.
+    m_rank_ids.clear();
+    for (const auto& endpoint : endpoints) {
+        m_rank_ids.push_back(endpoint.rank);
+    }
+    std::sort(m_rank_ids.begin(), m_rank_ids.end());
+    m_rank_position = static_cast<size_t>(
+        std::find(m_rank_ids.begin(), m_rank_ids.end(), m_node_id) - m_rank_ids.begin());
+    
+    buildPartitionGraph();
+    PartitionOptions options;
+    options.parts = m_rank_ids.size();
+    const PartitionResult result = GraphPartitioner::partition(m_partition_graph, options);
+    
+    std::lock_guard<std::mutex> event_lock(m_event_mutex);
+    m_rank_of = result.assignment;
+    m_rank_owned.assign(m_rank_of.size(), 0);
+    m_rank_cut_fraction = result.cutFraction();
+    rebuildRankBoundary();   // Los carriles se rehacen solo con las neuronas propias
+    m_exchange = std::move(exchange);
+    m_simulation_mode = "event_driven";
+    
+    const size_t owned = static_cast<size_t>(std::count(m_rank_owned.begin(), m_rank_owned.end(), 1));
+    std::cout << "Distributed simulation: node " << m_node_id << " owns " << owned << " of "
+              << m_rank_owned.size() << " neurons across " << m_rank_ids.size() << " ranks (edge cut "
+              << (m_rank_cut_fraction * 100) << "%)" << std::endl;
+}
+
+bool ParallelSimulation::ownsNeuron(const std::string& neuron_id) const {
+    auto index_it = m_event_index.find(neuron_id);
+    if (index_it == m_event_index.end()) {
+        return false;
+    }
+    if (m_rank_owned.empty()) {
+        return true;
+    }
+    // Las neuronas añadidas después de repartir se asignan por índice
+    return index_it->second < m_rank_owned.size() ? m_rank_owned[index_it->second] != 0
+                                                  : index_it->second % m_rank_ids.size() == m_rank_position;
+}
+
+ParallelSimulation::DistributedStats ParallelSimulation::getDistributedStats() const {
+    DistributedStats stats;
+    stats.node_id = m_node_id;
+    stats.ranks = m_rank_owned.empty() ? 1 : m_rank_ids.size();
+    stats.owned_neurons = m_rank_owned.empty()
+        ? m_neurons.size()
+        : static_cast<size_t>(std::count(m_rank_owned.begin(), m_rank_owned.end(), 1));
+    stats.boundary_neurons = 0;
+    for (size_t index = 0; index + 1 < m_rank_peer_offsets.size(); ++index) {
+        if (m_rank_peer_offsets[index + 1] > m_rank_peer_offsets[index]) {
+            ++stats.boundary_neurons;
         }
-        
-        // TODO: Intercambiar datos de estado de neuronas activas
-        // TODO: Sincronizar eventos entre nodos
     }
+    stats.edge_cut_fraction = m_rank_cut_fraction;
+    stats.exchange = m_exchange ? m_exchange->getStats() : SpikeExchange::Stats();
+    return stats;
 }
 
 // Dynamic network growth implementations
@@ -1000,6 +1590,8 @@ void ParallelSimulation::pruneInactiveConnections(double threshold) {
             
             it = m_connections.erase(it);
             pruned_count++;
+            m_event_topology_dirty = true;
+            m_partition_dirty = true;
         } else {
             ++it;
         }
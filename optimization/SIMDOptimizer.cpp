@@ -41,10 +41,11 @@ void SIMDOptimizer::detectCapabilities() {
     has_sse41_ = (cpuInfo[2] & (1 << 19)) != 0;
     has_fma_ = (cpuInfo[2] & (1 << 12)) != 0;
     
+    // Leaf 7 needs subleaf 0 in ECX
 #ifdef _WIN32
-    __cpuid(cpuInfo, 7);
+    __cpuidex(cpuInfo, 7, 0);
 #else
-    __cpuid(7, cpuInfo[0], cpuInfo[1], cpuInfo[2], cpuInfo[3]);
+    __cpuid_count(7, 0, cpuInfo[0], cpuInfo[1], cpuInfo[2], cpuInfo[3]);
 #endif
     
     has_avx2_ = (cpuInfo[1] & (1 << 5)) != 0;
@@ -928,6 +929,418 @@ void SIMDOptimizer::vectorMulScalar(const double* a, const double* b, double* re
     }
 }
 
+// ============================================================================
+// SPIKING NEURON KERNELS
+// ============================================================================
+
+namespace {
+    // Copia la máscara de comparación (4 lanes) a bytes 0/1 y devuelve cuántos dispararon
+    inline size_t storeSpikeMask(int bits, uint8_t* fired) {
+        size_t count = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            const uint8_t spike = static_cast<uint8_t>((bits >> lane) & 1);
+            fired[lane] = spike;
+            count += spike;
+        }
+        return count;
+    }
+}
+
+size_t SIMDOptimizer::lifPopulationStep(double* potential, double* input, double* adaptation, uint8_t* fired,
+                                        size_t size, const LIFKernelParams& params) {
+    if (has_avx2_ && has_fma_ && size >= 4) {
+        return lifPopulationStepAVX2(potential, input, adaptation, fired, size, params);
+    }
+    return lifPopulationStepScalar(potential, input, adaptation, fired, size, params);
+}
+
+size_t SIMDOptimizer::izhikevichPopulationStep(double* v, double* u, double* input, uint8_t* fired,
+                                               size_t size, const IzhikevichKernelParams& params) {
+    if (has_avx2_ && has_fma_ && size >= 4) {
+        return izhikevichPopulationStepAVX2(v, u, input, fired, size, params);
+    }
+    return izhikevichPopulationStepScalar(v, u, input, fired, size, params);
+}
+
+size_t SIMDOptimizer::lifPopulationStepAVX2(double* potential, double* input, double* adaptation, uint8_t* fired,
+                                            size_t size, const LIFKernelParams& params) {
+    const __m256d decay = _mm256_set1_pd(params.decay);
+    const __m256d gain = _mm256_set1_pd(params.input_gain);
+    const __m256d rest = _mm256_set1_pd(params.rest_drive);
+    const __m256d threshold = _mm256_set1_pd(params.threshold);
+    const __m256d reset = _mm256_set1_pd(params.reset);
+    const __m256d adaptation_decay = _mm256_set1_pd(params.adaptation_decay);
+    const __m256d adaptation_jump = _mm256_set1_pd(params.adaptation_jump);
+    const __m256d zero = _mm256_setzero_pd();
+
+    const size_t simd_end = (size / 4) * 4;
+    size_t spikes = 0;
+    for (size_t i = 0; i < simd_end; i += 4) {
+        __m256d drive = _mm256_loadu_pd(&input[i]);
+        __m256d a = zero;
+        if (adaptation) {
+            a = _mm256_mul_pd(_mm256_loadu_pd(&adaptation[i]), adaptation_decay);
+            drive = _mm256_sub_pd(drive, a);
+        }
+        __m256d v = _mm256_fmadd_pd(drive, gain, _mm256_fmadd_pd(_mm256_loadu_pd(&potential[i]), decay, rest));
+
+        const __m256d spiked = _mm256_cmp_pd(v, threshold, _CMP_GE_OQ);
+        v = _mm256_blendv_pd(v, reset, spiked);
+        if (adaptation) {
+            _mm256_storeu_pd(&adaptation[i], _mm256_add_pd(a, _mm256_and_pd(spiked, adaptation_jump)));
+        }
+        _mm256_storeu_pd(&potential[i], v);
+        _mm256_storeu_pd(&input[i], zero);
+        spikes += storeSpikeMask(_mm256_movemask_pd(spiked), &fired[i]);
+    }
+
+    return spikes + lifPopulationStepScalar(potential + simd_end, input + simd_end,
+                                            adaptation ? adaptation + simd_end : nullptr,
+                                            fired + simd_end, size - simd_end, params);
+}
+
+size_t SIMDOptimizer::lifPopulationStepScalar(double* potential, double* input, double* adaptation, uint8_t* fired,
+                                              size_t size, const LIFKernelParams& params) {
+    size_t spikes = 0;
+    for (size_t i = 0; i < size; ++i) {
+        double drive = input[i];
+        if (adaptation) {
+            adaptation[i] *= params.adaptation_decay;
+            drive -= adaptation[i];
+        }
+        double v = potential[i] * params.decay + params.rest_drive + drive * params.input_gain;
+        input[i] = 0.0;
+
+        const bool spiked = v >= params.threshold;
+        if (spiked) {
+            v = params.reset;
+            if (adaptation) {
+                adaptation[i] += params.adaptation_jump;
+            }
+        }
+        potential[i] = v;
+        fired[i] = spiked ? 1 : 0;
+        spikes += spiked ? 1 : 0;
+    }
+    return spikes;
+}
+
+size_t SIMDOptimizer::izhikevichPopulationStepAVX2(double* v, double* u, double* input, uint8_t* fired,
+                                                   size_t size, const IzhikevichKernelParams& params) {
+    const __m256d k2 = _mm256_set1_pd(0.04);
+    const __m256d k1 = _mm256_set1_pd(5.0);
+    const __m256d k0 = _mm256_set1_pd(140.0);
+    const __m256d a = _mm256_set1_pd(params.a);
+    const __m256d b = _mm256_set1_pd(params.b);
+    const __m256d c = _mm256_set1_pd(params.c);
+    const __m256d d = _mm256_set1_pd(params.d);
+    const __m256d dt = _mm256_set1_pd(params.dt);
+    const __m256d peak = _mm256_set1_pd(params.peak);
+    const __m256d zero = _mm256_setzero_pd();
+
+    const size_t simd_end = (size / 4) * 4;
+    size_t spikes = 0;
+    for (size_t i = 0; i < simd_end; i += 4) {
+        const __m256d vv = _mm256_loadu_pd(&v[i]);
+        const __m256d uu = _mm256_loadu_pd(&u[i]);
+
+        // dv = 0.04 v^2 + 5 v + 140 - u + I ; du = a (b v - u), ambos con el v anterior
+        const __m256d quad = _mm256_fmadd_pd(_mm256_fmadd_pd(k2, vv, k1), vv, k0);
+        const __m256d dv = _mm256_add_pd(_mm256_sub_pd(quad, uu), _mm256_loadu_pd(&input[i]));
+        const __m256d du = _mm256_mul_pd(a, _mm256_fmsub_pd(b, vv, uu));
+
+        __m256d v_next = _mm256_fmadd_pd(dv, dt, vv);
+        __m256d u_next = _mm256_fmadd_pd(du, dt, uu);
+
+        const __m256d spiked = _mm256_cmp_pd(v_next, peak, _CMP_GE_OQ);
+        v_next = _mm256_blendv_pd(v_next, c, spiked);
+        u_next = _mm256_add_pd(u_next, _mm256_and_pd(spiked, d));
+
+        _mm256_storeu_pd(&v[i], v_next);
+        _mm256_storeu_pd(&u[i], u_next);
+        _mm256_storeu_pd(&input[i], zero);
+        spikes += storeSpikeMask(_mm256_movemask_pd(spiked), &fired[i]);
+    }
+
+    return spikes + izhikevichPopulationStepScalar(v + simd_end, u + simd_end, input + simd_end,
+                                                   fired + simd_end, size - simd_end, params);
+}
+
+size_t SIMDOptimizer::izhikevichPopulationStepScalar(double* v, double* u, double* input, uint8_t* fired,
+                                                     size_t size, const IzhikevichKernelParams& params) {
+    size_t spikes = 0;
+    for (size_t i = 0; i < size; ++i) {
+        const double dv = 0.04 * v[i] * v[i] + 5.0 * v[i] + 140.0 - u[i] + input[i];
+        const double du = params.a * (params.b * v[i] - u[i]);
+        double v_next = v[i] + dv * params.dt;
+        double u_next = u[i] + du * params.dt;
+        input[i] = 0.0;
+
+        const bool spiked = v_next >= params.peak;
+        if (spiked) {
+            v_next = params.c;
+            u_next += params.d;
+        }
+        v[i] = v_next;
+        u[i] = u_next;
+        fired[i] = spiked ? 1 : 0;
+        spikes += spiked ? 1 : 0;
+    }
+    return spikes;
+}
+
+// ============================================================================
+// RECURRENT GATE KERNELS
+// ============================================================================
+
+namespace {
+    inline float dotAVX2(const float* a, const float* b, size_t size) {
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16) {
+            acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+        }
+        for (; i + 8 <= size; i += 8) {
+            acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        }
+        acc0 = _mm256_add_ps(acc0, acc1);
+        __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+        sum = _mm_hadd_ps(sum, sum);
+        sum = _mm_hadd_ps(sum, sum);
+        float result = _mm_cvtss_f32(sum);
+        for (; i < size; ++i) {
+            result += a[i] * b[i];
+        }
+        return result;
+    }
+
+    inline double dotAVX2(const double* a, const double* b, size_t size) {
+        __m256d acc0 = _mm256_setzero_pd();
+        __m256d acc1 = _mm256_setzero_pd();
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), acc0);
+            acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), acc1);
+        }
+        for (; i + 4 <= size; i += 4) {
+            acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), acc0);
+        }
+        acc0 = _mm256_add_pd(acc0, acc1);
+        __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(acc0), _mm256_extractf128_pd(acc0, 1));
+        double result = _mm_cvtsd_f64(_mm_hadd_pd(sum, sum));
+        for (; i < size; ++i) {
+            result += a[i] * b[i];
+        }
+        return result;
+    }
+
+    template <typename T>
+    T dotScalar(const T* a, const T* b, size_t size) {
+        T result = 0;
+        for (size_t i = 0; i < size; ++i) {
+            result += a[i] * b[i];
+        }
+        return result;
+    }
+}
+
+void SIMDOptimizer::gateMatrixVectorMul(const float* weights, const float* x, const float* h, float* out_x, float* out_h,
+                                       size_t rows, size_t input_size, size_t hidden_size) {
+    const size_t cols = input_size + hidden_size;
+    const bool simd = has_avx2_ && has_fma_;
+    for (size_t r = 0; r < rows; ++r) {
+        const float* row = weights + r * cols;
+        out_x[r] = simd ? dotAVX2(row, x, input_size) : dotScalar(row, x, input_size);
+        out_h[r] = simd ? dotAVX2(row + input_size, h, hidden_size) : dotScalar(row + input_size, h, hidden_size);
+    }
+}
+
+void SIMDOptimizer::gateMatrixVectorMul(const double* weights, const double* x, const double* h, double* out_x, double* out_h,
+                                       size_t rows, size_t input_size, size_t hidden_size) {
+    const size_t cols = input_size + hidden_size;
+    const bool simd = has_avx2_ && has_fma_;
+    for (size_t r = 0; r < rows; ++r) {
+        const double* row = weights + r * cols;
+        out_x[r] = simd ? dotAVX2(row, x, input_size) : dotScalar(row, x, input_size);
+        out_h[r] = simd ? dotAVX2(row + input_size, h, hidden_size) : dotScalar(row + input_size, h, hidden_size);
+    }
+}
+
+// ============================================================================
+// CONVOLUTION AND POOLING
+// ============================================================================
+
+namespace {
+    template <typename T>
+    void convolution2DScalar(const T* input, const T* kernel, T* output,
+                             size_t input_w, size_t kernel_h, size_t kernel_w,
+                             size_t out_h, size_t out_w, size_t stride_h, size_t stride_w) {
+        for (size_t oy = 0; oy < out_h; ++oy) {
+            for (size_t ox = 0; ox < out_w; ++ox) {
+                T sum = 0;
+                for (size_t ky = 0; ky < kernel_h; ++ky) {
+                    const T* in_row = input + (oy * stride_h + ky) * input_w + ox * stride_w;
+                    const T* k_row = kernel + ky * kernel_w;
+                    for (size_t kx = 0; kx < kernel_w; ++kx) {
+                        sum += in_row[kx] * k_row[kx];
+                    }
+                }
+                output[oy * out_w + ox] = sum;
+            }
+        }
+    }
+
+    // Max or average over each window; rows of the window are reduced one at a time
+    template <typename T, bool IsMax>
+    void pooling2D(const T* input, T* output, size_t input_h, size_t input_w,
+                   size_t pool_h, size_t pool_w, size_t stride_h, size_t stride_w) {
+        if (input_h < pool_h || input_w < pool_w || stride_h == 0 || stride_w == 0) {
+            return;
+        }
+        const size_t out_h = (input_h - pool_h) / stride_h + 1;
+        const size_t out_w = (input_w - pool_w) / stride_w + 1;
+        const T scale = static_cast<T>(1) / static_cast<T>(pool_h * pool_w);
+
+        for (size_t oy = 0; oy < out_h; ++oy) {
+            T* out_row = output + oy * out_w;
+            const T* first = input + oy * stride_h * input_w;
+            for (size_t ox = 0; ox < out_w; ++ox) {
+                out_row[ox] = first[ox * stride_w];
+            }
+            for (size_t py = 0; py < pool_h; ++py) {
+                const T* in_row = first + py * input_w;
+                for (size_t ox = 0; ox < out_w; ++ox) {
+                    const T* window = in_row + ox * stride_w;
+                    T acc = out_row[ox];
+                    for (size_t px = (py == 0 ? 1 : 0); px < pool_w; ++px) {
+                        acc = IsMax ? std::max(acc, window[px]) : acc + window[px];
+                    }
+                    out_row[ox] = acc;
+                }
+            }
+            if (!IsMax) {
+                for (size_t ox = 0; ox < out_w; ++ox) {
+                    out_row[ox] *= scale;
+                }
+            }
+        }
+    }
+}
+
+void SIMDOptimizer::convolution2D(const float* input, const float* kernel, float* output,
+                                 size_t input_h, size_t input_w, size_t kernel_h, size_t kernel_w,
+                                 size_t stride_h, size_t stride_w) {
+    if (input_h < kernel_h || input_w < kernel_w || stride_h == 0 || stride_w == 0) {
+        return;
+    }
+    const size_t out_h = (input_h - kernel_h) / stride_h + 1;
+    const size_t out_w = (input_w - kernel_w) / stride_w + 1;
+    if (has_avx2_ && has_fma_ && stride_w == 1 && out_w >= 8) {
+        convolution2DAVX2(input, kernel, output, input_h, input_w, kernel_h, kernel_w, stride_h);
+    } else {
+        convolution2DScalar(input, kernel, output, input_w, kernel_h, kernel_w, out_h, out_w, stride_h, stride_w);
+    }
+}
+
+void SIMDOptimizer::convolution2D(const double* input, const double* kernel, double* output,
+                                 size_t input_h, size_t input_w, size_t kernel_h, size_t kernel_w,
+                                 size_t stride_h, size_t stride_w) {
+    if (input_h < kernel_h || input_w < kernel_w || stride_h == 0 || stride_w == 0) {
+        return;
+    }
+    const size_t out_h = (input_h - kernel_h) / stride_h + 1;
+    const size_t out_w = (input_w - kernel_w) / stride_w + 1;
+    if (has_avx2_ && has_fma_ && stride_w == 1 && out_w >= 4) {
+        convolution2DAVX2(input, kernel, output, input_h, input_w, kernel_h, kernel_w, stride_h);
+    } else {
+        convolution2DScalar(input, kernel, output, input_w, kernel_h, kernel_w, out_h, out_w, stride_h, stride_w);
+    }
+}
+
+void SIMDOptimizer::convolution2DAVX2(const float* input, const float* kernel, float* output,
+                                     size_t input_h, size_t input_w, size_t kernel_h, size_t kernel_w,
+                                     size_t stride_h) {
+    const size_t out_h = (input_h - kernel_h) / stride_h + 1;
+    const size_t out_w = input_w - kernel_w + 1;
+
+    for (size_t oy = 0; oy < out_h; ++oy) {
+        float* out_row = output + oy * out_w;
+        std::memset(out_row, 0, out_w * sizeof(float));
+        for (size_t ky = 0; ky < kernel_h; ++ky) {
+            const float* in_row = input + (oy * stride_h + ky) * input_w;
+            for (size_t kx = 0; kx < kernel_w; ++kx) {
+                const float weight = kernel[ky * kernel_w + kx];
+                const __m256 w = _mm256_set1_ps(weight);
+                const float* src = in_row + kx;
+                size_t x = 0;
+                for (; x + 8 <= out_w; x += 8) {
+                    __m256 acc = _mm256_loadu_ps(out_row + x);
+                    acc = _mm256_fmadd_ps(w, _mm256_loadu_ps(src + x), acc);
+                    _mm256_storeu_ps(out_row + x, acc);
+                }
+                for (; x < out_w; ++x) {
+                    out_row[x] += weight * src[x];
+                }
+            }
+        }
+    }
+}
+
+void SIMDOptimizer::convolution2DAVX2(const double* input, const double* kernel, double* output,
+                                     size_t input_h, size_t input_w, size_t kernel_h, size_t kernel_w,
+                                     size_t stride_h) {
+    const size_t out_h = (input_h - kernel_h) / stride_h + 1;
+    const size_t out_w = input_w - kernel_w + 1;
+
+    for (size_t oy = 0; oy < out_h; ++oy) {
+        double* out_row = output + oy * out_w;
+        std::memset(out_row, 0, out_w * sizeof(double));
+        for (size_t ky = 0; ky < kernel_h; ++ky) {
+            const double* in_row = input + (oy * stride_h + ky) * input_w;
+            for (size_t kx = 0; kx < kernel_w; ++kx) {
+                const double weight = kernel[ky * kernel_w + kx];
+                const __m256d w = _mm256_set1_pd(weight);
+                const double* src = in_row + kx;
+                size_t x = 0;
+                for (; x + 4 <= out_w; x += 4) {
+                    __m256d acc = _mm256_loadu_pd(out_row + x);
+                    acc = _mm256_fmadd_pd(w, _mm256_loadu_pd(src + x), acc);
+                    _mm256_storeu_pd(out_row + x, acc);
+                }
+                for (; x < out_w; ++x) {
+                    out_row[x] += weight * src[x];
+                }
+            }
+        }
+    }
+}
+
+void SIMDOptimizer::maxPooling2D(const float* input, float* output,
+                                size_t input_h, size_t input_w, size_t pool_h, size_t pool_w,
+                                size_t stride_h, size_t stride_w) {
+    pooling2D<float, true>(input, output, input_h, input_w, pool_h, pool_w, stride_h, stride_w);
+}
+
+void SIMDOptimizer::maxPooling2D(const double* input, double* output,
+                                size_t input_h, size_t input_w, size_t pool_h, size_t pool_w,
+                                size_t stride_h, size_t stride_w) {
+    pooling2D<double, true>(input, output, input_h, input_w, pool_h, pool_w, stride_h, stride_w);
+}
+
+void SIMDOptimizer::avgPooling2D(const float* input, float* output,
+                                size_t input_h, size_t input_w, size_t pool_h, size_t pool_w,
+                                size_t stride_h, size_t stride_w) {
+    pooling2D<float, false>(input, output, input_h, input_w, pool_h, pool_w, stride_h, stride_w);
+}
+
+void SIMDOptimizer::avgPooling2D(const double* input, double* output,
+                                size_t input_h, size_t input_w, size_t pool_h, size_t pool_w,
+                                size_t stride_h, size_t stride_w) {
+    pooling2D<double, false>(input, output, input_h, input_w, pool_h, pool_w, stride_h, stride_w);
+}
+
 // ============================================================================
 // BENCHMARKING
 // ============================================================================
@@ -981,14 +1394,114 @@ double SIMDOptimizer::vectorSum(const double* input, size_t size) {
     return sum;
 }
 
+namespace {
+    // exp() for |x| <= 88 (float) / 708 (double), Cephes range reduction + polynomial
+    inline __m256 expAVX2(__m256 x) {
+        const __m256 fx = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(1.44269504088896341f)),
+                                          _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(0.693359375f), x);
+        x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(-2.12194440e-4f), x);
+
+        __m256 y = _mm256_set1_ps(1.9875691500e-4f);
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.3981999507e-3f));
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(8.3334519073e-3f));
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(4.1665795894e-2f));
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.6666665459e-1f));
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(5.0000001201e-1f));
+        y = _mm256_fmadd_ps(y, _mm256_mul_ps(x, x), _mm256_add_ps(x, _mm256_set1_ps(1.0f)));
+
+        const __m256i exponent = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(fx), _mm256_set1_epi32(127)), 23);
+        return _mm256_mul_ps(y, _mm256_castsi256_ps(exponent));
+    }
+
+    inline __m256d expAVX2(__m256d x) {
+        const __m256d fx = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(1.4426950408889634073599)),
+                                           _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        x = _mm256_fnmadd_pd(fx, _mm256_set1_pd(6.93145751953125e-1), x);
+        x = _mm256_fnmadd_pd(fx, _mm256_set1_pd(1.42860682030941723212e-6), x);
+
+        // exp(r) = 1 + 2 r P(r^2) / (Q(r^2) - r P(r^2))
+        const __m256d xx = _mm256_mul_pd(x, x);
+        __m256d px = _mm256_set1_pd(1.26177193074810590878e-4);
+        px = _mm256_fmadd_pd(px, xx, _mm256_set1_pd(3.02994407707441961300e-2));
+        px = _mm256_fmadd_pd(px, xx, _mm256_set1_pd(9.99999999999999999910e-1));
+        px = _mm256_mul_pd(px, x);
+        __m256d qx = _mm256_set1_pd(3.00198505138664455042e-6);
+        qx = _mm256_fmadd_pd(qx, xx, _mm256_set1_pd(2.52448340349684104192e-3));
+        qx = _mm256_fmadd_pd(qx, xx, _mm256_set1_pd(2.27265548208155028766e-1));
+        qx = _mm256_fmadd_pd(qx, xx, _mm256_set1_pd(2.00000000000000000009e0));
+        const __m256d ratio = _mm256_div_pd(px, _mm256_sub_pd(qx, px));
+        const __m256d y = _mm256_fmadd_pd(_mm256_set1_pd(2.0), ratio, _mm256_set1_pd(1.0));
+
+        const __m256i n = _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(fx));
+        const __m256i exponent = _mm256_slli_epi64(_mm256_add_epi64(n, _mm256_set1_epi64x(1023)), 52);
+        return _mm256_mul_pd(y, _mm256_castsi256_pd(exponent));
+    }
+
+    // tanh(x) = sign(x) * (1 - 2 / (exp(2|x|) + 1)); |x| clamped where tanh is already +-1.
+    // Below |x| = 0.625 that difference cancels catastrophically, so there the odd
+    // Cephes approximation x + x^3 P(x^2) (x + x^3 P/Q in double) is used instead
+    inline __m256 tanhAVX2(__m256 x) {
+        const __m256 sign = _mm256_and_ps(x, _mm256_set1_ps(-0.0f));
+        const __m256 ax = _mm256_min_ps(_mm256_set1_ps(20.0f), _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x));
+        const __m256 e = expAVX2(_mm256_add_ps(ax, ax));
+        const __m256 large = _mm256_sub_ps(_mm256_set1_ps(1.0f),
+                                           _mm256_div_ps(_mm256_set1_ps(2.0f), _mm256_add_ps(e, _mm256_set1_ps(1.0f))));
+
+        const __m256 z = _mm256_mul_ps(ax, ax);
+        __m256 p = _mm256_set1_ps(-5.70498872745e-3f);
+        p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(2.06390887954e-2f));
+        p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-5.37397155531e-2f));
+        p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(1.33314422036e-1f));
+        p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-3.33332819422e-1f));
+        const __m256 small = _mm256_fmadd_ps(_mm256_mul_ps(p, z), ax, ax);
+
+        const __m256 use_small = _mm256_cmp_ps(ax, _mm256_set1_ps(0.625f), _CMP_LT_OQ);
+        return _mm256_or_ps(_mm256_blendv_ps(large, small, use_small), sign);
+    }
+
+    inline __m256d tanhAVX2(__m256d x) {
+        const __m256d sign = _mm256_and_pd(x, _mm256_set1_pd(-0.0));
+        const __m256d ax = _mm256_min_pd(_mm256_set1_pd(40.0), _mm256_andnot_pd(_mm256_set1_pd(-0.0), x));
+        const __m256d e = expAVX2(_mm256_add_pd(ax, ax));
+        const __m256d large = _mm256_sub_pd(_mm256_set1_pd(1.0),
+                                            _mm256_div_pd(_mm256_set1_pd(2.0), _mm256_add_pd(e, _mm256_set1_pd(1.0))));
+
+        // x + x z P(z) / Q(z), z = x^2
+        const __m256d z = _mm256_mul_pd(ax, ax);
+        __m256d p = _mm256_set1_pd(-9.64399179425052238628e-1);
+        p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(-9.92877231001918586564e1));
+        p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(-1.61468768441708447952e3));
+        __m256d q = _mm256_add_pd(z, _mm256_set1_pd(1.12811678491632931402e2));
+        q = _mm256_fmadd_pd(q, z, _mm256_set1_pd(2.23548839060100448583e3));
+        q = _mm256_fmadd_pd(q, z, _mm256_set1_pd(4.84406305325125486048e3));
+        const __m256d small = _mm256_fmadd_pd(_mm256_div_pd(_mm256_mul_pd(p, z), q), ax, ax);
+
+        const __m256d use_small = _mm256_cmp_pd(ax, _mm256_set1_pd(0.625), _CMP_LT_OQ);
+        return _mm256_or_pd(_mm256_blendv_pd(large, small, use_small), sign);
+    }
+}
+
 void SIMDOptimizer::vectorTanh(const float* input, float* output, size_t size) {
-    for (size_t i = 0; i < size; ++i) {
+    size_t i = 0;
+    if (has_avx2_ && has_fma_) {
+        for (; i + 8 <= size; i += 8) {
+            _mm256_storeu_ps(&output[i], tanhAVX2(_mm256_loadu_ps(&input[i])));
+        }
+    }
+    for (; i < size; ++i) {
         output[i] = std::tanh(input[i]);
     }
 }
 
 void SIMDOptimizer::vectorTanh(const double* input, double* output, size_t size) {
-    for (size_t i = 0; i < size; ++i) {
+    size_t i = 0;
+    if (has_avx2_ && has_fma_) {
+        for (; i + 4 <= size; i += 4) {
+            _mm256_storeu_pd(&output[i], tanhAVX2(_mm256_loadu_pd(&input[i])));
+        }
+    }
+    for (; i < size; ++i) {
         output[i] = std::tanh(input[i]);
     }
 }
@@ -1023,23 +1536,6 @@ SIMDOptimizer::BenchmarkResult SIMDOptimizer::benchmarkConvolution(size_t input_
     return result;
 }
 
-// Minimal implementations for remaining functions
-void SIMDOptimizer::convolution2D(const float* input, const float* kernel, float* output,
-                                 size_t input_h, size_t input_w, size_t kernel_h, size_t kernel_w,
-                                 size_t stride_h, size_t stride_w) {}
-
-void SIMDOptimizer::convolution2D(const double* input, const double* kernel, double* output,
-                                 size_t input_h, size_t input_w, size_t kernel_h, size_t kernel_w,
-                                 size_t stride_h, size_t stride_w) {}
-
-void SIMDOptimizer::maxPooling2D(const float* input, float* output,
-                                size_t input_h, size_t input_w, size_t pool_h, size_t pool_w,
-                                size_t stride_h, size_t stride_w) {}
-
-void SIMDOptimizer::avgPooling2D(const float* input, float* output,
-                                size_t input_h, size_t input_w, size_t pool_h, size_t pool_w,
-                                size_t stride_h, size_t stride_w) {}
-
 float SIMDOptimizer::vectorMax(const float* input, size_t size) { return 0.0f; }
 double SIMDOptimizer::vectorMax(const double* input, size_t size) { return 0.0; }
 float SIMDOptimizer::vectorMin(const float* input, size_t size) { return 0.0f; }
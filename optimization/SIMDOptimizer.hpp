@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <memory>
+#include <cstdint>
 #include <immintrin.h>  // AVX/SSE intrinsics
 #include <cstring>
 #include <algorithm>
@@ -57,7 +58,14 @@ public:
     void matrixMatrixMul(const double* a, const double* b, double* result,
                         size_t m, size_t n, size_t k);
     
-    // Convolution operations
+    // Gates recurrentes empaquetados: weights [rows][input_size + hidden_size], columnas x | h.
+    // out_x[r] = W[r][:input]·x y out_h[r] = W[r][input:]·h en una sola pasada sobre W.
+    void gateMatrixVectorMul(const float* weights, const float* x, const float* h, float* out_x, float* out_h,
+                             size_t rows, size_t input_size, size_t hidden_size);
+    void gateMatrixVectorMul(const double* weights, const double* x, const double* h, double* out_x, double* out_h,
+                             size_t rows, size_t input_size, size_t hidden_size);
+    
+    // Convolution operations (un canal, sin padding: output [(in_h - k_h) / s_h + 1][(in_w - k_w) / s_w + 1])
     void convolution2D(const float* input, const float* kernel, float* output,
                       size_t input_h, size_t input_w, size_t kernel_h, size_t kernel_w,
                       size_t stride_h = 1, size_t stride_w = 1);
@@ -66,14 +74,20 @@ public:
                       size_t input_h, size_t input_w, size_t kernel_h, size_t kernel_w,
                       size_t stride_h = 1, size_t stride_w = 1);
     
-    // Pooling operations
+    // Pooling operations (output [(in_h - pool_h) / s_h + 1][(in_w - pool_w) / s_w + 1])
     void maxPooling2D(const float* input, float* output,
                      size_t input_h, size_t input_w, size_t pool_h, size_t pool_w,
                      size_t stride_h = 1, size_t stride_w = 1);
+    void maxPooling2D(const double* input, double* output,
+                     size_t input_h, size_t input_w, size_t pool_h, size_t pool_w,
+                     size_t stride_h = 1, size_t stride_w = 1);
     
     void avgPooling2D(const float* input, float* output,
                      size_t input_h, size_t input_w, size_t pool_h, size_t pool_w,
                      size_t stride_h = 1, size_t stride_w = 1);
+    void avgPooling2D(const double* input, double* output,
+                     size_t input_h, size_t input_w, size_t pool_h, size_t pool_w,
+                     size_t stride_h = 1, size_t stride_w = 1);
     
     // Reduction operations
     float vectorSum(const float* input, size_t size);
@@ -103,6 +117,30 @@ public:
     void attentionWeights(const double* query, const double* key, double* weights,
                          size_t seq_len, size_t dim);
     
+    // Spiking neuron kernels (population SoA, un paso de Euler)
+    struct LIFKernelParams {
+        double decay;             // 1 - dt / (R * C)
+        double input_gain;        // dt / C
+        double rest_drive;        // dt * V_rest / (R * C)
+        double threshold;
+        double reset;
+        double adaptation_decay;  // exp(-dt / tau_adapt); solo con adaptation != nullptr
+        double adaptation_jump;   // Incremento de la corriente de adaptación por spike
+    };
+
+    struct IzhikevichKernelParams {
+        double a, b, c, d;
+        double dt;
+        double peak;              // Umbral de spike (30 mV)
+    };
+
+    // Consumen 'input' (queda a cero), escriben fired[i] en {0, 1} y devuelven el número de spikes.
+    // adaptation == nullptr integra LIF simple; si no, LIF adaptativa.
+    size_t lifPopulationStep(double* potential, double* input, double* adaptation, uint8_t* fired,
+                             size_t size, const LIFKernelParams& params);
+    size_t izhikevichPopulationStep(double* v, double* u, double* input, uint8_t* fired,
+                                    size_t size, const IzhikevichKernelParams& params);
+
     // Memory management
     void* alignedAlloc(size_t size, size_t alignment = 32);
     void alignedFree(void* ptr);
@@ -173,7 +211,22 @@ private:
                               size_t m, size_t n, size_t k);
     void matrixMatrixMulScalar(const double* a, const double* b, double* result,
                               size_t m, size_t n, size_t k);
-    
+
+    // Convolución con stride_w == 1: broadcast del peso y FMA sobre filas de salida contiguas
+    void convolution2DAVX2(const float* input, const float* kernel, float* output,
+                          size_t input_h, size_t input_w, size_t kernel_h, size_t kernel_w, size_t stride_h);
+    void convolution2DAVX2(const double* input, const double* kernel, double* output,
+                          size_t input_h, size_t input_w, size_t kernel_h, size_t kernel_w, size_t stride_h);
+
+    size_t lifPopulationStepAVX2(double* potential, double* input, double* adaptation, uint8_t* fired,
+                                 size_t size, const LIFKernelParams& params);
+    size_t lifPopulationStepScalar(double* potential, double* input, double* adaptation, uint8_t* fired,
+                                   size_t size, const LIFKernelParams& params);
+    size_t izhikevichPopulationStepAVX2(double* v, double* u, double* input, uint8_t* fired,
+                                        size_t size, const IzhikevichKernelParams& params);
+    size_t izhikevichPopulationStepScalar(double* v, double* u, double* input, uint8_t* fired,
+                                          size_t size, const IzhikevichKernelParams& params);
+
     // Utility functions
     void detectCapabilities();
     size_t getAlignment() const;
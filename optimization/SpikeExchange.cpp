@@ -0,0 +1,496 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../../include/SpikeExchange.hpp"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace brainll {
+
+namespace {
+    constexpr uint32_t kHelloMagic = 0x534c4c42;    // "BLLS"
+    constexpr size_t kHeaderBytes = 16;             // u64 paso, u32 spikes, u32 flags
+    constexpr uint32_t kFlagEpochEnd = 1;
+
+    template<typename T>
+    void appendRaw(std::vector<uint8_t>& buffer, const T& value) {
+        const size_t offset = buffer.size();
+        buffer.resize(offset + sizeof(T));
+        std::memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+
+    template<typename T>
+    T readRaw(const uint8_t* data) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+}
+
+SpikeExchange::~SpikeExchange() {
+    close();
+}
+
+bool SpikeExchange::fail(const std::string& message) {
+    m_error = message;
+    return false;
+}
+
+void SpikeExchange::send(size_t peer_index, uint64_t step, const uint32_t* sources, size_t count, bool epoch_end) {
+    Peer& peer = m_peers[peer_index];
+    appendRaw(peer.outbox, step);
+    appendRaw(peer.outbox, static_cast<uint32_t>(count));
+    appendRaw(peer.outbox, epoch_end ? kFlagEpochEnd : 0u);
+    const size_t offset = peer.outbox.size();
+    peer.outbox.resize(offset + count * sizeof(uint32_t));
+    if (count > 0) {
+        std::memcpy(peer.outbox.data() + offset, sources, count * sizeof(uint32_t));
+    }
+    ++m_stats.packets_sent;
+    m_stats.spikes_sent += count;
+    // Empezar a escribir ya; lo que no quepa en el socket sale en el próximo progress()
+    flush(peer);
+}
+
+void SpikeExchange::takeReceived(uint64_t step, std::vector<RemoteSpike>& spikes) {
+    spikes.clear();
+    for (auto& peer : m_peers) {
+        // Cada par envía sus pasos en orden, así que basta con cortar por el primero posterior
+        auto end = std::find_if(peer.received.begin(), peer.received.end(),
+                                [step](const RemoteSpike& spike) { return spike.step > step; });
+        spikes.insert(spikes.end(), peer.received.begin(), end);
+        peer.received.erase(peer.received.begin(), end);
+    }
+}
+
+#ifndef _WIN32
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    bool setNonBlocking(int fd) {
+        const int flags = fcntl(fd, F_GETFL, 0);
+        return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+
+    int remainingMs(Clock::time_point deadline) {
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+        return left > 0 ? static_cast<int>(left) : 0;
+    }
+
+    // Crea un socket para 'endpoint' y resuelve su dirección; -1 si falla
+    int openSocket(const RankEndpoint& endpoint, sockaddr_storage& address, socklen_t& length) {
+        std::memset(&address, 0, sizeof(address));
+        if (endpoint.address.compare(0, 5, "unix:") == 0) {
+            sockaddr_un* unix_address = reinterpret_cast<sockaddr_un*>(&address);
+            const std::string path = endpoint.address.substr(5);
+            if (path.empty() || path.size() >= sizeof(unix_address->sun_path)) {
+                return -1;
+            }
+            unix_address->sun_family = AF_UNIX;
+            std::memcpy(unix_address->sun_path, path.c_str(), path.size() + 1);
+            length = sizeof(sockaddr_un);
+            return ::socket(AF_UNIX, SOCK_STREAM, 0);
+        }
+
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* result = nullptr;
+        const std::string port = std::to_string(endpoint.port);
+        if (getaddrinfo(endpoint.address.c_str(), port.c_str(), &hints, &result) != 0 || !result) {
+            return -1;
+        }
+        std::memcpy(&address, result->ai_addr, result->ai_addrlen);
+        length = static_cast<socklen_t>(result->ai_addrlen);
+        freeaddrinfo(result);
+
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd >= 0) {
+            // Los paquetes son pequeños y sensibles a la latencia
+            const int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+        return fd;
+    }
+
+    bool waitReady(int fd, short events, Clock::time_point deadline) {
+        pollfd entry{fd, events, 0};
+        return ::poll(&entry, 1, remainingMs(deadline)) > 0 && !(entry.revents & (POLLERR | POLLNVAL));
+    }
+
+    bool writeAll(int fd, const void* data, size_t size, Clock::time_point deadline) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        while (size > 0) {
+            const ssize_t written = ::send(fd, bytes, size, MSG_NOSIGNAL);
+            if (written > 0) {
+                bytes += written;
+                size -= static_cast<size_t>(written);
+            } else if (written < 0 && errno == EINTR) {
+                continue;
+            } else if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                if (!waitReady(fd, POLLOUT, deadline)) {
+                    return false;
+                }
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool readAll(int fd, void* data, size_t size, Clock::time_point deadline) {
+        uint8_t* bytes = static_cast<uint8_t*>(data);
+        while (size > 0) {
+            const ssize_t got = ::recv(fd, bytes, size, 0);
+            if (got > 0) {
+                bytes += got;
+                size -= static_cast<size_t>(got);
+            } else if (got < 0 && errno == EINTR) {
+                continue;
+            } else if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                if (!waitReady(fd, POLLIN, deadline)) {
+                    return false;
+                }
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    struct Hello {
+        uint32_t magic;
+        int32_t rank;
+        uint64_t fingerprint;
+    };
+}
+
+bool SpikeExchange::connect(int rank, const std::vector<RankEndpoint>& endpoints, uint64_t fingerprint,
+                            std::chrono::milliseconds timeout) {
+    close();
+    const auto deadline = Clock::now() + timeout;
+
+    const RankEndpoint* self = nullptr;
+    std::vector<RankEndpoint> others;
+    for (const auto& endpoint : endpoints) {
+        if (endpoint.rank == rank) {
+            self = &endpoint;
+        } else {
+            others.push_back(endpoint);
+        }
+    }
+    if (!self) {
+        return fail("No endpoint for rank " + std::to_string(rank));
+    }
+    if (others.empty()) {
+        m_connected_alone = true;
+        return true;
+    }
+    std::sort(others.begin(), others.end(),
+              [](const RankEndpoint& a, const RankEndpoint& b) { return a.rank < b.rank; });
+    m_peers.resize(others.size());
+    for (size_t i = 0; i < others.size(); ++i) {
+        m_peers[i].rank = others[i].rank;
+    }
+
+    // 1. Escuchar antes de conectar: así los rangos mayores pueden conectarse a este
+    //    aunque todavía esté conectándose a los menores
+    sockaddr_storage address;
+    socklen_t length = 0;
+    m_listen_fd = openSocket(*self, address, length);
+    if (m_listen_fd < 0) {
+        return fail("Cannot create listening socket for " + self->address);
+    }
+    if (address.ss_family == AF_UNIX) {
+        m_unix_path = self->address.substr(5);
+        ::unlink(m_unix_path.c_str());
+    } else {
+        const int one = 1;
+        setsockopt(m_listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    }
+    if (::bind(m_listen_fd, reinterpret_cast<sockaddr*>(&address), length) != 0 ||
+        ::listen(m_listen_fd, static_cast<int>(others.size())) != 0 || !setNonBlocking(m_listen_fd)) {
+        const std::string reason = std::strerror(errno);
+        close();
+        return fail("Cannot listen on " + self->address + ":" + std::to_string(self->port) + ": " + reason);
+    }
+
+    const Hello hello{kHelloMagic, rank, fingerprint};
+    auto checkHello = [&](const Hello& remote, int expected_rank) {
+        if (remote.magic != kHelloMagic || (expected_rank >= 0 && remote.rank != expected_rank)) {
+            return fail("Unexpected handshake from rank " + std::to_string(remote.rank));
+        }
+        if (remote.fingerprint != fingerprint) {
+            return fail("Rank " + std::to_string(remote.rank) + " built a different network");
+        }
+        return true;
+    };
+
+    // 2. Conectar con los rangos menores, reintentando mientras aún no escuchen
+    for (size_t i = 0; i < others.size() && others[i].rank < rank; ++i) {
+        Peer& peer = m_peers[i];
+        while (peer.fd < 0) {
+            sockaddr_storage remote_address;
+            socklen_t remote_length = 0;
+            const int fd = openSocket(others[i], remote_address, remote_length);
+            if (fd < 0) {
+                close();
+                return fail("Cannot resolve " + others[i].address);
+            }
+            if (::connect(fd, reinterpret_cast<sockaddr*>(&remote_address), remote_length) == 0) {
+                peer.fd = fd;
+                break;
+            }
+            ::close(fd);
+            if (Clock::now() >= deadline) {
+                close();
+                return fail("Timed out connecting to rank " + std::to_string(others[i].rank));
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        Hello reply;
+        if (!setNonBlocking(peer.fd) || !writeAll(peer.fd, &hello, sizeof(hello), deadline) ||
+            !readAll(peer.fd, &reply, sizeof(reply), deadline)) {
+            close();
+            return fail("Handshake with rank " + std::to_string(peer.rank) + " failed");
+        }
+        if (!checkHello(reply, peer.rank)) {
+            const std::string error = m_error;
+            close();
+            return fail(error);
+        }
+    }
+
+    // 3. Aceptar a los rangos mayores en el orden en que lleguen
+    size_t pending = static_cast<size_t>(std::count_if(others.begin(), others.end(),
+                                                       [rank](const RankEndpoint& e) { return e.rank > rank; }));
+    while (pending > 0) {
+        if (!waitReady(m_listen_fd, POLLIN, deadline)) {
+            close();
+            return fail("Timed out waiting for higher ranks to connect");
+        }
+        const int fd = ::accept(m_listen_fd, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+        if (address.ss_family != AF_UNIX) {
+            const int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+        Hello remote;
+        if (!setNonBlocking(fd) || !readAll(fd, &remote, sizeof(remote), deadline) || !checkHello(remote, -1)) {
+            ::close(fd);
+            const std::string error = m_error.empty() ? "Handshake with a higher rank failed" : m_error;
+            close();
+            return fail(error);
+        }
+        auto peer = std::find_if(m_peers.begin(), m_peers.end(),
+                                 [&](const Peer& p) { return p.rank == remote.rank; });
+        if (peer == m_peers.end() || peer->fd >= 0 || remote.rank < rank ||
+            !writeAll(fd, &hello, sizeof(hello), deadline)) {
+            ::close(fd);
+            close();
+            return fail("Unexpected connection from rank " + std::to_string(remote.rank));
+        }
+        peer->fd = fd;
+        --pending;
+    }
+
+    m_error.clear();
+    return true;
+}
+
+void SpikeExchange::close() {
+    for (auto& peer : m_peers) {
+        if (peer.fd >= 0) {
+            ::close(peer.fd);
+        }
+    }
+    m_peers.clear();
+    if (m_listen_fd >= 0) {
+        ::close(m_listen_fd);
+        m_listen_fd = -1;
+    }
+    if (!m_unix_path.empty()) {
+        ::unlink(m_unix_path.c_str());
+        m_unix_path.clear();
+    }
+    m_connected_alone = false;
+}
+
+bool SpikeExchange::flush(Peer& peer) {
+    if (peer.closed && peer.out_offset < peer.outbox.size()) {
+        return fail("Connection to rank " + std::to_string(peer.rank) + " closed");
+    }
+    while (peer.out_offset < peer.outbox.size()) {
+        const ssize_t written = ::send(peer.fd, peer.outbox.data() + peer.out_offset,
+                                       peer.outbox.size() - peer.out_offset, MSG_NOSIGNAL);
+        if (written > 0) {
+            peer.out_offset += static_cast<size_t>(written);
+            m_stats.bytes_sent += static_cast<uint64_t>(written);
+        } else if (written < 0 && errno == EINTR) {
+            continue;
+        } else if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true;
+        } else {
+            return fail("Send to rank " + std::to_string(peer.rank) + " failed");
+        }
+    }
+    peer.outbox.clear();
+    peer.out_offset = 0;
+    return true;
+}
+
+bool SpikeExchange::receive(Peer& peer) {
+    uint8_t chunk[65536];
+    while (!peer.closed) {
+        const ssize_t got = ::recv(peer.fd, chunk, sizeof(chunk), 0);
+        if (got > 0) {
+            peer.inbox.insert(peer.inbox.end(), chunk, chunk + got);
+            m_stats.bytes_received += static_cast<uint64_t>(got);
+        } else if (got < 0 && errno == EINTR) {
+            continue;
+        } else if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else if (got == 0) {
+            // Un rango que terminó antes cierra su extremo; lo ya recibido sigue valiendo
+            peer.closed = true;
+        } else {
+            return fail("Receive from rank " + std::to_string(peer.rank) + " failed");
+        }
+    }
+
+    // Decodificar los paquetes completos; un paquete a medias espera al siguiente recv
+    size_t offset = 0;
+    while (peer.inbox.size() - offset >= kHeaderBytes) {
+        const uint8_t* header = peer.inbox.data() + offset;
+        const uint64_t step = readRaw<uint64_t>(header);
+        const uint32_t count = readRaw<uint32_t>(header + 8);
+        const uint32_t flags = readRaw<uint32_t>(header + 12);
+        const size_t packet_bytes = kHeaderBytes + static_cast<size_t>(count) * sizeof(uint32_t);
+        if (peer.inbox.size() - offset < packet_bytes) {
+            break;
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            peer.received.push_back({step, readRaw<uint32_t>(header + kHeaderBytes + i * sizeof(uint32_t))});
+        }
+        if (flags & kFlagEpochEnd) {
+            peer.closed_through = std::max(peer.closed_through, step + 1);
+        }
+        ++m_stats.packets_received;
+        m_stats.spikes_received += count;
+        offset += packet_bytes;
+    }
+    peer.inbox.erase(peer.inbox.begin(), peer.inbox.begin() + static_cast<std::ptrdiff_t>(offset));
+    return true;
+}
+
+bool SpikeExchange::progress() {
+    for (auto& peer : m_peers) {
+        if (!flush(peer) || !receive(peer)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SpikeExchange::waitFor(uint64_t step, std::chrono::milliseconds timeout) {
+    const auto start = Clock::now();
+    const auto deadline = start + timeout;
+    std::vector<pollfd> entries(m_peers.size());
+    bool ok = true;
+    for (;;) {
+        if (!progress()) {
+            ok = false;
+            break;
+        }
+        bool complete = true;
+        for (size_t i = 0; i < m_peers.size(); ++i) {
+            const Peer& peer = m_peers[i];
+            if (peer.closed_through <= step && peer.closed) {
+                ok = fail("Connection to rank " + std::to_string(peer.rank) + " closed before step " +
+                          std::to_string(step));
+            }
+            complete = complete && peer.closed_through > step;
+            const bool writing = peer.out_offset < peer.outbox.size();
+            entries[i] = {peer.closed ? -1 : peer.fd, static_cast<short>(POLLIN | (writing ? POLLOUT : 0)), 0};
+        }
+        if (complete || !ok) {
+            break;
+        }
+        if (Clock::now() >= deadline) {
+            ok = fail("Timed out waiting for spikes of step " + std::to_string(step));
+            break;
+        }
+        ::poll(entries.data(), entries.size(), std::min(remainingMs(deadline), 100));
+    }
+    m_stats.wait_ms += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return ok;
+}
+
+#else
+
+// Sin sockets POSIX: la simulación distribuida solo está disponible en Linux/Unix
+bool SpikeExchange::connect(int rank, const std::vector<RankEndpoint>& endpoints, uint64_t,
+                            std::chrono::milliseconds) {
+    close();
+    if (endpoints.size() == 1 && endpoints.front().rank == rank) {
+        m_connected_alone = true;
+        return true;
+    }
+    return fail("Distributed spike exchange is not supported on this platform");
+}
+
+void SpikeExchange::close() {
+    m_peers.clear();
+    m_connected_alone = false;
+}
+
+bool SpikeExchange::flush(Peer&) {
+    return false;
+}
+
+bool SpikeExchange::receive(Peer&) {
+    return false;
+}
+
+bool SpikeExchange::progress() {
+    return m_peers.empty();
+}
+
+bool SpikeExchange::waitFor(uint64_t, std::chrono::milliseconds) {
+    return m_peers.empty();
+}
+
+#endif
+
+}
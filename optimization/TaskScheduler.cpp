@@ -0,0 +1,419 @@
+#include "TaskScheduler.hpp"
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <set>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#undef min
+#undef max
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace BrainLL {
+
+namespace {
+    // Scheduler y worker del hilo actual (nullptr / -1 fuera de cualquier pool)
+    thread_local const TaskScheduler* t_scheduler = nullptr;
+    thread_local int t_worker = -1;
+    thread_local size_t t_steal_cursor = 0;
+    thread_local int t_depth = 0;             // Tareas anidadas en curso (parallelFor dentro de una tarea)
+
+    // Formato de /sys: "0-3,8,10-11"
+    std::vector<int> parseCpuList(const std::string& text) {
+        std::vector<int> cpus;
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t comma = text.find(',', pos);
+            if (comma == std::string::npos) {
+                comma = text.size();
+            }
+            const std::string item = text.substr(pos, comma - pos);
+            const size_t dash = item.find('-');
+            try {
+                const int first = std::stoi(item.substr(0, dash));
+                const int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+                for (int cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            } catch (...) {
+                // Entrada vacía o malformada
+            }
+            pos = comma + 1;
+        }
+        return cpus;
+    }
+
+    std::string readLine(const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        return line;
+    }
+
+    // (cpu, nodo NUMA) de las CPUs utilizables, agrupadas nodo a nodo
+    std::vector<std::pair<int, int>> detectCpuTopology() {
+        std::vector<std::pair<int, int>> topology;
+#if defined(__linux__)
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        const bool have_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+        auto usable = [&](int cpu) {
+            return cpu >= 0 && cpu < CPU_SETSIZE && (!have_mask || CPU_ISSET(cpu, &allowed));
+        };
+
+        std::set<int> seen;
+        for (int node : parseCpuList(readLine("/sys/devices/system/node/online"))) {
+            const std::string path = "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+            for (int cpu : parseCpuList(readLine(path))) {
+                if (usable(cpu) && seen.insert(cpu).second) {
+                    topology.push_back({cpu, node});
+                }
+            }
+        }
+        if (topology.empty() && have_mask) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &allowed)) {
+                    topology.push_back({cpu, 0});
+                }
+            }
+        }
+#elif defined(_WIN32)
+        const int count = static_cast<int>(std::min<unsigned>(std::thread::hardware_concurrency(), 64));
+        for (int cpu = 0; cpu < count; ++cpu) {
+            topology.push_back({cpu, 0});
+        }
+#endif
+        return topology;
+    }
+
+    void pinCurrentThread(int cpu) {
+        if (cpu < 0) {
+            return;
+        }
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#elif defined(_WIN32)
+        SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu);
+#endif
+    }
+
+    uint64_t nanosecondsSince(std::chrono::steady_clock::time_point start) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+}
+
+// Global instance
+TaskScheduler& getTaskScheduler() {
+    static TaskScheduler* scheduler = new TaskScheduler();
+    return *scheduler;
+}
+
+struct TaskScheduler::ForJob {
+    const std::function<void(size_t, size_t)>* body;
+    size_t grain;
+    std::atomic<size_t> pending{1};      // Subrangos encolados o en ejecución
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+};
+
+TaskScheduler::TaskScheduler(const TaskSchedulerConfig& config)
+    : config_(config)
+    , numa_nodes_(1)
+    , stats_start_(std::chrono::steady_clock::now())
+{
+    size_t count = config_.num_workers;
+    if (count == 0) {
+        const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+        count = hardware - 1;
+    }
+
+    workers_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    assignCpus();
+
+    for (size_t i = 0; i < count; ++i) {
+        workers_[i]->thread = std::thread(&TaskScheduler::workerLoop, this, i);
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_.store(true);
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+void TaskScheduler::assignCpus() {
+    const auto topology = detectCpuTopology();
+    std::set<int> nodes;
+    for (const auto& entry : topology) {
+        nodes.insert(entry.second);
+    }
+    numa_nodes_ = std::max<size_t>(nodes.size(), 1);
+
+    // Workers consecutivos llenan un nodo antes de pasar al siguiente; la primera CPU
+    // queda para el hilo principal mientras haya CPUs de sobra
+    const size_t count = workers_.size();
+    for (size_t i = 0; i < count && !topology.empty(); ++i) {
+        const auto& slot = topology[(i + (count < topology.size() ? 1 : 0)) % topology.size()];
+        workers_[i]->numa_node = slot.second;
+        workers_[i]->cpu = config_.pin_workers ? slot.first : -1;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        auto& victims = workers_[i]->victims;
+        for (int pass = 0; pass < 2; ++pass) {
+            for (size_t k = 1; k < count; ++k) {
+                const size_t other = (i + k) % count;
+                const bool same_node = workers_[other]->numa_node == workers_[i]->numa_node;
+                if (same_node == (pass == 0)) {
+                    victims.push_back(other);
+                }
+            }
+        }
+    }
+}
+
+int TaskScheduler::currentWorker() const {
+    return t_scheduler == this ? t_worker : -1;
+}
+
+void TaskScheduler::push(Task task) {
+    // Sin workers (una sola CPU) nadie más la ejecutaría
+    if (workers_.empty()) {
+        task();
+        return;
+    }
+    const int self = currentWorker();
+    if (self >= 0) {
+        Worker& worker = *workers_[self];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    } else {
+        std::lock_guard<std::mutex> lock(injection_mutex_);
+        injection_.push_back(std::move(task));
+    }
+    queued_.fetch_add(1);
+
+    // Despertar a un worker dormido; sleeping_ se lee después de publicar la tarea,
+    // así que o el worker ve queued_ > 0 antes de dormir o recibe la notificación
+    if (sleeping_.load() > 0) {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        wake_.notify_one();
+    }
+}
+
+bool TaskScheduler::tryTake(int self, Task& task) {
+    if (queued_.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+
+    // Cola propia por detrás (LIFO: lo último partido sigue en caché)
+    if (self >= 0) {
+        Worker& worker = *workers_[self];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (!worker.tasks.empty()) {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+            queued_.fetch_sub(1);
+            return true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(injection_mutex_);
+        if (!injection_.empty()) {
+            task = std::move(injection_.front());
+            injection_.pop_front();
+            queued_.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // Robo por delante (FIFO: los trozos más grandes), primero en el mismo nodo
+    const size_t count = workers_.size();
+    const size_t attempts = self >= 0 ? workers_[self]->victims.size() : count;
+    const size_t start = self >= 0 ? 0 : t_steal_cursor++;
+    for (size_t k = 0; k < attempts; ++k) {
+        const size_t victim = self >= 0 ? workers_[self]->victims[k] : (start + k) % count;
+        Worker& other = *workers_[victim];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.tasks.empty()) {
+            task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+            queued_.fetch_sub(1);
+            if (self >= 0) {
+                workers_[self]->steals.fetch_add(1, std::memory_order_relaxed);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::execute(int self, Task& task) {
+    if (self < 0) {
+        caller_tasks_.fetch_add(1, std::memory_order_relaxed);
+        task();
+        return;
+    }
+    // Solo la tarea exterior suma tiempo ocupado; las que ejecuta mientras espera ya caen dentro
+    Worker& worker = *workers_[self];
+    worker.tasks_executed.fetch_add(1, std::memory_order_relaxed);
+    if (t_depth > 0) {
+        task();
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    ++t_depth;
+    task();
+    --t_depth;
+    worker.busy_ns.fetch_add(nanosecondsSince(start), std::memory_order_relaxed);
+}
+
+void TaskScheduler::workerLoop(size_t index) {
+    t_scheduler = this;
+    t_worker = static_cast<int>(index);
+    pinCurrentThread(workers_[index]->cpu);
+
+    const int self = static_cast<int>(index);
+    size_t idle_rounds = 0;
+    Task task;
+    while (true) {
+        if (tryTake(self, task)) {
+            execute(self, task);
+            task = nullptr;
+            idle_rounds = 0;
+            continue;
+        }
+        if (stop_.load()) {
+            break;
+        }
+        if (++idle_rounds < config_.spin_attempts) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleeping_.fetch_add(1);
+        wake_.wait(lock, [this]() { return queued_.load() > 0 || stop_.load(); });
+        sleeping_.fetch_sub(1);
+        idle_rounds = 0;
+    }
+}
+
+void TaskScheduler::parallelFor(size_t begin, size_t end, size_t grain,
+                                const std::function<void(size_t, size_t)>& body) {
+    if (end <= begin) {
+        return;
+    }
+    const size_t count = end - begin;
+    if (grain == 0) {
+        grain = std::max<size_t>(1, count / (concurrency() * 8));
+    }
+    if (count <= grain || workers_.empty()) {
+        for (size_t chunk = begin; chunk < end; chunk += std::min(grain, end - chunk)) {
+            body(chunk, chunk + std::min(grain, end - chunk));
+        }
+        return;
+    }
+
+    auto job = std::make_shared<ForJob>();
+    job->body = &body;
+    job->grain = grain;
+    runRange(job, begin, end);
+
+    // Ayudar (con esta u otras tareas) hasta que no quede ningún subrango pendiente
+    const int self = currentWorker();
+    Task task;
+    while (job->pending.load() > 0) {
+        if (tryTake(self, task)) {
+            execute(self, task);
+            task = nullptr;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    if (job->error) {
+        std::rethrow_exception(job->error);
+    }
+}
+
+void TaskScheduler::runRange(const std::shared_ptr<ForJob>& job, size_t begin, size_t end) {
+    // Bisección perezosa: la mitad derecha queda disponible para robar
+    while (end - begin > job->grain) {
+        const size_t middle = begin + (end - begin) / 2;
+        job->pending.fetch_add(1);
+        push([this, job, middle, end]() { runRange(job, middle, end); });
+        end = middle;
+    }
+    if (!job->failed.load()) {
+        try {
+            (*job->body)(begin, end);
+        } catch (...) {
+            if (!job->failed.exchange(true)) {
+                job->error = std::current_exception();
+            }
+        }
+    }
+    job->pending.fetch_sub(1);
+}
+
+TaskScheduler::Stats TaskScheduler::getStats() const {
+    Stats stats;
+    stats.caller_tasks = caller_tasks_.load(std::memory_order_relaxed);
+    stats.tasks_executed = stats.caller_tasks;
+    stats.steals = 0;
+    stats.elapsed_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - stats_start_).count();
+
+    double busy_ms = 0.0;
+    for (const auto& worker : workers_) {
+        WorkerStats entry;
+        entry.cpu = worker->cpu;
+        entry.numa_node = worker->numa_node;
+        entry.tasks_executed = worker->tasks_executed.load(std::memory_order_relaxed);
+        entry.steals = worker->steals.load(std::memory_order_relaxed);
+        entry.busy_ms = static_cast<double>(worker->busy_ns.load(std::memory_order_relaxed)) / 1e6;
+        stats.tasks_executed += entry.tasks_executed;
+        stats.steals += entry.steals;
+        busy_ms += entry.busy_ms;
+        stats.workers.push_back(entry);
+    }
+    const double capacity = stats.elapsed_ms * static_cast<double>(workers_.size());
+    stats.utilization = capacity > 0.0 ? std::min(1.0, busy_ms / capacity) : 0.0;
+    return stats;
+}
+
+void TaskScheduler::resetStats() {
+    for (auto& worker : workers_) {
+        worker->tasks_executed.store(0, std::memory_order_relaxed);
+        worker->steals.store(0, std::memory_order_relaxed);
+        worker->busy_ns.store(0, std::memory_order_relaxed);
+    }
+    caller_tasks_.store(0, std::memory_order_relaxed);
+    stats_start_ = std::chrono::steady_clock::now();
+}
+
+} // namespace BrainLL
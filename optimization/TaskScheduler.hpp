@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace BrainLL {
+
+struct TaskSchedulerConfig {
+    size_t num_workers = 0;          // 0: hardware_concurrency() - 1 (el hilo que espera también trabaja)
+    // Fija cada worker a una CPU de la máscara de afinidad del proceso, llenando un nodo NUMA
+    // antes del siguiente. Desactivado por defecto: varios procesos en el mismo host (rangos
+    // de ParallelSimulation, intérpretes Python) empezarían todos por las mismas CPUs
+    bool pin_workers = false;
+    size_t spin_attempts = 256;      // Rondas de robo sin éxito antes de dormir
+};
+
+/**
+ * @brief Process-wide work-stealing task scheduler
+ *
+ * Shared by the simulation, CNN and optimizer subsystems so they don't each spawn
+ * their own threads and oversubscribe the machine.
+ * - One deque per worker: the owner pushes/pops at the back, thieves take from the
+ *   front, trying workers on the same NUMA node before remote ones
+ * - Threads outside the pool submit through a shared injection queue
+ * - parallelFor() splits lazily down to the grain size; the calling thread helps
+ *   execute until its range is done, so nested calls from inside a task are safe
+ * - Idle workers spin briefly, then sleep until new work is queued
+ */
+class TaskScheduler {
+public:
+    using Task = std::function<void()>;
+
+    struct WorkerStats {
+        int cpu;                     // CPU a la que está fijado (-1 si no lo está)
+        int numa_node;
+        uint64_t tasks_executed;
+        uint64_t steals;             // Tareas tomadas de otra cola
+        double busy_ms;              // Tiempo ejecutando tareas
+    };
+
+    struct Stats {
+        std::vector<WorkerStats> workers;
+        uint64_t caller_tasks;       // Ejecutadas por hilos externos mientras esperaban
+        uint64_t tasks_executed;
+        uint64_t steals;
+        double elapsed_ms;           // Desde la construcción o el último resetStats()
+        double utilization;          // busy / (elapsed * workers), en [0, 1]
+    };
+
+    explicit TaskScheduler(const TaskSchedulerConfig& config = TaskSchedulerConfig());
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    size_t workerCount() const { return workers_.size(); }
+    size_t concurrency() const { return workers_.size() + 1; }   // Workers + hilo llamante
+    size_t numaNodeCount() const { return numa_nodes_; }
+
+    // Índice del worker actual en este scheduler, o -1 desde un hilo externo
+    int currentWorker() const;
+
+    // Encola una tarea; no se debe bloquear en el future desde dentro de otra tarea
+    template<typename F>
+    auto submit(F&& function) -> std::future<typename std::invoke_result<F>::type> {
+        using Result = typename std::invoke_result<F>::type;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(function));
+        std::future<Result> future = task->get_future();
+        push([task]() { (*task)(); });
+        return future;
+    }
+
+    /**
+     * Ejecuta body(chunk_begin, chunk_end) sobre subrangos disjuntos que cubren
+     * [begin, end), de como mucho 'grain' elementos (grain 0 elige uno automático).
+     * Los subrangos salen de bisecar el rango, así que dependen solo de begin, end y
+     * grain, no de qué hilo los ejecuta. Bloquea hasta terminar y relanza la primera
+     * excepción de body.
+     */
+    void parallelFor(size_t begin, size_t end, size_t grain,
+                     const std::function<void(size_t, size_t)>& body);
+
+    Stats getStats() const;
+    void resetStats();
+
+private:
+    struct alignas(64) Worker {
+        std::deque<Task> tasks;
+        std::mutex mutex;
+        std::thread thread;
+        int cpu = -1;
+        int numa_node = 0;
+        std::vector<size_t> victims;             // Mismo nodo primero, luego el resto
+        std::atomic<uint64_t> tasks_executed{0};
+        std::atomic<uint64_t> steals{0};
+        std::atomic<uint64_t> busy_ns{0};
+    };
+
+    struct ForJob;
+
+    TaskSchedulerConfig config_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    size_t numa_nodes_;
+
+    std::deque<Task> injection_;                 // Tareas de hilos externos
+    std::mutex injection_mutex_;
+
+    std::atomic<size_t> queued_{0};              // Tareas en colas, aún sin tomar
+    std::atomic<size_t> sleeping_{0};
+    std::atomic<bool> stop_{false};
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+
+    std::atomic<uint64_t> caller_tasks_{0};
+    std::chrono::steady_clock::time_point stats_start_;
+
+    void push(Task task);
+    bool tryTake(int self, Task& task);
+    void execute(int self, Task& task);
+    void workerLoop(size_t index);
+    void runRange(const std::shared_ptr<ForJob>& job, size_t begin, size_t end);
+    void assignCpus();
+};
+
+// Scheduler global, creado en el primer uso
+extern TaskScheduler& getTaskScheduler();
+
+} // namespace BrainLL
@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2025 Joaquín Sturtz - NetechAI
+ * Licensed under AGPL v3 License - 17/7/2025
+ */
+
+// Las comprobaciones usan assert: que sigan activas también en builds Release
+#undef NDEBUG
+
+#include "../../include/ParallelSimulation.hpp"
+#include "../../include/Neuron.hpp"
+#include "../../include/Connection.hpp"
+#include "../../include/DynamicNetwork.hpp"
+#include "../../include/DebugConfig.hpp"
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace brainll {
+namespace Tests {
+
+NeuronTypeParams izhikevichParams() {
+    NeuronTypeParams params;
+    params.model = "Izhikevich";
+    return params;
+}
+
+struct EventNetwork {
+    ParallelSimulation simulation;
+    std::vector<std::shared_ptr<Neuron>> neurons;
+    std::vector<std::shared_ptr<Connection>> connections;
+};
+
+// Red reproducible en modo por eventos: conexiones sobre todo locales (varios carriles
+// con pocas sinapsis cortadas) y retardos de min_delay a min_delay + 7 pasos
+void buildTopology(EventNetwork& network, size_t size, uint32_t min_delay) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> weight(0.0, 5.0);
+    for (size_t i = 0; i < size; ++i) {
+        auto neuron = std::make_shared<Neuron>("n" + std::to_string(i), "RS", izhikevichParams());
+        network.neurons.push_back(neuron);
+        network.simulation.addNeuron(neuron);
+    }
+    for (size_t i = 0; i < size; ++i) {
+        for (int k = 0; k < 30; ++k) {
+            const size_t target = (rng() % 5 == 0) ? rng() % size : (i + size + rng() % 200 - 100) % size;
+            auto connection = std::make_shared<Connection>(network.neurons[i], network.neurons[target], weight(rng));
+            connection->setDelay(min_delay + rng() % 8);
+            network.connections.push_back(connection);
+            network.simulation.addConnection(connection);
+        }
+    }
+    network.simulation.setSimulationMode("event_driven");
+}
+
+// Estímulos externos; en modo distribuido se programan después de repartir la red
+void scheduleStimuli(EventNetwork& network, size_t size) {
+    for (size_t i = 0; i < size; i += 30) {
+        network.simulation.scheduleEvent("n" + std::to_string(i), static_cast<double>(i % 9), 60.0);
+    }
+    for (int step = 0; step < 300; step += 40) {
+        for (size_t i = 0; i < size; i += 71) {
+            network.simulation.scheduleEvent("n" + std::to_string(i), step, 45.0);
+        }
+    }
+}
+
+void buildNetwork(EventNetwork& network, size_t size, uint32_t min_delay) {
+    buildTopology(network, size, min_delay);
+    scheduleStimuli(network, size);
+}
+
+std::vector<double> potentialsOf(const EventNetwork& network) {
+    std::vector<double> potentials;
+    for (const auto& neuron : network.neurons) {
+        potentials.push_back(neuron->getPotential());
+    }
+    return potentials;
+}
+
+void testEventArrivalStep() {
+    std::cout << "Testing event-driven delivery at the connection delay..." << std::endl;
+
+    // Retardo -> pasos entre el disparo de la fuente y la llegada al destino
+    const std::pair<double, uint64_t> cases[] = {{0.0, 1}, {1.0, 1}, {4.6, 5}, {5.0, 5}, {12.0, 12}};
+    for (const auto& [delay, latency] : cases) {
+        ParallelSimulation simulation;
+        auto source = std::make_shared<Neuron>("a", "RS", izhikevichParams());
+        auto target = std::make_shared<Neuron>("b", "RS", izhikevichParams());
+        simulation.addNeuron(source);
+        simulation.addNeuron(target);
+        auto connection = std::make_shared<Connection>(source, target, 60.0);
+        connection->setDelay(delay);
+        simulation.addConnection(connection);
+        simulation.setSimulationMode("event_driven");
+        simulation.scheduleEvent("a", 3, 60.0);
+
+        const double rest = target->getPotential();
+        uint64_t fired_at = 0, arrived_at = 0;
+        for (int i = 0; i < 20 && arrived_at == 0; ++i) {
+            const uint64_t step = simulation.getCurrentStep();
+            simulation.update();
+            if (source->hasFired() && fired_at == 0) {
+                fired_at = step;
+            }
+            if (target->getPotential() != rest) {
+                arrived_at = step;
+            }
+        }
+        assert(fired_at > 0);
+        assert(arrived_at == fired_at + latency);
+    }
+
+    std::cout << "✓ Arrival step tests passed" << std::endl;
+}
+
+void testEventDrivenMatchesAcrossThreads() {
+    std::cout << "Testing event-driven update across thread counts..." << std::endl;
+
+    std::vector<double> reference;
+    size_t reference_deliveries = 0;
+    for (int threads : {1, 2, 3, 8}) {
+        EventNetwork network;
+        buildNetwork(network, 3000, 1);
+        network.simulation.setThreadCount(threads);
+        size_t deliveries = 0;
+        for (int step = 0; step < 150; ++step) {
+            network.simulation.update();
+            deliveries += network.simulation.getLastStats().connections_processed;
+        }
+        if (threads == 1) {
+            reference = potentialsOf(network);
+            reference_deliveries = deliveries;
+            assert(deliveries > 0);
+        } else {
+            assert(potentialsOf(network) == reference);
+            assert(deliveries == reference_deliveries);
+        }
+    }
+
+    std::cout << "✓ Event-driven determinism tests passed" << std::endl;
+}
+
+void testEpochRunMatchesUpdate() {
+    std::cout << "Testing epoch-synchronized run against step-by-step update..." << std::endl;
+
+    for (uint32_t min_delay : {1u, 3u}) {
+        EventNetwork reference;
+        buildNetwork(reference, 3000, min_delay);
+        reference.simulation.setThreadCount(1);
+        for (int step = 0; step < 300; ++step) {
+            reference.simulation.update();
+        }
+
+        // run() en dos tramos que no caen en frontera de época
+        for (int threads : {2, 4, 8}) {
+            EventNetwork network;
+            buildNetwork(network, 3000, min_delay);
+            network.simulation.setThreadCount(threads);
+            network.simulation.run(121);
+            network.simulation.run(179);
+            // Hay sinapsis entre carriles: la época es el retardo mínimo
+            assert(network.simulation.getEpochSteps() == min_delay);
+            assert(network.simulation.getCurrentStep() == reference.simulation.getCurrentStep());
+            assert(potentialsOf(network) == potentialsOf(reference));
+        }
+    }
+
+    std::cout << "✓ Epoch determinism tests passed" << std::endl;
+}
+
+constexpr size_t kDistributedSize = 2000;
+constexpr int kDistributedSteps = 240;
+
+std::string rankAddress(const std::string& transport, int rank) {
+    return transport == "unix"
+        ? "unix:/tmp/brainll_test_" + std::to_string(getppid()) + "_" + std::to_string(rank) + ".sock"
+        : "127.0.0.1";
+}
+
+int rankPort(int rank) {
+    return 20000 + static_cast<int>(getppid() % 20000) + rank;
+}
+
+void connectRank(EventNetwork& network, const std::string& transport, int rank, int ranks) {
+    network.simulation.setNodeId(rank);
+    network.simulation.setListenAddress(rankAddress(transport, rank), rankPort(rank));
+    for (int other = 0; other < ranks; ++other) {
+        if (other != rank) {
+            network.simulation.addRemoteNode(other, rankAddress(transport, other), rankPort(other));
+        }
+    }
+    network.simulation.enableDistributedMode(true);
+    network.simulation.synchronizeWithRemoteNodes();
+    assert(network.simulation.getDistributedStats().ranks == static_cast<size_t>(ranks));
+}
+
+// Disparos por neurona propia de un rango (ranks 1: la simulación en un solo proceso)
+std::vector<int> spikeCountsOfRank(const std::string& transport, int rank, int ranks) {
+    EventNetwork network;
+    buildTopology(network, kDistributedSize, 2);
+    if (ranks > 1) {
+        connectRank(network, transport, rank, ranks);
+    }
+    scheduleStimuli(network, kDistributedSize);
+    std::vector<int> counts(kDistributedSize, 0);
+    for (int step = 0; step < kDistributedSteps; ++step) {
+        network.simulation.update();
+        for (size_t i = 0; i < kDistributedSize; ++i) {
+            if (network.neurons[i]->hasFired() && network.simulation.ownsNeuron(network.neurons[i]->getId())) {
+                ++counts[i];
+            }
+        }
+    }
+    return counts;
+}
+
+// Espera a un hijo como mucho 'seconds'; si no termina lo mata y devuelve -1
+int waitChild(pid_t pid, int seconds) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    int status = 0;
+    while (waitpid(pid, &status, WNOHANG) == 0) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            kill(pid, SIGKILL);
+            waitpid(pid, &status, 0);
+            return -1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+// Lanza un proceso por rango y suma los disparos que cada uno envía por su pipe
+std::vector<int> forkedSpikeCounts(const std::string& transport, int ranks) {
+    std::vector<pid_t> children;
+    std::vector<int> pipes;
+    for (int rank = 0; rank < ranks; ++rank) {
+        int fds[2];
+        assert(pipe(fds) == 0);
+        const pid_t pid = fork();
+        assert(pid >= 0);
+        if (pid == 0) {
+            close(fds[0]);
+            const std::vector<int> counts = spikeCountsOfRank(transport, rank, ranks);
+            const ssize_t bytes = static_cast<ssize_t>(counts.size() * sizeof(int));
+            _exit(write(fds[1], counts.data(), counts.size() * sizeof(int)) == bytes ? 0 : 1);
+        }
+        close(fds[1]);
+        children.push_back(pid);
+        pipes.push_back(fds[0]);
+    }
+
+    std::vector<int> total(kDistributedSize, 0);
+    for (int rank = 0; rank < ranks; ++rank) {
+        std::vector<int> counts(kDistributedSize, 0);
+        size_t received = 0;
+        const size_t bytes = counts.size() * sizeof(int);
+        ssize_t chunk = 0;
+        while (received < bytes &&
+               (chunk = read(pipes[rank], reinterpret_cast<char*>(counts.data()) + received, bytes - received)) > 0) {
+            received += static_cast<size_t>(chunk);
+        }
+        close(pipes[rank]);
+        assert(received == bytes);
+        for (size_t i = 0; i < kDistributedSize; ++i) {
+            total[i] += counts[i];
+        }
+    }
+    for (pid_t pid : children) {
+        assert(waitChild(pid, 120) == 0);
+    }
+    return total;
+}
+
+void testDistributedMatchesSingleProcess() {
+    std::cout << "Testing distributed ranks over TCP and Unix sockets against one process..." << std::endl;
+
+    const std::vector<int> reference = forkedSpikeCounts("tcp", 1);
+    size_t reference_spikes = 0;
+    for (int count : reference) {
+        reference_spikes += static_cast<size_t>(count);
+    }
+    assert(reference_spikes > 0);
+
+    for (const std::string transport : {"tcp", "unix"}) {
+        for (int ranks : {2, 4}) {
+            assert(forkedSpikeCounts(transport, ranks) == reference);
+        }
+    }
+
+    std::cout << "✓ Distributed spike count tests passed" << std::endl;
+}
+
+void testDistributedPeerDisconnect() {
+    std::cout << "Testing distributed run when a peer disconnects mid-run..." << std::endl;
+
+    for (const std::string transport : {"tcp", "unix"}) {
+        std::vector<pid_t> children;
+        for (int rank = 0; rank < 2; ++rank) {
+            const pid_t pid = fork();
+            assert(pid >= 0);
+            if (pid == 0) {
+                EventNetwork network;
+                buildTopology(network, kDistributedSize, 2);
+                connectRank(network, transport, rank, 2);
+                scheduleStimuli(network, kDistributedSize);
+                // El rango 1 sale sin cerrar nada; el 0 tiene que ver el error, no colgarse
+                const int steps = rank == 1 ? 40 : kDistributedSteps;
+                for (int step = 0; step < steps; ++step) {
+                    try {
+                        network.simulation.updateAsync().get();
+                    } catch (const std::runtime_error&) {
+                        _exit(rank == 0 ? 3 : 1);
+                    }
+                }
+                _exit(rank == 1 ? 0 : 2);
+            }
+            children.push_back(pid);
+        }
+        assert(waitChild(children[1], 60) == 0);
+        assert(waitChild(children[0], 30) == 3);
+    }
+
+    std::cout << "✓ Peer disconnect tests passed" << std::endl;
+}
+
+void runAllTests() {
+    std::cout << "=== Running ParallelSimulation Tests ===" << std::endl;
+    DebugConfig::getInstance().setDebugLevel(DebugLevel::WARNING);
+
+    // Los tests con fork() primero: el proceso aún no ha arrancado los hilos del scheduler
+    testDistributedMatchesSingleProcess();
+    testDistributedPeerDisconnect();
+    testEventArrivalStep();
+    testEventDrivenMatchesAcrossThreads();
+    testEpochRunMatchesUpdate();
+
+    std::cout << "\nAll ParallelSimulation tests passed" << std::endl;
+}
+
+} // namespace Tests
+} // namespace brainll
+
+int main() {
+    brainll::Tests::runAllTests();
+    return 0;
+}
@@ -0,0 +1,74 @@
+// Las comprobaciones usan assert: que sigan activas también en builds Release
+#undef NDEBUG
+
+#include "SIMDOptimizer.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace BrainLL {
+namespace Tests {
+
+// Entradas de 1e-30 a 30 en ambos signos, con especial densidad cerca de cero y
+// alrededor del corte |x| = 0.625 entre el polinomio y la fórmula con exp
+template <typename T>
+std::vector<T> tanhInputs() {
+    std::vector<T> inputs = {T(0), T(-0.0), T(0.625), T(-0.625), T(20), T(-20), T(40), T(-40), T(1e3)};
+    for (int e = -30; e <= 1; ++e) {
+        for (T m : {T(1), T(1.7), T(3.3), T(6.1), T(9.9)}) {
+            const T x = m * std::pow(T(10), T(e));
+            inputs.push_back(x);
+            inputs.push_back(-x);
+        }
+    }
+    for (int i = -400; i <= 400; ++i) {
+        inputs.push_back(T(0.625) + T(i) * T(1e-4));
+        inputs.push_back(T(i) * T(0.0375));
+    }
+    // Tamaño impar: el resto que no llena un registro pasa por la cola escalar
+    if (inputs.size() % 2 == 0) {
+        inputs.push_back(T(0.3));
+    }
+    return inputs;
+}
+
+template <typename T>
+void checkTanh(const char* name, T max_relative_error) {
+    std::cout << "Testing vectorTanh (" << name << ") against std::tanh..." << std::endl;
+
+    const std::vector<T> inputs = tanhInputs<T>();
+    std::vector<T> outputs(inputs.size());
+    getSIMDOptimizer().vectorTanh(inputs.data(), outputs.data(), inputs.size());
+
+    T worst = 0;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const T expected = std::tanh(inputs[i]);
+        const T error = expected == T(0) ? std::abs(outputs[i]) : std::abs(outputs[i] - expected) / std::abs(expected);
+        worst = std::max(worst, error);
+        assert(error <= max_relative_error);
+        assert(std::signbit(outputs[i]) == std::signbit(inputs[i]) || expected == T(0));
+    }
+
+    std::cout << "✓ " << name << " tanh tests passed (max relative error " << worst << ")" << std::endl;
+}
+
+void runAllTests() {
+    std::cout << "=== Running SIMD tanh Tests ===" << std::endl;
+    std::cout << "AVX2: " << (SIMDOptimizer::hasAVX2() ? "yes" : "no")
+              << ", FMA: " << (SIMDOptimizer::hasFMA() ? "yes" : "no") << std::endl;
+
+    // Unos pocos ulp: 2^-23 ~ 1.2e-7 en float, 2^-52 ~ 2.2e-16 en double
+    checkTanh<float>("float", 5e-7f);
+    checkTanh<double>("double", 1e-15);
+
+    std::cout << "\nAll SIMD tanh tests passed" << std::endl;
+}
+
+} // namespace Tests
+} // namespace BrainLL
+
+int main() {
+    BrainLL::Tests::runAllTests();
+    return 0;
+}
@@ -65,6 +65,8 @@ PYBIND11_MODULE(brainll, m) {
     py::class_<Connection, std::shared_ptr<Connection>>(m, "Connection")
         .def("get_weight", &Connection::getWeight)
         .def("set_weight", &Connection::setWeight)
+        .def("get_delay", &Connection::getDelay)
+        .def("set_delay", &Connection::setDelay, "Sets the synaptic delay in simulation steps.", py::arg("delay"))
         .def("get_source_neuron", &Connection::getSourceNeuron)
         .def("get_destination_neuron", &Connection::getDestinationNeuron)
         .def("is_plastic", &Connection::isPlastic);
@@ -82,7 +84,10 @@ PYBIND11_MODULE(brainll, m) {
         .def("reset", &AdvancedNeuron::reset, "Resets the neuron to its initial state.")
         .def("get_threshold", &AdvancedNeuron::getThreshold)
         .def("get_last_spike_time", &AdvancedNeuron::getLastSpikeTime)
-        .def("get_firing_rate", &AdvancedNeuron::getFiringRate, "Gets firing rate over time window.", py::arg("time_window") = 1000.0);
+        .def("get_firing_rate", &AdvancedNeuron::getFiringRate, "Gets firing rate (Hz) over time window from the bounded spike history.", py::arg("time_window") = 1000.0)
+        .def("get_spike_history", [](const AdvancedNeuron& neuron, double time_window) { return neuron.getSpikeHistory(time_window).toVector(); },
+             "Gets spike times within the time window.", py::arg("time_window") = 1000.0)
+        .def("set_spike_history_capacity", &AdvancedNeuron::setSpikeHistoryCapacity, "Sets how many spikes the neuron keeps.", py::arg("capacity"));
 
     // NeuronModel enum
     py::enum_<NeuronModel>(m, "NeuronModel")
@@ -111,12 +116,26 @@ PYBIND11_MODULE(brainll, m) {
         .def_readwrite("membrane_resistance", &AdvancedNeuronParams::membrane_resistance)
         .def_readwrite("refractory_period", &AdvancedNeuronParams::refractory_period);
 
+    py::enum_<WeightFileFormat>(m, "WeightFileFormat")
+        .value("AUTO", WeightFileFormat::AUTO)
+        .value("BINARY", WeightFileFormat::BINARY)
+        .value("CSV", WeightFileFormat::CSV);
+
+    py::class_<InferenceStats>(m, "InferenceStats")
+        .def_readonly("samples", &InferenceStats::samples)
+        .def_readonly("total_steps", &InferenceStats::total_steps)
+        .def_readonly("converged_exits", &InferenceStats::converged_exits)
+        .def_readonly("silent_exits", &InferenceStats::silent_exits)
+        .def_readonly("last_steps", &InferenceStats::last_steps)
+        .def_readonly("max_steps", &InferenceStats::max_steps)
+        .def("get_average_steps", &InferenceStats::getAverageSteps);
+
     py::class_<DynamicNetwork>(m, "DynamicNetwork")
         .def(py::init<>())
         // Neuron and population management
         .def("create_neuron", &DynamicNetwork::createNeuron, "Creates a new neuron of a given type and adds it to a population.", py::arg("type"), py::arg("population_name"))
         .def("name_neuron", static_cast<void (DynamicNetwork::*)(const std::string&, const std::string&)>(&DynamicNetwork::nameNeuron), "Assigns a name to a neuron using its ID.", py::arg("id"), py::arg("new_name"))
-        .def("get_neuron", &DynamicNetwork::getNeuron, "Retrieves a neuron by its ID or name.", py::arg("id_or_name"), py::return_value_policy::reference)
+        .def("get_neuron", static_cast<std::shared_ptr<Neuron> (DynamicNetwork::*)(const std::string&)>(&DynamicNetwork::getNeuron), "Retrieves a neuron by its ID or name.", py::arg("id_or_name"), py::return_value_policy::reference)
         .def("get_all_neurons", &DynamicNetwork::getAllNeurons, "Get all neurons in the network", py::return_value_policy::reference_internal)
         .def("get_neuron_ids_for_population", &DynamicNetwork::getNeuronIdsForPopulation, "Gets all neuron IDs for a specific population.", py::arg("pop_name"))
         .def("stimulate_population", &DynamicNetwork::stimulatePopulation, "Stimulate all neurons in a specific population.", py::arg("pop_name"), py::arg("potential"))
@@ -126,20 +145,29 @@ PYBIND11_MODULE(brainll, m) {
         .def("connect_by_type", &DynamicNetwork::connectByType, "Connects all neurons of a source type to a destination type.",
              py::arg("source_type"), py::arg("dest_type"), py::arg("weight"), py::arg("is_plastic") = false, py::arg("learning_rate") = 0.05)
         .def("get_connections_for_neuron", &DynamicNetwork::getConnectionsForNeuron, "Gets all connections for a specific neuron.", py::arg("neuron_id"))
+        .def("get_connection", &DynamicNetwork::getConnection, "Gets the connection from source to destination, or None.", py::arg("source_id"), py::arg("dest_id"))
         .def("get_connection_count", &DynamicNetwork::getConnectionCount, "Returns the total number of connections.")
         // Simulation and state
         .def("update", &DynamicNetwork::update, "Performs one simulation step.")
         .def("reset", &DynamicNetwork::reset, "Resets the network to its initial state.")
+        .def("enable_csr_propagation", &DynamicNetwork::enableCSRPropagation, "Propagates spikes through a compiled CSR matrix, walking only rows of fired neurons.", py::arg("enable") = true)
+        .def("set_thread_count", &DynamicNetwork::setThreadCount, "Sets the number of threads for the deterministic parallel step.", py::arg("num_threads"))
+        .def("get_thread_count", &DynamicNetwork::getThreadCount, "Gets the number of threads used by update().")
+        .def("set_random_seed", &DynamicNetwork::setRandomSeed, "Sets the seed used for random connectivity.", py::arg("seed"))
+        .def("get_random_seed", &DynamicNetwork::getRandomSeed, "Gets the seed used for random connectivity.")
         .def("get_most_active_neuron", &DynamicNetwork::getMostActiveNeuron, "Gets the most active neuron, optionally filtered by type prefix.", py::arg("type_prefix") = "")
         // Persistence
-        .def("save_weights", &DynamicNetwork::saveWeights, "Saves the network's connection weights to a file.", py::arg("filepath"))
+        .def("save_weights", &DynamicNetwork::saveWeights, "Saves the network's connection weights to a file (binary .bllw, or CSV for *.csv paths).", py::arg("filepath"), py::arg("format") = WeightFileFormat::AUTO)
         .def("load_weights", &DynamicNetwork::loadWeights, "Loads connection weights from a file.", py::arg("filepath"))
         // Inference methods
         .def("set_input_neurons", &DynamicNetwork::setInputNeurons, "Sets the input neurons for inference.", py::arg("neuron_ids"))
         .def("set_output_neurons", &DynamicNetwork::setOutputNeurons, "Sets the output neurons for inference.", py::arg("neuron_ids"))
         .def("get_output_activations", &DynamicNetwork::getOutputActivations, "Gets the current activations of output neurons.")
-        .def("process_input", &DynamicNetwork::processInput, "Processes numerical input through the network.", py::arg("input"))
-        .def("forward", &DynamicNetwork::forward, "Forward pass through the network.", py::arg("input"))
+        .def("process_input", &DynamicNetwork::processInput, "Processes numerical input through the network.", py::arg("input"), py::arg("max_steps") = -1)
+        .def("process_batch", static_cast<std::vector<std::vector<double>> (DynamicNetwork::*)(const std::vector<std::vector<double>>&, int)>(&DynamicNetwork::processBatch), "Processes a batch of inputs, each on an independent copy of the network state.", py::arg("inputs"), py::arg("max_steps") = -1)
+        .def("forward", &DynamicNetwork::forward, "Forward pass through the network.", py::arg("input"), py::arg("max_steps") = -1)
+        .def("get_inference_stats", &DynamicNetwork::getInferenceStats, "Gets accumulated inference step statistics.", py::return_value_policy::reference_internal)
+        .def("reset_inference_stats", &DynamicNetwork::resetInferenceStats, "Clears inference step statistics.")
         .def("predict", &DynamicNetwork::predict, "Predicts output from text input.", py::arg("text_input"));
         
     // BrainLLParser eliminado - solo usar EnhancedBrainLLParser